@@ -18,7 +18,63 @@
 #include <iostream>
 #include <limits>   // for numeric_limits, numeric_limits<>::max_digits10
 #include <set>      // for set
-#include <utility>  // for pair, make_pair
+#include <utility>  // for pair, make_pair, move
+
+namespace
+{
+  // build the column of one field from a per channel entry map, entries are sorted by channel
+  template <class T>
+  const CDBTTree::Column<T> &get_column(std::map<std::string, CDBTTree::Column<T>> &columns,
+                                        const std::map<int, std::map<std::string, T>> &entries,
+                                        const std::string &fieldname, T missing)
+  {
+    auto iter = columns.find(fieldname);
+    if (iter != columns.end())
+    {
+      return iter->second;
+    }
+    std::vector<int> channels;
+    std::vector<T> values;
+    for (const auto &entry : entries)
+    {
+      auto fielditer = entry.second.find(fieldname);
+      if (fielditer != entry.second.end())
+      {
+        channels.push_back(entry.first);
+        values.push_back(fielditer->second);
+      }
+    }
+    return columns.emplace(fieldname, CDBTTree::Column<T>(std::move(channels), std::move(values), missing)).first->second;
+  }
+}  // namespace
+
+template <class T>
+CDBTTree::Column<T>::Column(std::vector<int> channels, std::vector<T> values, T missing)
+  : m_Channels(std::move(channels))
+  , m_Values(std::move(values))
+  , m_Missing(missing)
+{
+  if (m_Channels.empty())
+  {
+    return;
+  }
+  // use a dense array unless more than half of it would be empty
+  const int64_t span = static_cast<int64_t>(m_Channels.back()) - m_Channels.front() + 1;
+  if (span <= 2 * static_cast<int64_t>(m_Channels.size()) + 64)
+  {
+    m_FirstChannel = m_Channels.front();
+    m_Dense.assign(span, m_Missing);
+    for (std::size_t i = 0; i < m_Channels.size(); ++i)
+    {
+      m_Dense[m_Channels[i] - m_FirstChannel] = m_Values[i];
+    }
+  }
+}
+
+template class CDBTTree::Column<float>;
+template class CDBTTree::Column<double>;
+template class CDBTTree::Column<int>;
+template class CDBTTree::Column<uint64_t>;
 
 CDBTTree::CDBTTree(const std::string &fname)
   : m_Filename(fname)
@@ -45,6 +101,7 @@ void CDBTTree::SetFloatValue(int channel, const std::string &name, float value)
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  m_FloatColumnMap.clear();
   m_FloatEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -62,6 +119,7 @@ void CDBTTree::SetDoubleValue(int channel, const std::string &name, double value
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  m_DoubleColumnMap.clear();
   m_DoubleEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -79,6 +137,7 @@ void CDBTTree::SetIntValue(int channel, const std::string &name, int value)
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  m_IntColumnMap.clear();
   m_IntEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -96,6 +155,7 @@ void CDBTTree::SetUInt64Value(int channel, const std::string &name, uint64_t val
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  m_UInt64ColumnMap.clear();
   m_UInt64EntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -873,3 +933,59 @@ uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verb
   }
   return calibiter->second;
 }
+
+const CDBTTree::Column<float> &CDBTTree::GetFloatColumn(const std::string &name, int verbose)
+{
+  if (m_FloatEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  const auto &column = get_column(m_FloatColumnMap, m_FloatEntryMap, "F" + name, std::numeric_limits<float>::quiet_NaN());
+  if (column.empty() && verbose > 0)
+  {
+    std::cout << PHWHERE << " Could not find " << name << " in float calibrations" << std::endl;
+  }
+  return column;
+}
+
+const CDBTTree::Column<double> &CDBTTree::GetDoubleColumn(const std::string &name, int verbose)
+{
+  if (m_DoubleEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  const auto &column = get_column(m_DoubleColumnMap, m_DoubleEntryMap, "D" + name, std::numeric_limits<double>::quiet_NaN());
+  if (column.empty() && verbose > 0)
+  {
+    std::cout << PHWHERE << " Could not find " << name << " in double calibrations" << std::endl;
+  }
+  return column;
+}
+
+const CDBTTree::Column<int> &CDBTTree::GetIntColumn(const std::string &name, int verbose)
+{
+  if (m_IntEntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  const auto &column = get_column(m_IntColumnMap, m_IntEntryMap, "I" + name, std::numeric_limits<int>::min());
+  if (column.empty() && verbose > 0)
+  {
+    std::cout << PHWHERE << " Could not find " << name << " in int calibrations" << std::endl;
+  }
+  return column;
+}
+
+const CDBTTree::Column<uint64_t> &CDBTTree::GetUInt64Column(const std::string &name, int verbose)
+{
+  if (m_UInt64EntryMap.empty())
+  {
+    LoadCalibrations();
+  }
+  const auto &column = get_column(m_UInt64ColumnMap, m_UInt64EntryMap, "g" + name, std::numeric_limits<uint64_t>::max());
+  if (column.empty() && verbose > 0)
+  {
+    std::cout << PHWHERE << " Could not find " << name << " in uint64 calibrations" << std::endl;
+  }
+  return column;
+}
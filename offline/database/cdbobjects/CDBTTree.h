@@ -1,15 +1,67 @@
 #ifndef CDBOBJECTS_CDBTTREE_H
 #define CDBOBJECTS_CDBTTREE_H
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 class TTree;
 
 class CDBTTree
 {
  public:
+  //! values of one per channel field, resolved once by name
+  /*!
+   * channels are stored sorted, lookups do not involve strings or maps. When the
+   * channel numbers are compact, Get() indexes a dense array, otherwise it does a
+   * binary search. Channels without this field return the same value as the
+   * corresponding Get...Value method (NaN, INT_MIN or UINT64_MAX)
+   */
+  template <class T>
+  class Column
+  {
+   public:
+    Column() = default;
+    Column(std::vector<int> channels, std::vector<T> values, T missing);
+
+    //! value of a given channel
+    T Get(int channel) const
+    {
+      if (!m_Dense.empty())
+      {
+        const auto index = static_cast<std::size_t>(static_cast<int64_t>(channel) - m_FirstChannel);
+        return index < m_Dense.size() ? m_Dense[index] : m_Missing;
+      }
+      const auto iter = std::lower_bound(m_Channels.begin(), m_Channels.end(), channel);
+      return (iter == m_Channels.end() || *iter != channel) ? m_Missing : m_Values[iter - m_Channels.begin()];
+    }
+
+    //! true if the field was not found for any channel
+    bool empty() const { return m_Channels.empty(); }
+
+    //! number of channels with this field
+    std::size_t size() const { return m_Channels.size(); }
+
+    //! sorted channels with this field
+    const std::vector<int> &GetChannels() const { return m_Channels; }
+
+    //! values, in the same order as the channels
+    const std::vector<T> &GetValues() const { return m_Values; }
+
+   private:
+    std::vector<int> m_Channels;
+    std::vector<T> m_Values;
+
+    //! values indexed by channel - m_FirstChannel, empty when the channels are too sparse
+    std::vector<T> m_Dense;
+    int64_t m_FirstChannel = 0;
+
+    T m_Missing{};
+  };
+
   CDBTTree() = default;
   explicit CDBTTree(const std::string &fname);
   ~CDBTTree();
@@ -38,6 +90,18 @@ class CDBTTree
   uint64_t GetSingleUInt64Value(const std::string &name, int verbose = 1);
   uint64_t GetUInt64Value(int channel, const std::string &name, int verbose = 1);
 
+  //!@name per channel fields resolved once, for lookups in event loops
+  /*!
+   * the calibrations are loaded if needed and the column is built on first use.
+   * The returned reference is valid until the tree is modified or deleted
+   */
+  //@{
+  const Column<float> &GetFloatColumn(const std::string &name, int verbose = 1);
+  const Column<double> &GetDoubleColumn(const std::string &name, int verbose = 1);
+  const Column<int> &GetIntColumn(const std::string &name, int verbose = 1);
+  const Column<uint64_t> &GetUInt64Column(const std::string &name, int verbose = 1);
+  //@}
+
  private:
   enum
   {
@@ -57,6 +121,12 @@ class CDBTTree
   std::map<std::string, int> m_SingleIntEntryMap;
   std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
   std::map<std::string, uint64_t> m_SingleUInt64EntryMap;
+
+  //! columns built from the entry maps, by field name
+  std::map<std::string, Column<float>> m_FloatColumnMap;
+  std::map<std::string, Column<double>> m_DoubleColumnMap;
+  std::map<std::string, Column<int>> m_IntColumnMap;
+  std::map<std::string, Column<uint64_t>> m_UInt64ColumnMap;
 };
 
 #endif
@@ -0,0 +1,170 @@
+#include "CDBCache.h"
+
+#include <nlohmann/json.hpp>
+
+#include <unistd.h>  // for getpid
+
+#include <cstdint>  // for uint64_t
+#include <cstdio>   // for rename, remove, snprintf
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <utility>  // for move
+
+namespace
+{
+  constexpr uint64_t fnv_offset = 14695981039346656037ULL;
+  constexpr uint64_t fnv_prime = 1099511628211ULL;
+
+  void fnv_update(uint64_t &hash, const char *data, size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= fnv_prime;
+    }
+  }
+
+  std::string to_hex(uint64_t hash)
+  {
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return buffer;
+  }
+
+  // unique temporary name next to path, for jobs sharing the cache
+  std::string temporary_name(const std::string &path)
+  {
+    std::random_device rd;
+    return path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(rd());
+  }
+}  // namespace
+
+CDBCache::CDBCache(const std::string &directory)
+  : m_Directory(directory)
+{
+}
+
+std::string CDBCache::hash(const std::string &data)
+{
+  uint64_t value = fnv_offset;
+  fnv_update(value, data.data(), data.size());
+  return to_hex(value);
+}
+
+bool CDBCache::atomicWrite(const std::string &path, const std::string &content) const
+{
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+  const std::string tmpname = temporary_name(path);
+  {
+    std::ofstream out(tmpname, std::ios::binary);
+    out << content;
+    if (!out.good())
+    {
+      std::cout << "CDBCache: could not write " << tmpname << std::endl;
+      out.close();
+      std::remove(tmpname.c_str());
+      return false;
+    }
+  }
+  if (std::rename(tmpname.c_str(), path.c_str()) != 0)
+  {
+    std::cout << "CDBCache: could not rename " << tmpname << " to " << path << std::endl;
+    std::remove(tmpname.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool CDBCache::readUrls(const std::string &globaltag, long long iov, std::map<std::string, std::string> &urls) const
+{
+  const std::string path = m_Directory + "/" + globaltag + "/" + std::to_string(iov) + ".json";
+  std::ifstream in(path);
+  if (!in.is_open())
+  {
+    return false;
+  }
+  nlohmann::json content = nlohmann::json::parse(in, nullptr, false);
+  if (!content.is_object())
+  {
+    std::cout << "CDBCache: ignoring corrupted " << path << std::endl;
+    return false;
+  }
+  std::map<std::string, std::string> cached;
+  for (auto &item : content.items())
+  {
+    if (!item.value().is_string())
+    {
+      std::cout << "CDBCache: ignoring corrupted " << path << std::endl;
+      return false;
+    }
+    cached[item.key()] = item.value().get<std::string>();
+  }
+  urls = std::move(cached);
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBCache: read " << urls.size() << " urls from " << path << std::endl;
+  }
+  return true;
+}
+
+bool CDBCache::writeUrls(const std::string &globaltag, long long iov, const std::map<std::string, std::string> &urls) const
+{
+  const std::string path = m_Directory + "/" + globaltag + "/" + std::to_string(iov) + ".json";
+  nlohmann::json content(urls);
+  return atomicWrite(path, content.dump(1));
+}
+
+std::string CDBCache::getPayload(const std::string &url, bool copy) const
+{
+  // payload already cached
+  const std::string indexpath = m_Directory + "/urls/" + hash(url);
+  {
+    std::ifstream index(indexpath);
+    std::string cached;
+    if (std::getline(index, cached) && std::filesystem::is_regular_file(cached))
+    {
+      return cached;
+    }
+  }
+  if (!copy || !std::filesystem::is_regular_file(url))
+  {
+    return url;
+  }
+
+  // hash the payload content
+  std::ifstream in(url, std::ios::binary);
+  uint64_t value = fnv_offset;
+  char buffer[1 << 16];
+  while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0)
+  {
+    fnv_update(value, buffer, in.gcount());
+  }
+  if (in.bad())
+  {
+    return url;
+  }
+
+  // copy through a temporary file
+  const std::string cached = m_Directory + "/payloads/" + to_hex(value) + "/" + std::filesystem::path(url).filename().string();
+  if (!std::filesystem::is_regular_file(cached))
+  {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cached).parent_path(), ec);
+    const std::string tmpname = temporary_name(cached);
+    if (!std::filesystem::copy_file(url, tmpname, ec) || std::rename(tmpname.c_str(), cached.c_str()) != 0)
+    {
+      std::cout << "CDBCache: could not copy " << url << " to " << cached << std::endl;
+      std::remove(tmpname.c_str());
+      return url;
+    }
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBCache: cached " << url << " as " << cached << std::endl;
+  }
+  atomicWrite(indexpath, cached + "\n");
+  return cached;
+}
@@ -0,0 +1,48 @@
+#ifndef SPHENIXNPC_CDBCACHE_H
+#define SPHENIXNPC_CDBCACHE_H
+
+#include <map>
+#include <string>
+
+// On disk cache of resolved payload urls and payload files, shared by all
+// jobs pointing to the same directory. Layout:
+//   <dir>/<global tag>/<iov>.json      urls of all domains valid at iov
+//   <dir>/urls/<hash of url>           local copy of the payload at url
+//   <dir>/payloads/<hash of content>/  payload files, content addressed
+// Files are written to a temporary name and renamed, so concurrent jobs
+// never see partial files. The cached urls never expire, the cache must
+// only be used for locked global tags.
+class CDBCache
+{
+ public:
+  explicit CDBCache(const std::string &directory);
+  virtual ~CDBCache() = default;
+
+  // read the urls resolved for a global tag and iov, false if not cached
+  bool readUrls(const std::string &globaltag, long long iov, std::map<std::string, std::string> &urls) const;
+
+  // save the urls resolved for a global tag and iov
+  bool writeUrls(const std::string &globaltag, long long iov, const std::map<std::string, std::string> &urls) const;
+
+  // local copy of the payload at url. If copy is set, a payload which is not
+  // cached yet is copied into the cache. Returns the url itself if the
+  // payload is not cached and cannot be copied
+  std::string getPayload(const std::string &url, bool copy) const;
+
+  const std::string &getDirectory() const { return m_Directory; }
+
+  void Verbosity(int i) { m_Verbosity = i; }
+  int Verbosity() const { return m_Verbosity; }
+
+  // 64 bit FNV-1a hash, in hex
+  static std::string hash(const std::string &data);
+
+ private:
+  // write content to path through a temporary file
+  bool atomicWrite(const std::string &path, const std::string &content) const;
+
+  int m_Verbosity = 0;
+  std::string m_Directory;
+};
+
+#endif  // SPHENIXNPC_CDBCACHE_H
@@ -1,10 +1,13 @@
 #include "SphenixClient.h"
 
+#include "CDBCache.h"
+
 #include <nopayloadclient/exception.hpp>  // for DataBaseException
 #include <nopayloadclient/nopayloadclient.hpp>
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
 #include <iostream>
 #include <stdexcept>
 
@@ -14,6 +17,15 @@ SphenixClient::SphenixClient(const std::string& gt_name)
 {
 }
 
+SphenixClient::~SphenixClient() = default;
+
+void SphenixClient::setCacheDirectory(const std::string& dir, bool copy_payloads)
+{
+  m_DiskCache = std::make_unique<CDBCache>(dir);
+  m_DiskCache->Verbosity(m_Verbosity);
+  m_CopyPayloads = copy_payloads;
+}
+
 nlohmann::json SphenixClient::getPayloadIOVs(long long iov)
 {
   return nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
@@ -74,30 +86,102 @@ nlohmann::json SphenixClient::getUrlDict(long long iov)
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start)
 {
+  m_IOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end)
 {
+  m_IOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start, 0, iov_end);
 }
 
 std::string SphenixClient::getCalibration(const std::string& pl_type, long long iov)
 {
-  nlohmann::json resp = getUrl(pl_type, iov);
+  const std::map<std::string, std::string>& urls = getCalibrations(iov);
+  auto iter = urls.find(pl_type);
+  if (iter == urls.end())
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << "No valid payload with type " << pl_type << std::endl;
+    }
+    return "";
+  }
+  if (m_DiskCache && (m_Offline || isGlobalTagLocked(m_CachedGlobalTag)))
+  {
+    return m_DiskCache->getPayload(iter->second, m_CopyPayloads && !m_Offline);
+  }
+  return iter->second;
+}
+
+const std::map<std::string, std::string>& SphenixClient::getCalibrations(long long iov)
+{
+  const auto key = std::make_pair(m_CachedGlobalTag, iov);
+  auto iter = m_IOVCache.find(key);
+  if (iter != m_IOVCache.end())
+  {
+    return iter->second;
+  }
+
+  // cached urls never expire, the disk cache is only used for locked global tags
+  // in offline mode the lock status cannot be checked, but only locked global tags are written to the cache
+  const bool use_disk_cache = m_DiskCache && (m_Offline || isGlobalTagLocked(m_CachedGlobalTag));
+
+  std::map<std::string, std::string> urls;
+  if (use_disk_cache && m_DiskCache->readUrls(m_CachedGlobalTag, iov, urls))
+  {
+    return m_IOVCache.emplace(key, std::move(urls)).first->second;
+  }
+  if (m_Offline)
+  {
+    // keep the empty result, this is reported only once
+    std::cout << "SphenixClient: offline mode, no cached payloads for global tag " << m_CachedGlobalTag
+              << ", iov: " << iov << std::endl;
+    return m_IOVCache[key];
+  }
+
+  // one request for all domains
+  const auto start = std::chrono::steady_clock::now();
+  nlohmann::json resp = getPayloadIOVs(iov);
+  ++m_NRequests;
+  m_RequestTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
   if (resp["code"] != 0)
   {
+    // not kept, the next call retries
     if (m_Verbosity > 0)
     {
       std::cout << resp << std::endl;
     }
-    return "";
+    static const std::map<std::string, std::string> empty;
+    return empty;
   }
-  return resp["msg"];
+  for (auto& piov : resp["msg"].items())
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << "pl_type: " << piov.key()
+                << ", iov: " << iov
+                << ", minor_iov_start: " << piov.value()["minor_iov_start"]
+                << ", minor_iov_end: " << piov.value()["minor_iov_end"]
+                << std::endl;
+    }
+    // same validity as getUrl
+    if (piov.value()["minor_iov_end"] > iov)
+    {
+      urls[piov.key()] = piov.value()["payload_url"].get<std::string>();
+    }
+  }
+  if (use_disk_cache)
+  {
+    m_DiskCache->writeUrls(m_CachedGlobalTag, iov, urls);
+  }
+  return m_IOVCache.emplace(key, std::move(urls)).first->second;
 }
 
 nlohmann::json SphenixClient::unlockGlobalTag(const std::string& gt_name)
 {
+  m_GlobalTagLocked.erase(gt_name);
   if (existGlobalTag(gt_name))
   {
     return nopayloadclient::NoPayloadClient::unlockGlobalTag(gt_name);
@@ -108,6 +192,7 @@ nlohmann::json SphenixClient::unlockGlobalTag(const std::string& gt_name)
 
 nlohmann::json SphenixClient::lockGlobalTag(const std::string& gt_name)
 {
+  m_GlobalTagLocked.erase(gt_name);
   if (existGlobalTag(gt_name))
   {
     return nopayloadclient::NoPayloadClient::lockGlobalTag(gt_name);
@@ -119,12 +204,14 @@ nlohmann::json SphenixClient::lockGlobalTag(const std::string& gt_name)
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start)
 {
+  m_IOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start, long long iov_end)
 {
+  m_IOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start, 0, iov_end);
 }
 
@@ -242,3 +329,38 @@ bool SphenixClient::existGlobalTag(const std::string& tagname)
   }
   return false;
 }
+
+bool SphenixClient::isGlobalTagLocked(const std::string& tagname)
+{
+  auto iter = m_GlobalTagLocked.find(tagname);
+  if (iter != m_GlobalTagLocked.end())
+  {
+    return iter->second;
+  }
+  bool locked = false;
+  nlohmann::json resp = nopayloadclient::NoPayloadClient::getGlobalTags();
+  nlohmann::json msgcont = resp["msg"];
+  for (auto& it : msgcont.items())
+  {
+    if (!it.value().contains("name") || it.value()["name"] != tagname || !it.value().contains("status"))
+    {
+      continue;
+    }
+    // the status is given by its name, either directly or as a status object
+    const nlohmann::json& status = it.value()["status"];
+    locked = (status.is_string() && status == "locked") ||
+             (status.is_object() && status.contains("name") && status["name"] == "locked");
+    break;
+  }
+  if (!locked && m_DiskCache && resp["code"] == 0)
+  {
+    std::cout << "SphenixClient: global tag " << tagname << " is not locked, the disk cache "
+              << m_DiskCache->getDirectory() << " is not used for it" << std::endl;
+  }
+  // a failed request is not kept, the next call retries
+  if (resp["code"] == 0)
+  {
+    m_GlobalTagLocked[tagname] = locked;
+  }
+  return locked;
+}
@@ -5,15 +5,20 @@
 
 #include <nlohmann/json.hpp>
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <utility>
+
+class CDBCache;
 
 class SphenixClient : public nopayloadclient::NoPayloadClient
 {
  public:
   SphenixClient() = default;
   explicit SphenixClient(const std::string& globaltag);
-  virtual ~SphenixClient() = default;
+  virtual ~SphenixClient();
   // make clang happy, since we use our own without overriding the base class methods
   using nopayloadclient::NoPayloadClient::getPayloadIOVs;
 
@@ -29,22 +34,48 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   nlohmann::json insertPayload(const std::string& pl_type, const std::string& file_url, long long iov_start, long long iov_end) override;
   nlohmann::json setGlobalTag(const std::string& name) override;
   std::string getCalibration(const std::string& pl_type, long long iov);
+  // urls of all domains valid at iov for the current global tag. They are
+  // resolved with a single request per global tag and iov, then kept in memory
+  const std::map<std::string, std::string>& getCalibrations(long long iov);
   nlohmann::json unlockGlobalTag(const std::string& tagname) override;
   nlohmann::json lockGlobalTag(const std::string& tagname) override;
   nlohmann::json deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end) override;
 
   bool existGlobalTag(const std::string& tagname);
+  // true if the global tag is locked, so that its payloads cannot change anymore
+  bool isGlobalTagLocked(const std::string& tagname);
   int createDomain(const std::string& domain);
   int cache_set_GlobalTag(const std::string& name);
   bool isGlobalTagSet();
   void Verbosity(int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
+  // on disk cache of resolved urls shared between jobs, only used for locked
+  // global tags. If copy_payloads is set, payload files are copied into it
+  void setCacheDirectory(const std::string& dir, bool copy_payloads = false);
+  // read only mode for running without db server, urls are only taken from the disk cache,
+  // which only contains locked global tags
+  void setOffline(bool b) { m_Offline = b; }
+  bool isOffline() const { return m_Offline; }
+  void clearIOVCache() { m_IOVCache.clear(); }
+  // number of payload iov requests sent to the db server and time spent in them (s)
+  unsigned int getNRequests() const { return m_NRequests; }
+  double getRequestTime() const { return m_RequestTime; }
+
  private:
   int m_Verbosity = 0;
+  bool m_Offline = false;
+  bool m_CopyPayloads = false;
+  unsigned int m_NRequests = 0;
+  double m_RequestTime = 0;
+  std::unique_ptr<CDBCache> m_DiskCache;
+  // urls by domain for each global tag and iov
+  std::map<std::pair<std::string, long long>, std::map<std::string, std::string>> m_IOVCache;
   std::string m_CachedGlobalTag;
   std::set<std::string> m_DomainCache;
   std::set<std::string> m_GlobalTagCache;
+  // lock status of the global tags used with the disk cache
+  std::map<std::string, bool> m_GlobalTagLocked;
 };
 
 #endif  // SPHENIXNPC_SPHENIXCLIENT_H
@@ -20,6 +20,7 @@
 
 #include <TSystem.h>
 
+#include <chrono>
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
@@ -99,6 +100,10 @@ int CDBInterface::End(PHCompositeNode *topNode)
   {
     cdburls->identify();
   }
+  if (Verbosity() > 0)
+  {
+    PrintStatistics();
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -111,6 +116,19 @@ void CDBInterface::Print(const std::string & /* what */) const
               << ", url: " << std::get<1>(iter)
               << ", timestamp: " << std::get<2>(iter) << std::endl;
   }
+  PrintStatistics();
+}
+
+//____________________________________________________________________________..
+void CDBInterface::PrintStatistics() const
+{
+  std::cout << "CDBInterface: " << m_NCalls << " calls, " << m_Time * 1000 << " ms";
+  if (cdbclient)
+  {
+    std::cout << ", db server requests: " << cdbclient->getNRequests()
+              << ", " << cdbclient->getRequestTime() * 1000 << " ms";
+  }
+  std::cout << std::endl;
 }
 
 std::string CDBInterface::getUrl(const std::string &domain, const std::string &filename)
@@ -128,9 +146,27 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
     std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
     gSystem->Exit(1);
   }
+  const auto start = std::chrono::steady_clock::now();
   if (cdbclient == nullptr)
   {
     cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+    // optional on disk cache of resolved urls (and payloads) shared between jobs, used for locked global tags only
+    if (rc->FlagExist("CDB_CACHE_DIR"))
+    {
+      cdbclient->setCacheDirectory(rc->get_StringFlag("CDB_CACHE_DIR"),
+                                   rc->FlagExist("CDB_CACHE_PAYLOADS") && rc->get_IntFlag("CDB_CACHE_PAYLOADS"));
+    }
+    // read only mode without db server, urls are taken from the cache
+    if (rc->FlagExist("CDB_OFFLINE") && rc->get_IntFlag("CDB_OFFLINE"))
+    {
+      if (!rc->FlagExist("CDB_CACHE_DIR"))
+      {
+        std::cout << PHWHERE << "CDB_OFFLINE needs a cache directory set via" << std::endl;
+        std::cout << "rc->set_StringFlag(\"CDB_CACHE_DIR\",<directory>)" << std::endl;
+        gSystem->Exit(1);
+      }
+      cdbclient->setOffline(true);
+    }
   }
   uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
   if (Verbosity() > 0)
@@ -155,6 +191,8 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   {
     return_url = filename;
   }
+  ++m_NCalls;
+  m_Time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
   auto pret = m_UrlVector.insert(make_tuple(domain, return_url, timestamp));
   if (!pret.second && Verbosity() > 1)
   {
@@ -27,12 +27,17 @@ class CDBInterface : public SubsysReco
 
   std::string getUrl(const std::string &domain, const std::string &filename = "");
 
+  /// number of getUrl calls, time spent in them (s), number of and time spent in db server requests (s)
+  void PrintStatistics() const;
+
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
   static CDBInterface *__instance;
   SphenixClient *cdbclient = nullptr;
   std::set<std::tuple<std::string, std::string, uint64_t>> m_UrlVector;
+  unsigned int m_NCalls = 0;
+  double m_Time = 0;
 };
 
 #endif  // FFAMODULES_CDBINTERFACE_H
@@ -15,6 +15,14 @@ class TpcRawHitContainer : public PHObject
   virtual TpcRawHit *AddHit(TpcRawHit *) { return nullptr; }
   virtual unsigned int get_nhits() { return 0; }
   virtual TpcRawHit *get_hit(unsigned int) { return nullptr; }
+  //! append copies of all hits of another container
+  virtual void AddHits(TpcRawHitContainer *hits)
+  {
+    for (unsigned int i = 0; i < hits->get_nhits(); ++i)
+    {
+      AddHit(hits->get_hit(i));
+    }
+  }
 
  private:
   ClassDefOverride(TpcRawHitContainer, 1)
@@ -0,0 +1,183 @@
+#include "TpcRawHitContainerv2.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <limits>
+
+TpcRawHitContainerv2::TpcRawHitContainerv2()
+  : m_offset(1, 0)
+{
+}
+
+TpcRawHitContainerv2::TpcRawHitContainerv2(const TpcRawHitContainerv2 &other)
+  : TpcRawHitContainer(other)
+  , m_bco(other.m_bco)
+  , m_gtm_bco(other.m_gtm_bco)
+  , m_packetid(other.m_packetid)
+  , m_fee(other.m_fee)
+  , m_channel(other.m_channel)
+  , m_sampaaddress(other.m_sampaaddress)
+  , m_sampachannel(other.m_sampachannel)
+  , m_offset(other.m_offset)
+  , m_adc(other.m_adc)
+{
+  // the views of other point to other, get_hit creates new ones
+}
+
+TpcRawHitContainerv2 &TpcRawHitContainerv2::operator=(const TpcRawHitContainerv2 &other)
+{
+  if (this != &other)
+  {
+    TpcRawHitContainer::operator=(other);
+    m_bco = other.m_bco;
+    m_gtm_bco = other.m_gtm_bco;
+    m_packetid = other.m_packetid;
+    m_fee = other.m_fee;
+    m_channel = other.m_channel;
+    m_sampaaddress = other.m_sampaaddress;
+    m_sampachannel = other.m_sampachannel;
+    m_offset = other.m_offset;
+    m_adc = other.m_adc;
+    m_views.clear();
+  }
+  return *this;
+}
+
+void TpcRawHitContainerv2::Reset()
+{
+  // keep the capacity, the next event has about the same size
+  m_bco.clear();
+  m_gtm_bco.clear();
+  m_packetid.clear();
+  m_fee.clear();
+  m_channel.clear();
+  m_sampaaddress.clear();
+  m_sampachannel.clear();
+  m_offset.assign(1, 0);
+  m_adc.clear();
+  m_views.clear();
+}
+
+void TpcRawHitContainerv2::identify(std::ostream &os) const
+{
+  os << "TpcRawHitContainerv2" << std::endl;
+  os << "containing " << m_bco.size() << " Tpc hits with " << m_adc.size() << " samples" << std::endl;
+  if (!m_bco.empty())
+  {
+    os << "for beam clock: " << std::hex << m_bco.front() << std::dec << std::endl;
+  }
+}
+
+int TpcRawHitContainerv2::isValid() const
+{
+  return !m_bco.empty();
+}
+
+void TpcRawHitContainerv2::Reserve(const unsigned int nhits, const unsigned int nsamples)
+{
+  m_bco.reserve(nhits);
+  m_gtm_bco.reserve(nhits);
+  m_packetid.reserve(nhits);
+  m_fee.reserve(nhits);
+  m_channel.reserve(nhits);
+  m_sampaaddress.reserve(nhits);
+  m_sampachannel.reserve(nhits);
+  m_offset.reserve(nhits + 1);
+  m_adc.reserve(static_cast<size_t>(nhits) * nsamples);
+}
+
+uint16_t *TpcRawHitContainerv2::AddWaveform(const uint64_t bco, const uint64_t gtm_bco, const int32_t packetid,
+                                            const uint16_t fee, const uint16_t channel,
+                                            const uint16_t sampaaddress, const uint16_t sampachannel,
+                                            const uint16_t nsamples)
+{
+  m_bco.push_back(bco);
+  m_gtm_bco.push_back(gtm_bco);
+  m_packetid.push_back(packetid);
+  m_fee.push_back(fee);
+  m_channel.push_back(channel);
+  m_sampaaddress.push_back(sampaaddress);
+  m_sampachannel.push_back(sampachannel);
+  const uint32_t first = m_adc.size();
+  m_offset.push_back(first + nsamples);
+  m_adc.resize(first + nsamples, 0);
+  return m_adc.data() + first;
+}
+
+void TpcRawHitContainerv2::set_samples(const unsigned int index, const uint16_t val)
+{
+  if (index + 1 != m_bco.size())
+  {
+    std::cout << PHWHERE << " number of samples can only be changed for the last waveform, "
+              << index << " is not the last of " << m_bco.size() << std::endl;
+    return;
+  }
+  m_offset.back() = m_offset[index] + val;
+  m_adc.resize(m_offset.back(), 0);
+}
+
+TpcRawHit *TpcRawHitContainerv2::AddHit()
+{
+  // same defaults as TpcRawHitv1, the samples are added with set_samples
+  AddWaveform(std::numeric_limits<uint64_t>::max(), std::numeric_limits<uint64_t>::max(),
+              std::numeric_limits<int32_t>::max(), std::numeric_limits<uint16_t>::max(),
+              std::numeric_limits<uint16_t>::max(), std::numeric_limits<uint16_t>::max(),
+              std::numeric_limits<uint16_t>::max(), 0);
+  return get_hit(m_bco.size() - 1);
+}
+
+TpcRawHit *TpcRawHitContainerv2::AddHit(TpcRawHit *tpchit)
+{
+  const uint16_t samples = tpchit->get_samples();
+  uint16_t *adc = AddWaveform(tpchit->get_bco(), tpchit->get_gtm_bco(), tpchit->get_packetid(),
+                              tpchit->get_fee(), tpchit->get_channel(),
+                              tpchit->get_sampaaddress(), tpchit->get_sampachannel(),
+                              samples);
+  for (uint16_t i = 0; i < samples; ++i)
+  {
+    adc[i] = tpchit->get_adc(i);
+  }
+  return get_hit(m_bco.size() - 1);
+}
+
+void TpcRawHitContainerv2::AddHits(TpcRawHitContainer *hits)
+{
+  TpcRawHitContainerv2 *other = dynamic_cast<TpcRawHitContainerv2 *>(hits);
+  if (!other)
+  {
+    // hit by hit for other versions, each AddHit adds a single view
+    TpcRawHitContainer::AddHits(hits);
+    return;
+  }
+  // append the columns, the offsets of the other container are shifted by our samples
+  m_bco.insert(m_bco.end(), other->m_bco.begin(), other->m_bco.end());
+  m_gtm_bco.insert(m_gtm_bco.end(), other->m_gtm_bco.begin(), other->m_gtm_bco.end());
+  m_packetid.insert(m_packetid.end(), other->m_packetid.begin(), other->m_packetid.end());
+  m_fee.insert(m_fee.end(), other->m_fee.begin(), other->m_fee.end());
+  m_channel.insert(m_channel.end(), other->m_channel.begin(), other->m_channel.end());
+  m_sampaaddress.insert(m_sampaaddress.end(), other->m_sampaaddress.begin(), other->m_sampaaddress.end());
+  m_sampachannel.insert(m_sampachannel.end(), other->m_sampachannel.begin(), other->m_sampachannel.end());
+  const uint32_t shift = m_adc.size();
+  std::transform(other->m_offset.begin() + 1, other->m_offset.end(), std::back_inserter(m_offset),
+                 [shift](const uint32_t offset)
+                 { return offset + shift; });
+  m_adc.insert(m_adc.end(), other->m_adc.begin(), other->m_adc.end());
+}
+
+TpcRawHit *TpcRawHitContainerv2::get_hit(unsigned int index)
+{
+  if (index >= m_bco.size())
+  {
+    return nullptr;
+  }
+  // create the missing views after reading from file or adding waveforms,
+  // the existing ones are kept
+  while (m_views.size() <= index)
+  {
+    m_views.emplace_back(this, m_views.size());
+  }
+  return &m_views[index];
+}
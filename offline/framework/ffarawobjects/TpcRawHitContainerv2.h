@@ -0,0 +1,95 @@
+#ifndef FUN4ALLRAW_TPCHITRAWCONTAINERV2_H
+#define FUN4ALLRAW_TPCHITRAWCONTAINERV2_H
+
+#include "TpcRawHitContainer.h"
+#include "TpcRawHitv2.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class TpcRawHit;
+
+//! tpc waveforms stored column wise: one entry per waveform for the header
+//! words and all adc samples in one contiguous buffer with an offset table.
+//! TpcRawHit pointers from get_hit()/AddHit() are views into the container,
+//! they stay valid until Reset or an assignment to the container
+class TpcRawHitContainerv2 : public TpcRawHitContainer
+{
+ public:
+  TpcRawHitContainerv2();
+  ~TpcRawHitContainerv2() override = default;
+
+  //! copies the waveforms, the views of the copy refer to the copy
+  TpcRawHitContainerv2(const TpcRawHitContainerv2 &other);
+  TpcRawHitContainerv2 &operator=(const TpcRawHitContainerv2 &other);
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override;
+
+  TpcRawHit *AddHit() override;
+  TpcRawHit *AddHit(TpcRawHit *tpchit) override;
+  void AddHits(TpcRawHitContainer *hits) override;
+  unsigned int get_nhits() override { return m_bco.size(); }
+  TpcRawHit *get_hit(unsigned int index) override;
+
+  //! append a waveform and return its nsamples adc values for the caller to fill
+  uint16_t *AddWaveform(const uint64_t bco, const uint64_t gtm_bco, const int32_t packetid,
+                        const uint16_t fee, const uint16_t channel,
+                        const uint16_t sampaaddress, const uint16_t sampachannel,
+                        const uint16_t nsamples);
+  //! reserve space for nhits waveforms with nsamples samples each
+  void Reserve(const unsigned int nhits, const unsigned int nsamples);
+
+  // column access, also used by the TpcRawHitv2 views
+  unsigned int size() const { return m_bco.size(); }
+  uint64_t get_bco(const unsigned int index) const { return m_bco[index]; }
+  uint64_t get_gtm_bco(const unsigned int index) const { return m_gtm_bco[index]; }
+  int32_t get_packetid(const unsigned int index) const { return m_packetid[index]; }
+  uint16_t get_fee(const unsigned int index) const { return m_fee[index]; }
+  uint16_t get_channel(const unsigned int index) const { return m_channel[index]; }
+  uint16_t get_sampaaddress(const unsigned int index) const { return m_sampaaddress[index]; }
+  uint16_t get_sampachannel(const unsigned int index) const { return m_sampachannel[index]; }
+  uint16_t get_samples(const unsigned int index) const { return m_offset[index + 1] - m_offset[index]; }
+  //! the get_samples(index) adc values of waveform index
+  const uint16_t *get_adc(const unsigned int index) const { return m_adc.data() + m_offset[index]; }
+  uint16_t *get_adc(const unsigned int index) { return m_adc.data() + m_offset[index]; }
+
+  void set_bco(const unsigned int index, const uint64_t val) { m_bco[index] = val; }
+  void set_gtm_bco(const unsigned int index, const uint64_t val) { m_gtm_bco[index] = val; }
+  void set_packetid(const unsigned int index, const int32_t val) { m_packetid[index] = val; }
+  void set_fee(const unsigned int index, const uint16_t val) { m_fee[index] = val; }
+  void set_channel(const unsigned int index, const uint16_t val) { m_channel[index] = val; }
+  void set_sampaaddress(const unsigned int index, const uint16_t val) { m_sampaaddress[index] = val; }
+  void set_sampachannel(const unsigned int index, const uint16_t val) { m_sampachannel[index] = val; }
+  //! only possible for the last waveform (the samples are contiguous)
+  void set_samples(const unsigned int index, const uint16_t val);
+
+ private:
+  std::vector<uint64_t> m_bco;
+  std::vector<uint64_t> m_gtm_bco;
+  std::vector<int32_t> m_packetid;
+  std::vector<uint16_t> m_fee;
+  std::vector<uint16_t> m_channel;
+  std::vector<uint16_t> m_sampaaddress;
+  std::vector<uint16_t> m_sampachannel;
+  //! first sample of each waveform in m_adc, one more entry than waveforms
+  std::vector<uint32_t> m_offset;
+  std::vector<uint16_t> m_adc;
+
+  //! views handed out by get_hit, extended when waveforms were added. A deque
+  //! does not move its elements when growing, handed out pointers stay valid
+  std::deque<TpcRawHitv2> m_views;  //!
+
+  ClassDefOverride(TpcRawHitContainerv2, 1)
+};
+
+#endif
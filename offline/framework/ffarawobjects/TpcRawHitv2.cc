@@ -0,0 +1,46 @@
+#include "TpcRawHitv2.h"
+#include "TpcRawHitContainerv2.h"
+
+#include <cassert>
+
+void TpcRawHitv2::identify(std::ostream &os) const
+{
+  os << "BCO: 0x" << std::hex << get_bco() << std::dec << std::endl;
+  os << "packet id: " << get_packetid() << std::endl;
+}
+
+uint64_t TpcRawHitv2::get_bco() const { return m_container->get_bco(m_index); }
+void TpcRawHitv2::set_bco(const uint64_t val) { m_container->set_bco(m_index, val); }
+
+uint64_t TpcRawHitv2::get_gtm_bco() const { return m_container->get_gtm_bco(m_index); }
+void TpcRawHitv2::set_gtm_bco(const uint64_t val) { m_container->set_gtm_bco(m_index, val); }
+
+int32_t TpcRawHitv2::get_packetid() const { return m_container->get_packetid(m_index); }
+void TpcRawHitv2::set_packetid(const int32_t val) { m_container->set_packetid(m_index, val); }
+
+uint16_t TpcRawHitv2::get_fee() const { return m_container->get_fee(m_index); }
+void TpcRawHitv2::set_fee(const uint16_t val) { m_container->set_fee(m_index, val); }
+
+uint16_t TpcRawHitv2::get_channel() const { return m_container->get_channel(m_index); }
+void TpcRawHitv2::set_channel(const uint16_t val) { m_container->set_channel(m_index, val); }
+
+uint16_t TpcRawHitv2::get_sampaaddress() const { return m_container->get_sampaaddress(m_index); }
+void TpcRawHitv2::set_sampaaddress(const uint16_t val) { m_container->set_sampaaddress(m_index, val); }
+
+uint16_t TpcRawHitv2::get_sampachannel() const { return m_container->get_sampachannel(m_index); }
+void TpcRawHitv2::set_sampachannel(const uint16_t val) { m_container->set_sampachannel(m_index, val); }
+
+uint16_t TpcRawHitv2::get_samples() const { return m_container->get_samples(m_index); }
+void TpcRawHitv2::set_samples(const uint16_t val) { m_container->set_samples(m_index, val); }
+
+uint16_t TpcRawHitv2::get_adc(size_t sample) const
+{
+  assert(sample < get_samples());
+  return m_container->get_adc(m_index)[sample];
+}
+
+void TpcRawHitv2::set_adc(size_t sample, const uint16_t val)
+{
+  assert(sample < get_samples());
+  m_container->get_adc(m_index)[sample] = val;
+}
@@ -0,0 +1,63 @@
+#ifndef FUN4ALLRAW_TPCRAWTHITV2_H
+#define FUN4ALLRAW_TPCRAWTHITV2_H
+
+#include "TpcRawHit.h"
+
+#include <phool/PHObject.h>
+
+class TpcRawHitContainerv2;
+
+//! view of one waveform stored in a TpcRawHitContainerv2, it does not hold any data
+//! itself and is only valid as long as the container it points to
+class TpcRawHitv2 : public TpcRawHit
+{
+ public:
+  TpcRawHitv2() = default;
+  TpcRawHitv2(TpcRawHitContainerv2 *container, const unsigned int index)
+    : m_container(container)
+    , m_index(index)
+  {
+  }
+  ~TpcRawHitv2() override = default;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  uint64_t get_bco() const override;
+  void set_bco(const uint64_t val) override;
+
+  uint64_t get_gtm_bco() const override;
+  void set_gtm_bco(const uint64_t val) override;
+
+  int32_t get_packetid() const override;
+  void set_packetid(const int32_t val) override;
+
+  uint16_t get_fee() const override;
+  void set_fee(const uint16_t val) override;
+
+  uint16_t get_channel() const override;
+  void set_channel(const uint16_t val) override;
+
+  uint16_t get_sampaaddress() const override;
+  void set_sampaaddress(const uint16_t val) override;
+
+  uint16_t get_sampachannel() const override;
+  void set_sampachannel(const uint16_t val) override;
+
+  uint16_t get_samples() const override;
+  //! only possible for the last waveform of the container
+  void set_samples(const uint16_t val) override;
+
+  uint16_t get_adc(size_t sample) const override;
+  void set_adc(size_t sample, const uint16_t val) override;
+
+ private:
+  TpcRawHitContainerv2 *m_container = nullptr;  //!
+  unsigned int m_index = 0;                     //!
+
+  ClassDefOverride(TpcRawHitv2, 1)
+};
+
+#endif
@@ -14,10 +14,12 @@
 #include <phool/PHNodeIntegrate.h>
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
 #include <phool/PHObject.h>        // for PHObject
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/phooldefs.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #pragma GCC diagnostic push
@@ -41,6 +43,8 @@ Fun4AllDstInputManager::Fun4AllDstInputManager(const std::string &name, const st
 
 Fun4AllDstInputManager::~Fun4AllDstInputManager()
 {
+  WaitForPrefetch();
+  delete m_PrefetchIManager;
   delete m_IManager;
   delete m_RunNodeSum;
   return;
@@ -57,8 +61,22 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  fullfilename = frog.location(FileName());
+  WaitForPrefetch();
+  if (m_PrefetchIManager && m_PrefetchFileName != FileName())
+  {
+    // the prefetched file is not the one we want (file list was changed)
+    delete m_PrefetchIManager;
+    m_PrefetchIManager = nullptr;
+  }
+  if (m_PrefetchIManager)
+  {
+    fullfilename = m_PrefetchFullFileName;
+  }
+  else
+  {
+    FROG frog;
+    fullfilename = frog.location(FileName());
+  }
   if (Verbosity() > 0)
   {
     std::cout << Name() << ": opening file " << fullfilename << std::endl;
@@ -128,7 +146,17 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
   }
   // now open the dst node
   dstNode = se->getNode(InputNode(), TopNodeName());
-  m_IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
+  if (m_PrefetchIManager)
+  {
+    m_IManager = m_PrefetchIManager;
+    m_PrefetchIManager = nullptr;
+  }
+  else
+  {
+    m_IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
+  }
+  m_IManager->SetReadCacheSize(m_ReadCacheSize);
+  m_IManager->SetParallelUnzip(m_ParallelUnzip);
   if (m_IManager->isFunctional())
   {
     IsOpen(1);
@@ -185,6 +213,8 @@ int Fun4AllDstInputManager::run(const int nevents)
 readagain:
   PHCompositeNode *dummy;
   int ncount = 0;
+  PHTimer readtimer("DstRead");
+  readtimer.restart();
   dummy = m_IManager->read(dstNode);
   while (dummy)
   {
@@ -195,6 +225,8 @@ readagain:
     }
     dummy = m_IManager->read(dstNode);
   }
+  readtimer.stop();
+  m_TimeBlockedOnRead += readtimer.elapsed();
   if (!dummy)
   {
     fileclose();
@@ -217,6 +249,53 @@ readagain:
   return 0;
 }
 
+void Fun4AllDstInputManager::PrefetchNextFile(const bool b)
+{
+  if (b)
+  {
+    // the next file is opened on its own thread while this one is read
+    ROOT::EnableThreadSafety();
+  }
+  Fun4AllInputManager::PrefetchNextFile(b);
+}
+
+void Fun4AllDstInputManager::PrefetchFile(const std::string &filenam)
+{
+  // runs on the prefetch thread, only touches the prefetch members.
+  // Resolving the location and opening the file (remote lookups, staging)
+  // are the slow parts, the node tree is set up in fileopen()
+  FROG frog;
+  const std::string fullname = frog.location(filenam);
+  PHNodeIOManager *iman = new PHNodeIOManager(fullname, PHReadOnly);
+  if (!iman->isFunctional())
+  {
+    // fileopen() will try again and report the error
+    delete iman;
+    return;
+  }
+  m_PrefetchFileName = filenam;
+  m_PrefetchFullFileName = fullname;
+  m_PrefetchIManager = iman;
+}
+
+void Fun4AllDstInputManager::ParallelUnzip(const unsigned int nthreads)
+{
+  if (!ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(nthreads);
+  }
+  m_ParallelUnzip = true;
+  if (m_ReadCacheSize <= 0)
+  {
+    // the unzipping works on the read cache, it needs an explicit size
+    m_ReadCacheSize = 100 * 1024 * 1024;
+  }
+  if (IsOpen())
+  {
+    std::cout << PHWHERE << " " << Name() << ": ParallelUnzip takes effect with the next file" << std::endl;
+  }
+}
+
 int Fun4AllDstInputManager::fileclose()
 {
   if (!IsOpen())
@@ -628,6 +707,18 @@ void Fun4AllDstInputManager::Print(const std::string &what) const
     std::cout << "PHNodeIOManager print in Fun4AllDstInputManager " << Name() << ":" << std::endl;
     m_IManager->print();
   }
+  if (what == "ALL" || what == "TIMING")
+  {
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Input timing of Fun4AllDstInputManager " << Name() << ":" << std::endl;
+    std::cout << "time blocked on reading: " << m_TimeBlockedOnRead / 1000. << " s" << std::endl;
+    std::cout << "time blocked on opening files: " << TimeBlockedOnOpen() / 1000. << " s" << std::endl;
+    if (m_IManager)
+    {
+      std::cout << "bytes read from current file: " << m_IManager->GetBytesRead() << std::endl;
+    }
+  }
   Fun4AllInputManager::Print(what);
   return;
 }
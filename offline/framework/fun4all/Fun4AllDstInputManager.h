@@ -5,6 +5,7 @@
 
 #include "Fun4AllInputManager.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -28,8 +29,18 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
   int HasSyncObject() const override;
+  //! size (bytes) of the TTreeCache of the event tree. The cache holds only the
+  //! branches selected with BranchSelect, 0 keeps the ROOT default
+  void ReadCacheSize(const int64_t bytes) { m_ReadCacheSize = bytes; }
+  //! decompress the upcoming baskets of the read cache on nthreads background
+  //! threads (0 = all cores). Switches on ROOT implicit MT for the process
+  void ParallelUnzip(const unsigned int nthreads = 0);
+  void PrefetchNextFile(const bool b = true) override;
+  //! wall time (ms) spent reading events from the dst (I/O and decompression)
+  double TimeBlockedOnRead() const { return m_TimeBlockedOnRead; }
 
  protected:
+  void PrefetchFile(const std::string &filename) override;
   int ReadNextEventSyncObject();
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
   void IManager(PHNodeIOManager *iman) { m_IManager = iman; }
@@ -49,6 +60,9 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int events_thisfile = 0;
   int events_skipped_during_sync = 0;
   int m_HaveSyncObject = 0;
+  bool m_ParallelUnzip = false;
+  int64_t m_ReadCacheSize = 0;
+  double m_TimeBlockedOnRead = 0;
   std::map<const std::string, int> branchread;
   std::string syncbranchname;
   PHCompositeNode *dstNode = nullptr;
@@ -56,6 +70,10 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   PHCompositeNode *m_RunNodeCopy = nullptr;
   PHCompositeNode *m_RunNodeSum = nullptr;
   PHNodeIOManager *m_IManager = nullptr;
+  // next file of the list, opened on the prefetch thread
+  PHNodeIOManager *m_PrefetchIManager = nullptr;
+  std::string m_PrefetchFileName;
+  std::string m_PrefetchFullFileName;
   SyncObject *syncobject = nullptr;
   std::string RunNode = "RUN";
 };
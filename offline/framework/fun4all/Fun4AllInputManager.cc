@@ -3,6 +3,7 @@
 #include "Fun4AllServer.h"
 #include "SubsysReco.h"
 
+#include <phool/PHTimer.h>
 #include <phool/phool.h>
 
 #include <boost/filesystem.hpp>
@@ -10,6 +11,7 @@
 #include <cstdint>  // for uintmax_t
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 Fun4AllInputManager::Fun4AllInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
   : Fun4AllBase(name)
@@ -21,6 +23,8 @@ Fun4AllInputManager::Fun4AllInputManager(const std::string &name, const std::str
 
 Fun4AllInputManager::~Fun4AllInputManager()
 {
+  // last resort, derived classes implementing PrefetchFile() wait in their dtor
+  WaitForPrefetch();
   while (m_SubsystemsVector.begin() != m_SubsystemsVector.end())
   {
     if (Verbosity())
@@ -212,6 +216,10 @@ void Fun4AllInputManager::UpdateFileList()
 
 int Fun4AllInputManager::OpenNextFile()
 {
+  PHTimer opentimer("OpenNextFile");
+  opentimer.restart();
+  // a prefetch of this file has to be finished before fileopen() can pick it up
+  WaitForPrefetch();
   while (!m_FileList.empty())
   {
     std::list<std::string>::const_iterator iter = m_FileList.begin();
@@ -226,8 +234,32 @@ int Fun4AllInputManager::OpenNextFile()
     }
     else
     {
+      opentimer.stop();
+      m_TimeBlockedOnOpen += opentimer.elapsed();
+      // the next entry is the one fileclose() moves to the front
+      // (unless a single file is repeated)
+      if (m_PrefetchNextFile && std::next(iter) != m_FileList.end())
+      {
+        const std::string nextfile = *std::next(iter);
+        if (Verbosity())
+        {
+          std::cout << PHWHERE << " prefetching next file: " << nextfile << std::endl;
+        }
+        m_PrefetchThread = std::thread([this, nextfile]()
+                                       { PrefetchFile(nextfile); });
+      }
       return 0;
     }
   }
+  opentimer.stop();
+  m_TimeBlockedOnOpen += opentimer.elapsed();
   return -1;
 }
+
+void Fun4AllInputManager::WaitForPrefetch()
+{
+  if (m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread.join();
+  }
+}
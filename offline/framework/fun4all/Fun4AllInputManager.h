@@ -8,6 +8,7 @@
 
 #include <list>
 #include <string>
+#include <thread>
 #include <type_traits>  // for __decay_and_strip<>::__type
 #include <utility>      // for make_pair, pair
 #include <vector>
@@ -59,6 +60,11 @@ class Fun4AllInputManager : public Fun4AllBase
   virtual std::string GetString(const std::string &) const { return ""; }
   const std::list<std::string> GetFileList() const { return m_FileListCopy; }
   const std::list<std::string> GetFileOpenedList() const { return m_FileListOpened; }
+  //! open the next file of the list on a background thread while the current one
+  //! is processed, only has an effect for managers which implement PrefetchFile()
+  virtual void PrefetchNextFile(const bool b = true) { m_PrefetchNextFile = b; }
+  //! wall time (ms) spent in OpenNextFile(), including waiting for a prefetch
+  double TimeBlockedOnOpen() const { return m_TimeBlockedOnOpen; }
 
  protected:
   Fun4AllInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
@@ -66,6 +72,12 @@ class Fun4AllInputManager : public Fun4AllBase
   int OpenNextFile();
   void IsOpen(const int i) { m_IsOpen = i; }
   Fun4AllSyncManager *MySyncManager() { return m_MySyncManager; }
+  //! called on the prefetch thread with the name of the next file in the list.
+  //! Managers do the expensive part of opening here and pick it up in fileopen()
+  virtual void PrefetchFile(const std::string & /*filename*/) {}
+  //! wait for a running prefetch, managers implementing PrefetchFile() have to call
+  //! this in their destructor and before using the prefetched file
+  void WaitForPrefetch();
 
  private:
   Fun4AllSyncManager *m_MySyncManager = nullptr;
@@ -73,6 +85,9 @@ class Fun4AllInputManager : public Fun4AllBase
   int m_Repeat = 0;
   int m_MyRunNumber = 0;
   int m_InitRun = 0;
+  bool m_PrefetchNextFile = false;
+  double m_TimeBlockedOnOpen = 0;
+  std::thread m_PrefetchThread;
   std::vector<SubsysReco *> m_SubsystemsVector;
   std::string m_InputNode;
   std::string m_FileName;
@@ -2,6 +2,7 @@
 
 #include "Fun4AllHistoBinDefs.h"
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
+#include "Fun4AllInputManager.h"
 #include "Fun4AllMemoryTracker.h"
 #include "Fun4AllMonitoring.h"
 #include "Fun4AllOutputManager.h"
@@ -15,6 +16,7 @@
 #include <phool/PHNodeReset.h>
 #include <phool/PHObject.h>
 #include <phool/PHPointerListIterator.h>
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimeStamp.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
@@ -30,10 +32,13 @@
 #include <TSystem.h>
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
+#include <mutex>
+#include <set>
 #include <sstream>
 
 //#define FFAMEMTRACKER
@@ -271,6 +276,8 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
     timer_map.insert(make_pair(timer_name, timer));
   }
   RetCodes.push_back(iret);  // vector with return codes
+  m_ModuleGraphValid = false;
+  m_ModuleTableValid = false;
   return 0;
 }
 
@@ -325,6 +332,8 @@ int Fun4AllServer::unregisterSubsystemsNow()
   }
   unregistersubsystem = 0;
   DeleteSubsystems.clear();
+  m_ModuleGraphValid = false;
+  m_ModuleTableValid = false;
   return 0;
 }
 
@@ -528,53 +537,30 @@ int Fun4AllServer::process_event()
   {
     unregisterSubsystemsNow();
   }
+  if (!m_ModuleTableValid)
+  {
+    BuildModuleTable();
+  }
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
+  if (m_ConcurrentModules)
+  {
+    RunModulesConcurrently();
+  }
   for (auto &Subsystem : Subsystems)
   {
-    if (Verbosity() >= VERBOSITY_MORE)
-    {
-      std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
-    }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
+    if (m_ConcurrentModules)
     {
-      std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
-                << Subsystem.second->getName()
-                << " - send e-mail to off-l with your macro" << std::endl;
-      exit(1);
-    }
-    else
-    {
-      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      // modules were run already, the ones which were not started are
+      // behind a module which stopped the event (handled below)
+      if (!m_ModuleExecuted[icnt])
       {
-        std::cout << "process_event: cded to " << newdirname << std::endl;
+        break;
       }
     }
-
-    try
+    else
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Start(timer_name, "SubsysReco");
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
-      int retcode = Subsystem.first->process_event(Subsystem.second);
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
-#endif
+      int retcode = ProcessEventSubsystem(icnt);
       // we have observed an index overflow in RetCodes. I assume it is some
       // memory corruption elsewhere which hits the icnt variable. Rather than
       // the previous [], use at() which does bounds checking and throws an
@@ -590,26 +576,6 @@ int Fun4AllServer::process_event()
         std::cout << "error: " << e.what() << std::endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
-      {
-        titer->second.stop();
-      }
-#ifdef FFAMEMTRACKER
-      ffamemtracker->Stop(timer_name, "SubsysReco");
-#endif
-    }
-    catch (const std::exception &e)
-    {
-      std::cout << PHWHERE << " caught exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      std::cout << "error: " << e.what() << std::endl;
-      gSystem->Exit(1);
-    }
-    catch (...)
-    {
-      std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
-                << Subsystem.first->Name() << std::endl;
-      exit(1);
     }
     if (RetCodes[icnt])
     {
@@ -658,36 +624,69 @@ int Fun4AllServer::process_event()
   gROOT->cd(currdir.c_str());
 
   //  mainIter.print();
-  if (!OutputManager.empty() && !eventbad)  // there are registered IO managers and
-  // the event is not flagged bad
+  if (!eventbad)
   {
-    PHNodeIterator iter(TopNode);
-    PHCompositeNode *dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+    WriteEvent(TopNode, m_OutNodes, &RetCodes);
+  }
+  for (auto &Subsystem : Subsystems)
+  {
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "Fun4AllServer::process_event Resetting Event " << Subsystem.first->Name() << std::endl;
+    }
+    Subsystem.first->ResetEvent(Subsystem.second);
+  }
+  for (auto &syncman : SyncManagers)
+  {
+    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    {
+      std::cout << "Fun4AllServer::process_event Resetting Event for Sync Manager " << syncman->Name() << std::endl;
+    }
+    syncman->ResetEvent();
+  }
+  Fun4AllMonitoring::instance()->Snapshot("Event");
+  ResetNodeTree();
+  return 0;
+}
+
+void Fun4AllServer::WriteEvent(PHCompositeNode *topnode, OutNodeCache &outnodes, std::vector<int> *retcodes)
+{
+  if (!OutputManager.empty())  // there are registered IO managers
+  {
+    // nodes are only added or removed if the tree generation changes
+    if (!outnodes.valid || outnodes.generation != topnode->treeGeneration())
+    {
+      PHNodeIterator iter(topnode);
+      outnodes.dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+      outnodes.count = (outnodes.dstNode ? CountOutNodes(outnodes.dstNode) : 0);
+      outnodes.generation = topnode->treeGeneration();
+      outnodes.valid = true;
+    }
+    PHCompositeNode *dstNode = outnodes.dstNode;
 
     if (dstNode)
     {
       // check if we have same number of nodes. After first event is
       // written out root I/O doesn't permit adding nodes, otherwise
       // events get out of sync
-      static int first = 1;
-      int newcount = CountOutNodes(dstNode);
-      if (first)
+      int newcount = outnodes.count;
+      if (outnodes.firstcount < 0)
       {
-        first = 0;
-        OutNodeCount = newcount;      // save number of nodes before first write
-        MakeNodesTransient(dstNode);  // make all nodes transient before 1st write in case someone sneaked a node in at the first event
+        outnodes.firstcount = newcount;  // save number of nodes before first write
+        MakeNodesTransient(dstNode);     // make all nodes transient before 1st write in case someone sneaked a node in at the first event
       }
 
-      if (OutNodeCount != newcount)
+      if (outnodes.firstcount != newcount)
       {
+        PHNodeIterator iter(topnode);
         iter.print();
-        std::cout << PHWHERE << " FATAL: Someone changed the number of Output Nodes on the fly, from " << OutNodeCount << " to " << newcount << std::endl;
+        std::cout << PHWHERE << " FATAL: Someone changed the number of Output Nodes on the fly, from " << outnodes.firstcount << " to " << newcount << std::endl;
         exit(1);
       }
       std::vector<Fun4AllOutputManager *>::iterator iterOutMan;
       for (iterOutMan = OutputManager.begin(); iterOutMan != OutputManager.end(); ++iterOutMan)
       {
-        if (!(*iterOutMan)->DoNotWriteEvent(&RetCodes))
+        if (!(*iterOutMan)->DoNotWriteEvent(retcodes))
         {
           if (Verbosity() >= VERBOSITY_MORE)
           {
@@ -726,47 +725,589 @@ int Fun4AllServer::process_event()
       }
     }
   }
-  for (auto &Subsystem : Subsystems)
+}
+
+void Fun4AllServer::BuildModuleTable()
+{
+  // resolve TDirectories and timers once instead of by name for every module and event
+  gROOT->cd(default_Tdirectory.c_str());
+  std::string currdir = gDirectory->GetPath();
+  m_ModuleTable.resize(Subsystems.size());
+  for (unsigned int i = 0; i < Subsystems.size(); i++)
+  {
+    ModuleEntry &entry = m_ModuleTable[i];
+    entry.module = Subsystems[i].first;
+    entry.topnode = Subsystems[i].second;
+    std::string newdirname = entry.topnode->getName() + "/" + entry.module->Name();
+    gROOT->cd(default_Tdirectory.c_str());
+    if (!gROOT->cd(newdirname.c_str()))
+    {
+      std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
+                << entry.topnode->getName()
+                << " - send e-mail to off-l with your macro" << std::endl;
+      exit(1);
+    }
+    entry.dir = gDirectory;
+    entry.timername = entry.module->Name() + "_" + entry.topnode->getName();
+    std::map<const std::string, PHTimer>::iterator titer = timer_map.find(entry.timername);
+    if (titer != timer_map.end())
+    {
+      entry.timer = &(titer->second);
+    }
+    else
+    {
+      entry.timer = nullptr;
+      std::cout << "could not find timer for " << entry.timername << std::endl;
+    }
+  }
+  gROOT->cd(currdir.c_str());
+  m_ModuleTableValid = true;
+}
+
+int Fun4AllServer::ProcessEventSubsystem(const unsigned int imodule)
+{
+  const ModuleEntry &entry = m_ModuleTable[imodule];
+  if (Verbosity() >= VERBOSITY_MORE)
   {
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    std::cout << "Fun4AllServer::process_event processing " << entry.module->Name() << std::endl;
+  }
+  entry.dir->cd();
+  if (Verbosity() >= VERBOSITY_EVEN_MORE)
+  {
+    std::cout << "process_event: cded to " << entry.dir->GetPath() << std::endl;
+  }
+
+  int retcode = 0;
+  try
+  {
+    if (entry.timer)
     {
-      std::cout << "Fun4AllServer::process_event Resetting Event " << Subsystem.first->Name() << std::endl;
+      entry.timer->restart();
     }
-    Subsystem.first->ResetEvent(Subsystem.second);
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Start(entry.timername, "SubsysReco");
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    retcode = entry.module->process_event(entry.topnode);
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
+#endif
+    if (entry.timer)
+    {
+      entry.timer->stop();
+    }
+#ifdef FFAMEMTRACKER
+    ffamemtracker->Stop(entry.timername, "SubsysReco");
+#endif
   }
-  for (auto &syncman : SyncManagers)
+  catch (const std::exception &e)
   {
-    if (Verbosity() >= VERBOSITY_EVEN_MORE)
+    std::cout << PHWHERE << " caught exception thrown during process_event from "
+              << entry.module->Name() << std::endl;
+    std::cout << "error: " << e.what() << std::endl;
+    gSystem->Exit(1);
+  }
+  catch (...)
+  {
+    std::cout << PHWHERE << " caught unknown type exception thrown during process_event from "
+              << entry.module->Name() << std::endl;
+    exit(1);
+  }
+  return retcode;
+}
+
+void Fun4AllServer::ConcurrentModules(const bool yesno, const unsigned int nthreads)
+{
+  m_ConcurrentModules = yesno;
+  m_ModuleGraphValid = false;
+  m_ModulePool.reset();
+  if (m_ConcurrentModules)
+  {
+    // gDirectory becomes thread local, each module cd's into its own TDirectory
+    ROOT::EnableThreadSafety();
+    m_ModulePool = std::make_unique<PHThreadPool>(nthreads);
+    if (Verbosity() > 0)
     {
-      std::cout << "Fun4AllServer::process_event Resetting Event for Sync Manager " << syncman->Name() << std::endl;
+      std::cout << "Fun4AllServer: running modules concurrently on "
+                << m_ModulePool->size() << " threads" << std::endl;
     }
-    syncman->ResetEvent();
+  }
+}
+
+void Fun4AllServer::BuildModuleGraph()
+{
+  // full node names (top node/node) read and written by each module
+  const unsigned int nmodules = Subsystems.size();
+  std::vector<std::set<std::string>> inputs(nmodules);
+  std::vector<std::set<std::string>> outputs(nmodules);
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    const std::string &topname = Subsystems[i].second->getName();
+    for (const auto &nodename : Subsystems[i].first->InputNodes())
+    {
+      inputs[i].insert(topname + "/" + nodename);
+    }
+    for (const auto &nodename : Subsystems[i].first->OutputNodes())
+    {
+      outputs[i].insert(topname + "/" + nodename);
+    }
+  }
+  auto overlaps = [](const std::set<std::string> &s1, const std::set<std::string> &s2)
+  {
+    return std::any_of(s1.begin(), s1.end(), [&s2](const std::string &name)
+                       { return s2.find(name) != s2.end(); });
+  };
+
+  // module i depends on an earlier module j if they conflict on a node
+  // (write/read, read/write or write/write) or if either did not declare its nodes,
+  // this keeps the registration order wherever it matters
+  m_ModuleSuccessors.assign(nmodules, std::vector<unsigned int>());
+  m_ModuleNPredecessors.assign(nmodules, 0);
+  m_ModuleExecuted.assign(nmodules, 0);
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    const bool declared_i = Subsystems[i].first->NodesDeclared();
+    for (unsigned int j = 0; j < i; j++)
+    {
+      if (!declared_i || !Subsystems[j].first->NodesDeclared() ||
+          overlaps(outputs[j], inputs[i]) ||
+          overlaps(outputs[j], outputs[i]) ||
+          overlaps(inputs[j], outputs[i]))
+      {
+        m_ModuleSuccessors[j].push_back(i);
+        m_ModuleNPredecessors[i]++;
+      }
+    }
+  }
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    std::cout << "Fun4AllServer: module dependencies" << std::endl;
+    for (unsigned int i = 0; i < nmodules; i++)
+    {
+      std::cout << Subsystems[i].first->Name() << " waits for " << m_ModuleNPredecessors[i]
+                << " modules" << (Subsystems[i].first->NodesDeclared() ? "" : " (no nodes declared)")
+                << std::endl;
+    }
+  }
+  m_ModuleGraphValid = true;
+}
+
+void Fun4AllServer::RunModulesConcurrently()
+{
+  if (!m_ModuleGraphValid)
+  {
+    BuildModuleGraph();
+  }
+  const unsigned int nmodules = Subsystems.size();
+  std::vector<unsigned int> npending(m_ModuleNPredecessors);
+  std::fill(m_ModuleExecuted.begin(), m_ModuleExecuted.end(), 0);
+
+  // ready modules are started lowest index first. Once a module stops the
+  // event (everything but EVENT_OK and DISCARDEVENT) no module registered
+  // after it is started, modules registered before it still run so the
+  // return codes seen by process_event() are the ones of sequential running.
+  // Independent modules registered after it which were started before it
+  // returned have processed the event though, sequential running would not
+  // have called them (see ConcurrentModules() in Fun4AllServer.h)
+  std::set<unsigned int> ready;
+  for (unsigned int i = 0; i < nmodules; i++)
+  {
+    if (npending[i] == 0)
+    {
+      ready.insert(i);
+    }
+  }
+  unsigned int nfinished = 0;
+  unsigned int firststop = nmodules;
+  std::mutex mtx;
+  std::condition_variable cv;
+
+  auto worker = [&](size_t /*task*/, unsigned int /*thread*/)
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true)
+    {
+      cv.wait(lock, [&]
+              { return !ready.empty() || nfinished == nmodules; });
+      if (ready.empty())
+      {
+        return;
+      }
+      const unsigned int imod = *ready.begin();
+      ready.erase(ready.begin());
+      if (imod < firststop)
+      {
+        lock.unlock();
+        int retcode = ProcessEventSubsystem(imod);
+        lock.lock();
+        RetCodes[imod] = retcode;
+        m_ModuleExecuted[imod] = 1;
+        if (retcode != Fun4AllReturnCodes::EVENT_OK && retcode != Fun4AllReturnCodes::DISCARDEVENT)
+        {
+          firststop = std::min(firststop, imod);
+        }
+      }
+      nfinished++;
+      for (unsigned int succ : m_ModuleSuccessors[imod])
+      {
+        if (--npending[succ] == 0)
+        {
+          ready.insert(succ);
+        }
+      }
+      cv.notify_all();
+    }
+  };
+  m_ModulePool->parallel_for(m_ModulePool->size(), worker);
+}
+
+void Fun4AllServer::EventSlots(const unsigned int nslots)
+{
+  if (m_NEventSlots > 1)
+  {
+    std::cout << PHWHERE << " event slots are already set to " << m_NEventSlots << std::endl;
+    return;
+  }
+  if (nslots < 2)
+  {
+    return;
+  }
+  m_NEventSlots = nslots;
+  // gDirectory becomes thread local, each module cd's into its own TDirectory
+  ROOT::EnableThreadSafety();
+  m_SlotPool = std::make_unique<PHThreadPool>(nslots);
+  m_SlotTopNodes.push_back(TopNode);
+  m_SlotSyncManagers.push_back(defaultSyncManager);
+  for (unsigned int slot = 1; slot < nslots; slot++)
+  {
+    m_SlotTopNodes.push_back(topNode(EventSlotTopNodeName(slot)));
+    Fun4AllSyncManager *syncman = new Fun4AllSyncManager("EventSlotSyncManager" + std::to_string(slot));
+    registerSyncManager(syncman);
+    m_SlotSyncManagers.push_back(syncman);
+  }
+  m_SlotOutNodes.assign(nslots, OutNodeCache());
+  m_SlotEventsRead.assign(nslots, 0);
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllServer: processing " << nslots << " events concurrently" << std::endl;
+  }
+}
+
+std::string Fun4AllServer::EventSlotTopNodeName(const unsigned int slot)
+{
+  if (slot == 0)
+  {
+    return "TOP";
+  }
+  return "TOP_SLOT" + std::to_string(slot);
+}
+
+void Fun4AllServer::LinkSharedNodes(PHCompositeNode *slottopnode)
+{
+  PHNodeIterator topiter(TopNode);
+  PHNodeIterator slotiter(slottopnode);
+  for (const char *nodename : {"RUN", "PAR"})
+  {
+    PHCompositeNode *source = dynamic_cast<PHCompositeNode *>(topiter.findFirst("PHCompositeNode", nodename));
+    PHCompositeNode *target = dynamic_cast<PHCompositeNode *>(slotiter.findFirst("PHCompositeNode", nodename));
+    if (source && target)
+    {
+      target->linkNodes(source);
+    }
+  }
+}
+
+int Fun4AllServer::ReadEventSlot(const unsigned int slot)
+{
+  Fun4AllSyncManager *syncman = m_SlotSyncManagers[slot];
+  // slot i reads events i, i + nslots, i + 2*nslots, ...
+  int nskip = (m_SlotEventsRead[slot] ? m_NEventSlots - 1 : slot);
+  if (nskip > 0)
+  {
+    int iret = syncman->skip(nskip);
+    if (iret)
+    {
+      return iret;
+    }
+  }
+  m_SlotEventsRead[slot]++;
+  while (true)
+  {
+    int retval = syncman->run(1);
+    // a new input file was opened, see the comment in run()
+    if (retval == Fun4AllReturnCodes::RESET_NODE_TREE)
+    {
+      syncman->PushBackInputMgrsEvents(1);
+      ResetNodeTree(m_SlotTopNodes[slot]);
+      continue;
+    }
+    return retval;
+  }
+}
+
+int Fun4AllServer::ProcessEventSlot(const unsigned int slot, const std::vector<unsigned int> &modules)
+{
+  for (unsigned int imod : modules)
+  {
+    int retcode = ProcessEventSubsystem(imod);
+    RetCodes[imod] = retcode;
+    if (retcode == Fun4AllReturnCodes::EVENT_OK)
+    {
+      continue;
+    }
+    if (retcode == Fun4AllReturnCodes::DISCARDEVENT)
+    {
+      if (Verbosity() >= VERBOSITY_EVEN_MORE)
+      {
+        std::cout << "Fun4AllServer::Discard Event in slot " << slot << " by " << Subsystems[imod].first->Name() << std::endl;
+      }
+    }
+    else if (retcode == Fun4AllReturnCodes::ABORTEVENT)
+    {
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        std::cout << "Fun4AllServer::Abort Event in slot " << slot << " by " << Subsystems[imod].first->Name() << std::endl;
+      }
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
+    else if (retcode == Fun4AllReturnCodes::ABORTRUN)
+    {
+      std::cout << "Fun4AllServer::Abort Run by " << Subsystems[imod].first->Name() << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    else
+    {
+      std::cout << "Fun4AllServer::Unknown return code: "
+                << retcode << " from process_event method of "
+                << Subsystems[imod].first->Name() << std::endl;
+      std::cout << "This smells like an uninitialized return code and" << std::endl;
+      std::cout << "it is too dangerous to continue, this Run will be aborted" << std::endl;
+      return -1;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllServer::ProcessEventSlots(const std::vector<unsigned int> &slots, int &ngood)
+{
+  if (unregistersubsystem)
+  {
+    unregisterSubsystemsNow();
+  }
+  if (!m_ModuleTableValid)
+  {
+    BuildModuleTable();
+  }
+  // modules of each slot in registration order
+  std::vector<std::vector<unsigned int>> modules(m_NEventSlots);
+  for (unsigned int imod = 0; imod < Subsystems.size(); imod++)
+  {
+    auto slotiter = std::find(m_SlotTopNodes.begin(), m_SlotTopNodes.end(), Subsystems[imod].second);
+    if (slotiter == m_SlotTopNodes.end())
+    {
+      std::cout << PHWHERE << " module " << Subsystems[imod].first->Name()
+                << " is registered under top node " << Subsystems[imod].second->getName()
+                << " which is not an event slot" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    modules[slotiter - m_SlotTopNodes.begin()].push_back(imod);
+  }
+
+  // shared nodes were added to or removed from TOP (e.g. by an input manager
+  // opening a new file), update the links of the slots before they run
+  if (TopNode->treeGeneration() != m_SlotLinkGeneration)
+  {
+    for (unsigned int slot = 1; slot < m_NEventSlots; slot++)
+    {
+      LinkSharedNodes(m_SlotTopNodes[slot]);
+    }
+    m_SlotLinkGeneration = TopNode->treeGeneration();
+  }
+
+  gROOT->cd(default_Tdirectory.c_str());
+  std::string currdir = gDirectory->GetPath();
+  std::vector<int> status(slots.size(), Fun4AllReturnCodes::EVENT_OK);
+  m_SlotPool->parallel_for(slots.size(), [&](size_t task, unsigned int /*thread*/)
+                           { status[task] = ProcessEventSlot(slots[task], modules[slots[task]]); });
+  gROOT->cd(currdir.c_str());
+
+  // output and reset in input order. Event selectors of the output managers
+  // refer to the modules of slot 0, they see the return codes of the
+  // corresponding module (same position in the slot) of the written slot
+  int iret = 0;
+  std::vector<int> retcodes;
+  for (size_t i = 0; i < slots.size(); i++)
+  {
+    const unsigned int slot = slots[i];
+    eventcounter++;
+    if (!iret)
+    {
+      if (status[i] == Fun4AllReturnCodes::EVENT_OK)
+      {
+        retcodesmap[Fun4AllReturnCodes::EVENT_OK]++;
+        ngood++;
+        retcodes = RetCodes;
+        for (size_t j = 0; j < modules[slot].size() && j < modules[0].size(); j++)
+        {
+          retcodes[modules[0][j]] = RetCodes[modules[slot][j]];
+        }
+        WriteEvent(m_SlotTopNodes[slot], m_SlotOutNodes[slot], &retcodes);
+      }
+      else if (status[i] == Fun4AllReturnCodes::ABORTEVENT)
+      {
+        retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
+      }
+      else
+      {
+        // events after an abort run are dropped
+        if (status[i] == Fun4AllReturnCodes::ABORTRUN)
+        {
+          retcodesmap[Fun4AllReturnCodes::ABORTRUN]++;
+        }
+        iret = Fun4AllReturnCodes::ABORTRUN;
+      }
+    }
+    for (unsigned int imod : modules[slot])
+    {
+      Subsystems[imod].first->ResetEvent(Subsystems[imod].second);
+    }
+    m_SlotSyncManagers[slot]->ResetEvent();
+    ResetNodeTree(m_SlotTopNodes[slot]);
   }
   Fun4AllMonitoring::instance()->Snapshot("Event");
-  ResetNodeTree();
-  return 0;
+  return iret;
+}
+
+int Fun4AllServer::RunEventSlots(const int nevnts, const bool require_nevents)
+{
+  recoConsts *rc = recoConsts::instance();
+  const bool run_number_forced = rc->FlagExist("RUNNUMBER");
+  if (SyncManagers.size() != m_SlotSyncManagers.size())
+  {
+    std::cout << PHWHERE << " additional sync managers are not supported with event slots" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  int iret = 0;
+  int icnt = 0;
+  int icnt_good = 0;
+  std::vector<unsigned int> batch;
+  batch.reserve(m_NEventSlots);
+  while (!iret)
+  {
+    // read up to one event per slot, the slots are filled round robin
+    // so consecutive run() calls continue with the right events
+    batch.clear();
+    int readret = 0;
+    while (batch.size() < m_NEventSlots)
+    {
+      if (nevnts > 0 && !require_nevents && icnt + (int) batch.size() >= nevnts)
+      {
+        break;
+      }
+      const unsigned int slot = m_NextEventSlot;
+      readret = ReadEventSlot(slot);
+      if (readret)
+      {
+        break;
+      }
+      m_NextEventSlot = (m_NextEventSlot + 1) % m_NEventSlots;
+      int currentrun = m_SlotSyncManagers[slot]->CurrentRun();
+      if (!m_EventSlotsStarted)
+      {
+        if (run_number_forced)
+        {
+          runnumber = rc->get_IntFlag("RUNNUMBER");
+          std::cout << "Fun4AllServer: Runnumber forced to " << runnumber << " by RUNNUMBER IntFlag" << std::endl;
+        }
+        else
+        {
+          runnumber = currentrun;
+        }
+        setRun(runnumber);
+        BeginRun(runnumber);
+        m_EventSlotsStarted = true;
+      }
+      else if (!run_number_forced && currentrun != 0 && currentrun != runnumber)
+      {
+        // finish the events of the previous run first
+        if (!batch.empty())
+        {
+          iret = ProcessEventSlots(batch, icnt_good);
+          icnt += batch.size();
+          batch.clear();
+          if (iret)
+          {
+            break;
+          }
+        }
+        EndRun(runnumber);
+        runnumber = currentrun;
+        setRun(runnumber);
+        BeginRun(runnumber);
+      }
+      batch.push_back(slot);
+    }
+    if (iret)
+    {
+      break;
+    }
+    if (!batch.empty())
+    {
+      if (Verbosity() >= 1)
+      {
+        std::cout << "Fun4AllServer::run - processing events " << (icnt + 1) << " to " << (icnt + batch.size())
+                  << " from run " << runnumber << std::endl;
+      }
+      iret = ProcessEventSlots(batch, icnt_good);
+      icnt += batch.size();
+    }
+    if (readret && !iret)
+    {
+      iret = readret;
+    }
+    if (require_nevents)
+    {
+      if (nevnts > 0 && icnt_good >= nevnts)
+      {
+        break;
+      }
+    }
+    else if (nevnts > 0 && icnt >= nevnts)
+    {
+      break;
+    }
+  }
+  return iret;
 }
 
 int Fun4AllServer::ResetNodeTree()
+{
+  std::map<std::string, PHCompositeNode *>::const_iterator iter;
+  for (iter = topnodemap.begin(); iter != topnodemap.end(); ++iter)
+  {
+    ResetNodeTree((*iter).second);
+  }
+  return 0;  // anything except 0 would abort the event loop in pmonitor
+}
+
+int Fun4AllServer::ResetNodeTree(PHCompositeNode *topnode)
 {
   std::vector<std::string> ResetNodeList;
   ResetNodeList.emplace_back("DST");
   PHNodeReset reset;
   reset.Verbosity(Verbosity() > 2 ? Verbosity() - 2 : 0);  // one lower verbosity level than Fun4AllServer
-  std::map<std::string, PHCompositeNode *>::const_iterator iter;
-  for (iter = topnodemap.begin(); iter != topnodemap.end(); ++iter)
+  PHNodeIterator mainIter(topnode);
+  for (const auto &nodename : ResetNodeList)
   {
-    PHNodeIterator mainIter((*iter).second);
-    for (const auto &nodename : ResetNodeList)
+    if (mainIter.cd(nodename))
     {
-      if (mainIter.cd(nodename))
-      {
-        mainIter.forEach(reset);
-        mainIter.cd();
-      }
+      mainIter.forEach(reset);
+      mainIter.cd();
     }
   }
-  return 0;  // anything except 0 would abort the event loop in pmonitor
+  return 0;
 }
 
 int Fun4AllServer::Reset()
@@ -852,6 +1393,11 @@ int Fun4AllServer::BeginRun(const int runno)
     registerSubsystem((NewSubsystems.front()).first, (NewSubsystems.front()).second);
     BeginRunSubsystem(std::make_pair(NewSubsystems.front().first, topNode(NewSubsystems.front().second)));
   }
+  // modules may declare their nodes in InitRun
+  if (m_ConcurrentModules)
+  {
+    BuildModuleGraph();
+  }
   gROOT->cd(currdir.c_str());
   // print out all node trees
   Print("NODETREE");
@@ -884,6 +1430,11 @@ int Fun4AllServer::BeginRunSubsystem(const std::pair<SubsysReco *, PHCompositeNo
   {
     std::cout << "Fun4AllServer::BeginRun: InitRun for " << subsys.first->Name() << std::endl;
   }
+  // modules of event slots find the shared nodes which exist by now
+  if (m_NEventSlots > 1 && subsys.second != TopNode)
+  {
+    LinkSharedNodes(subsys.second);
+  }
   try
   {
 #ifdef FFAMEMTRACKER
@@ -1313,6 +1864,14 @@ PHCompositeNode *Fun4AllServer::getNode(const std::string &name, const std::stri
 
 int Fun4AllServer::registerInputManager(Fun4AllInputManager *InManager)
 {
+  // input managers of event slots go to the sync manager of their slot
+  for (unsigned int slot = 1; slot < m_SlotSyncManagers.size(); slot++)
+  {
+    if (InManager->TopNodeName() == EventSlotTopNodeName(slot))
+    {
+      return m_SlotSyncManagers[slot]->registerInputManager(InManager);
+    }
+  }
   int iret = defaultSyncManager->registerInputManager(InManager);
   return iret;
 }
@@ -1345,6 +1904,10 @@ int Fun4AllServer::DstEvents() const
 //_________________________________________________________________
 int Fun4AllServer::run(const int nevnts, const bool require_nevents)
 {
+  if (m_NEventSlots > 1)
+  {
+    return RunEventSlots(nevnts, require_nevents);
+  }
   recoConsts *rc = recoConsts::instance();
   static bool run_number_forced = rc->FlagExist("RUNNUMBER");
   static int ifirst = 1;
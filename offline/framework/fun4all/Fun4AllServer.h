@@ -12,6 +12,7 @@
 #include <deque>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
@@ -21,6 +22,7 @@ class Fun4AllMemoryTracker;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
 class PHCompositeNode;
+class PHThreadPool;
 class PHTimeStamp;
 class SubsysReco;
 class TDirectory;
@@ -62,6 +64,7 @@ class Fun4AllServer : public Fun4AllBase
   int Reset();
   virtual int BeginRun(const int runno);
   int BeginRunSubsystem(const std::pair<SubsysReco *, PHCompositeNode *> &subsys);
+  int ProcessEventSubsystem(const unsigned int imodule);
   virtual int EndRun(const int runno = 0);
   virtual int End();
   PHCompositeNode *topNode() const { return TopNode; }
@@ -94,6 +97,7 @@ class Fun4AllServer : public Fun4AllBase
   int fileclose(const std::string &managername);
   int SegmentNumber();
   int ResetNodeTree();
+  int ResetNodeTree(PHCompositeNode *topnode);
   int BranchSelect(const std::string &managername, const std::string &branch, int iflag);
   int BranchSelect(const std::string &branch, int iflag);
   int setBranches(const std::string &managername);
@@ -117,6 +121,37 @@ class Fun4AllServer : public Fun4AllBase
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
 
+  /*!
+    \brief run modules which do not share nodes concurrently.
+    Modules declare the nodes they read and write (SubsysReco::DeclareInputNode(),
+    SubsysReco::DeclareOutputNode()), the dependencies are resolved in registration
+    order. nthreads = 0 uses all cores.
+
+    Unlike sequential running, a module registered after a module which stops the
+    event (ABORTEVENT, ABORTRUN, ABORTPROCESSING) can already have processed this
+    event if it does not depend on that module: it is started as soon as its own
+    inputs are ready. The return codes and the output are the ones of sequential
+    running (the event is not written and its nodes are reset), but such a module
+    has seen the event in its own state (histograms, counters) and in nodes which
+    are not reset per event. A module which must only see events accepted by an
+    earlier module has to depend on it, e.g. declare one of its output nodes as input.
+  */
+  void ConcurrentModules(const bool yesno = true, const unsigned int nthreads = 0);
+  bool ConcurrentModules() const { return m_ConcurrentModules; }
+
+  /*!
+    \brief process nslots events at the same time, each in its own node tree.
+    Slot 0 is the TOP node tree, slot i > 0 uses the top node EventSlotTopNodeName(i).
+    Modules and input managers are registered for each slot under the slot top node
+    name (call this before registering them), the input managers of a slot read every
+    nslots-th event. Nodes under RUN and PAR of TOP which do not exist in a slot are
+    linked (shared, not copied) into the slot tree before the InitRun of its modules.
+    Output managers get the events in input order. Modules of a slot run sequentially.
+  */
+  void EventSlots(const unsigned int nslots);
+  unsigned int EventSlots() const { return m_NEventSlots; }
+  static std::string EventSlotTopNodeName(const unsigned int slot);
+
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
   int InitNodeTree(PHCompositeNode *topNode);
@@ -125,6 +160,36 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runnumber);
+  void BuildModuleGraph();
+  void RunModulesConcurrently();
+  // output nodes of a top node, the DST node and its number of output
+  // nodes are only looked up again after a node tree changed
+  struct OutNodeCache
+  {
+    PHCompositeNode *dstNode = nullptr;
+    int firstcount = -1;  // number of output nodes at the first write
+    int count = 0;
+    unsigned long generation = 0;
+    bool valid = false;
+  };
+
+  // per module data resolved once when modules are added or removed
+  struct ModuleEntry
+  {
+    SubsysReco *module = nullptr;
+    PHCompositeNode *topnode = nullptr;
+    TDirectory *dir = nullptr;
+    PHTimer *timer = nullptr;
+    std::string timername;
+  };
+
+  void BuildModuleTable();
+  void WriteEvent(PHCompositeNode *topnode, OutNodeCache &outnodes, std::vector<int> *retcodes);
+  int RunEventSlots(const int nevnts, const bool require_nevents);
+  int ReadEventSlot(const unsigned int slot);
+  int ProcessEventSlot(const unsigned int slot, const std::vector<unsigned int> &modules);
+  int ProcessEventSlots(const std::vector<unsigned int> &slots, int &ngood);
+  void LinkSharedNodes(PHCompositeNode *slottopnode);
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars = nullptr;
   Fun4AllMemoryTracker *ffamemtracker = nullptr;
@@ -133,7 +198,6 @@ class Fun4AllServer : public Fun4AllBase
   PHCompositeNode *TopNode = nullptr;
   Fun4AllSyncManager *defaultSyncManager = nullptr;
 
-  int OutNodeCount = 0;
   int bortime_override = 0;
   int ScreamEveryEvent = 0;
   int unregistersubsystem = 0;
@@ -141,6 +205,12 @@ class Fun4AllServer : public Fun4AllBase
   int eventnumber = 0;
   int eventcounter = 0;
   int keep_db_connected = 0;
+  bool m_ConcurrentModules = false;
+  bool m_ModuleGraphValid = false;
+  bool m_ModuleTableValid = false;
+  bool m_EventSlotsStarted = false;
+  unsigned int m_NEventSlots = 1;
+  unsigned int m_NextEventSlot = 0;
 
   std::vector<std::string> ComplaintList;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> Subsystems;
@@ -155,6 +225,25 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+
+  // indexed like Subsystems
+  std::vector<ModuleEntry> m_ModuleTable;
+  OutNodeCache m_OutNodes;
+
+  // module dependency graph for concurrent processing, indexed like Subsystems
+  std::unique_ptr<PHThreadPool> m_ModulePool;
+  std::vector<std::vector<unsigned int>> m_ModuleSuccessors;
+  std::vector<unsigned int> m_ModuleNPredecessors;
+  std::vector<char> m_ModuleExecuted;
+
+  // event slots, index is the slot number (slot 0 is TOP)
+  std::unique_ptr<PHThreadPool> m_SlotPool;
+  std::vector<PHCompositeNode *> m_SlotTopNodes;
+  std::vector<Fun4AllSyncManager *> m_SlotSyncManagers;
+  std::vector<OutNodeCache> m_SlotOutNodes;
+  std::vector<int> m_SlotEventsRead;
+  // TOP tree generation when the slot links were last updated
+  unsigned long m_SlotLinkGeneration = 0;
 };
 
 #endif
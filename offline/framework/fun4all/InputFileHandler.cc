@@ -1,11 +1,19 @@
 #include "InputFileHandler.h"
 
+#include <phool/PHTimer.h>
 #include <phool/phool.h>
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+
+InputFileHandler::~InputFileHandler()
+{
+  // last resort, derived classes implementing PrefetchFile() wait in their dtor
+  WaitForPrefetch();
+}
 
 int InputFileHandler::AddFile(const std::string &filename)
 {
@@ -81,6 +89,10 @@ int InputFileHandler::AddListFile(const std::string &filename)
 
 int InputFileHandler::OpenNextFile()
 {
+  PHTimer opentimer("OpenNextFile");
+  opentimer.restart();
+  // a prefetch of this file has to be finished before fileopen() can pick it up
+  WaitForPrefetch();
   while (!m_FileList.empty())
   {
     std::list<std::string>::const_iterator iter = m_FileList.begin();
@@ -95,12 +107,36 @@ int InputFileHandler::OpenNextFile()
     }
     else
     {
+      opentimer.stop();
+      m_TimeBlockedOnOpen += opentimer.elapsed();
+      // the next entry is the one fileclose() moves to the front
+      // (unless a single file is repeated)
+      if (m_PrefetchNextFile && std::next(iter) != m_FileList.end())
+      {
+        const std::string nextfile = *std::next(iter);
+        if (GetVerbosity())
+        {
+          std::cout << PHWHERE << " prefetching next file: " << nextfile << std::endl;
+        }
+        m_PrefetchThread = std::thread([this, nextfile]()
+                                       { PrefetchFile(nextfile); });
+      }
       return 1;
     }
   }
+  opentimer.stop();
+  m_TimeBlockedOnOpen += opentimer.elapsed();
   return 0;
 }
 
+void InputFileHandler::WaitForPrefetch()
+{
+  if (m_PrefetchThread.joinable())
+  {
+    m_PrefetchThread.join();
+  }
+}
+
 void InputFileHandler::Print(const std::string & /* what */) const
 {
   std::cout << "file list: " << std::endl;
@@ -3,12 +3,13 @@
 
 #include <list>
 #include <string>
+#include <thread>
 
 class InputFileHandler
 {
  public:
   InputFileHandler() = default;
-  virtual ~InputFileHandler() = default;
+  virtual ~InputFileHandler();
   virtual int fileopen(const std::string & /*filename*/) { return 0; }
   virtual int fileclose() { return -1; }
   int OpenNextFile();
@@ -23,11 +24,27 @@ class InputFileHandler
   void UpdateFileList();
   void FileName(const std::string &fn) { m_FileName = fn; }
   const std::string FileName() const { return m_FileName; }
+  //! open the next file of the list on a background thread while the current one
+  //! is processed, only has an effect for inputs which implement PrefetchFile()
+  void PrefetchNextFile(const bool b = true) { m_PrefetchNextFile = b; }
+  //! wall time (ms) spent in OpenNextFile(), including waiting for a prefetch
+  double TimeBlockedOnOpen() const { return m_TimeBlockedOnOpen; }
+
+ protected:
+  //! called on the prefetch thread with the name of the next file in the list.
+  //! Inputs do the expensive part of opening here and pick it up in fileopen()
+  virtual void PrefetchFile(const std::string & /*filename*/) {}
+  //! wait for a running prefetch, inputs implementing PrefetchFile() have to call
+  //! this in their destructor and before using the prefetched file
+  void WaitForPrefetch();
 
  private:
   int m_IsOpen = 0;
   int m_Repeat = 0;
   int m_Verbosity = 0;
+  bool m_PrefetchNextFile = false;
+  double m_TimeBlockedOnOpen = 0;
+  std::thread m_PrefetchThread;
   std::string m_FileName;
   std::list<std::string> m_FileList;
   std::list<std::string> m_FileListCopy;
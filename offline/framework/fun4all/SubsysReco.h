@@ -5,6 +5,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <set>
 #include <string>
 
 class PHCompositeNode;
@@ -60,6 +61,29 @@ class SubsysReco : public Fun4AllBase
 
   void Print(const std::string & /*what*/ = "ALL") const override {}
 
+  /** Declare a node (by name, below the top node of this module) which
+      is read in process_event(). This is only used when the Fun4AllServer
+      runs modules concurrently. Modules which do not declare any nodes are
+      run exclusively, after all modules registered before them and before
+      all modules registered after them.
+  */
+  void DeclareInputNode(const std::string &name)
+  {
+    m_InputNodes.insert(name);
+    m_NodesDeclared = true;
+  }
+
+  /// Declare a node which is created or modified in process_event().
+  void DeclareOutputNode(const std::string &name)
+  {
+    m_OutputNodes.insert(name);
+    m_NodesDeclared = true;
+  }
+
+  const std::set<std::string> &InputNodes() const { return m_InputNodes; }
+  const std::set<std::string> &OutputNodes() const { return m_OutputNodes; }
+  bool NodesDeclared() const { return m_NodesDeclared; }
+
  protected:
   /** ctor.
       @param name is the reference used inside the Fun4AllServer
@@ -68,6 +92,11 @@ class SubsysReco : public Fun4AllBase
     : Fun4AllBase(name)
   {
   }
+
+ private:
+  std::set<std::string> m_InputNodes;
+  std::set<std::string> m_OutputNodes;
+  bool m_NodesDeclared = false;
 };
 
 #endif
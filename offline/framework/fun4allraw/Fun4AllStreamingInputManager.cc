@@ -94,15 +94,7 @@ Fun4AllStreamingInputManager::~Fun4AllStreamingInputManager()
   }
   m_InttInputVector.clear();
 
-  // TPC
-  for (auto const &mapiter : m_TpcRawHitMap)
-  {
-    for (auto tpchititer : mapiter.second.TpcRawHitVector)
-    {
-      delete tpchititer;
-    }
-  }
-
+  // TPC, the hits are owned by the inputs
   m_TpcRawHitMap.clear();
   for (auto iter : m_TpcInputVector)
   {
@@ -247,8 +239,11 @@ void Fun4AllStreamingInputManager::Print(const std::string &what) const
       std::cout << "bco: " << std::hex << iter.first << std::dec << std::endl;
       for (auto &itervec : iter.second.TpcRawHitVector)
       {
-        std::cout << "hit: " << std::hex << itervec << std::dec << std::endl;
-        itervec->identify();
+        for (unsigned int i = 0; i < itervec->get_nhits(); ++i)
+        {
+          std::cout << "hit: " << std::hex << itervec->get_hit(i) << std::dec << std::endl;
+          itervec->get_hit(i)->identify();
+        }
       }
     }
   }
@@ -511,14 +506,14 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
   m_MicromegasRawHitMap[bclk].MicromegasRawHitVector.push_back(hit);
 }
 
-void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
+void Fun4AllStreamingInputManager::AddTpcRawHits(uint64_t bclk, TpcRawHitContainer *hits)
 {
   if (Verbosity() > 1)
   {
-    std::cout << "Adding tpc hit to bclk 0x"
+    std::cout << "Adding tpc hits to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
-  m_TpcRawHitMap[bclk].TpcRawHitVector.push_back(hit);
+  m_TpcRawHitMap[bclk].TpcRawHitVector.push_back(hits);
 }
 
 int Fun4AllStreamingInputManager::FillGl1()
@@ -869,7 +864,8 @@ int Fun4AllStreamingInputManager::FillTpc()
       {
         tpchititer->identify();
       }
-      tpccont->AddHit(tpchititer);
+      // bulk copy of all waveforms of this input and beam clock
+      tpccont->AddHits(tpchititer);
     }
     for (auto iter : m_TpcInputVector)
     {
@@ -18,7 +18,7 @@ class MicromegasRawHit;
 class MvtxRawHit;
 class PHCompositeNode;
 class SyncObject;
-class TpcRawHit;
+class TpcRawHitContainer;
 
 class Fun4AllStreamingInputManager : public Fun4AllInputManager
 {
@@ -49,7 +49,8 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   void AddMvtxFeeId(uint64_t bclk, uint16_t feeid);
   void AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco);
   void AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit);
-  void AddTpcRawHit(uint64_t bclk, TpcRawHit *hit);
+  //! all waveforms of bclk from one input, owned by the input until CleanupUsedPackets
+  void AddTpcRawHits(uint64_t bclk, TpcRawHitContainer *hits);
   void SetInttBcoRange(const unsigned int i);
   void SetInttNegativeBco(const unsigned int value);
   void SetMicromegasBcoRange(const unsigned int i);
@@ -92,7 +93,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
 
   struct TpcRawHitInfo
   {
-    std::vector<TpcRawHit *> TpcRawHitVector;
+    std::vector<TpcRawHitContainer *> TpcRawHitVector;
     unsigned int EventFoundCounter{0};
   };
 
@@ -38,6 +38,8 @@ SinglePrdfInput::SinglePrdfInput(const std::string &name, Fun4AllPrdfInputTrigge
 
 SinglePrdfInput::~SinglePrdfInput()
 {
+  WaitForPrefetch();
+  delete m_PrefetchEventIterator;
   delete m_EventIterator;
   delete[] plist;
   delete[] m_PacketEventNumberOffset;
@@ -365,14 +367,32 @@ int SinglePrdfInput::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  std::string fname = frog.location(FileName());
-  if (Verbosity() > 0)
+  WaitForPrefetch();
+  std::string fname;
+  int status = 0;
+  if (m_PrefetchEventIterator && m_PrefetchFileName == filenam)
   {
-    std::cout << Name() << ": opening file " << FileName() << std::endl;
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": using prefetched file " << FileName() << std::endl;
+    }
+    fname = m_PrefetchLocation;
+    m_EventIterator = m_PrefetchEventIterator;
+    m_PrefetchEventIterator = nullptr;
+  }
+  else
+  {
+    // the prefetched file is not the one we want (file list was changed)
+    delete m_PrefetchEventIterator;
+    m_PrefetchEventIterator = nullptr;
+    FROG frog;
+    fname = frog.location(FileName());
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": opening file " << FileName() << std::endl;
+    }
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
   }
-  int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
   m_EventsThisFile = 0;
   if (status)
   {
@@ -386,6 +406,24 @@ int SinglePrdfInput::fileopen(const std::string &filenam)
   return 0;
 }
 
+void SinglePrdfInput::PrefetchFile(const std::string &filenam)
+{
+  // runs on the prefetch thread, only touches the prefetch members
+  FROG frog;
+  std::string fname = frog.location(filenam);
+  int status = 0;
+  Eventiterator *evtiter = new fileEventiterator(fname.c_str(), status);
+  if (status)
+  {
+    // fileopen() will try again and report the error
+    delete evtiter;
+    return;
+  }
+  m_PrefetchFileName = filenam;
+  m_PrefetchLocation = fname;
+  m_PrefetchEventIterator = evtiter;
+}
+
 int SinglePrdfInput::fileclose()
 {
   if (!IsOpen())
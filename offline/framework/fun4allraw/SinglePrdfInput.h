@@ -38,6 +38,9 @@ class SinglePrdfInput : public Fun4AllBase, public InputFileHandler
   void MakeReference(const bool b);
   bool ReferenceFlag() const { return m_MeReferenceFlag; }
 
+ protected:
+  void PrefetchFile(const std::string &filename) override;
+
  private:
   int majority_eventnumber();
   int majority_beamclock();
@@ -48,6 +51,10 @@ class SinglePrdfInput : public Fun4AllBase, public InputFileHandler
     unsigned int EventFoundCounter = 0;
   };
   Eventiterator *m_EventIterator = nullptr;
+  // next file of the list, opened on the prefetch thread
+  Eventiterator *m_PrefetchEventIterator = nullptr;
+  std::string m_PrefetchFileName;
+  std::string m_PrefetchLocation;
   Fun4AllPrdfInputPoolManager *m_InputMgr = nullptr;
   Fun4AllPrdfInputTriggerManager *m_TriggerInputMgr = nullptr;
   Packet **plist = nullptr;
@@ -3,13 +3,13 @@
 #include "Fun4AllStreamingInputManager.h"
 #include "InputManagerType.h"
 
-#include <ffarawobjects/TpcRawHitContainerv1.h>
-#include <ffarawobjects/TpcRawHitv1.h>
+#include <ffarawobjects/TpcRawHitContainerv2.h>
 
 #include <frog/FROG.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -79,6 +79,8 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
     }
     int EventSequence = evt->getEvtSequence();
     int npackets = evt->getPacketList(plist, NTPCPACKETS);
+    PHTimer decodetimer("TpcDecode");
+    decodetimer.restart();
 
     if (npackets >= NTPCPACKETS)
     {
@@ -123,9 +125,15 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
 
       int m_nWaveFormInFrame = packet->iValue(0, "NR_WF");
       static int once = 0;
+      // all waveforms of this frame go into the storage of their beam clock
+      TpcRawHitContainerv2 *frame = nullptr;
       for (int wf = 0; wf < m_nWaveFormInFrame; wf++)
       {
-        if (m_TpcRawHitMap[gtm_bco].size() > 20000)
+        if (!frame)
+        {
+          frame = &m_TpcRawHitMap[gtm_bco];
+        }
+        if (frame->get_nhits() > 20000)
         {
           if (!once)
           {
@@ -148,18 +156,12 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
           continue;
         }
 
-        TpcRawHit *newhit = new TpcRawHitv1();
-        int FEE = packet->iValue(wf, "FEE");
-        newhit->set_bco(packet->iValue(wf, "BCO"));
-
-        // store gtm bco in hit
-        newhit->set_gtm_bco(gtm_bco);
-
-        newhit->set_packetid(packet->getIdentifier());
-        newhit->set_fee(FEE);
-        newhit->set_channel(packet->iValue(wf, "CHANNEL"));
-        newhit->set_sampaaddress(packet->iValue(wf, "SAMPAADDRESS"));
-        newhit->set_sampachannel(packet->iValue(wf, "CHANNEL"));
+        // every string keyed lookup is a separate search in the decoder,
+        // ask for each field once
+        const int FEE = packet->iValue(wf, "FEE");
+        const int channel = packet->iValue(wf, "CHANNEL");
+        const uint64_t bco = packet->iValue(wf, "BCO");
+        const int sampaaddress = packet->iValue(wf, "SAMPAADDRESS");
 
         //         // checksum and checksum error
         //         newhit->set_checksum( packet->iValue(iwf, "CHECKSUM") );
@@ -171,7 +173,12 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
         // Temp remedy as we set the time window as 360 for now
         const uint16_t samples = 360;
 
-        newhit->set_samples(samples);
+        // first waveform of this beam clock, the streaming manager picks up
+        // the whole frame
+        const bool newframe = (frame->get_nhits() == 0);
+
+        // store gtm bco in hit, the sampa channel is the channel
+        uint16_t *adc = frame->AddWaveform(bco, gtm_bco, packet_id, FEE, channel, sampaaddress, channel, samples);
 
         // adc values
         for (uint16_t is = 0; is < samples; ++is)
@@ -182,15 +189,9 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
           // if(adval >= 64000){ newhit->set_samples(is); break;}
 
           // With this, the hit is unseen from clusterizer
-          if (adval >= 64000)
-          {
-            newhit->set_adc(is, 0);
-          }
-          else
-          {
-            newhit->set_adc(is, adval);
-          }
+          adc[is] = (adval >= 64000) ? 0 : adval;
         }
+        ++m_NumWaveforms;
 
         m_BeamClockFEE[gtm_bco].insert(FEE);
         m_FEEBclkMap[FEE] = gtm_bco;
@@ -205,16 +206,17 @@ void SingleTpcPoolInput::FillPool(const unsigned int /*nbclks*/)
         //          packet->convert();
         // if (m_TpcRawHitMap[gtm_bco].size() < 50000)
         // {
-        if (StreamingInputManager())
+        if (newframe && StreamingInputManager())
         {
-          StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit);
+          StreamingInputManager()->AddTpcRawHits(gtm_bco, frame);
         }
-        m_TpcRawHitMap[gtm_bco].push_back(newhit);
         m_BclkStack.insert(gtm_bco);
         //	}
       }
       delete packet;
     }
+    decodetimer.stop();
+    m_DecodeTime += decodetimer.elapsed();
   }
   //    Print("HITS");
   //  } while (m_TpcRawHitMap.size() < 10 || CheckPoolDepth(m_TpcRawHitMap.begin()->first));
@@ -254,11 +256,12 @@ void SingleTpcPoolInput::Print(const std::string &what) const
   {
     for (const auto &bcliter : m_TpcRawHitMap)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec
+                << " at " << std::hex << &bcliter.second << std::dec << std::endl;
+      for (unsigned int i = 0; i < bcliter.second.size(); ++i)
       {
-        std::cout << "fee: " << feeiter->get_fee()
-                  << " at " << std::hex << feeiter << std::dec << std::endl;
+        std::cout << "fee: " << bcliter.second.get_fee(i)
+                  << ", samples: " << bcliter.second.get_samples(i) << std::endl;
       }
     }
   }
@@ -269,6 +272,16 @@ void SingleTpcPoolInput::Print(const std::string &what) const
       std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
     }
   }
+  if (what == "ALL" || what == "RATE")
+  {
+    std::cout << Name() << ": decoded " << m_NumWaveforms << " waveforms in "
+              << m_DecodeTime / 1000. << " s";
+    if (m_DecodeTime > 0)
+    {
+      std::cout << ", " << m_NumWaveforms / (m_DecodeTime / 1000.) << " waveforms/s";
+    }
+    std::cout << std::endl;
+  }
 }
 
 void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
@@ -283,10 +296,6 @@ void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
   {
     if (iter.first <= bclk)
     {
-      for (auto pktiter : iter.second)
-      {
-        delete pktiter;
-      }
       toclearbclk.push_back(iter.first);
     }
     else
@@ -413,7 +422,7 @@ void SingleTpcPoolInput::CreateDSTNode(PHCompositeNode *topNode)
   TpcRawHitContainer *tpchitcont = findNode::getClass<TpcRawHitContainer>(detNode, "TPCRAWHIT");
   if (!tpchitcont)
   {
-    tpchitcont = new TpcRawHitContainerv1();
+    tpchitcont = new TpcRawHitContainerv2();
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(tpchitcont, "TPCRAWHIT", "PHObject");
     detNode->addNode(newNode);
   }
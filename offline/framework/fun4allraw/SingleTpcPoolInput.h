@@ -3,14 +3,16 @@
 
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/TpcRawHitContainerv2.h>
+
 #include <array>
+#include <cstdint>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 #include <vector>
 
-class TpcRawHit;
 class Packet;
 
 class SingleTpcPoolInput : public SingleStreamingInput
@@ -38,8 +40,13 @@ class SingleTpcPoolInput : public SingleStreamingInput
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
 
+  //! decoding throughput
+  uint64_t m_NumWaveforms{0};
+  double m_DecodeTime{0};
+
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
-  std::map<uint64_t, std::vector<TpcRawHit *>> m_TpcRawHitMap;
+  //! all waveforms of a beam clock in one contiguous container
+  std::map<uint64_t, TpcRawHitContainerv2> m_TpcRawHitMap;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
 };
@@ -0,0 +1,120 @@
+#ifndef PHOOL_NODEHANDLE_H
+#define PHOOL_NODEHANDLE_H
+
+//  Typed handle to a node tree object. It is resolved once (typically in
+//  InitRun) and can then be dereferenced per event without searching the
+//  node tree again. The lookup is only repeated if nodes were added to or
+//  removed from the node tree below the top node since, or if the data
+//  pointer of the node was replaced (e.g. by an input manager).
+//
+//  usage:
+//    findNode::NodeHandle<TrkrHitSetContainer> m_hitsets{"TRKR_HITSET"};
+//    InitRun:       if (!m_hitsets.resolve(topNode)) { ... }
+//    process_event: m_hitsets->findOrAddHitSet(...);
+
+#include "PHCompositeNode.h"
+#include "PHDataNode.h"
+#include "PHIODataNode.h"
+#include "PHNodeIterator.h"
+
+#include <TObject.h>
+
+#include <string>
+
+namespace findNode
+{
+  template <class T>
+  class NodeHandle
+  {
+   public:
+    NodeHandle() = default;
+    explicit NodeHandle(const std::string &name)
+      : m_Name(name)
+    {
+    }
+
+    T *resolve(PHCompositeNode *top, const std::string &name)
+    {
+      m_Name = name;
+      return resolve(top);
+    }
+
+    T *resolve(PHCompositeNode *top)
+    {
+      m_TopNode = top;
+      m_DataNode = nullptr;
+      m_IODataNode = nullptr;
+      m_RawData = nullptr;
+      m_Object = nullptr;
+      if (!top)
+      {
+        return nullptr;
+      }
+      m_Generation = top->treeGeneration();
+      PHNodeIterator iter(top);
+      PHNode *node = iter.findFirst(m_Name);
+      if (!node)
+      {
+        return nullptr;
+      }
+      // same logic as getClass, but remember the node for later
+      m_DataNode = dynamic_cast<PHDataNode<T> *>(node);
+      if (m_DataNode)
+      {
+        m_RawData = m_DataNode->getData();
+        m_Object = dynamic_cast<T *>(m_DataNode->getData());
+        if (m_Object)
+        {
+          return m_Object;
+        }
+        m_DataNode = nullptr;
+      }
+      m_IODataNode = static_cast<PHIODataNode<TObject> *>(node);
+      m_RawData = m_IODataNode->getData();
+      m_Object = dynamic_cast<T *>(m_IODataNode->getData());
+      return m_Object;
+    }
+
+    T *get()
+    {
+      if (!m_TopNode)
+      {
+        return nullptr;
+      }
+      if (m_Generation != m_TopNode->treeGeneration())
+      {
+        return resolve(m_TopNode);
+      }
+      const void *rawdata = nullptr;
+      if (m_DataNode)
+      {
+        rawdata = m_DataNode->getData();
+      }
+      else if (m_IODataNode)
+      {
+        rawdata = m_IODataNode->getData();
+      }
+      if (rawdata != m_RawData)
+      {
+        return resolve(m_TopNode);
+      }
+      return m_Object;
+    }
+
+    T *operator->() { return get(); }
+    T &operator*() { return *get(); }
+    explicit operator bool() { return get() != nullptr; }
+    const std::string &name() const { return m_Name; }
+
+   private:
+    std::string m_Name;
+    PHCompositeNode *m_TopNode = nullptr;
+    unsigned long m_Generation = 0;
+    PHDataNode<T> *m_DataNode = nullptr;
+    PHIODataNode<TObject> *m_IODataNode = nullptr;
+    const void *m_RawData = nullptr;
+    T *m_Object = nullptr;
+  };
+}  // namespace findNode
+
+#endif
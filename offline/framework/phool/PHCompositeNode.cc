@@ -27,6 +27,12 @@ PHCompositeNode::~PHCompositeNode()
   // works but it has to be executed in case the PHCompositeNode is
   // a parent and supposed to stay. Then the deleted node has to take itself
   // out of the node list
+  // The parent has to drop our sub tree from its name index while
+  // our subnodes still exist
+  if (parent)
+  {
+    static_cast<PHCompositeNode*>(parent)->forgetMe(this);
+  }
   deleteMe = 1;
   subNodes.clearAndDestroy();
 }
@@ -51,7 +57,13 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
-  return (subNodes.append(newNode));
+  if (!subNodes.append(newNode))
+  {
+    return false;
+  }
+  indexSubTree(newNode);
+  treeChanged();
+  return true;
 }
 
 void PHCompositeNode::prune()
@@ -64,6 +76,8 @@ void PHCompositeNode::prune()
     {
       subNodes.removeAt(nodeIter.pos());
       --nodeIter;
+      unindexSubTree(thisNode);
+      treeChanged();
       delete thisNode;
     }
     else
@@ -73,6 +87,51 @@ void PHCompositeNode::prune()
   }
 }
 
+void PHCompositeNode::linkNodes(PHCompositeNode* source)
+{
+  PHPointerListIterator<PHNode> sourceIter(source->subNodes);
+  PHNode* sourceNode;
+  while ((sourceNode = sourceIter()))
+  {
+    PHNode* existing = nullptr;
+    PHPointerListIterator<PHNode> nodeIter(subNodes);
+    PHNode* thisNode;
+    while ((thisNode = nodeIter()))
+    {
+      if (thisNode->getName() == sourceNode->getName())
+      {
+        existing = thisNode;
+        break;
+      }
+    }
+    if (existing && existing->isExpiredLink())
+    {
+      // the source node was replaced, link the new one
+      delete existing;
+      existing = nullptr;
+    }
+    if (!existing)
+    {
+      PHNode* link = sourceNode->makeLink();
+      if (link)
+      {
+        addNode(link);
+      }
+    }
+    else if (existing->getType() == "PHCompositeNode" && sourceNode->getType() == "PHCompositeNode")
+    {
+      static_cast<PHCompositeNode*>(existing)->linkNodes(static_cast<PHCompositeNode*>(sourceNode));
+    }
+  }
+}
+
+PHNode* PHCompositeNode::makeLink()
+{
+  PHCompositeNode* link = new PHCompositeNode(name);
+  link->linkNodes(this);
+  return link;
+}
+
 void PHCompositeNode::forgetMe(PHNode* child)
 {
   // if this PHCompositeNode is supposed to be deleted,
@@ -90,11 +149,132 @@ void PHCompositeNode::forgetMe(PHNode* child)
     if (thisNode == child)
     {
       subNodes.removeAt(nodeIter.pos());
+      unindexSubTree(child);
+      treeChanged();
       child = nullptr;
     }
   }
 }
 
+PHNode* PHCompositeNode::findNode(const std::string& searchName) const
+{
+  auto iter = m_NodeIndex.find(searchName);
+  if (iter == m_NodeIndex.end())
+  {
+    return nullptr;
+  }
+  if (iter->second.count == 1)
+  {
+    return iter->second.node;
+  }
+  // name is not unique, fall back to the ordered search
+  return searchSubNodes(searchName);
+}
+
+PHNode* PHCompositeNode::searchSubNodes(const std::string& searchName) const
+{
+  PHPointerListIterator<PHNode> nodeIter(subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter()))
+  {
+    if (thisNode->getName() == searchName)
+    {
+      return thisNode;
+    }
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      PHNode* nodeFoundInSubTree = static_cast<PHCompositeNode*>(thisNode)->findNode(searchName);
+      if (nodeFoundInSubTree)
+      {
+        return nodeFoundInSubTree;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void PHCompositeNode::indexAdd(const std::string& nodename, PHNode* node, unsigned int count)
+{
+  IndexEntry& entry = m_NodeIndex[nodename];
+  entry.node = (entry.count == 0 && count == 1) ? node : nullptr;
+  entry.count += count;
+}
+
+void PHCompositeNode::indexRemove(const std::string& nodename, unsigned int count)
+{
+  auto iter = m_NodeIndex.find(nodename);
+  if (iter == m_NodeIndex.end())
+  {
+    return;
+  }
+  if (iter->second.count <= count)
+  {
+    m_NodeIndex.erase(iter);
+    return;
+  }
+  iter->second.count -= count;
+  // the removed nodes are already taken out of the tree and the indices
+  // below this node are up to date, so the remaining node can be resolved
+  // right away
+  iter->second.node = (iter->second.count == 1) ? searchSubNodes(nodename) : nullptr;
+}
+
+// the index of every node contains its complete sub tree, so a node
+// (and everything below it) is registered with all its ancestors
+void PHCompositeNode::indexSubTree(PHNode* node)
+{
+  PHCompositeNode* compnode = dynamic_cast<PHCompositeNode*>(node);
+  for (PHNode* ancestor = this; ancestor; ancestor = ancestor->getParent())
+  {
+    PHCompositeNode* anccomp = static_cast<PHCompositeNode*>(ancestor);
+    anccomp->indexAdd(node->getName(), node, 1);
+    if (compnode)
+    {
+      for (auto& iter : compnode->m_NodeIndex)
+      {
+        anccomp->indexAdd(iter.first, iter.second.node, iter.second.count);
+      }
+    }
+  }
+}
+
+void PHCompositeNode::unindexSubTree(PHNode* node)
+{
+  PHCompositeNode* compnode = dynamic_cast<PHCompositeNode*>(node);
+  for (PHNode* ancestor = this; ancestor; ancestor = ancestor->getParent())
+  {
+    PHCompositeNode* anccomp = static_cast<PHCompositeNode*>(ancestor);
+    anccomp->indexRemove(node->getName(), 1);
+    if (compnode)
+    {
+      for (auto& iter : compnode->m_NodeIndex)
+      {
+        anccomp->indexRemove(iter.first, iter.second.count);
+      }
+    }
+  }
+}
+
+// only the name of the node changed, its sub tree stays as it is
+void PHCompositeNode::reindexName(PHNode* node, const std::string& oldname)
+{
+  for (PHNode* ancestor = this; ancestor; ancestor = ancestor->getParent())
+  {
+    PHCompositeNode* anccomp = static_cast<PHCompositeNode*>(ancestor);
+    anccomp->indexRemove(oldname, 1);
+    anccomp->indexAdd(node->getName(), node, 1);
+  }
+  treeChanged();
+}
+
+void PHCompositeNode::treeChanged()
+{
+  for (PHNode* ancestor = this; ancestor; ancestor = ancestor->getParent())
+  {
+    static_cast<PHCompositeNode*>(ancestor)->m_TreeGeneration.fetch_add(1, std::memory_order_acq_rel);
+  }
+}
+
 bool PHCompositeNode::write(PHIOManager* IOManager, const std::string& path)
 {
   std::string newPath = name;
@@ -7,12 +7,15 @@
 #include "PHNode.h"
 #include "PHPointerList.h"
 
+#include <atomic>
 #include <string>
+#include <unordered_map>
 
 class PHIOManager;
 
 class PHCompositeNode : public PHNode
 {
+  friend class PHNode;
   friend class PHNodeIterator;
 
  public:
@@ -37,6 +40,34 @@ class PHCompositeNode : public PHNode
   void print(const std::string & = "") override;
   bool write(PHIOManager *, const std::string & = "") override;
 
+  //
+  // Returns the first node with this name in the sub tree below this node
+  // (same search order as PHNodeIterator::findFirst). Names which are unique
+  // in the sub tree are resolved via a hash index without walking the tree.
+  // The index is updated when nodes are added or removed, the lookup itself
+  // does not modify anything
+  //
+  PHNode *findNode(const std::string &) const;
+
+  //
+  // Counter which is incremented whenever a node is added to or removed
+  // from the sub tree below this node. Cached node pointers (see NodeHandle)
+  // compare against it to find out if they have to be looked up again
+  //
+  unsigned long treeGeneration() const { return m_TreeGeneration.load(std::memory_order_acquire); }
+
+  //
+  // Adds links (see PHNode::makeLink) to all nodes of the source tree
+  // which do not exist yet below this node. Composite nodes which exist
+  // in both trees are merged recursively, links whose source node was
+  // deleted are replaced. This is used to share read only nodes (geometries,
+  // calibrations) between node trees without copies. Links refer to their
+  // source node, they see when its data is replaced and never point to
+  // deleted data
+  //
+  void linkNodes(PHCompositeNode *source);
+  PHNode *makeLink() override;
+
  protected:
   void forgetMe(PHNode *) override;
   PHPointerList<PHNode> subNodes;
@@ -44,6 +75,26 @@ class PHCompositeNode : public PHNode
 
  private:
   PHCompositeNode() = delete;
+
+  // number of nodes with a given name in the sub tree below this node,
+  // node is the unique match if count is 1 (nullptr otherwise)
+  struct IndexEntry
+  {
+    PHNode *node = nullptr;
+    unsigned int count = 0;
+  };
+
+  void indexAdd(const std::string &name, PHNode *node, unsigned int count);
+  void indexRemove(const std::string &name, unsigned int count);
+  void indexSubTree(PHNode *);
+  void unindexSubTree(PHNode *);
+  void reindexName(PHNode *, const std::string &oldname);
+  PHNode *searchSubNodes(const std::string &) const;
+  void treeChanged();
+
+  std::unordered_map<std::string, IndexEntry> m_NodeIndex;
+
+  std::atomic<unsigned long> m_TreeGeneration{0};
 };
 
 #endif
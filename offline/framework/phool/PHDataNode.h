@@ -6,7 +6,10 @@
 
 #include "PHNode.h"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
+
 class TObject;
 
 template <class T>
@@ -18,7 +21,8 @@ class PHDataNode : public PHNode
   ~PHDataNode() override;
 
  public:
-  T* getData() { return data.data; }
+  // links return the current data of the node they link to
+  T* getData() { return m_LinkSource ? m_LinkSource->getData() : data.data; }
   void setData(T* d) { data.data = d; }
   void prune() override {}
   void forgetMe(PHNode*) override {}
@@ -27,13 +31,24 @@ class PHDataNode : public PHNode
   {
     return true;
   }
+  PHNode* makeLink() override;
+  bool isExpiredLink() const override { return m_IsLink && !m_LinkSource; }
+  bool ownsData() const { return owndata; }
 
  protected:
+  void linkTo(PHDataNode<T>* source);
+
   union tobjcast {
     T* data;
     TObject* tobj;
   };
   tobjcast data;
+  bool owndata = true;
+  bool m_IsLink = false;
+  // node this link refers to, reset when that node is deleted
+  PHDataNode<T>* m_LinkSource = nullptr;
+  // links referring to this node
+  std::vector<PHDataNode<T>*> m_Links;
   PHDataNode() = delete;
 };
 
@@ -59,16 +74,51 @@ PHDataNode<T>::PHDataNode(T* d,
 template <class T>
 PHDataNode<T>::~PHDataNode()
 {
+  // links do not keep a pointer to this node (or its data) alive
+  for (PHDataNode<T>* link : m_Links)
+  {
+    link->m_LinkSource = nullptr;
+    link->data.data = nullptr;
+  }
+  if (m_LinkSource)
+  {
+    auto& links = m_LinkSource->m_Links;
+    links.erase(std::remove(links.begin(), links.end(), this), links.end());
+  }
   // This means that the node has complete responsibility for the
-  // data it contains. Check for null pointer just in case some
-  // joker adds a node with a null pointer
-  if (data.data)
+  // data it contains (unless it is a link to another node's data).
+  // Check for null pointer just in case some joker adds a node
+  // with a null pointer
+  if (owndata && data.data)
   {
     delete data.data;
     data.data = nullptr;
   }
 }
 
+template <class T>
+PHNode* PHDataNode<T>::makeLink()
+{
+  PHDataNode<T>* link = new PHDataNode<T>(data.data, name, objecttype);
+  link->objectclass = objectclass;
+  link->linkTo(this);
+  return link;
+}
+
+template <class T>
+void PHDataNode<T>::linkTo(PHDataNode<T>* source)
+{
+  // the data stays with the source node, the link looks it up there
+  // so it follows when the source replaces its data
+  owndata = false;
+  m_IsLink = true;
+  m_LinkSource = source;
+  data.data = nullptr;
+  source->m_Links.push_back(this);
+  makeTransient();
+  setResetFlag(false);
+}
+
 template <class T>
 void PHDataNode<T>::print(const std::string& path)
 {
@@ -27,6 +27,7 @@ class PHIODataNode : public PHDataNode<T>
   typedef PHTypedNodeIterator<T> iterator;
   void BufferSize(int size) {buffersize = size;}
   void SplitLevel(int split) {splitlevel = split;}
+  PHNode *makeLink() override;
 
  protected:
   bool write(PHIOManager *, const std::string & = "") override;
@@ -58,6 +59,18 @@ PHIODataNode<T>::PHIODataNode(T *d, const std::string &n,
   this->objectclass = TO->GetName();
 }
 
+template <class T>
+PHNode *PHIODataNode<T>::makeLink()
+{
+  if (!this->getData())
+  {
+    return nullptr;
+  }
+  PHIODataNode<T> *link = new PHIODataNode<T>(this->getData(), this->getName(), this->getObjectType());
+  link->linkTo(this);
+  return link;
+}
+
 template <class T>
 bool PHIODataNode<T>::write(PHIOManager *IOManager, const std::string &path)
 {
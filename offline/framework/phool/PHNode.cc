@@ -2,6 +2,7 @@
 
 #include "PHNode.h"
 
+#include "PHCompositeNode.h"
 #include "phool.h"
 
 #include <TSystem.h>
@@ -58,6 +59,17 @@ PHNode::~PHNode()
   }
 }
 
+void PHNode::setName(const std::string& n)
+{
+  // the parents keep an index of the node names in their sub trees
+  std::string oldname = name;
+  name = n;
+  if (parent)
+  {
+    static_cast<PHCompositeNode*>(parent)->reindexName(this, oldname);
+  }
+}
+
 // Implementation of external functions.
 std::ostream&
 operator<<(std::ostream& stream, const PHNode& node)
@@ -21,18 +21,24 @@ class PHNode
   PHNode *getParent() const { return parent; }
   bool isPersistent() const { return persistent; }
   void makePersistent() { persistent = true; }
-  const std::string getObjectType() const { return objecttype; }
-  const std::string getType() const { return type; }
-  const std::string getName() const { return name; }
-  const std::string getClass() const { return objectclass; }
+  const std::string &getObjectType() const { return objecttype; }
+  const std::string &getType() const { return type; }
+  const std::string &getName() const { return name; }
+  const std::string &getClass() const { return objectclass; }
   void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setName(const std::string &n);
   void setObjectType(const std::string &n) { objecttype = n; }
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
   virtual void forgetMe(PHNode *) = 0;
   virtual bool write(PHIOManager *, const std::string & = "") = 0;
 
+  // new transient node which shares (does not own) the data of this
+  // node, nullptr if this node type cannot be linked
+  virtual PHNode *makeLink() { return nullptr; }
+  // true for a link whose source node was deleted
+  virtual bool isExpiredLink() const { return false; }
+
   virtual void setResetFlag(const bool b) { reset_able = b; }
   virtual bool getResetFlag() const { return reset_able; }
   void makeTransient() { persistent = false; }
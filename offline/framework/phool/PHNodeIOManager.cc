@@ -385,6 +385,19 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
                             static_cast<bool>(it->second));
     }
   }
+  // size the read cache and fill it with the selected branches only,
+  // so it does not need a learning phase
+  if (m_ReadCacheSize > 0)
+  {
+    if (m_ParallelUnzip)
+    {
+      // the kind of cache is decided when it is created
+      tree->SetParallelUnzip(true);
+      // entries are still streamed into the node tree by this thread
+      tree->SetImplicitMT(false);
+    }
+    tree->SetCacheSize(m_ReadCacheSize);
+  }
   // The file contains a TTree with a list of the TBranchObjects
   // attached to it.
   TObjArray* branchArray = tree->GetListOfBranches();
@@ -424,6 +437,11 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       continue;
     }
 
+    if (m_ReadCacheSize > 0)
+    {
+      tree->AddBranchToCache(thisBranch, true);
+    }
+
     std::string branchClassName = getBranchClassName(thisBranch);
     std::string branchName = thisBranch->GetName();
     fBranches[branchName] = thisBranch;
@@ -490,6 +508,10 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       nodeIter.cd("..");
     }
   }
+  if (m_ReadCacheSize > 0)
+  {
+    tree->StopCacheLearningPhase();
+  }
   return topNode;
 }
 
@@ -552,6 +574,13 @@ PHNodeIOManager::GetFileSize()
   return 0.;
 }
 
+uint64_t
+PHNodeIOManager::GetBytesRead() const
+{
+  if (file) return file->GetBytesRead();
+  return 0;
+}
+
 std::map<std::string, TBranch*>*
 PHNodeIOManager::GetBranchMap()
 {
@@ -10,6 +10,7 @@
 #include "phool.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
 
@@ -44,6 +45,15 @@ class PHNodeIOManager : public PHIOManager
   uint64_t GetBytesWritten();
   uint64_t GetFileSize();
   std::map<std::string, TBranch *> *GetBranchMap();
+  uint64_t GetBytesRead() const;
+
+  //! size (bytes) of the TTreeCache used for reading, 0 keeps the ROOT default.
+  //! The cache is restricted to the selected branches (no learning phase).
+  //! Has to be set before the first read
+  void SetReadCacheSize(const int64_t bytes) { m_ReadCacheSize = bytes; }
+  //! decompress the baskets in the read cache ahead of use on the ROOT
+  //! implicit MT pool (needs ROOT::EnableImplicitMT()), set before the first read
+  void SetParallelUnzip(const bool b) { m_ParallelUnzip = b; }
 
   bool write(TObject **, const std::string &, int buffersize, int splitlevel);
   bool NodeExist(const std::string &nodename);
@@ -60,6 +70,8 @@ class PHNodeIOManager : public PHIOManager
   int accessMode {PHReadOnly};
   int m_CompressionSetting {505}; // ZSTD
   int isFunctionalFlag {0};  // flag to tell if that object initialized properly
+  int64_t m_ReadCacheSize {0};
+  bool m_ParallelUnzip {false};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
 
@@ -53,6 +53,22 @@ void PHNodeIterator::print()
 PHNode*
 PHNodeIterator::findFirst(const std::string& requiredType, const std::string& requiredName)
 {
+  // a name which is unique in this sub tree either has the right type or
+  // there is no match at all, only duplicated names need the tree walk
+  auto index = currentNode->m_NodeIndex.find(requiredName);
+  if (index == currentNode->m_NodeIndex.end())
+  {
+    return nullptr;
+  }
+  if (index->second.count == 1)
+  {
+    PHNode* thisNode = currentNode->findNode(requiredName);
+    if (thisNode && thisNode->getType() == requiredType)
+    {
+      return thisNode;
+    }
+    return nullptr;
+  }
   PHPointerListIterator<PHNode> iter(currentNode->subNodes);
   PHNode* thisNode;
   while ((thisNode = iter()))
@@ -66,7 +82,7 @@ PHNodeIterator::findFirst(const std::string& requiredType, const std::string& re
       if (thisNode->getType() == "PHCompositeNode")
       {
         PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredType.c_str(), requiredName.c_str());
+        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredType, requiredName);
         if (nodeFoundInSubTree) return nodeFoundInSubTree;
       }
     }
@@ -77,28 +93,7 @@ PHNodeIterator::findFirst(const std::string& requiredType, const std::string& re
 PHNode*
 PHNodeIterator::findFirst(const std::string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode* thisNode;
-  while ((thisNode = iter()))
-  {
-    if (thisNode->getName() == requiredName)
-    {
-      return thisNode;
-    }
-    else
-    {
-      if (thisNode->getType() == "PHCompositeNode")
-      {
-        PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredName.c_str());
-        if (nodeFoundInSubTree)
-        {
-          return nodeFoundInSubTree;
-        }
-      }
-    }
-  }
-  return nullptr;
+  return currentNode->findNode(requiredName);
 }
 
 bool PHNodeIterator::cd(const std::string& pathString)
@@ -0,0 +1,99 @@
+#include "PHThreadPool.h"
+
+#include <algorithm>
+
+PHThreadPool::PHThreadPool(const unsigned int nthreads)
+  : m_NThreads(nthreads)
+{
+  if (m_NThreads == 0)
+  {
+    m_NThreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+  m_Workers.reserve(m_NThreads - 1);
+  for (unsigned int i = 1; i < m_NThreads; ++i)
+  {
+    m_Workers.emplace_back(&PHThreadPool::worker, this, i);
+  }
+}
+
+PHThreadPool::~PHThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_StartCondition.notify_all();
+  for (auto &thread : m_Workers)
+  {
+    thread.join();
+  }
+}
+
+void PHThreadPool::parallel_for(const size_t ntasks, const std::function<void(size_t, unsigned int)> &func)
+{
+  if (ntasks == 0)
+  {
+    return;
+  }
+  // nothing to distribute, avoid waking up the workers
+  if (m_Workers.empty() || ntasks == 1)
+  {
+    for (size_t task = 0; task < ntasks; ++task)
+    {
+      func(task, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Func = &func;
+    m_NTasks = ntasks;
+    m_NextTask = 0;
+    m_Active = m_Workers.size();
+    ++m_Generation;
+  }
+  m_StartCondition.notify_all();
+
+  run(0);
+
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_DoneCondition.wait(lock, [this]
+                       { return m_Active == 0; });
+  m_Func = nullptr;
+}
+
+void PHThreadPool::worker(const unsigned int thread)
+{
+  unsigned long generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_StartCondition.wait(lock, [this, generation]
+                            { return m_Stop || m_Generation != generation; });
+      if (m_Stop)
+      {
+        return;
+      }
+      generation = m_Generation;
+    }
+
+    run(thread);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (--m_Active == 0)
+    {
+      m_DoneCondition.notify_one();
+    }
+  }
+}
+
+void PHThreadPool::run(const unsigned int thread)
+{
+  size_t task;
+  while ((task = m_NextTask.fetch_add(1)) < m_NTasks)
+  {
+    (*m_Func)(task, thread);
+  }
+}
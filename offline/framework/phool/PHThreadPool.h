@@ -0,0 +1,65 @@
+#ifndef PHOOL_PHTHREADPOOL_H
+#define PHOOL_PHTHREADPOOL_H
+
+//  Purpose: long lived pool of worker threads for data parallel loops
+//  inside a module (e.g. one task per hitset). The threads are created
+//  once and wait for work between events, so there is no thread
+//  creation per event.
+//
+//  usage:
+//    PHThreadPool pool(8);
+//    std::vector<Output> buffers(pool.size());
+//    pool.parallel_for(ntasks, [&](size_t task, unsigned int thread)
+//      { process(task, buffers[thread]); });
+//
+//  parallel_for is not reentrant, a pool is used by one thread at a time.
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class PHThreadPool
+{
+ public:
+  //! number of threads includes the calling thread,
+  //! 0 uses std::thread::hardware_concurrency()
+  explicit PHThreadPool(const unsigned int nthreads = 0);
+  virtual ~PHThreadPool();
+
+  //! number of threads working on a parallel_for (workers + calling thread)
+  unsigned int size() const { return m_NThreads; }
+
+  //! call func(task, thread) for all tasks in [0, ntasks) and return when all are done.
+  //! Tasks are handed out dynamically, thread is in [0, size()) and can be used
+  //! to address per thread buffers. The calling thread works as thread 0.
+  void parallel_for(const size_t ntasks, const std::function<void(size_t, unsigned int)> &func);
+
+ private:
+  PHThreadPool(const PHThreadPool &) = delete;
+  PHThreadPool &operator=(const PHThreadPool &) = delete;
+
+  void worker(const unsigned int thread);
+  void run(const unsigned int thread);
+
+  unsigned int m_NThreads = 1;
+  std::vector<std::thread> m_Workers;
+
+  std::mutex m_Mutex;
+  std::condition_variable m_StartCondition;
+  std::condition_variable m_DoneCondition;
+
+  // current job, set under the lock before m_Generation is incremented
+  const std::function<void(size_t, unsigned int)> *m_Func = nullptr;
+  size_t m_NTasks = 0;
+  std::atomic<size_t> m_NextTask{0};
+
+  unsigned int m_Active = 0;
+  unsigned long m_Generation = 0;
+  bool m_Stop = false;
+};
+
+#endif
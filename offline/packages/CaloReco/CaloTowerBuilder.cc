@@ -138,6 +138,21 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
   }
   WaveformProcessing->initialize_processing();
   CreateNodeTree(topNode);
+
+  // nodes used in process_event, for running modules concurrently
+  if (!m_isdata)
+  {
+    DeclareInputNode(m_inputNodePrefix + m_detector);
+  }
+  else if (m_UseOfflinePacketFlag)
+  {
+    DeclareInputNode(nodemap.find(m_dettype)->second);
+  }
+  else
+  {
+    DeclareInputNode("PRDF");
+  }
+  DeclareOutputNode(TowerNodeName);
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
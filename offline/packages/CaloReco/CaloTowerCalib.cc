@@ -29,6 +29,7 @@
 
 #include <TSystem.h>
 
+#include <cmath>      // for isnan
 #include <cstdlib>    // for exit
 #include <exception>  // for exception
 #include <iostream>   // for operator<<, basic_ostream
@@ -64,6 +65,9 @@ int CaloTowerCalib::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator nodeIter(topNode);
 
+  // filled from the new calibrations at the first event
+  m_calibconst.clear();
+
   EventHeader *evtHeader = findNode::getClass<EventHeader>(topNode, "EventHeader");
 
   if (evtHeader)
@@ -243,13 +247,17 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
   TowerInfoContainer *_calib_towers = findNode::getClass<TowerInfoContainer>(topNode, CalibTowerNodeName);
   unsigned int ntowers = _raw_towers->size();
 
+  if (m_calibconst.size() != ntowers)
+  {
+    FillCalibConst(_raw_towers);
+  }
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
-    unsigned int key = _raw_towers->encode_key(channel);
     TowerInfo *caloinfo_raw = _raw_towers->get_tower_at_channel(channel);
     _calib_towers->get_tower_at_channel(channel)->copy_tower(caloinfo_raw);
     float raw_amplitude = caloinfo_raw->get_energy();
-    float calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    float calibconst = m_calibconst[channel];
     _calib_towers->get_tower_at_channel(channel)->set_energy(raw_amplitude * calibconst);
     if (calibconst == 0)
     {
@@ -259,6 +267,28 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void CaloTowerCalib::FillCalibConst(TowerInfoContainer *towers)
+{
+  // resolve the field once, then look up each tower key in the column
+  const CDBTTree::Column<float> &column = cdbttree->GetFloatColumn(m_fieldname);
+  unsigned int ntowers = towers->size();
+  m_calibconst.resize(ntowers);
+  unsigned int nmissing = 0;
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    m_calibconst[channel] = column.Get(towers->encode_key(channel));
+    if (std::isnan(m_calibconst[channel]))
+    {
+      ++nmissing;
+    }
+  }
+  if (nmissing > 0)
+  {
+    std::cout << PHWHERE << " " << m_detector << ": no " << m_fieldname << " calibration for "
+              << nmissing << " of " << ntowers << " towers" << std::endl;
+  }
+}
+
 void CaloTowerCalib::CreateNodeTree(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -64,6 +65,9 @@ class CaloTowerCalib : public SubsysReco
   void set_use_TowerInfov2(bool use) { m_use_TowerInfov2 = use; }
 
  private:
+  //! fill the calibration constants of all towers of the container
+  void FillCalibConst(TowerInfoContainer *towers);
+
   CaloTowerDefs::DetectorSystem m_dettype;
 
   std::string m_detector;
@@ -83,6 +87,9 @@ class CaloTowerCalib : public SubsysReco
   std::string m_directURL = "";
 
   CDBTTree *cdbttree = nullptr;
+
+  //! calibration constant per tower channel, filled once per run
+  std::vector<float> m_calibconst;
   int m_runNumber;
 };
 
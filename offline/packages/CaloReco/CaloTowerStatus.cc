@@ -62,6 +62,11 @@ int CaloTowerStatus::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator nodeIter(topNode);
 
+  // filled from the new calibrations at the first event
+  m_fraction_badChi2.clear();
+  m_mean_time.clear();
+  m_hotMap.clear();
+
   if (m_dettype == CaloTowerDefs::CEMC)
   {
     m_detector = "CEMC";
@@ -176,22 +181,25 @@ int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
   float fraction_badChi2 = 0;
   float mean_time = 0;
   int hotMap_val = 0;
+  if (m_fraction_badChi2.size() != ntowers)
+  {
+    FillCalibValues();
+  }
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
-    unsigned int key = m_raw_towers->encode_key(channel);
     m_raw_towers->get_tower_at_channel(channel)->set_status(0);  // resetting status
 
     if (m_doHotChi2)
     {
-      fraction_badChi2 = m_cdbttree_chi2->GetFloatValue(key, m_fieldname_chi2);
+      fraction_badChi2 = m_fraction_badChi2[channel];
     }
     if (m_doTime)
     {
-      mean_time = m_cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      mean_time = m_mean_time[channel];
     }
     if (m_doHotMap)
     {
-      hotMap_val = m_cdbttree_hotMap->GetIntValue(key, m_fieldname_hotMap);
+      hotMap_val = m_hotMap[channel];
     }
     float chi2 = m_raw_towers->get_tower_at_channel(channel)->get_chi2();
     float time = m_raw_towers->get_tower_at_channel(channel)->get_time_float();
@@ -216,6 +224,39 @@ int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void CaloTowerStatus::FillCalibValues()
+{
+  // resolve each field once, then look up the tower keys in the columns
+  unsigned int ntowers = m_raw_towers->size();
+  m_fraction_badChi2.assign(ntowers, 0);
+  m_mean_time.assign(ntowers, 0);
+  m_hotMap.assign(ntowers, 0);
+  if (m_doHotChi2)
+  {
+    const CDBTTree::Column<float> &column = m_cdbttree_chi2->GetFloatColumn(m_fieldname_chi2);
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      m_fraction_badChi2[channel] = column.Get(m_raw_towers->encode_key(channel));
+    }
+  }
+  if (m_doTime)
+  {
+    const CDBTTree::Column<float> &column = m_cdbttree_time->GetFloatColumn(m_fieldname_time);
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      m_mean_time[channel] = column.Get(m_raw_towers->encode_key(channel));
+    }
+  }
+  if (m_doHotMap)
+  {
+    const CDBTTree::Column<int> &column = m_cdbttree_hotMap->GetIntColumn(m_fieldname_hotMap);
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      m_hotMap[channel] = column.Get(m_raw_towers->encode_key(channel));
+    }
+  }
+}
+
 void CaloTowerStatus::CreateNodeTree(PHCompositeNode *topNode)
 {
   std::string RawTowerNodeName = m_inputNodePrefix + m_detector;
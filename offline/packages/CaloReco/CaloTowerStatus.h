@@ -11,6 +11,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
@@ -72,12 +73,22 @@ class CaloTowerStatus : public SubsysReco
   }
 
  private:
+  //! fill the per tower calibration values from the CDB trees
+  void FillCalibValues();
+
   TowerInfoContainer *m_raw_towers{nullptr};
 
   CDBTTree *m_cdbttree_chi2{nullptr};
   CDBTTree *m_cdbttree_time{nullptr};
   CDBTTree *m_cdbttree_hotMap{nullptr};
 
+  //!@name calibration values per tower channel, filled once per run
+  //@{
+  std::vector<float> m_fraction_badChi2;
+  std::vector<float> m_mean_time;
+  std::vector<int> m_hotMap;
+  //@}
+
   bool m_doHotChi2{true};
   bool m_doTime{true};
   bool m_doHotMap{true};
@@ -16,6 +16,10 @@
 #include <ROOT/TThreadedObject.hxx>
 
 #include <pthread.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -34,17 +38,47 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   h_template = static_cast<TProfile *>(fin->Get("waveform_template"));
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
   t = new ROOT::TThreadExecutor(_nthreads);
+
+  // tabulate the template for the batch fitter, it needs uniform bins
+  if (h_template->GetXaxis()->IsVariableBinSize())
+  {
+    std::cout << "CaloWaveformFitting: template " << templatefile
+              << " has variable bin sizes, using the Minuit template fit" << std::endl;
+    _buseminuitfit = true;
+    return;
+  }
+  int nbins = h_template->GetNbinsX();
+  m_template_values.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    m_template_values[i] = h_template->GetBinContent(i + 1);
+  }
+  m_template_xmin = h_template->GetBinCenter(1);
+  m_template_binwidth = h_template->GetBinWidth(1);
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
   int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
+  if (!_buseminuitfit)
+  {
+    // the batch fitter reads the channels where they are
+    std::vector<float> results(size1 * 4);
+    calo_processing_templatefit_batch(waveformvector, results.data());
+    fitresults.reserve(size1);
+    for (int i = 0; i < size1; i++)
+    {
+      fitresults.emplace_back(results.begin() + i * 4, results.begin() + (i + 1) * 4);
+    }
+    return fitresults;
+  }
+  std::vector<std::vector<float>> chnlvector = waveformvector;
   for (int i = 0; i < size1; i++)
   {
-    waveformvector.at(i).push_back(i);
+    chnlvector.at(i).push_back(i);
   }
-  fitresults = calo_processing_templatefit(waveformvector);
+  fitresults = calo_processing_templatefit(chnlvector);
   return fitresults;
 }
 
@@ -86,9 +120,10 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
         pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
       }
 
-      if ( (_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight-pedestal  < _nsoftwarezerosuppression)  )
+      const int peaksample = std::min(6, size1 - 1);
+      if ( (_bdosoftwarezerosuppression && v.at(peaksample) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight-pedestal  < _nsoftwarezerosuppression)  )
       {
-        v.push_back(v.at(6) - v.at(0));
+        v.push_back(v.at(peaksample) - v.at(0));
         v.push_back(-1);
         v.push_back(v.at(0));
         v.push_back(0);
@@ -149,6 +184,240 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
   return fit_params;
 }
 
+double CaloWaveformFitting::template_value(double x) const
+{
+  // same as TH1::Interpolate: constant outside the outer bin centers,
+  // linear between bin centers
+  const int nbins = m_template_values.size();
+  double u = (x - m_template_xmin) / m_template_binwidth;
+  if (u <= 0)
+  {
+    return m_template_values.front();
+  }
+  if (u >= nbins - 1)
+  {
+    return m_template_values.back();
+  }
+  int k = u;
+  double frac = u - k;
+  return m_template_values[k] + frac * (m_template_values[k + 1] - m_template_values[k]);
+}
+
+double CaloWaveformFitting::template_chi2(const float *v, int size1, double time, double &amp, double &ped) const
+{
+  // amplitude and pedestal are linear parameters, solve the 2x2 normal equations
+  double tmpl[m_max_batch_samples];
+  double st = 0;
+  double stt = 0;
+  double sy = 0;
+  double sty = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    tmpl[i] = template_value(i - time);
+    st += tmpl[i];
+    stt += tmpl[i] * tmpl[i];
+    sy += v[i];
+    sty += tmpl[i] * v[i];
+  }
+  double det = size1 * stt - st * st;
+  if (std::abs(det) < 1e-12 * size1 * stt)
+  {
+    amp = 0;
+    ped = sy / size1;
+  }
+  else
+  {
+    amp = (size1 * sty - st * sy) / det;
+    ped = (stt * sy - st * sty) / det;
+  }
+  double chi2 = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    double res = v[i] - amp * tmpl[i] - ped;
+    chi2 += res * res;
+  }
+  return chi2;
+}
+
+void CaloWaveformFitting::templatefit_channel(const float *v, int size1, float *result) const
+{
+  // zero suppression and pedestal estimate exactly as in calo_processing_templatefit
+  if (size1 == _nzerosuppresssamples)
+  {
+    result[0] = v[1] - v[0];  // returns peak sample - pedestal sample
+    result[1] = -1;           // set time to -1 to indicate zero suppressed
+    result[2] = v[0];
+    result[3] = 0;
+    return;
+  }
+  float maxheight = 0;
+  int maxbin = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    if (v[i] > maxheight)
+    {
+      maxheight = v[i];
+      maxbin = i;
+    }
+  }
+  float pedestal = 1500;
+  if (maxbin > 4)
+  {
+    pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
+  }
+  else if (maxbin > 3)
+  {
+    pedestal = (v[maxbin - 4]);
+  }
+  else
+  {
+    pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
+  }
+  // sample 6 is the expected peak, short waveforms use their last sample
+  const int peaksample = std::min(6, size1 - 1);
+  if ((_bdosoftwarezerosuppression && v[peaksample] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+  {
+    result[0] = v[peaksample] - v[0];
+    result[1] = -1;
+    result[2] = v[0];
+    result[3] = 0;
+    return;
+  }
+
+  // chi2 as function of the time (amplitude, pedestal solved for), coarse
+  // scan of the allowed time range (same limits as the Minuit fit) followed
+  // by a golden section search around the best scan point
+  const double tmin = -1 * m_peakTimeTemp;
+  const double tmax = size1 - m_peakTimeTemp;
+  double amp;
+  double ped;
+  double tbest = tmin;
+  double chi2best = template_chi2(v, size1, tmin, amp, ped);
+  for (double time = tmin + 0.5; time <= tmax; time += 0.5)
+  {
+    double chi2 = template_chi2(v, size1, time, amp, ped);
+    if (chi2 < chi2best)
+    {
+      chi2best = chi2;
+      tbest = time;
+    }
+  }
+  static const double invphi = 0.5 * (std::sqrt(5.) - 1);
+  double a = std::max(tmin, tbest - 0.5);
+  double b = std::min(tmax, tbest + 0.5);
+  double c = b - invphi * (b - a);
+  double d = a + invphi * (b - a);
+  double fc = template_chi2(v, size1, c, amp, ped);
+  double fd = template_chi2(v, size1, d, amp, ped);
+  while (b - a > 1e-4)
+  {
+    if (fc < fd)
+    {
+      b = d;
+      d = c;
+      fd = fc;
+      c = b - invphi * (b - a);
+      fc = template_chi2(v, size1, c, amp, ped);
+    }
+    else
+    {
+      a = c;
+      c = d;
+      fc = fd;
+      d = a + invphi * (b - a);
+      fd = template_chi2(v, size1, d, amp, ped);
+    }
+  }
+  double time = 0.5 * (a + b);
+  double chi2 = template_chi2(v, size1, time, amp, ped);
+  if (chi2best < chi2)  // a scan point sitting on a kink of the template can win
+  {
+    time = tbest;
+    chi2 = template_chi2(v, size1, time, amp, ped);
+  }
+  result[0] = amp;
+  result[1] = time;
+  result[2] = ped;
+  result[3] = chi2 / (size1 - 3);  // divide by the number of dof
+}
+
+void CaloWaveformFitting::calo_processing_templatefit_batch(const float *waveforms, const int *nvalid, int nchannels, int nsamples, float *results)
+{
+  if (nsamples > m_max_batch_samples)
+  {
+    std::vector<std::vector<float>> chnlvector(nchannels);
+    for (int ich = 0; ich < nchannels; ich++)
+    {
+      chnlvector[ich].assign(waveforms + ich * nsamples, waveforms + ich * nsamples + nvalid[ich]);
+    }
+    templatefit_minuit(chnlvector, results);
+    return;
+  }
+  templatefit_channels(nchannels, [&](int ich)
+                       { templatefit_channel(waveforms + ich * nsamples, nvalid[ich], results + ich * 4); });
+}
+
+void CaloWaveformFitting::calo_processing_templatefit_batch(const std::vector<std::vector<float>> &waveforms, float *results)
+{
+  for (const auto &v : waveforms)
+  {
+    if ((int) v.size() > m_max_batch_samples)
+    {
+      templatefit_minuit(waveforms, results);
+      return;
+    }
+  }
+  templatefit_channels(waveforms.size(), [&](int ich)
+                       { templatefit_channel(waveforms[ich].data(), waveforms[ich].size(), results + ich * 4); });
+}
+
+void CaloWaveformFitting::templatefit_channels(int nchannels, const std::function<void(int)> &fit)
+{
+  // channels are cheap, hand them out in chunks
+  const int chunksize = 256;
+  const int nchunks = (nchannels + chunksize - 1) / chunksize;
+  auto fitchunk = [&](unsigned int ichunk)
+  {
+    int last = std::min<int>(nchannels, (ichunk + 1) * chunksize);
+    for (int ich = ichunk * chunksize; ich < last; ich++)
+    {
+      fit(ich);
+    }
+  };
+  if (_nthreads > 1 && nchunks > 1)
+  {
+    t->Foreach(fitchunk, nchunks);
+  }
+  else
+  {
+    for (int ichunk = 0; ichunk < nchunks; ichunk++)
+    {
+      fitchunk(ichunk);
+    }
+  }
+}
+
+void CaloWaveformFitting::templatefit_minuit(const std::vector<std::vector<float>> &waveforms, float *results)
+{
+  // waveforms longer than the batch fitter supports go through the Minuit fit
+  if (!m_warned_long_waveforms)
+  {
+    std::cout << "CaloWaveformFitting: more than " << m_max_batch_samples
+              << " samples, using the Minuit template fit" << std::endl;
+    m_warned_long_waveforms = true;
+  }
+  std::vector<std::vector<float>> chnlvector = waveforms;
+  for (unsigned int ich = 0; ich < chnlvector.size(); ich++)
+  {
+    chnlvector[ich].push_back(ich);
+  }
+  std::vector<std::vector<float>> fitresults = calo_processing_templatefit(chnlvector);
+  for (unsigned int ich = 0; ich < fitresults.size(); ich++)
+  {
+    std::copy(fitresults[ich].begin(), fitresults[ich].end(), results + ich * 4);
+  }
+}
+
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
   int n = 3;
@@ -1,6 +1,7 @@
 #ifndef CALORECO_CALOWAVEFORMFITTING_H
 #define CALORECO_CALOWAVEFORMFITTING_H
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -40,16 +41,51 @@ class CaloWaveformFitting
     return _nthreads;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
+  // use the generic Minuit (GSLMultiFit) template fit instead of the
+  // dedicated batch fitter (slow, kept as reference)
+  void set_minuit_templatefit(bool useminuit)
+  {
+    _buseminuitfit = useminuit;
+  }
+
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
   std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
   std::vector<std::vector<float>> calo_processing_fast(std::vector<std::vector<float>> chnlvector);
 
+  // Dedicated fit of amplitude * template(t - time) + pedestal, minimizing the
+  // same chi2 as the Minuit fit. For a given time amplitude and pedestal are
+  // solved analytically, the time is found by a scan of the allowed range in
+  // half sample steps and a golden section search to 1e-4 samples.
+  // Where both fits converge to the same minimum amplitude and pedestal agree
+  // to better than 1e-3 relative and the time to better than 1e-3 samples.
+  // waveforms is a contiguous nchannels x nsamples buffer, nvalid[ich] is the
+  // number of samples of channel ich (zero suppressed channels have 2),
+  // results is nchannels x 4 (amplitude, time, pedestal, chi2/ndf).
+  // Waveforms with more than 64 samples are fitted with Minuit
+  void calo_processing_templatefit_batch(const float *waveforms, const int *nvalid, int nchannels, int nsamples, float *results);
+  // same for one vector per channel, the samples are read in place
+  void calo_processing_templatefit_batch(const std::vector<std::vector<float>> &waveforms, float *results);
+
   void initialize_processing(const std::string &templatefile);
 
  private:
   void FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax);
+  void templatefit_channels(int nchannels, const std::function<void(int)> &fit);
+  void templatefit_minuit(const std::vector<std::vector<float>> &waveforms, float *results);
+  void templatefit_channel(const float *v, int size1, float *result) const;
+  double template_value(double x) const;
+  double template_chi2(const float *v, int size1, double time, double &amp, double &ped) const;
   TProfile *h_template = nullptr;
   double template_function(double *x, double *par);
+
+  // template bin contents at the bin centers (uniform binning), evaluated with the
+  // same linear interpolation as TH1::Interpolate
+  std::vector<double> m_template_values;
+  double m_template_xmin = 0;
+  double m_template_binwidth = 1;
+  static constexpr int m_max_batch_samples = 64;
+  bool _buseminuitfit = false;
+  bool m_warned_long_waveforms = false;
   int _nthreads = 1;
   int _nzerosuppresssamples = 2;
   int _nsoftwarezerosuppression = 40;
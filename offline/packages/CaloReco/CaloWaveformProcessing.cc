@@ -30,6 +30,10 @@ void CaloWaveformProcessing::initialize_processing()
     m_Fitter = new CaloWaveformFitting();
     m_Fitter->initialize_processing(url_template);
     m_Fitter->set_nthreads(get_nthreads());
+    if (_buseminuitfit)
+    {
+      m_Fitter->set_minuit_templatefit(true);
+    }
 
     if (_bdosoftwarezerosuppression == true)
       {
@@ -44,17 +48,12 @@ void CaloWaveformProcessing::initialize_processing()
   }
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
-  int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE)
   {
-    for (int i = 0; i < size1; i++)
-    {
-      waveformvector.at(i).push_back(i);
-    }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+    fitresults = m_Fitter->process_waveform(waveformvector);
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -67,13 +66,13 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
   return fitresults;
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
+    const std::vector<float> &v = chnlvector.at(m);
     int nsamples = v.size() - 1;
     std::vector<float> vtmp;
     vtmp.reserve(nsamples);
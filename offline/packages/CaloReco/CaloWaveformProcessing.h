@@ -61,8 +61,11 @@ class CaloWaveformProcessing : public SubsysReco
   }
 
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
-  std::vector<std::vector<float>> calo_processing_ONNX(std::vector<std::vector<float>> chnlvector);
+  // use the generic Minuit template fit instead of the batch fitter
+  void set_minuit_templatefit(bool useminuit) { _buseminuitfit = useminuit; }
+
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+  std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing();
 
@@ -73,6 +76,7 @@ class CaloWaveformProcessing : public SubsysReco
   int _nthreads = 1;
   int _nsoftwarezerosuppression = 40;
   bool _bdosoftwarezerosuppression = false;
+  bool _buseminuitfit = false;
 
   std::string m_template_input_file;
   std::string url_template;
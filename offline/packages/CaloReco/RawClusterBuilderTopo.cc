@@ -17,6 +17,7 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -26,8 +27,7 @@
 #include <exception>
 #include <iostream>
 #include <iterator>  // for begin, end
-#include <list>
-#include <memory>  // for allocator_traits<>::valu...
+#include <memory>    // for make_unique
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -195,26 +195,65 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
   return adjacent_towers;
 }
 
-void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &original_towers)
+void RawClusterBuilderTopo::build_neighbor_table()
+{
+  // tower IDs go up to the last EMCal tower, see get_ID
+  const int n_IDs = get_ID(2, _EMCAL_NETA - 1, _EMCAL_NPHI - 1) + 1;
+
+  _neighbor_offsets.assign(n_IDs + 1, 0);
+  _neighbor_IDs.clear();
+  for (int ID = 0; ID < n_IDs; ++ID)
+  {
+    _neighbor_offsets[ID] = _neighbor_IDs.size();
+
+    // skip IDs between the last HCal tower and the first EMCal tower
+    const bool valid = ID < 2 * _HCAL_NETA * _HCAL_NPHI || ID >= _EMCAL_NETA * _EMCAL_NPHI;
+    if (!valid)
+    {
+      continue;
+    }
+
+    const std::vector<int> adjacent_towers = get_adjacent_towers_by_ID(ID);
+    _neighbor_IDs.insert(_neighbor_IDs.end(), adjacent_towers.begin(), adjacent_towers.end());
+  }
+  _neighbor_offsets[n_IDs] = _neighbor_IDs.size();
+
+  _tower_E.assign(n_IDs, 0);
+  _tower_key.assign(n_IDs, 0);
+  _tower_status.assign(n_IDs, -2);
+  _tower_ownership.assign(n_IDs, std::pair<int, int>(-1, -1));
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "RawClusterBuilderTopo::build_neighbor_table: " << _neighbor_IDs.size() << " neighbors for " << n_IDs << " tower IDs" << std::endl;
+  }
+}
+
+void RawClusterBuilderTopo::set_single_cluster(const std::vector<int> &original_towers, ClusterSplit &split)
 {
   if (Verbosity() > 2)
   {
-    std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl;
+    std::cout << "RawClusterBuilderTopo::set_single_cluster called " << std::endl;
   }
 
-  std::map<int, std::pair<int, int> > tower_ownership;
   for (const int &original_tower : original_towers)
   {
-    tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
+    _tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
   }
-  export_clusters(original_towers, tower_ownership, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
-
-  return;
+  split.n_clusters = 1;
+  split.pseudocluster_sumE.clear();
+  split.pseudocluster_eta.clear();
+  split.pseudocluster_phi.clear();
 }
 
-void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, std::map<int, std::pair<int, int> > tower_ownership, unsigned int n_clusters, std::vector<float> pseudocluster_sumE, std::vector<float> pseudocluster_eta, std::vector<float> pseudocluster_phi)
+void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, const ClusterSplit &split)
 {
-  if (n_clusters != 1)  // if we didn't just pass down from export_single_cluster
+  const unsigned int n_clusters = split.n_clusters;
+  const std::vector<float> &pseudocluster_sumE = split.pseudocluster_sumE;
+  const std::vector<float> &pseudocluster_eta = split.pseudocluster_eta;
+  const std::vector<float> &pseudocluster_phi = split.pseudocluster_phi;
+
+  if (n_clusters != 1)  // if we didn't just pass down from set_single_cluster
   {
     if (Verbosity() > 2)
     {
@@ -222,55 +261,41 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
     }
   }
   // build a RawCluster for output
-  std::vector<RawCluster *> clusters;
-  std::vector<float> clusters_E;
-  std::vector<float> clusters_x;
-  std::vector<float> clusters_y;
-  std::vector<float> clusters_z;
+  // energy and energy weighted x, y, z sums
+  std::vector<RawCluster *> &clusters = _export_clusters;
+  std::vector<std::array<float, 4> > &sums = _export_sums;
+  clusters.clear();
+  sums.assign(n_clusters, {0, 0, 0, 0});
 
   for (unsigned int pc = 0; pc < n_clusters; pc++)
   {
     clusters.push_back(new RawClusterv1());
-    clusters_E.push_back(0);
-    clusters_x.push_back(0);
-    clusters_y.push_back(0);
-    clusters_z.push_back(0);
   }
 
   for (int original_tower : original_towers)
   {
     int this_ID = original_tower;
-    std::pair<int, int> the_pair = tower_ownership[this_ID];
+    std::pair<int, int> the_pair = _tower_ownership[this_ID];
 
     if (Verbosity() > 5)
     {
       std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << original_tower << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
     }
-    int this_ieta = get_ieta_from_ID(this_ID);
-    int this_iphi = get_iphi_from_ID(this_ID);
     int this_layer = get_ilayer_from_ID(this_ID);
     float this_E = get_E_from_ID(this_ID);
-
-    int this_key = 0;
-    if (this_layer == 2)
-    {
-      this_key = _EMTOWERMAP_KEY_ETA_PHI[this_ieta][this_iphi];
-    }
-    else
-    {
-      this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[this_layer][this_ieta][this_iphi];
-    }
+    int this_key = _tower_key[this_ID];
 
     RawTowerGeom *tower_geom = _geom_containers[this_layer]->get_tower_geometry(this_key);
 
     if (the_pair.second == -1)
     {
       // assigned only to one cluster, easy
+      auto &sum = sums[the_pair.first];
       clusters[the_pair.first]->addTower(this_key, this_E);
-      clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E;
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + this_E * tower_geom->get_center_x();
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + this_E * tower_geom->get_center_y();
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + this_E * tower_geom->get_center_z();
+      sum[0] = sum[0] + this_E;
+      sum[1] = sum[1] + this_E * tower_geom->get_center_x();
+      sum[2] = sum[2] + this_E * tower_geom->get_center_y();
+      sum[3] = sum[3] + this_E * tower_geom->get_center_z();
 
       if (Verbosity() > 5)
       {
@@ -289,17 +314,19 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
       {
         std::cout << " tower ID " << this_ID << " has dR1 = " << dR1 << " to pseudocluster " << the_pair.first << " , and dR2 = " << dR2 << " to pseudocluster " << the_pair.second << ", so frac1 = " << frac1 << std::endl;
       }
+      auto &sum1 = sums[the_pair.first];
       clusters[the_pair.first]->addTower(this_key, this_E * frac1);
-      clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E * frac1;
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + this_E * tower_geom->get_center_x() * frac1;
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + this_E * tower_geom->get_center_y() * frac1;
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + this_E * tower_geom->get_center_z() * frac1;
+      sum1[0] = sum1[0] + this_E * frac1;
+      sum1[1] = sum1[1] + this_E * tower_geom->get_center_x() * frac1;
+      sum1[2] = sum1[2] + this_E * tower_geom->get_center_y() * frac1;
+      sum1[3] = sum1[3] + this_E * tower_geom->get_center_z() * frac1;
 
+      auto &sum2 = sums[the_pair.second];
       clusters[the_pair.second]->addTower(this_key, this_E * (1 - frac1));
-      clusters_E[the_pair.second] = clusters_E[the_pair.second] + this_E * (1 - frac1);
-      clusters_x[the_pair.second] = clusters_x[the_pair.second] + this_E * tower_geom->get_center_x() * (1 - frac1);
-      clusters_y[the_pair.second] = clusters_y[the_pair.second] + this_E * tower_geom->get_center_y() * (1 - frac1);
-      clusters_z[the_pair.second] = clusters_z[the_pair.second] + this_E * tower_geom->get_center_z() * (1 - frac1);
+      sum2[0] = sum2[0] + this_E * (1 - frac1);
+      sum2[1] = sum2[1] + this_E * tower_geom->get_center_x() * (1 - frac1);
+      sum2[2] = sum2[2] + this_E * tower_geom->get_center_y() * (1 - frac1);
+      sum2[3] = sum2[3] + this_E * tower_geom->get_center_z() * (1 - frac1);
     }
   }
 
@@ -307,11 +334,12 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
 
   for (unsigned int cl = 0; cl < n_clusters; cl++)
   {
-    clusters[cl]->set_energy(clusters_E[cl]);
+    const auto &sum = sums[cl];
+    clusters[cl]->set_energy(sum[0]);
 
-    float mean_x = clusters_x[cl] / clusters_E[cl];
-    float mean_y = clusters_y[cl] / clusters_E[cl];
-    float mean_z = clusters_z[cl] / clusters_E[cl];
+    float mean_x = sum[1] / sum[0];
+    float mean_y = sum[2] / sum[0];
+    float mean_z = sum[3] / sum[0];
 
     clusters[cl]->set_r(std::sqrt(mean_y * mean_y + mean_x * mean_x));
     clusters[cl]->set_phi(std::atan2(mean_y, mean_x));
@@ -321,7 +349,7 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
 
     if (Verbosity() > 1)
     {
-      std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " << clusters_E[cl] << ", eta = " << -1 * log(tan(std::atan2(std::sqrt(mean_y * mean_y + mean_x * mean_x), mean_z) / 2.0)) << ", phi = " << std::atan2(mean_y, mean_x) << std::endl;
+      std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " << sum[0] << ", eta = " << -1 * log(tan(std::atan2(std::sqrt(mean_y * mean_y + mean_x * mean_x), mean_z) / 2.0)) << ", phi = " << std::atan2(mean_y, mean_x) << std::endl;
     }
   }
 
@@ -361,6 +389,8 @@ RawClusterBuilderTopo::RawClusterBuilderTopo(const std::string &name)
   ClusterNodeName = "TOPOCLUSTER_HCAL";
 }
 
+RawClusterBuilderTopo::~RawClusterBuilderTopo() = default;
+
 int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
 {
   try
@@ -373,6 +403,12 @@ int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
     throw;
   }
 
+  if (!_threadpool)
+  {
+    _threadpool = std::make_unique<PHThreadPool>(_num_threads);
+    _split_buffers.resize(_threadpool->size());
+  }
+
   if (Verbosity() > 0)
   {
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with EMCal enable = " << _enable_EMCal << " and I+OHCal enable = " << _enable_HCal << std::endl;
@@ -381,11 +417,57 @@ int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with allow_corner_neighbor = " << _allow_corner_neighbor << " (in HCal)" << std::endl;
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with do_split = " << _do_split << " , R_shower = " << _R_shower << " (angular units) " << std::endl;
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with minE for local max in EMCal / IHCal / OHCal = " << _local_max_minE_LAYER[2] << " / " << _local_max_minE_LAYER[0] << " / " << _local_max_minE_LAYER[1] << std::endl;
+    std::cout << "RawClusterBuilderTopo::InitRun: initialized with " << _threadpool->size() << " threads" << std::endl;
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void RawClusterBuilderTopo::fill_towers(TowerInfoContainer *towerinfos, int ilayer, std::vector<std::pair<int, float> > &seeds)
+{
+  static const RawTowerDefs::CalorimeterId calo_ids[3] = {RawTowerDefs::CalorimeterId::HCALIN, RawTowerDefs::CalorimeterId::HCALOUT, RawTowerDefs::CalorimeterId::CEMC};
+  static const char *calo_names[3] = {"IHCal", "OHCal", "EMCal"};
+
+  seeds.clear();
+
+  RawTowerGeomContainer *geom = _geom_containers[ilayer];
+  TowerInfo *towerInfo = nullptr;
+  for (unsigned int channel = 0; channel < towerinfos->size(); channel++)
+  {
+    towerInfo = towerinfos->get_tower_at_channel(channel);
+    unsigned int towerinfo_key = towerinfos->encode_key(channel);
+    int ti_ieta = towerinfos->getTowerEtaBin(towerinfo_key);
+    int ti_iphi = towerinfos->getTowerPhiBin(towerinfo_key);
+    const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(calo_ids[ilayer], ti_ieta, ti_iphi);
+
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
+
+    int ieta = geom->get_etabin(tower_geom->get_eta());
+    int iphi = geom->get_phibin(tower_geom->get_phi());
+    float this_E = towerInfo->get_energy();
+
+    if (this_E < 1.E-10)
+    {
+      continue;
+    }
+
+    int ID = get_ID(ilayer, ieta, iphi);
+    _tower_status[ID] = -1;  // change status to unknown
+    _tower_E[ID] = this_E;
+    _tower_key[ID] = key;
+
+    if (this_E > _sigma_seed * _noise_LAYER[ilayer])
+    {
+      seeds.emplace_back(ID, this_E);
+      if (Verbosity() > 10)
+      {
+        std::cout << "RawClusterBuilderTopo::process_event: adding " << calo_names[ilayer] << " tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
+        std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
+      };
+    }
+  }
+}
+
 int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 {
   TowerInfoContainer *towerinfosEM = findNode::getClass<TowerInfoContainer>(topNode, "TOWERINFO_CALIB_CEMC");
@@ -445,160 +527,40 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     _EMCAL_NETA = _geom_containers[2]->get_etabins();
     _EMCAL_NPHI = _geom_containers[2]->get_phibins();
 
-    _EMTOWERMAP_STATUS_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, -2));
-    _EMTOWERMAP_KEY_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, 0));
-    _EMTOWERMAP_E_ETA_PHI.resize(_EMCAL_NETA, std::vector<float>(_EMCAL_NPHI, 0));
-  }
-
-  if (_HCAL_NETA < 0)
-  {
-    // define geometry only once if it has not been yet
     _HCAL_NETA = _geom_containers[1]->get_etabins();
     _HCAL_NPHI = _geom_containers[1]->get_phibins();
 
-    _TOWERMAP_STATUS_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, -2)));
-    _TOWERMAP_KEY_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0)));
-    _TOWERMAP_E_LAYER_ETA_PHI.resize(2, std::vector<std::vector<float> >(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0)));
+    build_neighbor_table();
   }
 
   // reset maps
   // but note -- do not reset keys!
-  for (int ieta = 0; ieta < _EMCAL_NETA; ieta++)
-  {
-    for (int iphi = 0; iphi < _EMCAL_NPHI; iphi++)
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -2;  // set tower does not exist
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = 0;        // set zero energy
-    }
-  }
-  for (int ilayer = 0; ilayer < 2; ilayer++)
-  {
-    for (int ieta = 0; ieta < _HCAL_NETA; ieta++)
-    {
-      for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-      {
-        _TOWERMAP_STATUS_LAYER_ETA_PHI[ilayer][ieta][iphi] = -2;  // set tower does not exist
-        _TOWERMAP_E_LAYER_ETA_PHI[ilayer][ieta][iphi] = 0;        // set zero energy
-      }
-    }
-  }
-
-  // setup
-  std::vector<std::pair<int, float> > list_of_seeds;
+  std::fill(_tower_status.begin(), _tower_status.end(), -2);  // set tower does not exist
+  std::fill(_tower_E.begin(), _tower_E.end(), 0);             // set zero energy
 
   // translate towers to our internal representation
+  // calorimeters fill disjoint ranges of the tower maps, and are translated concurrently
+  // seeds are collected in EMCal, IHCal, OHCal order, independently of the number of threads
+  std::vector<std::pair<TowerInfoContainer *, int> > calorimeters;
   if (_enable_EMCal)
   {
-    TowerInfo *towerInfo = nullptr;
-    for (unsigned int iEM = 0; iEM < towerinfosEM->size(); iEM++)
-    {
-      towerInfo = towerinfosEM->get_tower_at_channel(iEM);
-      unsigned int towerinfo_key = towerinfosEM->encode_key(iEM);
-      int ti_ieta = towerinfosEM->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosEM->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[2]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[2]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[2]->get_phibin(tower_geom->get_phi());
-      float this_E = towerInfo->get_energy();
-
-      if (this_E < 1.E-10)
-      {
-        continue;
-      }
-
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -1;  // change status to unknown
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = this_E;
-      _EMTOWERMAP_KEY_ETA_PHI[ieta][iphi] = key;
-
-      if (this_E > _sigma_seed * _noise_LAYER[2])
-      {
-        int ID = get_ID(2, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding EMCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
+    calorimeters.emplace_back(towerinfosEM, 2);
   }
-
-  // translate towers to our internal representation
   if (_enable_HCal)
   {
-    TowerInfo *towerInfo = nullptr;
-    for (unsigned int iIH = 0; iIH < towerinfosIH->size(); iIH++)
-    {
-      towerInfo = towerinfosIH->get_tower_at_channel(iIH);
-      unsigned int towerinfo_key = towerinfosIH->encode_key(iIH);
-      int ti_ieta = towerinfosIH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosIH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[0]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[0]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[0]->get_phibin(tower_geom->get_phi());
-      float this_E = towerInfo->get_energy();
-
-      if (this_E < 1.E-10)
-      {
-        continue;
-      }
-
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[0][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[0][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[0][ieta][iphi] = key;
-
-      if (this_E > _sigma_seed * _noise_LAYER[0])
-      {
-        int ID = get_ID(0, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding IHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
-
-    for (unsigned int iOH = 0; iOH < towerinfosOH->size(); iOH++)
-    {
-      towerInfo = towerinfosOH->get_tower_at_channel(iOH);
-      unsigned int towerinfo_key = towerinfosOH->encode_key(iOH);
-      int ti_ieta = towerinfosOH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosOH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[1]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[1]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[1]->get_phibin(tower_geom->get_phi());
-      float this_E = towerInfo->get_energy();
-
-      if (this_E < 1.E-10)
-      {
-        continue;
-      }
+    calorimeters.emplace_back(towerinfosIH, 0);
+    calorimeters.emplace_back(towerinfosOH, 1);
+  }
 
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[1][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[1][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[1][ieta][iphi] = key;
+  _threadpool->parallel_for(calorimeters.size(), [this, &calorimeters](size_t task, unsigned int /*thread*/)
+                            { fill_towers(calorimeters[task].first, calorimeters[task].second, _layer_seeds[calorimeters[task].second]); });
 
-      if (this_E > _sigma_seed * _noise_LAYER[1])
-      {
-        int ID = get_ID(1, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding OHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
+  std::vector<std::pair<int, float> > &list_of_seeds = _list_of_seeds;
+  list_of_seeds.clear();
+  for (const auto &calorimeter : calorimeters)
+  {
+    const auto &seeds = _layer_seeds[calorimeter.second];
+    list_of_seeds.insert(list_of_seeds.end(), seeds.begin(), seeds.end());
   }
 
   if (Verbosity() > 10)
@@ -626,16 +588,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   int cluster_index = 0;  // begin counting clusters
 
-  std::vector<std::vector<int> > all_cluster_towers;  // store final cluster tower lists here
+  // final cluster tower lists are stored in _cluster_towers[0 ... cluster_index-1]
+  // the lists are reused from one event to the next
 
-  while (list_of_seeds.size() > 0)
+  for (unsigned int iseed = 0; iseed < list_of_seeds.size(); ++iseed)
   {
-    int seed_ID = list_of_seeds.at(0).first;
-    list_of_seeds.erase(list_of_seeds.begin());
+    int seed_ID = list_of_seeds[iseed].first;
 
     if (Verbosity() > 5)
     {
-      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() << std::endl;
+      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() - iseed - 1 << std::endl;
     }
 
     // if this seed was already claimed by some other seed during its growth, remove it and do nothing
@@ -652,10 +614,17 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // this seed tower now owned by new cluster
     set_status_by_ID(seed_ID, cluster_index);
 
-    std::vector<int> cluster_tower_ID;
+    if (static_cast<int>(_cluster_towers.size()) <= cluster_index)
+    {
+      _cluster_towers.emplace_back();
+    }
+    std::vector<int> &cluster_tower_ID = _cluster_towers[cluster_index];
+    cluster_tower_ID.clear();
     cluster_tower_ID.push_back(seed_ID);
 
-    std::vector<int> grow_tower_ID;
+    // towers are processed in the order in which they are added
+    std::vector<int> &grow_tower_ID = _grow_tower_ID;
+    grow_tower_ID.clear();
     grow_tower_ID.push_back(seed_ID);
 
     // iteratively process growth towers, adding > 2 * sigma neighbors to the list for further checking
@@ -665,19 +634,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
     }
 
-    while (grow_tower_ID.size() > 0)
+    for (unsigned int igrow = 0; igrow < grow_tower_ID.size(); ++igrow)
     {
-      int grow_ID = grow_tower_ID.at(0);
-      grow_tower_ID.erase(grow_tower_ID.begin());
+      int grow_ID = grow_tower_ID[igrow];
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() << " grow towers left" << std::endl;
+        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() - igrow - 1 << " grow towers left" << std::endl;
       }
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(grow_ID);
-
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+      for (int this_adjacent_tower_ID : get_neighbors(grow_ID))
       {
         if (Verbosity() > 10)
         {
@@ -737,7 +703,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
+        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() - igrow - 1 << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
       }
     }
 
@@ -757,9 +723,8 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
       }
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(core_ID);
 
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+      for (int this_adjacent_tower_ID : get_neighbors(core_ID))
       {
         if (Verbosity() > 10)
         {
@@ -813,9 +778,6 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       }
     }
 
-    // keep track of these
-    all_cluster_towers.push_back(cluster_tower_ID);
-
     // increment cluster index for next one
     cluster_index++;
   }
@@ -825,593 +787,591 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     std::cout << "RawClusterBuilderTopo::process_event: " << cluster_index << " topo-clusters initially reconstructed, entering splitting step" << std::endl;
   }
 
-  int original_cluster_index = cluster_index;  // since it may be updated
-
   // now entering cluster splitting stage
+  // topo-clusters own disjoint sets of towers and are split concurrently, then exported in order
+  if (static_cast<int>(_cluster_splits.size()) < cluster_index)
+  {
+    _cluster_splits.resize(cluster_index);
+  }
+  _threadpool->parallel_for(cluster_index, [this](size_t cl, unsigned int thread)
+                            { split_cluster(cl, _split_buffers[thread], _cluster_splits[cl]); });
+
+  for (int cl = 0; cl < cluster_index; cl++)
+  {
+    export_clusters(_cluster_towers[cl], _cluster_splits[cl]);
+  }
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "RawClusterBuilderTopo::process_event after splitting (if any) final clusters output to node are: " << std::endl;
+    RawClusterContainer::ConstRange begin_end = _clusters->getClusters();
+    int ncl = 0;
+    for (RawClusterContainer::ConstIterator hiter = begin_end.first; hiter != begin_end.second; ++hiter)
+    {
+      std::cout << "-> #" << ncl++ << " ";
+      hiter->second->identify();
+      std::cout << std::endl;
+    }
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+void RawClusterBuilderTopo::split_cluster(int cl, SplitBuffers &buffers, ClusterSplit &split)
+{
+  const std::vector<int> &original_towers = _cluster_towers[cl];
+
+  if (!_do_split)
+  {
+    // don't run splitting, just export entire cluster as it is
+    if (Verbosity() > 2)
+    {
+      std::cout << "RawClusterBuilderTopo::process_event: splitting step disabled, cluster " << cl << " is final" << std::endl;
+    }
+    set_single_cluster(original_towers, split);
+    return;
+  }
 
-  for (int cl = 0; cl < original_cluster_index; cl++)
+  std::vector<std::pair<int, float> > &local_maxima_ID = buffers.local_maxima;
+  local_maxima_ID.clear();
+
+  // iterate through each tower, looking for maxima
+  for (int tower_ID : original_towers)
   {
-    std::vector<int> original_towers = all_cluster_towers.at(cl);
+    if (Verbosity() > 10)
+    {
+      std::cout << " -> examining tower ID " << tower_ID << " for possible local maximum " << std::endl;
+    }
 
-    if (!_do_split)
+    // check minimum energy
+    if (get_E_from_ID(tower_ID) < _local_max_minE_LAYER[get_ilayer_from_ID(tower_ID)])
     {
-      // don't run splitting, just export entire cluster as it is
-      if (Verbosity() > 2)
+      if (Verbosity() > 10)
       {
-        std::cout << "RawClusterBuilderTopo::process_event: splitting step disabled, cluster " << cluster_index << " is final" << std::endl;
+        std::cout << " -> -> energy E = " << get_E_from_ID(tower_ID) << " < " << _local_max_minE_LAYER[get_ilayer_from_ID(tower_ID)] << " too low" << std::endl;
       }
-      export_single_cluster(original_towers);
       continue;
     }
 
-    std::vector<std::pair<int, float> > local_maxima_ID;
+    // examine neighbors
+    int neighbors_in_cluster = 0;
 
-    // iterate through each tower, looking for maxima
-    for (int tower_ID : original_towers)
+    // check for higher neighbox
+    bool has_higher_neighbor = false;
+    for (int this_adjacent_tower_ID : get_neighbors(tower_ID))
     {
-      if (Verbosity() > 10)
+      if (get_status_from_ID(this_adjacent_tower_ID) != cl)
       {
-        std::cout << " -> examining tower ID " << tower_ID << " for possible local maximum " << std::endl;
+        continue;  // only consider neighbors in cluster, obviously
       }
 
-      // check minimum energy
-      if (get_E_from_ID(tower_ID) < _local_max_minE_LAYER[get_ilayer_from_ID(tower_ID)])
+      neighbors_in_cluster++;
+
+      if (get_E_from_ID(this_adjacent_tower_ID) > get_E_from_ID(tower_ID))
       {
         if (Verbosity() > 10)
         {
-          std::cout << " -> -> energy E = " << get_E_from_ID(tower_ID) << " < " << _local_max_minE_LAYER[get_ilayer_from_ID(tower_ID)] << " too low" << std::endl;
+          std::cout << " -> -> has higher-energy neighbor ID / E = " << this_adjacent_tower_ID << " / " << get_E_from_ID(this_adjacent_tower_ID) << std::endl;
         }
-        continue;
+        has_higher_neighbor = true;  // at this point we can break -- we won't need to count the number of good neighbors, since we won't even pass the E_neighbor test
+        break;
       }
+    }
 
-      // examine neighbors
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(tower_ID);
-      int neighbors_in_cluster = 0;
+    if (has_higher_neighbor)
+    {
+      continue;  // if we broke out, now continue
+    }
 
-      // check for higher neighbox
-      bool has_higher_neighbor = false;
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+    // check number of neighbors
+    if (neighbors_in_cluster < 4)
+    {
+      if (Verbosity() > 10)
       {
-        if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-        {
-          continue;  // only consider neighbors in cluster, obviously
-        }
-
-        neighbors_in_cluster++;
-
-        if (get_E_from_ID(this_adjacent_tower_ID) > get_E_from_ID(tower_ID))
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << " -> -> has higher-energy neighbor ID / E = " << this_adjacent_tower_ID << " / " << get_E_from_ID(this_adjacent_tower_ID) << std::endl;
-          }
-          has_higher_neighbor = true;  // at this point we can break -- we won't need to count the number of good neighbors, since we won't even pass the E_neighbor test
-          break;
-        }
+        std::cout << " -> -> too few neighbors N = " << neighbors_in_cluster << std::endl;
       }
+      continue;
+    }
 
-      if (has_higher_neighbor)
-      {
-        continue;  // if we broke out, now continue
-      }
+    local_maxima_ID.emplace_back(tower_ID, get_E_from_ID(tower_ID));
+  }
 
-      // check number of neighbors
-      if (neighbors_in_cluster < 4)
-      {
-        if (Verbosity() > 10)
-        {
-          std::cout << " -> -> too few neighbors N = " << neighbors_in_cluster << std::endl;
-        }
-        continue;
-      }
+  // check for possible EMCal-OHCal seed overlaps
+  for (unsigned int n = 0; n < local_maxima_ID.size(); n++)
+  {
+    // only look at I/OHCal local maxima
+    std::pair<int, float> this_LM = local_maxima_ID.at(n);
+    if (get_ilayer_from_ID(this_LM.first) == 2)
+    {
+      continue;
+    }
 
-      local_maxima_ID.emplace_back(tower_ID, get_E_from_ID(tower_ID));
+    float this_phi = _geom_containers[get_ilayer_from_ID(this_LM.first)]->get_phicenter(get_iphi_from_ID(this_LM.first));
+    if (this_phi > M_PI)
+    {
+      this_phi -= 2 * M_PI;
     }
+    float this_eta = _geom_containers[get_ilayer_from_ID(this_LM.first)]->get_etacenter(get_ieta_from_ID(this_LM.first));
+
+    bool has_EM_overlap = false;
 
-    // check for possible EMCal-OHCal seed overlaps
-    for (unsigned int n = 0; n < local_maxima_ID.size(); n++)
+    // check all other local maxima for overlaps
+    for (unsigned int n2 = 0; n2 < local_maxima_ID.size(); n2++)
     {
-      // only look at I/OHCal local maxima
-      std::pair<int, float> this_LM = local_maxima_ID.at(n);
-      if (get_ilayer_from_ID(this_LM.first) == 2)
+      if (n == n2)
+      {
+        continue;  // don't check the same one
+      }
+
+      // only look at EMCal local mazima
+      std::pair<int, float> this_LM2 = local_maxima_ID.at(n2);
+      if (get_ilayer_from_ID(this_LM2.first) != 2)
       {
         continue;
       }
 
-      float this_phi = _geom_containers[get_ilayer_from_ID(this_LM.first)]->get_phicenter(get_iphi_from_ID(this_LM.first));
-      if (this_phi > M_PI)
+      float this_phi2 = _geom_containers[get_ilayer_from_ID(this_LM2.first)]->get_phicenter(get_iphi_from_ID(this_LM2.first));
+      if (this_phi2 > M_PI)
       {
         this_phi -= 2 * M_PI;
       }
-      float this_eta = _geom_containers[get_ilayer_from_ID(this_LM.first)]->get_etacenter(get_ieta_from_ID(this_LM.first));
+      float this_eta2 = _geom_containers[get_ilayer_from_ID(this_LM2.first)]->get_etacenter(get_ieta_from_ID(this_LM2.first));
 
-      bool has_EM_overlap = false;
+      // calculate geometric dR
+      float dR = calculate_dR(this_eta, this_eta2, this_phi, this_phi2);
 
-      // check all other local maxima for overlaps
-      for (unsigned int n2 = 0; n2 < local_maxima_ID.size(); n2++)
+      // check for and report overlaps
+      if (dR < 0.15)
       {
-        if (n == n2)
+        has_EM_overlap = true;
+        if (Verbosity() > 2)
         {
-          continue;  // don't check the same one
-        }
-
-        // only look at EMCal local mazima
-        std::pair<int, float> this_LM2 = local_maxima_ID.at(n2);
-        if (get_ilayer_from_ID(this_LM2.first) != 2)
-        {
-          continue;
-        }
-
-        float this_phi2 = _geom_containers[get_ilayer_from_ID(this_LM2.first)]->get_phicenter(get_iphi_from_ID(this_LM2.first));
-        if (this_phi2 > M_PI)
-        {
-          this_phi -= 2 * M_PI;
-        }
-        float this_eta2 = _geom_containers[get_ilayer_from_ID(this_LM2.first)]->get_etacenter(get_ieta_from_ID(this_LM2.first));
-
-        // calculate geometric dR
-        float dR = calculate_dR(this_eta, this_eta2, this_phi, this_phi2);
-
-        // check for and report overlaps
-        if (dR < 0.15)
-        {
-          has_EM_overlap = true;
-          if (Verbosity() > 2)
-          {
-            std::cout << "RawClusterBuilderTopo::process_event : removing I/OHal local maximum (ID,E,phi,eta = " << this_LM.first << ", " << this_LM.second << ", " << this_phi << ", " << this_eta << "), ";
-            std::cout << "due to EM overlap (ID,E,phi,eta = " << this_LM2.first << ", " << this_LM2.second << ", " << this_phi2 << ", " << this_eta2 << "), dR = " << dR << std::endl;
-          }
-          break;
+          std::cout << "RawClusterBuilderTopo::process_event : removing I/OHal local maximum (ID,E,phi,eta = " << this_LM.first << ", " << this_LM.second << ", " << this_phi << ", " << this_eta << "), ";
+          std::cout << "due to EM overlap (ID,E,phi,eta = " << this_LM2.first << ", " << this_LM2.second << ", " << this_phi2 << ", " << this_eta2 << "), dR = " << dR << std::endl;
         }
+        break;
       }
-
-      if (has_EM_overlap)
-      {
-        // remove the I/OHCal local maximum from the list
-        local_maxima_ID.erase(local_maxima_ID.begin() + n);
-        // make sure to back up one index...
-        n = n - 1;
-      }  // otherwise, keep this local maximum
     }
 
-    // only now print out full set of local maxima
-    if (Verbosity() > 2)
+    if (has_EM_overlap)
     {
-      for (auto this_LM : local_maxima_ID)
-      {
-        int tower_ID = this_LM.first;
-        std::cout << "RawClusterBuilderTopo::process_event in cluster " << cl << ", tower ID " << tower_ID << " is LOCAL MAXIMUM with layer / E = " << get_ilayer_from_ID(tower_ID) << " / " << get_E_from_ID(tower_ID) << ", ";
-        float this_phi = _geom_containers[get_ilayer_from_ID(tower_ID)]->get_phicenter(get_iphi_from_ID(tower_ID));
-        if (this_phi > M_PI)
-        {
-          this_phi -= 2 * M_PI;
-        }
-        std::cout << " eta / phi = " << _geom_containers[get_ilayer_from_ID(tower_ID)]->get_etacenter(get_ieta_from_ID(tower_ID)) << " / " << this_phi << std::endl;
-      }
-    }
+      // remove the I/OHCal local maximum from the list
+      local_maxima_ID.erase(local_maxima_ID.begin() + n);
+      // make sure to back up one index...
+      n = n - 1;
+    }  // otherwise, keep this local maximum
+  }
 
-    // do we have only 1 or 0 local maxima?
-    if (local_maxima_ID.size() <= 1)
+  // only now print out full set of local maxima
+  if (Verbosity() > 2)
+  {
+    for (auto this_LM : local_maxima_ID)
     {
-      if (Verbosity() > 2)
+      int tower_ID = this_LM.first;
+      std::cout << "RawClusterBuilderTopo::process_event in cluster " << cl << ", tower ID " << tower_ID << " is LOCAL MAXIMUM with layer / E = " << get_ilayer_from_ID(tower_ID) << " / " << get_E_from_ID(tower_ID) << ", ";
+      float this_phi = _geom_containers[get_ilayer_from_ID(tower_ID)]->get_phicenter(get_iphi_from_ID(tower_ID));
+      if (this_phi > M_PI)
       {
-        std::cout << "RawClusterBuilderTopo::process_event cluster " << cl << " has only " << local_maxima_ID.size() << " local maxima, not splitting " << std::endl;
+        this_phi -= 2 * M_PI;
       }
-      export_single_cluster(original_towers);
-
-      continue;
+      std::cout << " eta / phi = " << _geom_containers[get_ilayer_from_ID(tower_ID)]->get_etacenter(get_ieta_from_ID(tower_ID)) << " / " << this_phi << std::endl;
     }
+  }
 
-    // engage splitting procedure!
-
+  // do we have only 1 or 0 local maxima?
+  if (local_maxima_ID.size() <= 1)
+  {
     if (Verbosity() > 2)
     {
-      std::cout << "RawClusterBuilderTopo::process_event splitting cluster " << cl << " into " << local_maxima_ID.size() << " according to local maxima!" << std::endl;
-    }
-    // translate all cluster towers to a map which keeps track of their ownership
-    // -1 means unseen
-    // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
-    // -3 shared tower, ignore going forward...
-    std::map<int, std::pair<int, int> > tower_ownership;
-    for (int &original_tower : original_towers)
-    {
-      tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
+      std::cout << "RawClusterBuilderTopo::process_event cluster " << cl << " has only " << local_maxima_ID.size() << " local maxima, not splitting " << std::endl;
     }
-    std::vector<int> seed_list;
-    std::vector<int> neighbor_list;
-    std::vector<int> shared_list;
+    set_single_cluster(original_towers, split);
+    return;
+  }
+
+  // engage splitting procedure!
 
-    // sort maxima before populating seed list
-    std::sort(local_maxima_ID.begin(), local_maxima_ID.end(), sort_by_pair_second);
+  if (Verbosity() > 2)
+  {
+    std::cout << "RawClusterBuilderTopo::process_event splitting cluster " << cl << " into " << local_maxima_ID.size() << " according to local maxima!" << std::endl;
+  }
+  // translate all cluster towers to a map which keeps track of their ownership
+  // -1 means unseen
+  // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
+  // -3 shared tower, ignore going forward...
+  // only the entries of the towers of this topo-cluster are used
+  std::vector<std::pair<int, int> > &tower_ownership = _tower_ownership;
+  for (int original_tower : original_towers)
+  {
+    tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
+  }
+  std::vector<int> &seed_list = buffers.seed_list;
+  std::vector<int> &neighbor_list = buffers.neighbor_list;
+  std::vector<int> &shared_list = buffers.shared_list;
+  seed_list.clear();
+  neighbor_list.clear();
+  shared_list.clear();
+
+  // sort maxima before populating seed list
+  std::sort(local_maxima_ID.begin(), local_maxima_ID.end(), sort_by_pair_second);
+
+  // initialize neighbor list
+  for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
+  {
+    tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
+    neighbor_list.push_back(local_maxima_ID.at(s).first);
+  }
 
-    // initialize neighbor list
-    for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
+  if (Verbosity() > 100)
+  {
+    for (int original_tower : original_towers)
     {
-      tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
-      neighbor_list.push_back(local_maxima_ID.at(s).first);
+      std::pair<int, int> the_pair = tower_ownership[original_tower];
+      std::cout << " Debug Pre-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
+      std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
+      std::cout << std::endl;
     }
+  }
+
+  bool first_pass = true;
 
-    if (Verbosity() > 100)
+  do
+  {
+    if (Verbosity() > 5)
     {
-      for (int &original_tower : original_towers)
-      {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
-        std::cout << " Debug Pre-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-        std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
-        std::cout << std::endl;
-      }
+      std::cout << " -> starting split loop with " << seed_list.size() << " seed, " << neighbor_list.size() << " neighbor, and " << shared_list.size() << " shared towers " << std::endl;
     }
+    // go through neighbor list, assigning ownership only via the seed list
+    std::vector<int> &new_ownerships = buffers.new_ownerships;
+    new_ownerships.clear();
 
-    bool first_pass = true;
-
-    do
+    for (unsigned int n = 0; n < neighbor_list.size(); n++)
     {
-      if (Verbosity() > 5)
+      int neighbor_ID = neighbor_list.at(n);
+
+      if (Verbosity() > 10)
       {
-        std::cout << " -> starting split loop with " << seed_list.size() << " seed, " << neighbor_list.size() << " neighbor, and " << shared_list.size() << " shared towers " << std::endl;
+        std::cout << " -> -> looking at neighbor " << n << " (tower ID " << neighbor_ID << " ) of " << neighbor_list.size() << " total" << std::endl;
       }
-      // go through neighbor list, assigning ownership only via the seed list
-      std::vector<int> new_ownerships;
-
-      for (unsigned int n = 0; n < neighbor_list.size(); n++)
+      if (first_pass)
       {
-        int neighbor_ID = neighbor_list.at(n);
-
         if (Verbosity() > 10)
         {
-          std::cout << " -> -> looking at neighbor " << n << " (tower ID " << neighbor_ID << " ) of " << neighbor_list.size() << " total" << std::endl;
-        }
-        if (first_pass)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << tower_ownership[neighbor_ID].first << std::endl;
-          }
-          new_ownerships.push_back(tower_ownership[neighbor_ID].first);
+          std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << tower_ownership[neighbor_ID].first << std::endl;
         }
-        else
-        {
-          std::map<int, bool> pseudocluster_adjacency;
-          for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
-          {
-            pseudocluster_adjacency[s] = false;
-          }
-          // look over all towers THIS one is adjacent to, and count up...
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
-
-          for (int this_adjacent_tower_ID : adjacent_tower_IDs)
-          {
-            if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-            {
-              continue;
-            }
+        new_ownerships.push_back(tower_ownership[neighbor_ID].first);
+      }
+      else
+      {
+        std::vector<char> &pseudocluster_adjacency = buffers.pseudocluster_adjacency;
+        pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
 
-            if (tower_ownership[this_adjacent_tower_ID].first > -1)
-            {
-              if (Verbosity() > 20)
-              {
-                std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
-              }
-              pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
-            }
-          }
-          int n_pseudocluster_adjacent = 0;
-          int last_adjacent_pseudocluster = -1;
-          for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
+        // look over all towers THIS one is adjacent to, and count up...
+        for (int this_adjacent_tower_ID : get_neighbors(neighbor_ID))
+        {
+          if (get_status_from_ID(this_adjacent_tower_ID) != cl)
           {
-            if (pseudocluster_adjacency[s])
-            {
-              last_adjacent_pseudocluster = s;
-              n_pseudocluster_adjacent++;
-              if (Verbosity() > 20)
-              {
-                std::cout << " -> -> adjacent to pseudocluster " << s << std::endl;
-              }
-            }
+            continue;
           }
 
-          if (n_pseudocluster_adjacent == 0)
+          if (tower_ownership[this_adjacent_tower_ID].first > -1)
           {
-            std::cout << " -> -> ERROR! How can a neighbor tower at this stage be adjacent to no pseudoclusters?? " << std::endl;
-            new_ownerships.push_back(9999);
-          }
-          else if (n_pseudocluster_adjacent == 1)
-          {
-            if (Verbosity() > 10)
+            if (Verbosity() > 20)
             {
-              std::cout << " -> -> neighbor tower " << neighbor_ID << " is ONLY adjacent to one pseudocluster # " << last_adjacent_pseudocluster << std::endl;
+              std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
             }
-            new_ownerships.push_back(last_adjacent_pseudocluster);
+            pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
           }
-          else
+        }
+        int n_pseudocluster_adjacent = 0;
+        int last_adjacent_pseudocluster = -1;
+        for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
+        {
+          if (pseudocluster_adjacency[s])
           {
-            if (Verbosity() > 10)
+            last_adjacent_pseudocluster = s;
+            n_pseudocluster_adjacent++;
+            if (Verbosity() > 20)
             {
-              std::cout << " -> -> neighbor tower " << neighbor_ID << " is adjacent to " << n_pseudocluster_adjacent << " pseudoclusters, move to shared list " << std::endl;
+              std::cout << " -> -> adjacent to pseudocluster " << s << std::endl;
             }
-            new_ownerships.push_back(-3);
           }
         }
-      }
 
-      if (Verbosity() > 5)
-      {
-        std::cout << " -> now updating status of all " << neighbor_list.size() << " original neighbors " << std::endl;
-      }
-      // transfer neighbor list to seed list or shared list
-      for (unsigned int n = 0; n < neighbor_list.size(); n++)
-      {
-        int neighbor_ID = neighbor_list.at(n);
-        if (new_ownerships.at(n) > -1)
+        if (n_pseudocluster_adjacent == 0)
+        {
+          std::cout << " -> -> ERROR! How can a neighbor tower at this stage be adjacent to no pseudoclusters?? " << std::endl;
+          new_ownerships.push_back(9999);
+        }
+        else if (n_pseudocluster_adjacent == 1)
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
-          seed_list.push_back(neighbor_ID);
-          if (Verbosity() > 20)
+          if (Verbosity() > 10)
           {
-            std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << new_ownerships.at(n) << std::endl;
+            std::cout << " -> -> neighbor tower " << neighbor_ID << " is ONLY adjacent to one pseudocluster # " << last_adjacent_pseudocluster << std::endl;
           }
+          new_ownerships.push_back(last_adjacent_pseudocluster);
         }
-        if (new_ownerships.at(n) == -3)
+        else
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
-          shared_list.push_back(neighbor_ID);
-          if (Verbosity() > 20)
+          if (Verbosity() > 10)
           {
-            std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << -3 << std::endl;
+            std::cout << " -> -> neighbor tower " << neighbor_ID << " is adjacent to " << n_pseudocluster_adjacent << " pseudoclusters, move to shared list " << std::endl;
           }
+          new_ownerships.push_back(-3);
         }
       }
+    }
 
-      if (Verbosity() > 5)
+    if (Verbosity() > 5)
+    {
+      std::cout << " -> now updating status of all " << neighbor_list.size() << " original neighbors " << std::endl;
+    }
+    // transfer neighbor list to seed list or shared list
+    for (unsigned int n = 0; n < neighbor_list.size(); n++)
+    {
+      int neighbor_ID = neighbor_list.at(n);
+      if (new_ownerships.at(n) > -1)
       {
-        std::cout << " producing a new neighbor list ... " << std::endl;
+        tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
+        seed_list.push_back(neighbor_ID);
+        if (Verbosity() > 20)
+        {
+          std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << new_ownerships.at(n) << std::endl;
+        }
       }
-      // populate a new neighbor list from the about-to-be-owned towers before transferring this one
-      std::list<int> new_neighbor_list;
-      for (unsigned int n = 0; n < neighbor_list.size(); n++)
+      if (new_ownerships.at(n) == -3)
       {
-        int neighbor_ID = neighbor_list.at(n);
-        if (new_ownerships.at(n) > -1)
+        tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
+        shared_list.push_back(neighbor_ID);
+        if (Verbosity() > 20)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          std::cout << " -> -> neighbor ID " << neighbor_ID << " has new status " << -3 << std::endl;
+        }
+      }
+    }
 
-          for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+    if (Verbosity() > 5)
+    {
+      std::cout << " producing a new neighbor list ... " << std::endl;
+    }
+    // populate a new neighbor list from the about-to-be-owned towers before transferring this one
+    std::vector<int> &new_neighbor_list = buffers.new_neighbor_list;
+    new_neighbor_list.clear();
+    for (unsigned int n = 0; n < neighbor_list.size(); n++)
+    {
+      int neighbor_ID = neighbor_list.at(n);
+      if (new_ownerships.at(n) > -1)
+      {
+        for (int this_adjacent_tower_ID : get_neighbors(neighbor_ID))
+        {
+          if (get_status_from_ID(this_adjacent_tower_ID) != cl)
           {
-            if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-            {
-              continue;
-            }
-            if (tower_ownership[this_adjacent_tower_ID].first == -1)
+            continue;
+          }
+          if (tower_ownership[this_adjacent_tower_ID].first == -1)
+          {
+            new_neighbor_list.push_back(this_adjacent_tower_ID);
+            if (Verbosity() > 5)
             {
-              new_neighbor_list.push_back(this_adjacent_tower_ID);
-              if (Verbosity() > 5)
-              {
-                std::cout << " -> queueing up to add tower " << this_adjacent_tower_ID << " , neighbor of tower " << neighbor_ID << " to new neighbor list" << std::endl;
-              }
+              std::cout << " -> queueing up to add tower " << this_adjacent_tower_ID << " , neighbor of tower " << neighbor_ID << " to new neighbor list" << std::endl;
             }
           }
         }
       }
+    }
 
-      if (Verbosity() > 5)
-      {
-        std::cout << " new neighbor list has size " << new_neighbor_list.size() << ", but after removing duplicate elements: ";
-      }
-
-      new_neighbor_list.sort();
-      new_neighbor_list.unique();
+    if (Verbosity() > 5)
+    {
+      std::cout << " new neighbor list has size " << new_neighbor_list.size() << ", but after removing duplicate elements: ";
+    }
 
-      if (Verbosity() > 5)
-      {
-        std::cout << new_neighbor_list.size() << std::endl;
-      }
+    std::sort(new_neighbor_list.begin(), new_neighbor_list.end());
+    new_neighbor_list.erase(std::unique(new_neighbor_list.begin(), new_neighbor_list.end()), new_neighbor_list.end());
 
-      // clear neighbor list!
-      neighbor_list.clear();
+    if (Verbosity() > 5)
+    {
+      std::cout << new_neighbor_list.size() << std::endl;
+    }
 
-      // now transfer over new neighbor list
-      for (; new_neighbor_list.size() > 0;)
-      {
-        neighbor_list.push_back(new_neighbor_list.front());
-        new_neighbor_list.pop_front();
-      }
+    // now transfer over new neighbor list
+    neighbor_list.swap(new_neighbor_list);
 
-      first_pass = false;
+    first_pass = false;
 
-    } while (neighbor_list.size() > 0);
+  } while (neighbor_list.size() > 0);
 
-    if (Verbosity() > 100)
+  if (Verbosity() > 100)
+  {
+    for (int original_tower : original_towers)
     {
-      for (int &original_tower : original_towers)
+      std::pair<int, int> the_pair = tower_ownership[original_tower];
+      std::cout << " Debug Mid-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
+      std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
+      std::cout << std::endl;
+      if (the_pair.first == -1)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
-        std::cout << " Debug Mid-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-        std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
-        std::cout << std::endl;
-        if (the_pair.first == -1)
+        for (int this_adjacent_tower_ID : get_neighbors(original_tower))
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
-
-          for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+          if (get_status_from_ID(this_adjacent_tower_ID) != cl)
           {
-            if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-            {
-              continue;
-            }
-            std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+            continue;
           }
+          std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
         }
       }
     }
+  }
 
-    // calculate pseudocluster energies and positions
-    std::vector<float> pseudocluster_sumeta;
-    std::vector<float> pseudocluster_sumphi;
-    std::vector<float> pseudocluster_sumE;
-    std::vector<int> pseudocluster_ntower;
-    std::vector<float> pseudocluster_eta;
-    std::vector<float> pseudocluster_phi;
-
-    pseudocluster_sumeta.resize(local_maxima_ID.size(), 0);
-    pseudocluster_sumphi.resize(local_maxima_ID.size(), 0);
-    pseudocluster_sumE.resize(local_maxima_ID.size(), 0);
-    pseudocluster_ntower.resize(local_maxima_ID.size(), 0);
+  // calculate pseudocluster energies and positions
+  std::vector<float> &pseudocluster_sumeta = buffers.pseudocluster_sumeta;
+  std::vector<float> &pseudocluster_sumphi = buffers.pseudocluster_sumphi;
+  std::vector<float> &pseudocluster_sumE = split.pseudocluster_sumE;
+  std::vector<int> &pseudocluster_ntower = buffers.pseudocluster_ntower;
+  std::vector<float> &pseudocluster_eta = split.pseudocluster_eta;
+  std::vector<float> &pseudocluster_phi = split.pseudocluster_phi;
+
+  pseudocluster_sumeta.assign(local_maxima_ID.size(), 0);
+  pseudocluster_sumphi.assign(local_maxima_ID.size(), 0);
+  pseudocluster_sumE.assign(local_maxima_ID.size(), 0);
+  pseudocluster_ntower.assign(local_maxima_ID.size(), 0);
+  pseudocluster_eta.clear();
+  pseudocluster_phi.clear();
 
-    for (int &original_tower : original_towers)
+  for (int original_tower : original_towers)
+  {
+    std::pair<int, int> the_pair = tower_ownership[original_tower];
+    if (the_pair.first > -1)
     {
-      std::pair<int, int> the_pair = tower_ownership[original_tower];
-      if (the_pair.first > -1)
-      {
-        float this_ID = original_tower;
-        pseudocluster_sumE[the_pair.first] += get_E_from_ID(this_ID);
-        float this_eta = _geom_containers[get_ilayer_from_ID(this_ID)]->get_etacenter(get_ieta_from_ID(this_ID));
-        float this_phi = _geom_containers[get_ilayer_from_ID(this_ID)]->get_phicenter(get_iphi_from_ID(this_ID));
-        // float this_phi = ( get_ilayer_from_ID( this_ID ) == 2 ? geomEM->get_phicenter( get_iphi_from_ID( this_ID ) ) : geomOH->get_phicenter( get_iphi_from_ID( this_ID ) ) );
-        pseudocluster_sumeta[the_pair.first] += this_eta;
-        pseudocluster_sumphi[the_pair.first] += this_phi;
-        pseudocluster_ntower[the_pair.first] += 1;
-      }
+      int this_ID = original_tower;
+      pseudocluster_sumE[the_pair.first] += get_E_from_ID(this_ID);
+      float this_eta = _geom_containers[get_ilayer_from_ID(this_ID)]->get_etacenter(get_ieta_from_ID(this_ID));
+      float this_phi = _geom_containers[get_ilayer_from_ID(this_ID)]->get_phicenter(get_iphi_from_ID(this_ID));
+      // float this_phi = ( get_ilayer_from_ID( this_ID ) == 2 ? geomEM->get_phicenter( get_iphi_from_ID( this_ID ) ) : geomOH->get_phicenter( get_iphi_from_ID( this_ID ) ) );
+      pseudocluster_sumeta[the_pair.first] += this_eta;
+      pseudocluster_sumphi[the_pair.first] += this_phi;
+      pseudocluster_ntower[the_pair.first] += 1;
     }
+  }
 
-    for (unsigned int pc = 0; pc < local_maxima_ID.size(); pc++)
-    {
-      pseudocluster_eta.push_back(pseudocluster_sumeta.at(pc) / pseudocluster_ntower.at(pc));
-      pseudocluster_phi.push_back(pseudocluster_sumphi.at(pc) / pseudocluster_ntower.at(pc));
-
-      if (Verbosity() > 2)
-      {
-        std::cout << "RawClusterBuilderTopo::process_event pseudocluster #" << pc << ", E / eta / phi / Ntower = " << pseudocluster_sumE.at(pc) << " / " << pseudocluster_eta.at(pc) << " / " << pseudocluster_phi.at(pc) << " / " << pseudocluster_ntower.at(pc) << std::endl;
-      }
-    }
+  for (unsigned int pc = 0; pc < local_maxima_ID.size(); pc++)
+  {
+    pseudocluster_eta.push_back(pseudocluster_sumeta.at(pc) / pseudocluster_ntower.at(pc));
+    pseudocluster_phi.push_back(pseudocluster_sumphi.at(pc) / pseudocluster_ntower.at(pc));
 
     if (Verbosity() > 2)
     {
-      std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
+      std::cout << "RawClusterBuilderTopo::process_event pseudocluster #" << pc << ", E / eta / phi / Ntower = " << pseudocluster_sumE.at(pc) << " / " << pseudocluster_eta.at(pc) << " / " << pseudocluster_phi.at(pc) << " / " << pseudocluster_ntower.at(pc) << std::endl;
     }
-    // iterate through shared cells, identifying which two they belong to
-    while (shared_list.size() > 0)
+  }
+
+  if (Verbosity() > 2)
+  {
+    std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
+  }
+  // iterate through shared cells, identifying which two they belong to
+  // cells are processed in the order in which they are added to the list
+  for (unsigned int ishared = 0; ishared < shared_list.size(); ++ishared)
+  {
+    // pick the next cell
+    int shared_ID = shared_list[ishared];
+
+    if (Verbosity() > 5)
     {
-      // pick the first cell and pop off list
-      int shared_ID = shared_list.at(0);
-      shared_list.erase(shared_list.begin());
+      std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() - ishared - 1 << " shared towers left " << std::endl;
+    }
+    // look through adjacent pseudoclusters, taking two with highest energies
+    std::vector<char> &pseudocluster_adjacency = buffers.pseudocluster_adjacency;
+    pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
 
-      if (Verbosity() > 5)
+    for (int this_adjacent_tower_ID : get_neighbors(shared_ID))
+    {
+      if (get_status_from_ID(this_adjacent_tower_ID) != cl)
       {
-        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() << " shared towers left " << std::endl;
+        continue;
       }
-      // look through adjacent pseudoclusters, taking two with highest energies
-      std::vector<bool> pseudocluster_adjacency;
-      pseudocluster_adjacency.resize(local_maxima_ID.size(), false);
-
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(shared_ID);
-
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
+      if (tower_ownership[this_adjacent_tower_ID].first > -1)
       {
-        if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-        {
-          continue;
-        }
-        if (tower_ownership[this_adjacent_tower_ID].first > -1)
-        {
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
-        }
-        if (tower_ownership[this_adjacent_tower_ID].second > -1)
-        {  // can inherit adjacency from shared cluster
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].second] = true;
-        }
-        // at the same time, add unowned towers to the list for later examination
-        if (tower_ownership[this_adjacent_tower_ID].first == -1)
+        pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
+      }
+      if (tower_ownership[this_adjacent_tower_ID].second > -1)
+      {  // can inherit adjacency from shared cluster
+        pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].second] = true;
+      }
+      // at the same time, add unowned towers to the list for later examination
+      if (tower_ownership[this_adjacent_tower_ID].first == -1)
+      {
+        shared_list.push_back(this_adjacent_tower_ID);
+        tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
+        if (Verbosity() > 10)
         {
-          shared_list.push_back(this_adjacent_tower_ID);
-          tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
-          if (Verbosity() > 10)
-          {
-            std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
-          }
+          std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
         }
       }
+    }
 
-      // now figure out which pseudoclustes this shared tower is adjacent to...
-      int highest_pseudocluster_index = -1;
-      int second_highest_pseudocluster_index = -1;
+    // now figure out which pseudoclustes this shared tower is adjacent to...
+    int highest_pseudocluster_index = -1;
+    int second_highest_pseudocluster_index = -1;
 
-      float highest_pseudocluster_E = -1;
-      float second_highest_pseudocluster_E = -2;
+    float highest_pseudocluster_E = -1;
+    float second_highest_pseudocluster_E = -2;
 
-      for (unsigned int n = 0; n < pseudocluster_adjacency.size(); n++)
+    for (unsigned int n = 0; n < pseudocluster_adjacency.size(); n++)
+    {
+      if (!pseudocluster_adjacency[n])
       {
-        if (!pseudocluster_adjacency[n])
-        {
-          continue;
-        }
+        continue;
+      }
 
-        if (pseudocluster_sumE[n] > highest_pseudocluster_E)
-        {
-          second_highest_pseudocluster_E = highest_pseudocluster_E;
-          second_highest_pseudocluster_index = highest_pseudocluster_index;
+      if (pseudocluster_sumE[n] > highest_pseudocluster_E)
+      {
+        second_highest_pseudocluster_E = highest_pseudocluster_E;
+        second_highest_pseudocluster_index = highest_pseudocluster_index;
 
-          highest_pseudocluster_E = pseudocluster_sumE[n];
-          highest_pseudocluster_index = n;
-        }
-        else if (pseudocluster_sumE[n] > second_highest_pseudocluster_E)
-        {
-          second_highest_pseudocluster_E = pseudocluster_sumE[n];
-          second_highest_pseudocluster_index = n;
-        }
+        highest_pseudocluster_E = pseudocluster_sumE[n];
+        highest_pseudocluster_index = n;
       }
-
-      if (Verbosity() > 5)
+      else if (pseudocluster_sumE[n] > second_highest_pseudocluster_E)
       {
-        std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
+        second_highest_pseudocluster_E = pseudocluster_sumE[n];
+        second_highest_pseudocluster_index = n;
       }
-      // assign these clusters as owners
-      tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
     }
 
-    if (Verbosity() > 100)
+    if (Verbosity() > 5)
     {
-      for (int &original_tower : original_towers)
-      {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
-        std::cout << " Debug Post-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
-        std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
-        std::cout << std::endl;
-        if (the_pair.first == -1)
-        {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
-
-          for (int this_adjacent_tower_ID : adjacent_tower_IDs)
-          {
-            if (get_status_from_ID(this_adjacent_tower_ID) != cl)
-            {
-              continue;
-            }
-            std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
-          }
-        }
-      }
+      std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
     }
-
-    // call helper function
-    export_clusters(original_towers, tower_ownership, local_maxima_ID.size(), pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi);
+    // assign these clusters as owners
+    tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
   }
 
-  if (Verbosity() > 1)
+  if (Verbosity() > 100)
   {
-    std::cout << "RawClusterBuilderTopo::process_event after splitting (if any) final clusters output to node are: " << std::endl;
-    RawClusterContainer::ConstRange begin_end = _clusters->getClusters();
-    int ncl = 0;
-    for (RawClusterContainer::ConstIterator hiter = begin_end.first; hiter != begin_end.second; ++hiter)
+    for (int original_tower : original_towers)
     {
-      std::cout << "-> #" << ncl++ << " ";
-      hiter->second->identify();
+      std::pair<int, int> the_pair = tower_ownership[original_tower];
+      std::cout << " Debug Post-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
+      std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
       std::cout << std::endl;
+      if (the_pair.first == -1)
+      {
+        for (int this_adjacent_tower_ID : get_neighbors(original_tower))
+        {
+          if (get_status_from_ID(this_adjacent_tower_ID) != cl)
+          {
+            continue;
+          }
+          std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+        }
+      }
     }
   }
 
-  return Fun4AllReturnCodes::EVENT_OK;
+  split.n_clusters = local_maxima_ID.size();
 }
 
+
 int RawClusterBuilderTopo::End(PHCompositeNode * /*topNode*/)
 {
   return Fun4AllReturnCodes::EVENT_OK;
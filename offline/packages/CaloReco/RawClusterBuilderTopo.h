@@ -9,20 +9,24 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <map>
+#include <array>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
+class RawCluster;
 class RawClusterContainer;
 class RawTowerGeomContainer;
+class TowerInfoContainer;
 
 class RawClusterBuilderTopo : public SubsysReco
 {
  public:
   explicit RawClusterBuilderTopo(const std::string &name = "RawClusterBuilderTopo");
-  ~RawClusterBuilderTopo() override {}
+  ~RawClusterBuilderTopo() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -79,16 +83,82 @@ class RawClusterBuilderTopo : public SubsysReco
     _R_shower = R_shower;
   }
 
+  //! number of threads used to translate the calorimeter towers and to split the topo-clusters, 0 for all cores
+  /*! the output does not depend on the number of threads. Use 1 thread for verbose printouts */
+  void set_num_threads(unsigned int n)
+  {
+    _num_threads = n;
+  }
+
  private:
   void CreateNodes(PHCompositeNode *topNode);
 
-  std::vector<std::vector<std::vector<float> > > _TOWERMAP_E_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_KEY_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_STATUS_LAYER_ETA_PHI;
+  //! neighbours of a tower, see get_neighbors
+  class NeighborRange
+  {
+   public:
+    const int *begin() const { return _begin; }
+    const int *end() const { return _end; }
 
-  std::vector<std::vector<float> > _EMTOWERMAP_E_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_KEY_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_STATUS_ETA_PHI;
+    const int *_begin = nullptr;
+    const int *_end = nullptr;
+  };
+
+  //! scratch buffers used to split one topo-cluster, one set per thread
+  class SplitBuffers
+  {
+   public:
+    std::vector<std::pair<int, float> > local_maxima;
+    std::vector<int> seed_list;
+    std::vector<int> neighbor_list;
+    std::vector<int> new_neighbor_list;
+    std::vector<int> shared_list;
+    std::vector<int> new_ownerships;
+    std::vector<char> pseudocluster_adjacency;
+    std::vector<float> pseudocluster_sumeta;
+    std::vector<float> pseudocluster_sumphi;
+    std::vector<int> pseudocluster_ntower;
+  };
+
+  //! final clusters of one topo-cluster, as passed to export_clusters
+  class ClusterSplit
+  {
+   public:
+    unsigned int n_clusters = 1;
+    std::vector<float> pseudocluster_sumE;
+    std::vector<float> pseudocluster_eta;
+    std::vector<float> pseudocluster_phi;
+  };
+
+  //! tower state, indexed by tower ID (see get_ID), reset for each event
+  /*! keys are not reset */
+  std::vector<float> _tower_E;
+  std::vector<int> _tower_key;
+  std::vector<int> _tower_status;
+
+  //! ownership of the towers of a topo-cluster by its final clusters, indexed by tower ID
+  /*! only the entries of the towers of the topo-cluster being split are used */
+  std::vector<std::pair<int, int> > _tower_ownership;
+
+  //! neighbour table, computed once per geometry
+  /*! neighbours of tower ID are stored in _neighbor_IDs from _neighbor_offsets[ID] to _neighbor_offsets[ID+1] */
+  std::vector<int> _neighbor_offsets;
+  std::vector<int> _neighbor_IDs;
+
+  //!@name per event work space, kept between events to avoid allocations
+  //@{
+  std::array<std::vector<std::pair<int, float> >, 3> _layer_seeds;
+  std::vector<std::pair<int, float> > _list_of_seeds;
+  std::vector<int> _grow_tower_ID;
+  std::vector<std::vector<int> > _cluster_towers;
+  std::vector<ClusterSplit> _cluster_splits;
+  std::vector<SplitBuffers> _split_buffers;
+  std::vector<RawCluster *> _export_clusters;
+  std::vector<std::array<float, 4> > _export_sums;
+  //@}
+
+  unsigned int _num_threads = 1;
+  std::unique_ptr<PHThreadPool> _threadpool;
 
   // geometric constants to express IHCal<->EMCal overlap in eta
   static int RawClusterBuilderTopo_constants_EMCal_eta_start_given_IHCal[];
@@ -115,13 +185,31 @@ class RawClusterBuilderTopo : public SubsysReco
     return ((32 + (index_emcal_phi - 68 + _EMCAL_NPHI) / 4) % _HCAL_NPHI);
   }
 
+  //! used to build the neighbour table
   std::vector<int> get_adjacent_towers_by_ID(int ID);
 
+  //! compute the neighbours of all towers once the geometry is known
+  void build_neighbor_table();
+
+  //! neighbours of a tower, from the table
+  NeighborRange get_neighbors(int ID) const
+  {
+    return {_neighbor_IDs.data() + _neighbor_offsets[ID], _neighbor_IDs.data() + _neighbor_offsets[ID + 1]};
+  }
+
+  //! translate the towers of one calorimeter to the internal representation and collect its seeds
+  void fill_towers(TowerInfoContainer *, int ilayer, std::vector<std::pair<int, float> > &seeds);
+
   float calculate_dR(float, float, float, float);
 
-  void export_single_cluster(const std::vector<int> &);
+  //! find the local maxima of topo-cluster cl and share its towers between them
+  /*! only accesses the towers of this topo-cluster, so that topo-clusters can be split concurrently */
+  void split_cluster(int cl, SplitBuffers &, ClusterSplit &);
+
+  //! assign all towers to a single cluster
+  void set_single_cluster(const std::vector<int> &, ClusterSplit &);
 
-  void export_clusters(const std::vector<int> &, std::map<int, std::pair<int, int> >, unsigned int, std::vector<float>, std::vector<float>, std::vector<float>);
+  void export_clusters(const std::vector<int> &, const ClusterSplit &);
 
   int get_ID(int ilayer, int ieta, int iphi)
   {
@@ -168,34 +256,19 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_status_from_ID(int ID)
+  int get_status_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_status[ID];
   }
 
-  float get_E_from_ID(int ID)
+  float get_E_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_E_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_E_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_E[ID];
   }
 
   void set_status_by_ID(int ID, int status)
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
-    else
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
+    _tower_status[ID] = status;
   }
 
   RawClusterContainer *_clusters = nullptr;
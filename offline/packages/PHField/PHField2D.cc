@@ -18,10 +18,6 @@
 
 PHField2D::PHField2D(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
-  , r_index0_cache(0)
-  , r_index1_cache(0)
-  , z_index0_cache(0)
-  , z_index1_cache(0)
 {
   if (Verbosity() > 0)
   {
@@ -310,10 +306,10 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
   // between subsequent calls, we can save on the expense of the upper_bound
   // lookup (~10-15% of central event run time) with some caching between calls
 
-  unsigned int r_index0 = r_index0_cache;
-  unsigned int r_index1 = r_index1_cache;
+  unsigned int r_index0 = r_index0_cache.load(std::memory_order_relaxed);
+  unsigned int r_index1 = r_index0 + 1;
 
-  if (!((r > r_map_[r_index0]) && (r < r_map_[r_index1])))
+  if (!((r_index1 < r_map_.size()) && (r > r_map_[r_index0]) && (r < r_map_[r_index1])))
   {
     // if miss cached r values, search through the lookup table
     std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
@@ -338,14 +334,13 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     }
 
     // update cache
-    r_index0_cache = r_index0;
-    r_index1_cache = r_index1;
+    r_index0_cache.store(r_index0, std::memory_order_relaxed);
   }
 
-  unsigned int z_index0 = z_index0_cache;
-  unsigned int z_index1 = z_index1_cache;
+  unsigned int z_index0 = z_index0_cache.load(std::memory_order_relaxed);
+  unsigned int z_index1 = z_index0 + 1;
 
-  if (!((z > z_map_[z_index0]) && (z < z_map_[z_index1])))
+  if (!((z_index1 < z_map_.size()) && (z > z_map_[z_index0]) && (z < z_map_[z_index1])))
   {
     // if miss cached z values, search through the lookup table
     std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
@@ -361,8 +356,7 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     }
 
     // update cache
-    z_index0_cache = z_index0;
-    z_index1_cache = z_index1;
+    z_index0_cache.store(z_index0, std::memory_order_relaxed);
   }
 
   double Br000 = BFieldR_[z_index0][r_index0];
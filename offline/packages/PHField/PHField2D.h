@@ -4,6 +4,7 @@
 
 #include "PHField.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <tuple>
@@ -46,10 +47,10 @@ class PHField2D : public PHField
   // I want them to be data members so we can run 2 fieldmaps in parallel
   // and still have caching. Putting those as static variables into
   // the implementation will prevent this
-  mutable unsigned int r_index0_cache;
-  mutable unsigned int r_index1_cache;
-  mutable unsigned int z_index0_cache;
-  mutable unsigned int z_index1_cache;
+  // Only the lower index of the cached cell is kept (the upper one is lower + 1)
+  // and it is atomic, so that the field can be read from several threads
+  mutable std::atomic<unsigned int> r_index0_cache{0};
+  mutable std::atomic<unsigned int> z_index0_cache{0};
 };
 
 #endif
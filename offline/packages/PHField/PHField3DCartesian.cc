@@ -15,31 +15,16 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
-#include <cassert>
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
-#include <iterator>
 #include <set>
-#include <utility>
 
 PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
   : filename(fname)
 {
-  for (int i = 0; i < 2; i++)
-  {
-    for (int j = 0; j < 2; j++)
-    {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          xyz[i][j][k][l] = NAN;
-          bf[i][j][k][l] = NAN;
-        }
-      }
-    }
-  }
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
@@ -75,11 +60,15 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+  // first pass: find the grid, keep the selected field values for the second pass
+  std::set<float> xvals;
+  std::set<float> yvals;
+  std::set<float> zvals;
+  std::vector<std::array<float, 6>> selected;
   for (int i = 0; i < field_map->GetEntries(); i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
     xvals.insert(ROOT_X * cm);
     yvals.insert(ROOT_Y * cm);
     zvals.insert(ROOT_Z * cm);
@@ -87,7 +76,10 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
          std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
         std::abs(ROOT_Z * cm) > size_z)
     {
-      fieldmap[coord_key] = field_val;
+      selected.push_back({static_cast<float>(ROOT_X * cm), static_cast<float>(ROOT_Y * cm), static_cast<float>(ROOT_Z * cm),
+                          static_cast<float>(ROOT_BX * tesla * magfield_rescale),
+                          static_cast<float>(ROOT_BY * tesla * magfield_rescale),
+                          static_cast<float>(ROOT_BZ * tesla * magfield_rescale)});
     }
   }
   xmin = *(xvals.begin());
@@ -105,31 +97,60 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   zmin = *(zvals.begin());
   zmax = *(zvals.rbegin());
 
+  nx = xvals.size();
+  ny = yvals.size();
+  nz = zvals.size();
+  if (nx < 2 || ny < 2 || nz < 2)
+  {
+    std::cout << PHWHERE << " field map in " << filename << " needs at least 2 grid points in x, y and z"
+              << ", got nx: " << nx << ", ny: " << ny << ", nz: " << nz << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
   xstepsize = (xmax - xmin) / (xvals.size() - 1);
   ystepsize = (ymax - ymin) / (yvals.size() - 1);
   zstepsize = (zmax - zmin) / (zvals.size() - 1);
 
+  // second pass: fill the dense grid
+  fieldmap.assign(3 * static_cast<size_t>(nx) * ny * nz, NAN);
+  for (const auto &entry : selected)
+  {
+    const int ix = std::lround((entry[0] - xmin) / xstepsize);
+    const int iy = std::lround((entry[1] - ymin) / ystepsize);
+    const int iz = std::lround((entry[2] - zmin) / zstepsize);
+    if (std::abs(xmin + ix * xstepsize - entry[0]) > 1e-3 * xstepsize ||
+        std::abs(ymin + iy * ystepsize - entry[1]) > 1e-3 * ystepsize ||
+        std::abs(zmin + iz * zstepsize - entry[2]) > 1e-3 * zstepsize)
+    {
+      std::cout << PHWHERE << " field map in " << filename << " is not on a regular grid, point"
+                << " x: " << entry[0] / cm
+                << ", y: " << entry[1] / cm
+                << ", z: " << entry[2] / cm
+                << " is off the grid, exiting now" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    std::copy(entry.begin() + 3, entry.end(), fieldmap.begin() + index(ix, iy, iz));
+  }
+  std::cout << "PHField3DCartesian: " << nx << " x " << ny << " x " << nz
+            << " grid, " << selected.size() << " field values, "
+            << fieldmap.size() * sizeof(float) / 1024 / 1024 << " MB" << std::endl;
+
   delete field_map;
   delete rootinput;
   std::cout << "\n================= End Construct Mag Field ======================\n"
             << std::endl;
 }
 
-PHField3DCartesian::~PHField3DCartesian()
-{
-  if (Verbosity() > 0)
-  {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
-  }
-}
+PHField3DCartesian::~PHField3DCartesian() = default;
 
 void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
 {
-  static double xsav = -1000000.;
-  static double ysav = -1000000.;
-  static double zsav = -1000000.;
+  // last point, only used for the diagnostics of invalid coordinates
+  thread_local double xsav = -1000000.;
+  thread_local double ysav = -1000000.;
+  thread_local double zsav = -1000000.;
 
   double x = point[0];
   double y = point[1];
@@ -140,7 +161,7 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   Bfield[2] = 0.0;
   if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
   {
-    static int ifirst = 0;
+    thread_local int ifirst = 0;
     if (ifirst < 10)
     {
       std::cout << "PHField3DCartesian::GetFieldValue: "
@@ -172,147 +193,69 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   {
     return;
   }
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
+  // lower corner of the cell, a point on the upper edge of the grid
+  // belongs to the last cell
+  const double xbin = (x - xmin) / xstepsize;
+  const double ybin = (y - ymin) / ystepsize;
+  const double zbin = (z - zmin) / zstepsize;
+  const int ix = std::min(static_cast<int>(xbin), nx - 2);
+  const int iy = std::min(static_cast<int>(ybin), ny - 2);
+  const int iz = std::min(static_cast<int>(zbin), nz - 2);
+
+  // normalized distance to the lower corner
+  const double fractionx = xbin - ix;
+  const double fractiony = ybin - iy;
+  const double fractionz = zbin - iz;
+  if (Verbosity() > 0)
   {
-    --it;
-    zkey[1] = *it;
+    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
+    std::cout << "x/y/z cell: " << ix << "/" << iy << "/" << iz << std::endl;
+    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
   }
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
-  {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
 
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
+  // linear interpolation in cube, corner (i,j,k) gets weight
+  // wx[i] * wy[j] * wz[k] with w[0] = 1 - fraction, w[1] = fraction
+  const double wx[2] = {1. - fractionx, fractionx};
+  const double wy[2] = {1. - fractiony, fractiony};
+  const double wz[2] = {1. - fractionz, fractionz};
+
+  double bsum[3] = {0., 0., 0.};
+  for (int i = 0; i < 2; i++)
+  {
+    for (int j = 0; j < 2; j++)
     {
-      for (int j = 0; j < 2; j++)
+      // the two z corners are neighbors in memory
+      const float *bf = &fieldmap[index(ix + i, iy + j, iz)];
+      if (std::isnan(bf[0]) || std::isnan(bf[3]))
       {
-        for (int k = 0; k < 2; k++)
+        // called for every step and track fit, only report the first missing cells
+        thread_local int nmissing = 0;
+        if (nmissing < 10)
         {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
+          std::cout << PHWHERE << " could not locate key in " << filename
+                    << " value: x: " << (xmin + (ix + i) * xstepsize) / cm
+                    << ", y: " << (ymin + (iy + j) * ystepsize) / cm
+                    << ", z: " << (zmin + iz * zstepsize) / cm << std::endl;
+          nmissing++;
+          if (nmissing == 10)
           {
-            std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          xyz[i][j][k][0] = std::get<0>(magval->first);
-          xyz[i][j][k][1] = std::get<1>(magval->first);
-          xyz[i][j][k][2] = std::get<2>(magval->first);
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            std::cout << "read x/y/z: " << xyz[i][j][k][0] / cm << "/"
-                      << xyz[i][j][k][1] / cm << "/"
-                      << xyz[i][j][k][2] / cm << " bx/by/bz: "
-                      << bf[i][j][k][0] / tesla << "/"
-                      << bf[i][j][k][1] / tesla << "/"
-                      << bf[i][j][k][2] / tesla << std::endl;
+            std::cout << PHWHERE << " further missing keys are not reported" << std::endl;
           }
         }
+        return;
+      }
+      const double wxy = wx[i] * wy[j];
+      for (int l = 0; l < 3; l++)
+      {
+        bsum[l] += wxy * (wz[0] * bf[l] + wz[1] * bf[3 + l]);
       }
     }
   }
-  else
-  {
-    cache_hits++;
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
 
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
+  Bfield[0] = bsum[0];
+  Bfield[1] = bsum[1];
+  Bfield[2] = bsum[2];
 
   return;
 }
@@ -4,10 +4,9 @@
 #include "PHField.h"
 
 #include <cmath>
-#include <map>
-#include <set>
+#include <cstddef>
 #include <string>
-#include <tuple>
+#include <vector>
 
 class PHField3DCartesian : public PHField
 {
@@ -19,9 +18,16 @@ class PHField3DCartesian : public PHField
   //! Follow the convention of G4ElectroMagneticField
   //! @param[in]  Point   space time coordinate. x, y, z, t in Geant4/CLHEP units
   //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
+  //! Thread safe, the grid cell is found by index arithmetic from the step sizes
   void GetFieldValue(const double Point[4], double *Bfield) const override;
 
  private:
+  //! index of grid point ix, iy, iz in fieldmap
+  size_t index(const int ix, const int iy, const int iz) const
+  {
+    return 3 * ((static_cast<size_t>(ix) * ny + iy) * nz + iz);
+  }
+
   std::string filename;
   double xmin = 1000000;
   double xmax = -1000000;
@@ -32,21 +38,16 @@ class PHField3DCartesian : public PHField
   double xstepsize = NAN;
   double ystepsize = NAN;
   double zstepsize = NAN;
-  // these are updated in a const method
-  // to cache previous values
-  mutable double xyz[2][2][2][3]{};
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save = NAN;
-  mutable double ykey_save = NAN;
-  mutable double zkey_save = NAN;
-  mutable int cache_hits = 0;
-  mutable int cache_misses = 0;
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+  int nx = 0;
+  int ny = 0;
+  int nz = 0;
+
+  // dense regular grid, bx/by/bz for each grid point with z running fastest.
+  // The input ntuple is in float precision so nothing is lost by storing
+  // floats, which halves the memory footprint.
+  // Grid points which are not part of the field map (outside the selected
+  // radius/z range) are marked with NAN
+  std::vector<float> fieldmap;
 };
 
 #endif
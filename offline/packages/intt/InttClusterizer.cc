@@ -234,6 +234,18 @@ int InttClusterizer::InitRun(PHCompositeNode* topNode)
     }
   }
 
+  // nodes used in process_event, for running modules concurrently.
+  // The cluster containers are shared with the other trackers, which
+  // keeps their clusterizers in registration order
+  DeclareInputNode(do_read_raw ? "TRKR_RAWHITSET" : "TRKR_HITSET");
+  DeclareOutputNode("TRKR_CLUSTER");
+  DeclareOutputNode("TRKR_CLUSTERHITASSOC");
+  DeclareOutputNode("TRKR_CLUSTERCROSSINGASSOC");
+  if (record_ClusHitsVerbose)
+  {
+    DeclareOutputNode("Trkr_SvtxClusHitsVerbose");
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -190,15 +190,24 @@ int MbdCalib::Download_Gains(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<float>& qfit_integ = cdbttree->GetFloatColumn("qfit_integ");
+    const CDBTTree::Column<float>& qfit_mpv = cdbttree->GetFloatColumn("qfit_mpv");
+    const CDBTTree::Column<float>& qfit_sigma = cdbttree->GetFloatColumn("qfit_sigma");
+    const CDBTTree::Column<float>& qfit_integerr = cdbttree->GetFloatColumn("qfit_integerr");
+    const CDBTTree::Column<float>& qfit_mpverr = cdbttree->GetFloatColumn("qfit_mpverr");
+    const CDBTTree::Column<float>& qfit_sigmaerr = cdbttree->GetFloatColumn("qfit_sigmaerr");
+    const CDBTTree::Column<float>& qfit_chi2ndf = cdbttree->GetFloatColumn("qfit_chi2ndf");
+
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _qfit_integ[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_integ");
-      _qfit_mpv[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_mpv");
-      _qfit_sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_sigma");
-      _qfit_integerr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_integerr");
-      _qfit_mpverr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_mpverr");
-      _qfit_sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_sigmaerr");
-      _qfit_chi2ndf[ipmt] = cdbttree->GetFloatValue(ipmt, "qfit_chi2ndf");
+      _qfit_integ[ipmt] = qfit_integ.Get(ipmt);
+      _qfit_mpv[ipmt] = qfit_mpv.Get(ipmt);
+      _qfit_sigma[ipmt] = qfit_sigma.Get(ipmt);
+      _qfit_integerr[ipmt] = qfit_integerr.Get(ipmt);
+      _qfit_mpverr[ipmt] = qfit_mpverr.Get(ipmt);
+      _qfit_sigmaerr[ipmt] = qfit_sigmaerr.Get(ipmt);
+      _qfit_chi2ndf[ipmt] = qfit_chi2ndf.Get(ipmt);
       if (Verbosity() > 0)
       {
         if (ipmt < 5)
@@ -267,12 +276,18 @@ int MbdCalib::Download_TQT0(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<float>& tqfit_t0mean = cdbttree->GetFloatColumn("tqfit_t0mean");
+    const CDBTTree::Column<float>& tqfit_t0meanerr = cdbttree->GetFloatColumn("tqfit_t0meanerr");
+    const CDBTTree::Column<float>& tqfit_t0sigma = cdbttree->GetFloatColumn("tqfit_t0sigma");
+    const CDBTTree::Column<float>& tqfit_t0sigmaerr = cdbttree->GetFloatColumn("tqfit_t0sigmaerr");
+
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _tqfit_t0mean[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0mean");
-      _tqfit_t0meanerr[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0meanerr");
-      _tqfit_t0sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0sigma");
-      _tqfit_t0sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "tqfit_t0sigmaerr");
+      _tqfit_t0mean[ipmt] = tqfit_t0mean.Get(ipmt);
+      _tqfit_t0meanerr[ipmt] = tqfit_t0meanerr.Get(ipmt);
+      _tqfit_t0sigma[ipmt] = tqfit_t0sigma.Get(ipmt);
+      _tqfit_t0sigmaerr[ipmt] = tqfit_t0sigmaerr.Get(ipmt);
       if (Verbosity() > 0)
       {
         if (ipmt < 5 || ipmt >= MbdDefs::MBD_N_PMT - 5)
@@ -342,12 +357,18 @@ int MbdCalib::Download_TTT0(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<float>& ttfit_t0mean = cdbttree->GetFloatColumn("ttfit_t0mean");
+    const CDBTTree::Column<float>& ttfit_t0meanerr = cdbttree->GetFloatColumn("ttfit_t0meanerr");
+    const CDBTTree::Column<float>& ttfit_t0sigma = cdbttree->GetFloatColumn("ttfit_t0sigma");
+    const CDBTTree::Column<float>& ttfit_t0sigmaerr = cdbttree->GetFloatColumn("ttfit_t0sigmaerr");
+
     for (int ipmt = 0; ipmt < MbdDefs::MBD_N_PMT; ipmt++)
     {
-      _ttfit_t0mean[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0mean");
-      _ttfit_t0meanerr[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0meanerr");
-      _ttfit_t0sigma[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0sigma");
-      _ttfit_t0sigmaerr[ipmt] = cdbttree->GetFloatValue(ipmt, "ttfit_t0sigmaerr");
+      _ttfit_t0mean[ipmt] = ttfit_t0mean.Get(ipmt);
+      _ttfit_t0meanerr[ipmt] = ttfit_t0meanerr.Get(ipmt);
+      _ttfit_t0sigma[ipmt] = ttfit_t0sigma.Get(ipmt);
+      _ttfit_t0sigmaerr[ipmt] = ttfit_t0sigmaerr.Get(ipmt);
 
       if (Verbosity() > 0)
       {
@@ -418,12 +439,18 @@ int MbdCalib::Download_Ped(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<float>& pedmean = cdbttree->GetFloatColumn("pedmean");
+    const CDBTTree::Column<float>& pedmeanerr = cdbttree->GetFloatColumn("pedmeanerr");
+    const CDBTTree::Column<float>& pedsigma = cdbttree->GetFloatColumn("pedsigma");
+    const CDBTTree::Column<float>& pedsigmaerr = cdbttree->GetFloatColumn("pedsigmaerr");
+
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _pedmean[ifeech] = cdbttree->GetFloatValue(ifeech, "pedmean");
-      _pedmeanerr[ifeech] = cdbttree->GetFloatValue(ifeech, "pedmeanerr");
-      _pedsigma[ifeech] = cdbttree->GetFloatValue(ifeech, "pedsigma");
-      _pedsigmaerr[ifeech] = cdbttree->GetFloatValue(ifeech, "pedsigmaerr");
+      _pedmean[ifeech] = pedmean.Get(ifeech);
+      _pedmeanerr[ifeech] = pedmeanerr.Get(ifeech);
+      _pedsigma[ifeech] = pedsigma.Get(ifeech);
+      _pedsigmaerr[ifeech] = pedsigmaerr.Get(ifeech);
 
       if (Verbosity() > 0)
       {
@@ -487,9 +514,12 @@ int MbdCalib::Download_SampMax(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<int>& sampmax = cdbttree->GetIntColumn("sampmax");
+
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
-      _sampmax[ifeech] = cdbttree->GetIntValue(ifeech, "sampmax");
+      _sampmax[ifeech] = sampmax.Get(ifeech);
       if (Verbosity() > 0)
       {
         if (ifeech < 5 || ifeech >= MbdDefs::MBD_N_FEECH - 5)
@@ -567,6 +597,16 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<int>& shape_npts = cdbttree->GetIntColumn("shape_npts");
+    const CDBTTree::Column<float>& shape_min = cdbttree->GetFloatColumn("shape_min");
+    const CDBTTree::Column<float>& shape_max = cdbttree->GetFloatColumn("shape_max");
+    const CDBTTree::Column<int>& sherr_npts = cdbttree->GetIntColumn("sherr_npts");
+    const CDBTTree::Column<float>& sherr_min = cdbttree->GetFloatColumn("sherr_min");
+    const CDBTTree::Column<float>& sherr_max = cdbttree->GetFloatColumn("sherr_max");
+    const CDBTTree::Column<float>& shape_val = cdbttree->GetFloatColumn("shape_val");
+    const CDBTTree::Column<float>& sherr_val = cdbttree->GetFloatColumn("sherr_val");
+
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
       if (_mbdgeom->get_type(ifeech) == 0)
@@ -574,22 +614,22 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
         continue;  // skip t-channels
       }
 
-      _shape_npts[ifeech] = cdbttree->GetIntValue(ifeech, "shape_npts");
-      _shape_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "shape_min");
-      _shape_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "shape_max");
+      _shape_npts[ifeech] = shape_npts.Get(ifeech);
+      _shape_minrange[ifeech] = shape_min.Get(ifeech);
+      _shape_maxrange[ifeech] = shape_max.Get(ifeech);
 
-      _sherr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "sherr_npts");
-      _sherr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "sherr_min");
-      _sherr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "sherr_max");
+      _sherr_npts[ifeech] = sherr_npts.Get(ifeech);
+      _sherr_minrange[ifeech] = sherr_min.Get(ifeech);
+      _sherr_maxrange[ifeech] = sherr_max.Get(ifeech);
 
       for (int ipt = 0; ipt < _shape_npts[ifeech]; ipt++)
       {
         int chtemp = 1000 * ipt + ifeech;
 
-        float val = cdbttree->GetFloatValue(chtemp, "shape_val");
+        float val = shape_val.Get(chtemp);
         _shape_y[ifeech].push_back(val);
 
-        val = cdbttree->GetFloatValue(chtemp, "sherr_val");
+        val = sherr_val.Get(chtemp);
         _sherr_yerr[ifeech].push_back(val);
       }
 
@@ -756,6 +796,12 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<int>& tcorr_npts = cdbttree->GetIntColumn("tcorr_npts");
+    const CDBTTree::Column<float>& tcorr_min = cdbttree->GetFloatColumn("tcorr_min");
+    const CDBTTree::Column<float>& tcorr_max = cdbttree->GetFloatColumn("tcorr_max");
+    const CDBTTree::Column<float>& tcorr_val = cdbttree->GetFloatColumn("tcorr_val");
+
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
       if ( _mbdgeom->get_type(ifeech) == 1 )
@@ -763,15 +809,15 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
         continue;  // skip q-channels
       }
 
-      _tcorr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "tcorr_npts");
-      _tcorr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "tcorr_min");
-      _tcorr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "tcorr_max");
+      _tcorr_npts[ifeech] = tcorr_npts.Get(ifeech);
+      _tcorr_minrange[ifeech] = tcorr_min.Get(ifeech);
+      _tcorr_maxrange[ifeech] = tcorr_max.Get(ifeech);
 
       for (int ipt=0; ipt<_tcorr_npts[ifeech]; ipt++)
       {
         int chtemp = 1000*ipt + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "tcorr_val");
+        float val = tcorr_val.Get(chtemp);
         _tcorr_y[ifeech].push_back( val );
       }
 
@@ -915,6 +961,12 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
 
+    // resolve the fields once
+    const CDBTTree::Column<int>& scorr_npts = cdbttree->GetIntColumn("scorr_npts");
+    const CDBTTree::Column<float>& scorr_min = cdbttree->GetFloatColumn("scorr_min");
+    const CDBTTree::Column<float>& scorr_max = cdbttree->GetFloatColumn("scorr_max");
+    const CDBTTree::Column<float>& scorr_val = cdbttree->GetFloatColumn("scorr_val");
+
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
       if ( _mbdgeom->get_type(ifeech) == 1 )
@@ -922,15 +974,15 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
         continue;  // skip q-channels
       }
 
-      _scorr_npts[ifeech] = cdbttree->GetIntValue(ifeech, "scorr_npts");
-      _scorr_minrange[ifeech] = cdbttree->GetFloatValue(ifeech, "scorr_min");
-      _scorr_maxrange[ifeech] = cdbttree->GetFloatValue(ifeech, "scorr_max");
+      _scorr_npts[ifeech] = scorr_npts.Get(ifeech);
+      _scorr_minrange[ifeech] = scorr_min.Get(ifeech);
+      _scorr_maxrange[ifeech] = scorr_max.Get(ifeech);
 
       for (int ipt=0; ipt<_scorr_npts[ifeech]; ipt++)
       {
         int chtemp = 1000*ipt + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "scorr_val");
+        float val = scorr_val.Get(chtemp);
         _scorr_y[ifeech].push_back( val );
       }
 
@@ -53,7 +53,18 @@ int MbdReco::Init(PHCompositeNode *topNode)
 //____________________________________________________________________________..
 int MbdReco::InitRun(PHCompositeNode *topNode)
 {
-  int ret = getNodes(topNode);
+  m_eventnode.resolve(topNode);
+  m_mbdrawnode.resolve(topNode);
+  m_mbdpmtsnode.resolve(topNode);
+  m_mbdvtxmapnode.resolve(topNode);
+  int ret = getNodes();
+
+  // nodes used in process_event, for running modules concurrently
+  DeclareInputNode("PRDF");
+  DeclareInputNode("MBDPackets");
+  DeclareOutputNode("MbdPmtContainer");
+  DeclareOutputNode("MbdOut");
+  DeclareOutputNode("MbdVertexMap");
 
   m_mbdevent->SetSim(_simflag);
   m_mbdevent->InitRun();
@@ -64,7 +75,7 @@ int MbdReco::InitRun(PHCompositeNode *topNode)
 //____________________________________________________________________________..
 int MbdReco::process_event(PHCompositeNode *topNode)
 {
-  getNodes(topNode);
+  getNodes();
 
   if ( (m_mbdevent==nullptr && m_mbdraw==nullptr) || m_mbdpmts==nullptr )
   {
@@ -226,14 +237,17 @@ int MbdReco::createNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int MbdReco::getNodes(PHCompositeNode *topNode)
+int MbdReco::getNodes()
 {
+  // the handles are resolved in InitRun, they only search the node tree
+  // again if it changed or if the node data was replaced (e.g. the PRDF)
+
   // Get the bbc prdf data to mpcRawContent
-  m_event = findNode::getClass<Event>(topNode, "PRDF");
+  m_event = m_eventnode.get();
   // std::cout << "event addr " << (unsigned int)m_event << endl;
 
   // Get the raw data from event combined DST
-  m_mbdraw = findNode::getClass<CaloPacketContainer>(topNode, "MBDPackets");
+  m_mbdraw = m_mbdrawnode.get();
   
   if (!m_event && !m_mbdraw)
   {
@@ -249,14 +263,14 @@ int MbdReco::getNodes(PHCompositeNode *topNode)
   }
 
   // MbdPmtContainer
-  m_mbdpmts = findNode::getClass<MbdPmtContainer>(topNode, "MbdPmtContainer");
+  m_mbdpmts = m_mbdpmtsnode.get();
   if (!m_mbdpmts)
   {
     std::cout << PHWHERE << " MbdPmtContainer node not found on node tree" << std::endl;
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
-  m_mbdvtxmap = findNode::getClass<MbdVertexMap>(topNode, "MbdVertexMap");
+  m_mbdvtxmap = m_mbdvtxmapnode.get();
   if (!m_mbdvtxmap)
   {
     std::cout << PHWHERE << "MbdVertexMap node not found on node tree" << std::endl;
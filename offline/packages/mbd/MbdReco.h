@@ -3,6 +3,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/NodeHandle.h>
+
 #include <memory>
 #include <string>
 
@@ -33,7 +35,7 @@ class MbdReco : public SubsysReco
 
  private:
   int createNodes(PHCompositeNode *topNode);
-  int getNodes(PHCompositeNode *topNode);
+  int getNodes();
   int _simflag{0};
   int _calpass{0};
 
@@ -47,6 +49,11 @@ class MbdReco : public SubsysReco
   MbdPmtContainer *m_mbdpmts{nullptr};
   MbdGeom *m_mbdgeom{nullptr};
   MbdVertexMap *m_mbdvtxmap{nullptr};
+
+  findNode::NodeHandle<Event> m_eventnode{"PRDF"};
+  findNode::NodeHandle<CaloPacketContainer> m_mbdrawnode{"MBDPackets"};
+  findNode::NodeHandle<MbdPmtContainer> m_mbdpmtsnode{"MbdPmtContainer"};
+  findNode::NodeHandle<MbdVertexMap> m_mbdvtxmapnode{"MbdVertexMap"};
 };
 
 #endif  // __MBDRECO_H__
@@ -63,6 +63,10 @@ void MicromegasCalibrationData::read( const std::string& filename )
   CDBTTree cdbttree( filename );
   cdbttree.LoadCalibrations();
 
+  // resolve pedestal and rms fields once
+  const auto& pedestals = cdbttree.GetDoubleColumn( m_pedestal_key, 0 );
+  const auto& rmss = cdbttree.GetDoubleColumn( m_rms_key, 0 );
+
   // loop over registered fee ids
   MicromegasMapping mapping;
   for( const auto& fee:mapping.get_fee_id_list() )
@@ -78,8 +82,8 @@ void MicromegasCalibrationData::read( const std::string& filename )
 
       // read pedestal and rms
       int channel = fee*m_nchannels_fee + i;
-      double pedestal = cdbttree.GetDoubleValue( channel, m_pedestal_key, 0 );
-      double rms = cdbttree.GetDoubleValue( channel, m_rms_key, 0 );
+      double pedestal = pedestals.Get( channel );
+      double rms = rmss.Get( channel );
 
       // insert in local structure
       if( !std::isnan( rms ) )
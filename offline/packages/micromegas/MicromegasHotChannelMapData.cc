@@ -55,12 +55,17 @@ void MicromegasHotChannelMapData::read( const std::string& filename )
 
   // read total number of hot channels
   const int m_total_entries = cdbttree.GetSingleIntValue( m_total_entries_key );
+
+  // resolve channel id fields once
+  const auto& layer_ids = cdbttree.GetIntColumn( m_layer_id_key );
+  const auto& tile_ids = cdbttree.GetIntColumn( m_tile_id_key );
+  const auto& strip_ids = cdbttree.GetIntColumn( m_strip_id_key );
   for( int i = 0; i < m_total_entries; ++ i )
   {
     // read channel id
-    const int layer_id = cdbttree.GetIntValue( i, m_layer_id_key );
-    const int tile_id = cdbttree.GetIntValue( i, m_tile_id_key );
-    const int strip_id = cdbttree.GetIntValue( i, m_strip_id_key );
+    const int layer_id = layer_ids.Get( i );
+    const int tile_id = tile_ids.Get( i );
+    const int strip_id = strip_ids.Get( i );
     if( std::isnan(layer_id) || std::isnan(tile_id) || std::isnan(strip_id) )
     { continue; }
 
@@ -25,6 +25,7 @@
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -62,6 +63,8 @@ LaserClusterizer::LaserClusterizer(const std::string &name)
 {
 }
 
+LaserClusterizer::~LaserClusterizer() = default;
+
 int LaserClusterizer::InitRun(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -117,14 +120,27 @@ int LaserClusterizer::InitRun(PHCompositeNode *topNode)
 
   m_tdriftmax = AdcClockPeriod * NZBinsSide;
 
+  // the two sides are clustered in parallel on a pool of threads which lives for the whole job
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "LaserClusterizer::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   t_all = std::make_unique<PHTimer>("t_all");
   t_all->stop();
-  t_search = std::make_unique<PHTimer>("t_search");
-  t_search->stop();
-  t_clus = std::make_unique<PHTimer>("t_clus");
-  t_clus->stop();
-  t_erase = std::make_unique<PHTimer>("t_erase");
-  t_erase->stop();
+  for (int side = 0; side < 2; ++side)
+  {
+    t_search[side] = std::make_unique<PHTimer>("t_search_" + std::to_string(side));
+    t_search[side]->stop();
+    t_clus[side] = std::make_unique<PHTimer>("t_clus_" + std::to_string(side));
+    t_clus[side]->stop();
+    t_erase[side] = std::make_unique<PHTimer>("t_erase_" + std::to_string(side));
+    t_erase[side]->stop();
+  }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -200,8 +216,10 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
     rawhitsetrange = m_rawhits->getHitSets(TrkrDefs::TrkrId::tpcId);
   }
 
-  bgi::rtree<pointKeyLaser, bgi::quadratic<16>> rtree;
-  std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> adcMap;
+  // hits of the two sides never end up in the same cluster (opposite sign of it),
+  // each side gets its own tree and adc map and is clustered independently
+  std::array<bgi::rtree<pointKeyLaser, bgi::quadratic<16>>, 2> rtree;
+  std::array<std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>>, 2> adcMap;
 
   if (!do_read_raw)
   {
@@ -336,7 +354,7 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
         std::array<int, 3> coords = {(int) layer, iphi, it};
 
         std::vector<pointKeyLaser> testduplicate;
-        rtree.query(bgi::intersects(box(point(layer - 0.001, iphi - 0.001, it - 0.001),
+        rtree[side].query(bgi::intersects(box(point(layer - 0.001, iphi - 0.001, it - 0.001),
                                         point(layer + 0.001, iphi + 0.001, it + 0.001))),
                     std::back_inserter(testduplicate));
         if (!testduplicate.empty())
@@ -349,9 +367,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
         auto spechitkey = std::make_pair(hitKey, hitsetKey);
         auto keyCoords = std::make_pair(spechitkey, coords);
-        adcMap.insert(std::make_pair(adc, keyCoords));
+        adcMap[side].insert(std::make_pair(adc, keyCoords));
 
-        rtree.insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
+        rtree[side].insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
       }
     }
   }
@@ -359,54 +377,72 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
   if (Verbosity() > 1)
   {
     std::cout << "finished looping over hits" << std::endl;
-    std::cout << "map size: " << adcMap.size() << std::endl;
-    std::cout << "rtree size: " << rtree.size() << std::endl;
+    std::cout << "map size: " << adcMap[0].size() + adcMap[1].size() << std::endl;
+    std::cout << "rtree size: " << rtree[0].size() + rtree[1].size() << std::endl;
   }
 
   // done filling rTree
 
   t_all->restart();
 
-  while (adcMap.size() > 0)
-  {
-    auto iterKey = adcMap.rbegin();
-    if (iterKey == adcMap.rend())
+  std::array<std::vector<std::pair<TrkrDefs::hitsetkey, LaserClusterv1 *>>, 2> clusters;
+  m_threadpool->parallel_for(2, [this, &rtree, &adcMap, &clusters](size_t side, unsigned int /*thread*/)
+                             {
+    while (adcMap[side].size() > 0)
     {
-      break;
-    }
+      auto iterKey = adcMap[side].rbegin();
+      if (iterKey == adcMap[side].rend())
+      {
+        break;
+      }
 
-    auto coords = iterKey->second.second;
+      auto coords = iterKey->second.second;
 
-    int layer = coords[0];
-    int iphi = coords[1];
-    int it = coords[2];
+      int layer = coords[0];
+      int iphi = coords[1];
+      int it = coords[2];
 
-    int layerMax = layer + 1;
-    if (layer == 22 || layer == 38 || layer == 54)
-    {
-      layerMax = layer;
-    }
-    int layerMin = layer - 1;
-    if (layer == 7 || layer == 23 || layer == 39)
-    {
-      layerMin = layer;
-    }
+      int layerMax = layer + 1;
+      if (layer == 22 || layer == 38 || layer == 54)
+      {
+        layerMax = layer;
+      }
+      int layerMin = layer - 1;
+      if (layer == 7 || layer == 23 || layer == 39)
+      {
+        layerMin = layer;
+      }
 
-    std::vector<pointKeyLaser> clusHits;
+      std::vector<pointKeyLaser> clusHits;
 
-    t_search->restart();
-    rtree.query(bgi::intersects(box(point(layerMin, iphi - 2, it - 5), point(layerMax, iphi + 2, it + 5))), std::back_inserter(clusHits));
-    t_search->stop();
+      t_search[side]->restart();
+      rtree[side].query(bgi::intersects(box(point(layerMin, iphi - 2, it - 5), point(layerMax, iphi + 2, it + 5))), std::back_inserter(clusHits));
+      t_search[side]->stop();
 
-    t_clus->restart();
-    calc_cluster_parameter(clusHits, adcMap);
-    t_clus->stop();
+      t_clus[side]->restart();
+      calc_cluster_parameter(clusHits, adcMap[side], clusters[side]);
+      t_clus[side]->stop();
 
-    t_erase->restart();
-    remove_hits(clusHits, rtree, adcMap);
-    t_erase->stop();
+      t_erase[side]->restart();
+      remove_hits(clusHits, rtree[side], adcMap[side]);
+      t_erase[side]->stop();
 
-    clusHits.clear();
+      clusHits.clear();
+    } });
+
+  // add the clusters side by side, the keys are given in this order
+  for (const auto &sideclusters : clusters)
+  {
+    for (const auto &[maxKey, clus] : sideclusters)
+    {
+      const auto ckey = TrkrDefs::genClusKey(maxKey, m_clusterlist->size());
+      m_clusterlist->addClusterSpecifyKey(ckey, clus);
+      if (m_debug)
+      {
+        m_currentCluster = (LaserClusterv1 *) clus->CloneMe();
+        m_eventClusters.push_back((LaserClusterv1 *) m_currentCluster->CloneMe());
+      }
+    }
   }
 
   if (m_debug)
@@ -417,9 +453,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   if (m_debug)
   {
-    time_search = t_search->get_accumulated_time() / 1000.;
-    time_clus = t_clus->get_accumulated_time() / 1000.;
-    time_erase = t_erase->get_accumulated_time() / 1000.;
+    time_search = (t_search[0]->get_accumulated_time() + t_search[1]->get_accumulated_time()) / 1000.;
+    time_clus = (t_clus[0]->get_accumulated_time() + t_clus[1]->get_accumulated_time()) / 1000.;
+    time_erase = (t_erase[0]->get_accumulated_time() + t_erase[1]->get_accumulated_time()) / 1000.;
     time_all = t_all->get_accumulated_time() / 1000.;
 
     m_clusterTree->Fill();
@@ -427,9 +463,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   if (Verbosity())
   {
-    std::cout << "rtree search time: " << t_search->get_accumulated_time() / 1000. << " sec" << std::endl;
-    std::cout << "clustering time: " << t_clus->get_accumulated_time() / 1000. << " sec" << std::endl;
-    std::cout << "erasing time: " << t_erase->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "rtree search time: " << (t_search[0]->get_accumulated_time() + t_search[1]->get_accumulated_time()) / 1000. << " sec" << std::endl;
+    std::cout << "clustering time: " << (t_clus[0]->get_accumulated_time() + t_clus[1]->get_accumulated_time()) / 1000. << " sec" << std::endl;
+    std::cout << "erasing time: " << (t_erase[0]->get_accumulated_time() + t_erase[1]->get_accumulated_time()) / 1000. << " sec" << std::endl;
     std::cout << "total time: " << t_all->get_accumulated_time() / 1000. << " sec" << std::endl;
   }
 
@@ -464,7 +500,7 @@ int LaserClusterizer::End(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap)
+void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap, std::vector<std::pair<TrkrDefs::hitsetkey, LaserClusterv1 *>> &clusters) const
 {
   double rSum = 0.0;
   double phiSum = 0.0;
@@ -566,13 +602,7 @@ void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
   clus->setIPhi(iphiSum / adcSum);
   clus->setIT(itSum / adcSum);
 
-  const auto ckey = TrkrDefs::genClusKey(maxKey, m_clusterlist->size());
-  m_clusterlist->addClusterSpecifyKey(ckey, clus);
-  if (m_debug)
-  {
-    m_currentCluster = (LaserClusterv1 *) clus->CloneMe();
-    m_eventClusters.push_back((LaserClusterv1 *) m_currentCluster->CloneMe());
-  }
+  clusters.emplace_back(maxKey, clus);
 }
 
 void LaserClusterizer::remove_hits(std::vector<pointKeyLaser> &clusHits, bgi::rtree<pointKeyLaser, bgi::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap)
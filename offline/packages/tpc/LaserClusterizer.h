@@ -18,8 +18,11 @@
 #include <boost/geometry/geometries/point.hpp>
 #include <boost/geometry/index/rtree.hpp>
 
+#include <array>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 class LaserClusterContainerv1;
@@ -31,6 +34,7 @@ class RawHitSet;
 class RawHitSetContainer;
 class PHG4TpcCylinderGeom;
 class PHG4TpcCylinderGeomContainer;
+class PHThreadPool;
 
 namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
@@ -43,7 +47,7 @@ class LaserClusterizer : public SubsysReco
 {
  public:
   LaserClusterizer(const std::string &name = "LaserClusterizer");
-  ~LaserClusterizer() override = default;
+  ~LaserClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -51,7 +55,8 @@ class LaserClusterizer : public SubsysReco
   int End(PHCompositeNode *topNode) override;
 
   // void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int,std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap);
-  void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap);
+  //! the cluster is appended to clusters together with the hitset key of its maximum
+  void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap, std::vector<std::pair<TrkrDefs::hitsetkey, LaserClusterv1 *>> &clusters) const;
   // void remove_hits(std::vector<pointKeyLaser> &clusHits,  bgi::rtree<pointKeyLaser, bgi::quadratic<16> > &rtree, std::multimap <unsigned int, std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap, std::multimap <unsigned int, float*> &adcCoords);
   void remove_hits(std::vector<pointKeyLaser> &clusHits, bgi::rtree<pointKeyLaser, bgi::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap);
 
@@ -61,6 +66,9 @@ class LaserClusterizer : public SubsysReco
   void set_pedestal(float val) { pedestal = val; }
   void set_min_clus_size(float val) { min_clus_size = val; }
   void set_min_adc_sum(float val) { min_adc_sum = val; }
+  //! number of threads, the two TPC sides are clustered independently so
+  //! more than 2 are not used. 1 clusters in the calling thread
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
 
  private:
   int m_event = -1;
@@ -107,10 +115,14 @@ class LaserClusterizer : public SubsysReco
   std::vector<float> m_currentHit;
   std::vector<float> m_currentHit_hardware;
 
+  unsigned int m_num_threads = 2;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
+  // search, clustering and erase timers are per side since the sides run in parallel
   std::unique_ptr<PHTimer> t_all;
-  std::unique_ptr<PHTimer> t_search;
-  std::unique_ptr<PHTimer> t_clus;
-  std::unique_ptr<PHTimer> t_erase;
+  std::array<std::unique_ptr<PHTimer>, 2> t_search;
+  std::array<std::unique_ptr<PHTimer>, 2> t_clus;
+  std::array<std::unique_ptr<PHTimer>, 2> t_erase;
 };
 
 #endif
@@ -6,11 +6,14 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
+class PHThreadPool;
+class PHTimer;
 class TrkrHitSet;
 class TrkrHitSetContainer;
 class RawHitSet;
@@ -30,7 +33,7 @@ class TpcClusterizer : public SubsysReco
 {
  public:
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -42,6 +45,14 @@ class TpcClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of threads used to cluster the hitsets, 0 (default) uses all cores,
+  //! 1 clusters in the calling thread. The clusters are merged in hitset order,
+  //! so the output does not depend on the number of threads
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+  //! accumulated times (ms) of the event setup, clustering and merge phases
+  double get_setup_time() const;
+  double get_clustering_time() const;
+  double get_merge_time() const;
   void set_do_split(bool split) { do_split = split; }
   void set_pedestal(float val) { pedestal = val; }
   void set_seed_threshold(float val) { seed_threshold = val; }
@@ -107,6 +118,14 @@ class TpcClusterizer : public SubsysReco
   double m_sampa_tbias = 39.6;  // ns
 
   TrainingHitsContainer *m_training;
+
+  unsigned int m_num_threads = 0;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
+  //! timers for the event setup, clustering and merge phases
+  std::unique_ptr<PHTimer> t_setup;
+  std::unique_ptr<PHTimer> t_cluster;
+  std::unique_ptr<PHTimer> t_merge;
 };
 
 #endif
@@ -6,12 +6,13 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetContainerv2.h>
 #include <trackbase/TrkrHitSetv1.h>
 #include <trackbase/TrkrHitv2.h>
 
 #include <ffarawobjects/TpcRawHit.h>
 #include <ffarawobjects/TpcRawHitContainer.h>
-#include <ffarawobjects/TpcRawHitContainerv1.h>
+#include <ffarawobjects/TpcRawHitContainerv2.h>
 #include <ffarawobjects/TpcRawHitv1.h>
 
 #include <fun4all/Fun4AllServer.h>
@@ -35,6 +36,8 @@
 #include <phool/PHIODataNode.h>  // for PHIODataNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -44,9 +47,43 @@
 #include <TH1.h>
 #include <TNtuple.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdlib>   // for exit
 #include <iostream>  // for operator<<, endl, bas...
-#include <map>       // for _Rb_tree_iterator
+#include <limits>
+#include <map>  // for _Rb_tree_iterator
+
+namespace
+{
+  // binning of the pedestal histogram
+  constexpr int PEDBINS = 251;
+  constexpr double PEDMIN = -0.5;
+  constexpr double PEDMAX = 1000.5;
+
+  // adc values are 10 bit, anything above goes to the overflow bin
+  constexpr unsigned int MAXADC = 1024;
+
+  // pedestal histogram bin of each adc value, same as TAxis::FindFixBin
+  const std::array<uint8_t, MAXADC> pedestal_bins = []
+  {
+    std::array<uint8_t, MAXADC> bins{};
+    for (unsigned int adc = 0; adc < MAXADC; ++adc)
+    {
+      const double x = adc;
+      bins[adc] = (x < PEDMAX) ? 1 + int(PEDBINS * (x - PEDMIN) / (PEDMAX - PEDMIN)) : PEDBINS + 1;
+    }
+    return bins;
+  }();
+
+  // same as TAxis::GetBinCenter, also outside of the histogram range
+  float pedestal_bin_center(const int bin)
+  {
+    const double binwidth = (PEDMAX - PEDMIN) / PEDBINS;
+    return PEDMIN + (bin - 1) * binwidth + 0.5 * binwidth;
+  }
+}  // namespace
 
 TpcCombinedRawDataUnpacker::TpcCombinedRawDataUnpacker(std::string const& name, std::string const& outF)
   : SubsysReco(name)
@@ -55,6 +92,8 @@ TpcCombinedRawDataUnpacker::TpcCombinedRawDataUnpacker(std::string const& name,
   // Do nothing
 }
 
+TpcCombinedRawDataUnpacker::~TpcCombinedRawDataUnpacker() = default;
+
 int TpcCombinedRawDataUnpacker::Init(PHCompositeNode* /*topNode*/)
 {
   std::cout << "TpcCombinedRawDataUnpacker::Init(PHCompositeNode *topNode) Initializing" << std::endl;
@@ -74,6 +113,16 @@ int TpcCombinedRawDataUnpacker::Init(PHCompositeNode* /*topNode*/)
     exit(1);
   }
 
+  // look up the channel map once instead of per waveform,
+  // channels which are not in the map end up with an invalid layer
+  m_channel_layer.resize(m_NumMappedChannels);
+  m_channel_phi.resize(m_NumMappedChannels);
+  for (unsigned int key = 0; key < m_NumMappedChannels; ++key)
+  {
+    m_channel_layer[key] = m_cdbttree->GetIntValue(key, "layer", 0);
+    m_channel_phi[key] = m_cdbttree->GetDoubleValue(key, "phi", 0);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -127,12 +176,20 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
       std::cout << "\tMaking TrkrHitSetContainer" << std::endl;
     }
 
-    trkr_hit_set_container = new TrkrHitSetContainerv1;
+    if (m_use_flat_hitsets)
+    {
+      // about one hitset per TPC sector, layer and side plus the silicon staves
+      trkr_hit_set_container = new TrkrHitSetContainerv2("TrkrHitSetv2", 2000);
+    }
+    else
+    {
+      trkr_hit_set_container = new TrkrHitSetContainerv1;
+    }
     PHIODataNode<PHObject>* new_node = new PHIODataNode<PHObject>(trkr_hit_set_container, "TRKR_HITSET", "PHObject");
     trkr_node->addNode(new_node);
   }
 
-  TpcRawHitContainerv1* tpccont = findNode::getClass<TpcRawHitContainerv1>(topNode, m_TpcRawNodeName);
+  TpcRawHitContainer* tpccont = findNode::getClass<TpcRawHitContainer>(topNode, m_TpcRawNodeName);
   if (!tpccont)
   {
     std::cout << PHWHERE << std::endl;
@@ -145,6 +202,16 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    m_scratch.resize(m_threadpool->size());
+    if (Verbosity() > 0)
+    {
+      std::cout << "TpcCombinedRawDataUnpacker::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   if (m_writeTree)
   {
     m_file = new TFile(outfile_name.c_str(), "RECREATE");
@@ -174,7 +241,9 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
   _ievent++;
-  TH1F pedhist("pedhist", "pedhist", 251, -0.5, 1000.5);
+
+  PHTimer unpacktimer("TpcUnpack");
+  unpacktimer.restart();
 
   TrkrHitSetContainer* trkr_hit_set_container = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
   if (!trkr_hit_set_container)
@@ -189,7 +258,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
 
-  TpcRawHitContainerv1* tpccont = findNode::getClass<TpcRawHitContainerv1>(topNode, m_TpcRawNodeName);
+  TpcRawHitContainer* tpccont = findNode::getClass<TpcRawHitContainer>(topNode, m_TpcRawNodeName);
   if (!tpccont)
   {
     std::cout << PHWHERE << std::endl;
@@ -200,6 +269,8 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     gSystem->Exit(1);
     exit(1);
   }
+  // the samples of the contiguous container are read directly
+  TpcRawHitContainerv2* tpccontv2 = dynamic_cast<TpcRawHitContainerv2*>(tpccont);
 
   PHG4TpcCylinderGeomContainer* geom_container =
       findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
@@ -209,18 +280,16 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
-  TrkrDefs::hitsetkey hit_set_key = 0;
-  TrkrDefs::hitkey hit_key = 0;
-  TrkrHitSetContainer::Iterator hit_set_container_itr;
-  TrkrHit* hit = nullptr;
-
   uint64_t bco_min = UINT64_MAX;
   uint64_t bco_max = 0;
 
   const auto nhits = tpccont->get_nhits();
 
-  int ntotalchannels = 0;
-  int n_noisychannels = 0;
+  // map the waveforms to pads and group them by fee, the waveform
+  // and group buffers are kept between events to reuse their memory
+  unsigned int nwaveforms = 0;
+  unsigned int nfees = 0;
+  std::map<int64_t, unsigned int> fee_index;
   for (unsigned int i = 0; i < nhits; i++)
   {
     TpcRawHit* tpchit = tpccont->get_hit(i);
@@ -257,20 +326,18 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     }
 
     unsigned int key = 256 * (feeM) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
+    if (key >= m_NumMappedChannels)
+    {
+      continue;
+    }
+    int layer = m_channel_layer[key];
     // antenna pads will be in 0 layer
     if (layer <= 0)
     {
       continue;
     }
 
-    uint16_t sampadd = tpchit->get_sampaaddress();
-    uint16_t sampch = tpchit->get_sampachannel();
-    uint16_t sam = tpchit->get_samples();
-
-    varname = "phi";  // + std::to_string(key);
-    double phi = -1 * pow(-1, side) * m_cdbttree->GetDoubleValue(key, varname) + (sector % 12) * M_PI / 6;
+    double phi = -1 * pow(-1, side) * m_channel_phi[key] + (sector % 12) * M_PI / 6;
     PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(layer);
     unsigned int phibin = layergeom->get_phibin(phi);
     if (m_writeTree)
@@ -286,123 +353,154 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       fX[n++] = side;
       fX[n++] = fee;
       fX[n++] = channel;
-      fX[n++] = sampadd;
-      fX[n++] = sampch;
-      fX[n++] = sam;
+      fX[n++] = tpchit->get_sampaaddress();
+      fX[n++] = tpchit->get_sampachannel();
+      fX[n++] = tpchit->get_samples();
       m_ntup->Fill(fX);
     }
-    hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
-    hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
 
-    if (!m_do_zerosup)
+    if (nwaveforms == m_waveforms.size())
     {
-      if (Verbosity() > 2)
+      m_waveforms.emplace_back();
+    }
+    Waveform& wf = m_waveforms[nwaveforms];
+    wf.rawhit = tpchit;
+    wf.index = i;
+    wf.hitsetkey = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
+    wf.phibin = phibin;
+    wf.layer = layer;
+    wf.side = side;
+    wf.noisy = false;
+
+    auto feeiter = fee_index.try_emplace((int64_t(packet_id) << 8) + fee, nfees).first;
+    if (feeiter->second == nfees)
+    {
+      if (nfees == m_fee_waveforms.size())
       {
-        std::cout << "TpcCombinedRawDataUnpacker:: no zero suppression" << std::endl;
+        m_fee_waveforms.emplace_back();
       }
-      for (uint16_t s = 0; s < sam; s++)
-      {
-        uint16_t adc = tpchit->get_adc(s);
-        int t = s;
+      m_fee_waveforms[nfees].clear();
+      ++nfees;
+    }
+    m_fee_waveforms[feeiter->second].push_back(nwaveforms);
+    ++nwaveforms;
+  }
 
-        hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
-        // find existing hit, or create new one
-        hit = hit_set_container_itr->second->getHit(hit_key);
-        if (!hit)
-        {
-          hit = new TrkrHitv2();
-          hit->setAdc(float(adc));
+  // pedestal and zero suppression, one task per fee
+  m_threadpool->parallel_for(nfees, [this, tpccontv2](size_t task, unsigned int thread)
+                             {
+                               for (const auto iwf : m_fee_waveforms[task])
+                               {
+                                 process_waveform(tpccontv2, m_waveforms[iwf], m_scratch[thread]);
+                               }
+                             });
 
-          hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
-        }
-      }
-    }
-    else
+  if (Verbosity() > 2)
+  {
+    std::cout << "TpcCombinedRawDataUnpacker:: " << (m_do_zerosup ? "do" : "no") << " zero suppression" << std::endl;
+  }
+
+  // fill the hitsets in the original waveform order. A hit key is only
+  // filled by the first waveform which has it, the (rare) waveforms whose
+  // pad already got hits in this event check each key before adding
+  for (auto& pads : m_pad_filled)
+  {
+    std::fill(pads.begin(), pads.end(), 0);
+  }
+  std::unique_ptr<TH1F> pedhist;
+  if (m_do_zerosup && m_do_pedestal_check)
+  {
+    pedhist = std::make_unique<TH1F>("pedhist", "pedhist", PEDBINS, PEDMIN, PEDMAX);
+    pedhist->SetDirectory(nullptr);
+  }
+  std::vector<TrkrHitSet*> filled_hitsets;
+  TrkrHitSetContainer::Iterator hit_set_container_itr;
+  TrkrHitSet* hitset = nullptr;
+  int ntotalchannels = 0;
+  int n_noisychannels = 0;
+  for (unsigned int iwf = 0; iwf < nwaveforms; ++iwf)
+  {
+    const Waveform& wf = m_waveforms[iwf];
+    if (!hitset || hitset->getHitSetKey() != wf.hitsetkey)
     {
-      if (Verbosity() > 2)
-      {
-        std::cout << "TpcCombinedRawDataUnpacker:: do zero suppression" << std::endl;
-      }
-      float hpedestal = 0;
-      float hpedwidth = 0;
-      pedhist.Reset();
+      hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(wf.hitsetkey);
+      hitset = hit_set_container_itr->second;
+    }
 
-      for (uint16_t sampleNum = 0; sampleNum < sam; sampleNum++)
-      {
-        uint16_t adc = tpchit->get_adc(sampleNum);
-        pedhist.Fill(adc);
-      }
-      int hmax = 0;
-      int hmaxbin = 0;
-      for (int nbin = 1; nbin <= pedhist.GetNbinsX(); nbin++)
+    if (m_do_zerosup)
+    {
+      ntotalchannels++;
+      if (pedhist)
       {
-        float val = pedhist.GetBinContent(nbin);
-        if (val > hmax)
+        float hpedestal = 0;
+        float hpedwidth = 0;
+        if (tpccontv2)
         {
-          hmaxbin = nbin;
-          hmax = val;
+          calc_pedestal_hist(*pedhist, tpccontv2->get_adc(wf.index), tpccontv2->get_samples(wf.index), hpedestal, hpedwidth);
         }
-      }
-
-      // calculate pedestal mean and sigma
-
-      if (pedhist.GetStdDev() == 0 || pedhist.GetEntries() == 0)
-      {
-        hpedestal = pedhist.GetBinCenter(pedhist.GetMaximumBin());
-        hpedwidth = 999;
-      }
-      else
-      {
-        // calc peak position
-        double adc_sum = 0.0;
-        double ibin_sum = 0.0;
-        double ibin2_sum = 0.0;
-
-        for (int isum = -3; isum <= 3; isum++)
+        else
         {
-          float val = pedhist.GetBinContent(hmaxbin + isum);
-          float center = pedhist.GetBinCenter(hmaxbin + isum);
-          ibin_sum += center * val;
-          ibin2_sum += center * center * val;
-          adc_sum += val;
+          std::vector<uint16_t>& adc = m_scratch[0];
+          adc.resize(wf.rawhit->get_samples());
+          for (unsigned int s = 0; s < adc.size(); s++)
+          {
+            adc[s] = wf.rawhit->get_adc(s);
+          }
+          calc_pedestal_hist(*pedhist, adc.data(), adc.size(), hpedestal, hpedwidth);
         }
-
-        hpedestal = ibin_sum / adc_sum;
-        hpedwidth = sqrt(ibin2_sum / adc_sum - (hpedestal * hpedestal));
-      }
-
-      ntotalchannels++;
-      if (m_do_noise_rejection)
-      {
-        if (hpedwidth < 0.5 || hpedestal < 10 || hpedwidth == 999)
+        ++m_NumPedestalChecked;
+        if (std::abs(hpedestal - wf.pedestal) > 1e-3 || std::abs(hpedwidth - wf.pedwidth) > 1e-3)
         {
-          n_noisychannels++;
-          continue;
+          ++m_NumPedestalMismatch;
         }
       }
-
-      for (uint16_t s = 0; s < sam; s++)
+      if (wf.noisy)
       {
-        uint16_t adc = tpchit->get_adc(s);
-        int t = s;
+        n_noisychannels++;
+        continue;
+      }
+    }
+    if (wf.hits.empty())
+    {
+      continue;
+    }
 
-        if ((float(adc) - hpedestal) > (hpedwidth * m_ped_sig_cut))
-        {
-          hit_key = TpcDefs::genHitKey(phibin, (unsigned int) t);
-          // find existing hit, or create new one
-          hit = hit_set_container_itr->second->getHit(hit_key);
-          if (!hit)
-          {
-            hit = new TrkrHitv2();
-            hit->setAdc(float(adc) - hpedestal);
+    const unsigned int padindex = 2 * wf.layer + wf.side;
+    if (padindex >= m_pad_filled.size())
+    {
+      m_pad_filled.resize(padindex + 1);
+    }
+    std::vector<uint8_t>& pads = m_pad_filled[padindex];
+    if (wf.phibin >= pads.size())
+    {
+      pads.resize(wf.phibin + 1, 0);
+    }
+    const bool shared_pad = pads[wf.phibin];
+    pads[wf.phibin] = 1;
 
-            hit_set_container_itr->second->addHitSpecificKey(hit_key, hit);
-          }
-        }
+    for (const auto& [t, adc] : wf.hits)
+    {
+      const TrkrDefs::hitkey hit_key = TpcDefs::genHitKey(wf.phibin, t);
+      if (shared_pad && hitset->getHit(hit_key))
+      {
+        continue;
       }
+      hitset->appendHit(hit_key, adc);
     }
+    filled_hitsets.push_back(hitset);
+  }
+
+  std::sort(filled_hitsets.begin(), filled_hitsets.end());
+  filled_hitsets.erase(std::unique(filled_hitsets.begin(), filled_hitsets.end()), filled_hitsets.end());
+  for (auto* filled : filled_hitsets)
+  {
+    filled->finalizeHits();
   }
 
+  m_NumChannels += nwaveforms;
+  unpacktimer.stop();
+  m_UnpackTime += unpacktimer.elapsed();
+
   if (m_do_noise_rejection && Verbosity() >= 2)
   {
     std::cout << " noisy / total channels = " << n_noisychannels << "/" << ntotalchannels << " = " << n_noisychannels / (double) ntotalchannels << std::endl;
@@ -417,6 +515,175 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void TpcCombinedRawDataUnpacker::process_waveform(TpcRawHitContainerv2* rawhits, Waveform& wf, std::vector<uint16_t>& scratch) const
+{
+  wf.hits.clear();
+
+  const uint16_t* adc = nullptr;
+  unsigned int nsamples = 0;
+  if (rawhits)
+  {
+    adc = rawhits->get_adc(wf.index);
+    nsamples = rawhits->get_samples(wf.index);
+  }
+  else
+  {
+    nsamples = wf.rawhit->get_samples();
+    scratch.resize(nsamples);
+    for (unsigned int s = 0; s < nsamples; s++)
+    {
+      scratch[s] = wf.rawhit->get_adc(s);
+    }
+    adc = scratch.data();
+  }
+
+  if (!m_do_zerosup)
+  {
+    wf.hits.reserve(nsamples);
+    for (unsigned int s = 0; s < nsamples; s++)
+    {
+      wf.hits.emplace_back(s, adc[s]);
+    }
+    return;
+  }
+
+  calc_pedestal(adc, nsamples, wf.pedestal, wf.pedwidth);
+  if (m_do_noise_rejection)
+  {
+    if (wf.pedwidth < 0.5 || wf.pedestal < 10 || wf.pedwidth == 999)
+    {
+      wf.noisy = true;
+      return;
+    }
+  }
+
+  const float threshold = wf.pedwidth * m_ped_sig_cut;
+  for (unsigned int s = 0; s < nsamples; s++)
+  {
+    const float signal = float(adc[s]) - wf.pedestal;
+    if (signal > threshold)
+    {
+      wf.hits.emplace_back(s, static_cast<unsigned int>(signal));
+    }
+  }
+}
+
+void TpcCombinedRawDataUnpacker::calc_pedestal(const uint16_t* adc, unsigned int nsamples, float& pedestal, float& width)
+{
+  // bin contents including underflow (always empty) and overflow
+  std::array<uint16_t, PEDBINS + 2> counts{};
+  uint16_t adcmin = std::numeric_limits<uint16_t>::max();
+  uint16_t adcmax = 0;
+  for (unsigned int s = 0; s < nsamples; s++)
+  {
+    adcmin = std::min(adcmin, adc[s]);
+    adcmax = std::max(adcmax, adc[s]);
+  }
+  for (unsigned int s = 0; s < nsamples; s++)
+  {
+    ++counts[pedestal_bins[std::min<unsigned int>(adc[s], MAXADC - 1)]];
+  }
+
+  // the histogram statistics only use samples inside the histogram range
+  if (nsamples > 0 && pedestal_bins[std::min<unsigned int>(adcmax, MAXADC - 1)] > PEDBINS)
+  {
+    adcmin = std::numeric_limits<uint16_t>::max();
+    adcmax = 0;
+    for (unsigned int s = 0; s < nsamples; s++)
+    {
+      if (adc[s] < PEDMAX)
+      {
+        adcmin = std::min(adcmin, adc[s]);
+        adcmax = std::max(adcmax, adc[s]);
+      }
+    }
+  }
+
+  // first bin with the largest content
+  int hmaxbin = 1;
+  for (int bin = 2; bin <= PEDBINS; bin++)
+  {
+    if (counts[bin] > counts[hmaxbin])
+    {
+      hmaxbin = bin;
+    }
+  }
+
+  // no spread of the samples in range, or no samples at all
+  if (adcmin >= adcmax)
+  {
+    pedestal = pedestal_bin_center(hmaxbin);
+    width = 999;
+    return;
+  }
+
+  // calc peak position
+  double adc_sum = 0.0;
+  double ibin_sum = 0.0;
+  double ibin2_sum = 0.0;
+
+  for (int isum = -3; isum <= 3; isum++)
+  {
+    // bins beyond the overflow read the overflow, as TH1::GetBinContent
+    float val = counts[std::clamp(hmaxbin + isum, 0, PEDBINS + 1)];
+    float center = pedestal_bin_center(hmaxbin + isum);
+    ibin_sum += center * val;
+    ibin2_sum += center * center * val;
+    adc_sum += val;
+  }
+
+  pedestal = ibin_sum / adc_sum;
+  width = sqrt(ibin2_sum / adc_sum - (pedestal * pedestal));
+}
+
+void TpcCombinedRawDataUnpacker::calc_pedestal_hist(TH1F& pedhist, const uint16_t* adc, unsigned int nsamples, float& pedestal, float& width)
+{
+  pedhist.Reset();
+
+  for (unsigned int sampleNum = 0; sampleNum < nsamples; sampleNum++)
+  {
+    pedhist.Fill(adc[sampleNum]);
+  }
+  int hmax = 0;
+  int hmaxbin = 0;
+  for (int nbin = 1; nbin <= pedhist.GetNbinsX(); nbin++)
+  {
+    float val = pedhist.GetBinContent(nbin);
+    if (val > hmax)
+    {
+      hmaxbin = nbin;
+      hmax = val;
+    }
+  }
+
+  // calculate pedestal mean and sigma
+
+  if (pedhist.GetStdDev() == 0 || pedhist.GetEntries() == 0)
+  {
+    pedestal = pedhist.GetBinCenter(pedhist.GetMaximumBin());
+    width = 999;
+  }
+  else
+  {
+    // calc peak position
+    double adc_sum = 0.0;
+    double ibin_sum = 0.0;
+    double ibin2_sum = 0.0;
+
+    for (int isum = -3; isum <= 3; isum++)
+    {
+      float val = pedhist.GetBinContent(hmaxbin + isum);
+      float center = pedhist.GetBinCenter(hmaxbin + isum);
+      ibin_sum += center * val;
+      ibin2_sum += center * center * val;
+      adc_sum += val;
+    }
+
+    pedestal = ibin_sum / adc_sum;
+    width = sqrt(ibin2_sum / adc_sum - (pedestal * pedestal));
+  }
+}
+
 int TpcCombinedRawDataUnpacker::End(PHCompositeNode* /*topNode*/)
 {
   if (m_writeTree)
@@ -425,6 +692,21 @@ int TpcCombinedRawDataUnpacker::End(PHCompositeNode* /*topNode*/)
     m_ntup->Write();
     m_file->Close();
   }
+  if (Verbosity() || m_do_pedestal_check)
+  {
+    std::cout << "TpcCombinedRawDataUnpacker::End - unpacked " << m_NumChannels << " channels in "
+              << m_UnpackTime / 1000. << " s";
+    if (m_UnpackTime > 0)
+    {
+      std::cout << ", " << m_NumChannels / (m_UnpackTime / 1000.) << " channels/s";
+    }
+    std::cout << std::endl;
+  }
+  if (m_do_pedestal_check)
+  {
+    std::cout << "TpcCombinedRawDataUnpacker::End - pedestal differs from the histogram pedestal for "
+              << m_NumPedestalMismatch << " of " << m_NumPedestalChecked << " channels" << std::endl;
+  }
   if (Verbosity())
   {
     std::cout << "TpcCombinedRawDataUnpacker::End(PHCompositeNode *topNode) This is the End..." << std::endl;
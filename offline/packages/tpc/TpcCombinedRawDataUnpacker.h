@@ -5,18 +5,29 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
 class CDBTTree;
 class CDBInterface;
 class TFile;
+class TH1F;
 class TNtuple;
+class TpcRawHit;
+class TpcRawHitContainerv2;
 
 class TpcCombinedRawDataUnpacker : public SubsysReco
 {
  public:
   TpcCombinedRawDataUnpacker(std::string const &name = "TpcCombinedRawDataUnpacker", std::string const &outF = "TpcCombinedRawDataUnpackerOutput.root");
+  ~TpcCombinedRawDataUnpacker() override;
 
   int Init(PHCompositeNode *topNode) override;
   int InitRun(PHCompositeNode *) override;
@@ -32,8 +43,41 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
     startevt = a;
     endevt = b;
   }
+  //! number of threads used to unpack the FEEs, 1 (default) unpacks in the
+  //! calling thread, 0 uses all cores
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+  //! also run the histogram based pedestal on every channel and count
+  //! disagreements, reported with the channel rate in End()
+  void do_pedestal_check(bool b) { m_do_pedestal_check = b; }
+  //! if the TRKR_HITSET node is created here, store the hits of all
+  //! trackers contiguously (TrkrHitSetv2 in a TrkrHitSetContainerv2)
+  void use_flat_hitsets(bool b) { m_use_flat_hitsets = b; }
+
+  //! pedestal and width of a waveform, the mode of the samples in
+  //! 251 bins between -0.5 and 1000.5 averaged over +-3 bins around it.
+  //! width is 999 if the samples in range are all identical
+  static void calc_pedestal(const uint16_t *adc, unsigned int nsamples, float &pedestal, float &width);
 
  private:
+  //! one decoded waveform and the hits which survived zero suppression
+  struct Waveform
+  {
+    TpcRawHit *rawhit{nullptr};
+    unsigned int index{0};
+    TrkrDefs::hitsetkey hitsetkey{0};
+    unsigned int phibin{0};
+    unsigned int layer{0};
+    int side{0};
+    float pedestal{0};
+    float pedwidth{0};
+    bool noisy{false};
+    // (time bin, adc)
+    std::vector<std::pair<uint16_t, unsigned int>> hits;
+  };
+
+  void process_waveform(TpcRawHitContainerv2 *rawhits, Waveform &wf, std::vector<uint16_t> &scratch) const;
+  static void calc_pedestal_hist(TH1F &pedhist, const uint16_t *adc, unsigned int nsamples, float &pedestal, float &width);
+
   TNtuple *m_ntup{nullptr};
   TFile *m_file{nullptr};
   CDBTTree *m_cdbttree{nullptr};
@@ -51,6 +95,29 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   bool m_writeTree{false};
   bool m_do_zerosup{true};
   bool m_do_noise_rejection{true};
+  bool m_do_pedestal_check{false};
+  bool m_use_flat_hitsets{false};
+
+  //! layer and phi of each (mapped fee, channel) from the channel map
+  static constexpr unsigned int m_NumMappedChannels{26 * 256};
+  std::vector<int> m_channel_layer;
+  std::vector<double> m_channel_phi;
+
+  //! waveforms of the current event, grouped by fee for the threads
+  std::vector<Waveform> m_waveforms;
+  std::vector<std::vector<unsigned int>> m_fee_waveforms;
+  //! pads already filled in this event, per layer and side
+  std::vector<std::vector<uint8_t>> m_pad_filled;
+
+  unsigned int m_num_threads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  //! per thread copy of the samples if the raw hits are not contiguous
+  std::vector<std::vector<uint16_t>> m_scratch;
+
+  uint64_t m_NumChannels{0};
+  double m_UnpackTime{0};
+  uint64_t m_NumPedestalChecked{0};
+  uint64_t m_NumPedestalMismatch{0};
 
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
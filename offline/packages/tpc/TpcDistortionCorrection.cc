@@ -42,6 +42,26 @@ namespace
     return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi);
   }
 
+  // true if there is a correction, either from a grid or from a histogram
+  inline bool has_correction(const TpcDistortionGrid& grid, const TH1* h)
+  {
+    return grid.valid() || h;
+  }
+
+  // interpolated correction, from the grid when it is valid, 0 outside of the histogram boundaries
+  inline double get_correction(const TpcDistortionGrid& grid, TH1* h, int dimensions, double phi, double r, double z)
+  {
+    if (grid.valid())
+    {
+      return grid.interpolate(phi, r, z);
+    }
+    if (dimensions == 3)
+    {
+      return check_boundaries(h, phi, r, z) ? h->Interpolate(phi, r, z) : 0;
+    }
+    return check_boundaries(h, phi, r) ? h->Interpolate(phi, r) : 0;
+  }
+
 }  // namespace
 
 //________________________________________________________
@@ -71,35 +91,21 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
     divisor = 1.0;
   }
 
-  if (dcc->m_dimensions == 3)
-  {
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
-    {
-      phi_new = phi - dcc->m_hDPint[index]->Interpolate(phi, r, z) / divisor;
-    }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r, z))
-    {
-      r_new = r - dcc->m_hDRint[index]->Interpolate(phi, r, z);
-    }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r, z))
-    {
-      z_new = z - dcc->m_hDZint[index]->Interpolate(phi, r, z);
-    }
-  }
-  else if (dcc->m_dimensions == 2)
+  if (dcc->m_dimensions == 3 || dcc->m_dimensions == 2)
   {
-    const double zterm = (1. - std::abs(z) / 105.5);
-    if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r))
+    // 2D corrections are scaled linearly with the drift length
+    const double zterm = dcc->m_dimensions == 2 ? (1. - std::abs(z) / 105.5) : 1.;
+    if ((mask & COORD_PHI) && has_correction(dcc->m_gDPint[index], dcc->m_hDPint[index]))
     {
-      phi_new = phi - dcc->m_hDPint[index]->Interpolate(phi, r) * zterm / divisor;
+      phi_new = phi - get_correction(dcc->m_gDPint[index], dcc->m_hDPint[index], dcc->m_dimensions, phi, r, z) * zterm / divisor;
     }
-    if (dcc->m_hDRint[index] && (mask & COORD_R) && check_boundaries(dcc->m_hDRint[index], phi, r))
+    if ((mask & COORD_R) && has_correction(dcc->m_gDRint[index], dcc->m_hDRint[index]))
     {
-      r_new = r - dcc->m_hDRint[index]->Interpolate(phi, r) * zterm;
+      r_new = r - get_correction(dcc->m_gDRint[index], dcc->m_hDRint[index], dcc->m_dimensions, phi, r, z) * zterm;
     }
-    if (dcc->m_hDZint[index] && (mask & COORD_Z) && check_boundaries(dcc->m_hDZint[index], phi, r))
+    if ((mask & COORD_Z) && has_correction(dcc->m_gDZint[index], dcc->m_hDZint[index]))
     {
-      z_new = z - dcc->m_hDZint[index]->Interpolate(phi, r) * zterm;
+      z_new = z - get_correction(dcc->m_gDZint[index], dcc->m_hDZint[index], dcc->m_dimensions, phi, r, z) * zterm;
     }
   }
 
@@ -7,9 +7,13 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include <trackbase/TpcDistortionGrid.h>
+
 #include <array>
+#include <memory>
 
 class TH1;
+class TpcDistortionMapFile;
 
 class TpcDistortionCorrectionContainer
 {
@@ -36,6 +40,21 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //!@name dense grids of the distortions
+  /**
+   * used instead of the histograms to apply the corrections when valid.
+   * They are made by TpcLoadDistortionCorrection, either from the histograms
+   * or from a memory mapped TpcDistortionMapFile, in which case there are no histograms
+   */
+  //@{
+  std::array<TpcDistortionGrid, 2> m_gDRint;
+  std::array<TpcDistortionGrid, 2> m_gDPint;
+  std::array<TpcDistortionGrid, 2> m_gDZint;
+
+  /// distortion map file the grids are read from, if any
+  std::shared_ptr<TpcDistortionMapFile> m_mapfile;
+  //@}
 };
 
 #endif
@@ -7,6 +7,8 @@
 #include "TpcLoadDistortionCorrection.h"
 #include "TpcDistortionCorrectionContainer.h"
 
+#include <trackbase/TpcDistortionMapFile.h>
+
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <phool/PHCompositeNode.h>
 #include <phool/PHDataNode.h>
@@ -15,6 +17,9 @@
 #include <TFile.h>
 #include <TH1.h>
 
+#include <memory>
+#include <utility>  // for pair
+
 namespace
 {
 
@@ -80,6 +85,43 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     }
 
     std::cout << "TpcLoadDistortionCorrection::InitRun - reading corrections from " << m_correction_filename[i] << std::endl;
+    const std::array<const std::string, 2> extension = {{"_negz", "_posz"}};
+
+    if (TpcDistortionMapFile::is_map_file(m_correction_filename[i]))
+    {
+      // binary distortion maps, used in place from the memory mapped file. There are no histograms
+      distortion_correction_object->m_mapfile = std::make_shared<TpcDistortionMapFile>();
+      const auto& mapfile = distortion_correction_object->m_mapfile;
+      if (!mapfile->open(m_correction_filename[i]) || mapfile->entries() == 0)
+      {
+        std::cout << "TpcLoadDistortionCorrection::InitRun - cannot open " << m_correction_filename[i] << std::endl;
+        exit(1);
+      }
+
+      for (int j = 0; j < 2; ++j)
+      {
+        distortion_correction_object->m_hDPint[j] = nullptr;
+        distortion_correction_object->m_hDRint[j] = nullptr;
+        distortion_correction_object->m_hDZint[j] = nullptr;
+        distortion_correction_object->m_gDPint[j] = mapfile->get(std::string("hIntDistortionP") + extension[j]);
+        assert(distortion_correction_object->m_gDPint[j].valid());
+        distortion_correction_object->m_gDRint[j] = mapfile->get(std::string("hIntDistortionR") + extension[j]);
+        assert(distortion_correction_object->m_gDRint[j].valid());
+        distortion_correction_object->m_gDZint[j] = mapfile->get(std::string("hIntDistortionZ") + extension[j]);
+        assert(distortion_correction_object->m_gDZint[j].valid());
+      }
+
+      // assign correction object dimension from the maps, assuming all maps have the same
+      distortion_correction_object->m_dimensions = distortion_correction_object->m_gDPint[0].dimensions();
+
+      // only dimensions 2 or 3 are supported
+      assert(distortion_correction_object->m_dimensions == 2 || distortion_correction_object->m_dimensions == 3);
+
+      // assign whether phi corrections (DP) should be read as radians or mm
+      distortion_correction_object->m_phi_hist_in_radians = m_phi_hist_in_radians;
+      continue;
+    }
+
     auto distortion_tfile = TFile::Open(m_correction_filename[i].c_str());
     if (!distortion_tfile)
     {
@@ -87,7 +129,6 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
       exit(1);
     }
 
-    const std::array<const std::string, 2> extension = {{"_negz", "_posz"}};
     for (int j = 0; j < 2; ++j)
     {
       distortion_correction_object->m_hDPint[j] = dynamic_cast<TH1*>(distortion_tfile->Get((std::string("hIntDistortionP")+extension[j]).c_str()));
@@ -107,6 +148,20 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     // assign whether phi corrections (DP) should be read as radians or mm
     distortion_correction_object->m_phi_hist_in_radians = m_phi_hist_in_radians;
 
+    // copy the histograms to dense grids, used for the interpolation
+    // histograms with variable bins are interpolated directly
+    for (int j = 0; j < 2; ++j)
+    {
+      for (const auto& [h, grid] : {
+               std::make_pair(distortion_correction_object->m_hDPint[j], &distortion_correction_object->m_gDPint[j]),
+               std::make_pair(distortion_correction_object->m_hDRint[j], &distortion_correction_object->m_gDRint[j]),
+               std::make_pair(distortion_correction_object->m_hDZint[j], &distortion_correction_object->m_gDZint[j])})
+      {
+        *grid = TpcDistortionGrid::is_supported(h) ? TpcDistortionGrid(h) : TpcDistortionGrid();
+      }
+    }
+    distortion_correction_object->m_mapfile.reset();
+
     if (Verbosity())
     {
       for (const auto& h : {
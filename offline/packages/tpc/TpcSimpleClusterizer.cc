@@ -24,6 +24,8 @@
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -40,8 +42,6 @@
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -75,8 +75,6 @@ namespace
     std::vector<TrkrCluster *> cluster_vector;
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int zbin, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -278,9 +276,8 @@ namespace
     }
   }
 
-  void *ProcessSector(void *threadarg)
+  void ProcessSector(thread_data *my_data)
   {
-    auto my_data = (struct thread_data *) threadarg;
 
     const auto &pedestal = my_data->pedestal;
     const auto &phibins = my_data->phibins;
@@ -360,7 +357,6 @@ namespace
       calc_cluster_parameter(ihit_list, *my_data);
       remove_hits(ihit_list, all_hit_map, adcval);
     }
-    pthread_exit(nullptr);
   }
 }  // namespace
 
@@ -369,6 +365,8 @@ TpcSimpleClusterizer::TpcSimpleClusterizer(const std::string &name)
 {
 }
 
+TpcSimpleClusterizer::~TpcSimpleClusterizer() = default;
+
 bool TpcSimpleClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const
 {
   bool reject_it = false;
@@ -402,6 +400,19 @@ bool TpcSimpleClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4Tpc
 
 int TpcSimpleClusterizer::InitRun(PHCompositeNode *topNode)
 {
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+  }
+  // the timers accumulate over all runs
+  if (!t_cluster)
+  {
+    t_cluster = std::make_unique<PHTimer>("t_cluster");
+    t_cluster->stop();
+    t_merge = std::make_unique<PHTimer>("t_merge");
+    t_merge->stop();
+  }
+
   PHNodeIterator iter(topNode);
 
   // Looking for the DST node
@@ -517,26 +528,9 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
   TrkrHitSetContainer::ConstRange hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
   const int num_hitsets = std::distance(hitsetrange.first, hitsetrange.second);
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    printf("\n mutex init failed\n");
-    return 1;
-  }
+  // one task per hitset with its own output buffers, merged in hitset order
+  std::vector<thread_data> sectordata;
+  sectordata.reserve(num_hitsets);
 
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
@@ -548,19 +542,19 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
     unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
     PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-    // instanciate new thread pair, at the end of thread vector
-    thread_pair_t &thread_pair = threads.emplace_back();
+    // instanciate new task data, at the end of the vector
+    thread_data &data = sectordata.emplace_back();
 
-    thread_pair.data.layergeom = layergeom;
-    thread_pair.data.hitset = hitset;
-    thread_pair.data.layer = layer;
-    thread_pair.data.pedestal = pedestal;
-    thread_pair.data.sector = sector;
-    thread_pair.data.side = side;
-    thread_pair.data.do_assoc = do_hit_assoc;
-    thread_pair.data.tGeometry = m_tGeometry;
-    thread_pair.data.par0_neg = par0_neg;
-    thread_pair.data.par0_pos = par0_pos;
+    data.layergeom = layergeom;
+    data.hitset = hitset;
+    data.layer = layer;
+    data.pedestal = pedestal;
+    data.sector = sector;
+    data.side = side;
+    data.do_assoc = do_hit_assoc;
+    data.tGeometry = m_tGeometry;
+    data.par0_neg = par0_neg;
+    data.par0_pos = par0_pos;
 
     unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
     unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -580,31 +574,20 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
 
     unsigned short ZOffset = NZBinsMin;
 
-    thread_pair.data.phibins = NPhiBinsSector;
-    thread_pair.data.phioffset = PhiOffset;
-    thread_pair.data.zbins = NZBinsSide;
-    thread_pair.data.zoffset = ZOffset;
-
-    int rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-    if (rc)
-    {
-      std::cout << "Error:unable to create thread," << rc << std::endl;
-    }
+    data.phibins = NPhiBinsSector;
+    data.phioffset = PhiOffset;
+    data.zbins = NZBinsSide;
+    data.zoffset = ZOffset;
   }
 
-  pthread_attr_destroy(&attr);
+  t_cluster->restart();
+  m_threadpool->parallel_for(sectordata.size(), [&sectordata](size_t task, unsigned int /*thread*/)
+                             { ProcessSector(&sectordata[task]); });
+  t_cluster->stop();
 
-  // wait for completion of all threads
-  for (const auto &thread_pair : threads)
+  t_merge->restart();
+  for (const auto &data : sectordata)
   {
-    int rc2 = pthread_join(thread_pair.thread, nullptr);
-    if (rc2)
-    {
-      std::cout << "Error:unable to join," << rc2 << std::endl;
-    }
-
-    // get the hitsetkey from thread data
-    const auto &data(thread_pair.data);
     const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
     // copy clusters to map
@@ -621,7 +604,7 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
     }
 
     // copy hit associations to map
-    for (const auto &[index, hkey] : thread_pair.data.association_vector)
+    for (const auto &[index, hkey] : data.association_vector)
     {
       // generate cluster key
       const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
@@ -630,6 +613,7 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
       m_clusterhitassoc->addAssoc(ckey, hkey);
     }
   }
+  t_merge->stop();
 
   if (Verbosity() > 0)
   {
@@ -640,5 +624,11 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
 
 int TpcSimpleClusterizer::End(PHCompositeNode * /*topNode*/)
 {
+  if (Verbosity() > 0 && t_cluster)
+  {
+    std::cout << "TpcSimpleClusterizer::End - threads: " << m_threadpool->size() << std::endl;
+    std::cout << "  clustering: " << t_cluster->get_accumulated_time() << " ms in " << t_cluster->get_ncycle() << " events" << std::endl;
+    std::cout << "  merge:      " << t_merge->get_accumulated_time() << " ms in " << t_merge->get_ncycle() << " events" << std::endl;
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -6,10 +6,13 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
+class PHTimer;
 class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrClusterContainer;
@@ -26,7 +29,7 @@ class TpcSimpleClusterizer : public SubsysReco
 {
  public:
   TpcSimpleClusterizer(const std::string &name = "TpcSimpleClusterizer");
-  ~TpcSimpleClusterizer() override = default;
+  ~TpcSimpleClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -34,6 +37,10 @@ class TpcSimpleClusterizer : public SubsysReco
 
   void set_sector_fiducial_cut(const double cut) { SectorFiducialCut = cut; }
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
+  //! number of threads used to cluster the hitsets, 0 (default) uses all cores,
+  //! 1 clusters in the calling thread. The clusters are merged in hitset order,
+  //! so the output does not depend on the number of threads
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
 
  private:
   bool is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const;
@@ -51,6 +58,11 @@ class TpcSimpleClusterizer : public SubsysReco
   // From Tony Frawley May 13, 2021
   double par0_neg = 0.0503;
   double par0_pos = -0.0503;
+
+  unsigned int m_num_threads = 0;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  std::unique_ptr<PHTimer> t_cluster;
+  std::unique_ptr<PHTimer> t_merge;
 };
 
 #endif
@@ -0,0 +1,254 @@
+/**
+ * @file trackbase/TpcDistortionGrid.cc
+ * @brief Implementation of TpcDistortionGrid
+ */
+#include "TpcDistortionGrid.h"
+
+#include <TH1.h>
+
+#include <algorithm>
+#include <iostream>
+#include <utility>  // for move
+
+namespace
+{
+  // interpolate n points, see TpcDistortionGrid::interpolate
+  template <bool three_dimensional>
+  void interpolate_points(const float* values, const std::array<TpcDistortionGrid::Axis, 3>& axes, const std::array<double, 3>& scale,
+                          size_t n, const double* phi, const double* r, const double* z, double* result)
+  {
+    const double nx = axes[0].nbins;
+    const double ny = axes[1].nbins;
+    const double nz = axes[2].nbins;
+    const size_t stride_y = axes[0].nbins;
+    const size_t stride_z = static_cast<size_t>(axes[0].nbins) * axes[1].nbins;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      // position in units of bins, from the lower edge of the axis
+      const double ux = (phi[i] - axes[0].min) * scale[0];
+      const double uy = (r[i] - axes[1].min) * scale[1];
+      const double uz = three_dimensional ? (z[i] - axes[2].min) * scale[2] : 1.;
+
+      // same as the histogram boundary check: within the axis and not in the first or last bin
+      const bool inside_z = !three_dimensional || ((uz >= 1) & (uz < nz - 1));
+      const bool inside = (ux >= 1) & (ux < nx - 1) & (uy >= 1) & (uy < ny - 1) & inside_z;
+
+      // interpolate between the centers of the two bins around the point
+      // points outside are moved inside so that the memory accesses stay in the grid, their value is dropped below
+      const double cx = (inside ? ux : 1.) - 0.5;
+      const double cy = (inside ? uy : 1.) - 0.5;
+      const double cz = (inside ? uz : 1.) - 0.5;
+      const auto ix = static_cast<size_t>(cx);
+      const auto iy = static_cast<size_t>(cy);
+      const auto iz = three_dimensional ? static_cast<size_t>(cz) : 0;
+      const double tx = cx - ix;
+      const double ty = cy - iy;
+
+      const float* cell = values + ix + stride_y * iy + stride_z * iz;
+      double value =
+          (1 - tx) * (1 - ty) * cell[0] +
+          tx * (1 - ty) * cell[1] +
+          (1 - tx) * ty * cell[stride_y] +
+          tx * ty * cell[stride_y + 1];
+
+      if constexpr (three_dimensional)
+      {
+        const double tz = cz - iz;
+        const float* upper = cell + stride_z;
+        const double value_upper =
+            (1 - tx) * (1 - ty) * upper[0] +
+            tx * (1 - ty) * upper[1] +
+            (1 - tx) * ty * upper[stride_y] +
+            tx * ty * upper[stride_y + 1];
+        value = (1 - tz) * value + tz * value_upper;
+      }
+
+      result[i] = inside ? value : 0.;
+    }
+  }
+
+}  // namespace
+
+//_____________________________________________________________________
+bool TpcDistortionGrid::is_supported(const TH1* h)
+{
+  if (!h || (h->GetDimension() != 2 && h->GetDimension() != 3))
+  {
+    return false;
+  }
+
+  const int dimensions = h->GetDimension();
+  const std::array<const TAxis*, 3> axes = {{h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}};
+  std::array<Axis, 3> grid_axes = {};
+  for (int i = 0; i < 3; ++i)
+  {
+    if (i >= dimensions)
+    {
+      grid_axes[i] = {1, 0, 1};
+      continue;
+    }
+    if (axes[i]->IsVariableBinSize())
+    {
+      return false;
+    }
+    grid_axes[i] = {static_cast<unsigned int>(axes[i]->GetNbins()), axes[i]->GetXmin(), axes[i]->GetXmax()};
+  }
+  return is_valid(dimensions, grid_axes);
+}
+
+//_____________________________________________________________________
+bool TpcDistortionGrid::is_valid(int dimensions, const std::array<Axis, 3>& axes)
+{
+  if (dimensions != 2 && dimensions != 3)
+  {
+    return false;
+  }
+
+  // the interpolation reads the bin above the one of the point, also for points outside of the axes
+  for (int i = 0; i < dimensions; ++i)
+  {
+    if (axes[i].nbins < 2 || !(axes[i].max > axes[i].min))
+    {
+      return false;
+    }
+  }
+  return dimensions == 3 || axes[2].nbins == 1;
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid::TpcDistortionGrid(const TH1* h)
+{
+  if (!is_supported(h))
+  {
+    std::cout << "TpcDistortionGrid::TpcDistortionGrid - histogram " << (h ? h->GetName() : "(null)")
+              << " is not a 2D or 3D histogram with regular bins and at least 2 bins per axis" << std::endl;
+    return;
+  }
+
+  m_dimensions = h->GetDimension();
+  const std::array<const TAxis*, 3> axes = {{h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}};
+  for (int i = 0; i < 3; ++i)
+  {
+    if (i < m_dimensions)
+    {
+      m_axes[i] = {static_cast<unsigned int>(axes[i]->GetNbins()), axes[i]->GetXmin(), axes[i]->GetXmax()};
+    }
+    else
+    {
+      m_axes[i] = {1, 0, 1};
+    }
+  }
+
+  // copy, skipping under and overflow bins
+  m_storage.resize(size());
+  auto value = m_storage.begin();
+  for (unsigned int iz = 0; iz < m_axes[2].nbins; ++iz)
+  {
+    for (unsigned int iy = 0; iy < m_axes[1].nbins; ++iy)
+    {
+      for (unsigned int ix = 0; ix < m_axes[0].nbins; ++ix)
+      {
+        const int bin = m_dimensions == 3 ? h->GetBin(ix + 1, iy + 1, iz + 1) : h->GetBin(ix + 1, iy + 1);
+        *(value++) = h->GetBinContent(bin);
+      }
+    }
+  }
+  m_values = m_storage.data();
+  update_scale();
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid::TpcDistortionGrid(int dimensions, const std::array<Axis, 3>& axes, const float* values)
+  : m_dimensions(dimensions)
+  , m_axes(axes)
+{
+  if (!is_valid(dimensions, axes))
+  {
+    std::cout << "TpcDistortionGrid::TpcDistortionGrid - invalid axes for a " << dimensions << "D map" << std::endl;
+    return;
+  }
+  m_values = values;
+  update_scale();
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid::TpcDistortionGrid(const TpcDistortionGrid& other)
+  : m_dimensions(other.m_dimensions)
+  , m_axes(other.m_axes)
+  , m_scale(other.m_scale)
+  , m_storage(other.m_storage)
+  , m_values(other.m_storage.empty() ? other.m_values : m_storage.data())
+{
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid& TpcDistortionGrid::operator=(const TpcDistortionGrid& other)
+{
+  if (this != &other)
+  {
+    TpcDistortionGrid copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid::TpcDistortionGrid(TpcDistortionGrid&& other) noexcept
+  : m_dimensions(other.m_dimensions)
+  , m_axes(other.m_axes)
+  , m_scale(other.m_scale)
+  , m_storage(std::move(other.m_storage))
+  , m_values(other.m_values)
+{
+  // moving a vector keeps its buffer, so m_values stays valid for owning grids
+  other.m_values = nullptr;
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid& TpcDistortionGrid::operator=(TpcDistortionGrid&& other) noexcept
+{
+  m_dimensions = other.m_dimensions;
+  m_axes = other.m_axes;
+  m_scale = other.m_scale;
+  m_storage = std::move(other.m_storage);
+  m_values = other.m_values;
+  other.m_values = nullptr;
+  return *this;
+}
+
+//_____________________________________________________________________
+void TpcDistortionGrid::update_scale()
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    m_scale[i] = m_axes[i].max > m_axes[i].min ? m_axes[i].nbins / (m_axes[i].max - m_axes[i].min) : 0;
+  }
+}
+
+//_____________________________________________________________________
+double TpcDistortionGrid::interpolate(double phi, double r, double z) const
+{
+  double value = 0;
+  interpolate(1, &phi, &r, &z, &value);
+  return value;
+}
+
+//_____________________________________________________________________
+void TpcDistortionGrid::interpolate(size_t n, const double* phi, const double* r, const double* z, double* values) const
+{
+  if (!valid())
+  {
+    std::fill(values, values + n, 0.);
+    return;
+  }
+
+  if (m_dimensions == 3)
+  {
+    interpolate_points<true>(m_values, m_axes, m_scale, n, phi, r, z, values);
+  }
+  else
+  {
+    interpolate_points<false>(m_values, m_axes, m_scale, n, phi, r, z, values);
+  }
+}
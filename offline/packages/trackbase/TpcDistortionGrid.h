@@ -0,0 +1,111 @@
+#ifndef TRACKBASE_TPCDISTORTIONGRID_H
+#define TRACKBASE_TPCDISTORTIONGRID_H
+
+/**
+ * @file trackbase/TpcDistortionGrid.h
+ * @brief Dense grid of TPC distortions, with trilinear interpolation
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+/**
+ * Values of a TPC distortion map on a regular (phi, r, z) grid, stored as
+ * one contiguous array of floats. The axes are in the order of the
+ * distortion histograms (x = phi, y = r, z = z) and the values are indexed
+ * with phi running fastest. Two dimensional (phi, r) maps have a single z bin.
+ *
+ * The interpolation gives the same values as TH3::Interpolate (TH2 for two
+ * dimensional maps) in the region where the distortion code interpolates:
+ * the point must be within the axis ranges and not in the first or last bin
+ * of any axis. Outside of it the interpolated value is 0.
+ *
+ * The grid either owns its values, when made from a histogram, or views
+ * values owned by somebody else, e.g. a memory mapped TpcDistortionMapFile.
+ * Interpolation is const and thread safe.
+ */
+class TpcDistortionGrid
+{
+ public:
+  //! regular axis
+  struct Axis
+  {
+    unsigned int nbins = 0;
+    double min = 0;
+    double max = 0;
+  };
+
+  //! empty, invalid grid
+  TpcDistortionGrid() = default;
+
+  //! copy the content of a 2D or 3D histogram, without under and overflow bins
+  /*! the grid is left invalid if the histogram has variable bins */
+  explicit TpcDistortionGrid(const TH1*);
+
+  //! true if the histogram is 2D or 3D with regular bins, so that it can be copied to a grid
+  static bool is_supported(const TH1*);
+
+  //! true if the axes can be interpolated: 2 or 3 dimensions, at least 2 bins and a non empty range on each used axis, a single z bin for 2D maps
+  static bool is_valid(int dimensions, const std::array<Axis, 3>& axes);
+
+  //! view on values stored elsewhere, which must outlive the grid
+  /*! the grid is left invalid if the axes are not valid */
+  TpcDistortionGrid(int dimensions, const std::array<Axis, 3>& axes, const float* values);
+
+  // copies of an owning grid view their own copy of the values
+  TpcDistortionGrid(const TpcDistortionGrid&);
+  TpcDistortionGrid& operator=(const TpcDistortionGrid&);
+  TpcDistortionGrid(TpcDistortionGrid&&) noexcept;
+  TpcDistortionGrid& operator=(TpcDistortionGrid&&) noexcept;
+  ~TpcDistortionGrid() = default;
+
+  //! true if the grid has values
+  bool valid() const { return m_values != nullptr; }
+
+  //! 2 for (phi, r) maps, 3 for (phi, r, z) maps
+  int dimensions() const { return m_dimensions; }
+
+  //! axis, 0 = phi, 1 = r, 2 = z
+  const Axis& axis(int i) const { return m_axes[i]; }
+  const std::array<Axis, 3>& axes() const { return m_axes; }
+
+  //! number of values
+  size_t size() const { return static_cast<size_t>(m_axes[0].nbins) * m_axes[1].nbins * m_axes[2].nbins; }
+
+  //! values, phi running fastest
+  const float* data() const { return m_values; }
+
+  //! value in a bin, bins start at 0
+  float value(unsigned int iphi, unsigned int ir, unsigned int iz = 0) const
+  {
+    return m_values[iphi + m_axes[0].nbins * (ir + m_axes[1].nbins * iz)];
+  }
+
+  //! interpolated value at (phi, r, z), 0 outside the interpolation region. z is ignored for 2D maps
+  double interpolate(double phi, double r, double z) const;
+
+  //! interpolated values of n points
+  /*! there are no branches in the loop over points, so that the compiler can vectorize it */
+  void interpolate(size_t n, const double* phi, const double* r, const double* z, double* values) const;
+
+ private:
+  //! set the bin scale factors from the axes
+  void update_scale();
+
+  int m_dimensions = 0;
+  std::array<Axis, 3> m_axes = {};
+
+  //! bins per unit length of each axis
+  std::array<double, 3> m_scale = {{0, 0, 0}};
+
+  //! values, when owned by the grid
+  std::vector<float> m_storage;
+
+  //! values, either m_storage or external
+  const float* m_values = nullptr;
+};
+
+#endif  // TRACKBASE_TPCDISTORTIONGRID_H
@@ -0,0 +1,476 @@
+/**
+ * @file trackbase/TpcDistortionMapFile.cc
+ * @brief Implementation of TpcDistortionMapFile
+ */
+#include "TpcDistortionMapFile.h"
+
+#include <TBranch.h>
+#include <TClass.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TObjArray.h>
+#include <TTree.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+  constexpr char file_magic[8] = {'T', 'P', 'C', 'D', 'M', 'A', 'P', '\0'};
+  constexpr uint32_t file_version = 1;
+
+  // alignment of the maps in the file
+  constexpr uint64_t map_alignment = 64;
+
+  // file header
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nmaps;
+    uint32_t nentries;
+    uint32_t reserved;
+    uint64_t entry_size;
+    uint64_t data_offset;
+  };
+
+  // map descriptor
+  struct MapHeader
+  {
+    char name[64];
+    int32_t dimensions;
+    uint32_t nbins[3];
+    double min[3];
+    double max[3];
+    uint64_t offset;
+  };
+
+  inline uint64_t align(uint64_t value)
+  {
+    return (value + map_alignment - 1) / map_alignment * map_alignment;
+  }
+
+  // descriptors of the maps and size of an entry, from the grids of the first entry
+  bool make_layout(const std::vector<std::string>& names, const std::vector<TpcDistortionGrid>& grids, std::vector<MapHeader>& headers, uint64_t& entry_size)
+  {
+    headers.clear();
+    entry_size = 0;
+    for (size_t i = 0; i < grids.size(); ++i)
+    {
+      const auto& grid = grids[i];
+      if (!grid.valid() || names[i].empty() || names[i].size() >= sizeof(MapHeader::name))
+      {
+        std::cout << "TpcDistortionMapFile::write - invalid map " << names[i] << std::endl;
+        return false;
+      }
+
+      MapHeader header{};
+      std::strncpy(header.name, names[i].c_str(), sizeof(header.name) - 1);
+      header.dimensions = grid.dimensions();
+      for (int j = 0; j < 3; ++j)
+      {
+        header.nbins[j] = grid.axis(j).nbins;
+        header.min[j] = grid.axis(j).min;
+        header.max[j] = grid.axis(j).max;
+      }
+      header.offset = entry_size;
+      entry_size = align(entry_size + grid.size() * sizeof(float));
+      headers.push_back(header);
+    }
+    return true;
+  }
+
+  // write the header and map descriptors
+  void write_header(std::ofstream& out, const std::vector<MapHeader>& headers, uint32_t nentries, uint64_t entry_size)
+  {
+    FileHeader header{};
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.nmaps = headers.size();
+    header.nentries = nentries;
+    header.entry_size = entry_size;
+    header.data_offset = align(sizeof(FileHeader) + headers.size() * sizeof(MapHeader));
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(headers.data()), headers.size() * sizeof(MapHeader));
+    const std::vector<char> padding(header.data_offset - sizeof(FileHeader) - headers.size() * sizeof(MapHeader), 0);
+    out.write(padding.data(), padding.size());
+  }
+
+  // write the values of the maps of one entry, which must match the descriptors
+  bool write_entry(std::ofstream& out, const std::vector<MapHeader>& headers, uint64_t entry_size, const std::vector<TpcDistortionGrid>& grids)
+  {
+    if (grids.size() != headers.size())
+    {
+      std::cout << "TpcDistortionMapFile::write - inconsistent number of maps" << std::endl;
+      return false;
+    }
+
+    uint64_t written = 0;
+    for (size_t i = 0; i < grids.size(); ++i)
+    {
+      const auto& grid = grids[i];
+      const auto& header = headers[i];
+      bool consistent = grid.valid() && grid.dimensions() == header.dimensions;
+      for (int j = 0; j < 3 && consistent; ++j)
+      {
+        consistent = grid.axis(j).nbins == header.nbins[j] && grid.axis(j).min == header.min[j] && grid.axis(j).max == header.max[j];
+      }
+      if (!consistent)
+      {
+        std::cout << "TpcDistortionMapFile::write - map " << header.name << " does not have the same axes in all entries" << std::endl;
+        return false;
+      }
+
+      const std::vector<char> padding(header.offset - written, 0);
+      out.write(padding.data(), padding.size());
+      out.write(reinterpret_cast<const char*>(grid.data()), grid.size() * sizeof(float));
+      written = header.offset + grid.size() * sizeof(float);
+    }
+
+    const std::vector<char> padding(entry_size - written, 0);
+    out.write(padding.data(), padding.size());
+    return out.good();
+  }
+
+}  // namespace
+
+//_____________________________________________________________________
+TpcDistortionMapFile::TpcDistortionMapFile(const std::string& filename)
+{
+  open(filename);
+}
+
+//_____________________________________________________________________
+TpcDistortionMapFile::~TpcDistortionMapFile()
+{
+  close();
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapFile::is_map_file(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  char magic[sizeof(file_magic)] = {};
+  in.read(magic, sizeof(magic));
+  return in.good() && std::memcmp(magic, file_magic, sizeof(file_magic)) == 0;
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapFile::write(const std::string& filename, const std::vector<std::string>& names, const std::vector<std::vector<TpcDistortionGrid>>& entries)
+{
+  if (entries.empty() || entries.front().size() != names.size())
+  {
+    std::cout << "TpcDistortionMapFile::write - inconsistent names and maps" << std::endl;
+    return false;
+  }
+
+  std::vector<MapHeader> headers;
+  uint64_t entry_size = 0;
+  if (!make_layout(names, entries.front(), headers, entry_size))
+  {
+    return false;
+  }
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "TpcDistortionMapFile::write - cannot open " << filename << std::endl;
+    return false;
+  }
+
+  write_header(out, headers, entries.size(), entry_size);
+  for (const auto& grids : entries)
+  {
+    if (!write_entry(out, headers, entry_size, grids))
+    {
+      return false;
+    }
+  }
+  return out.good();
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapFile::convert(const std::string& rootfile, const std::string& filename, const std::string& treename)
+{
+  std::unique_ptr<TFile> input(TFile::Open(rootfile.c_str()));
+  if (!input || !input->IsOpen())
+  {
+    std::cout << "TpcDistortionMapFile::convert - cannot open " << rootfile << std::endl;
+    return false;
+  }
+
+  auto tree = dynamic_cast<TTree*>(input->Get(treename.c_str()));
+  if (!tree)
+  {
+    // static distortions: all the 2D and 3D histograms of the file
+    std::vector<std::string> names;
+    std::vector<TpcDistortionGrid> grids;
+    for (TObject* object : *input->GetListOfKeys())
+    {
+      const auto key = static_cast<TKey*>(object);
+      const auto cl = TClass::GetClass(key->GetClassName());
+      if (!cl || !cl->InheritsFrom(TH1::Class()))
+      {
+        continue;
+      }
+      if (std::find(names.begin(), names.end(), key->GetName()) != names.end())
+      {
+        // older cycle of a histogram already converted
+        continue;
+      }
+      std::unique_ptr<TH1> h(static_cast<TH1*>(key->ReadObj()));
+      if (!TpcDistortionGrid::is_supported(h.get()))
+      {
+        std::cout << "TpcDistortionMapFile::convert - skipping " << key->GetName() << std::endl;
+        continue;
+      }
+      names.emplace_back(key->GetName());
+      grids.emplace_back(h.get());
+    }
+
+    std::cout << "TpcDistortionMapFile::convert - " << rootfile << ": " << names.size() << " maps" << std::endl;
+    return !names.empty() && write(filename, names, std::vector<std::vector<TpcDistortionGrid>>(1, grids));
+  }
+
+  // time ordered distortions: one histogram per branch and per entry
+  // entries are written one at a time, so that they are never all in memory
+  std::vector<std::string> names;
+  std::vector<TH1*> histograms;
+  for (TObject* object : *tree->GetListOfBranches())
+  {
+    const auto branch = static_cast<TBranch*>(object);
+    const auto cl = TClass::GetClass(branch->GetClassName());
+    if (cl && cl->InheritsFrom(TH1::Class()))
+    {
+      names.emplace_back(branch->GetName());
+    }
+  }
+  histograms.resize(names.size(), nullptr);
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    tree->SetBranchAddress(names[i].c_str(), &histograms[i]);
+  }
+
+  const auto nentries = tree->GetEntries();
+  std::ofstream out;
+  std::vector<MapHeader> headers;
+  uint64_t entry_size = 0;
+  bool success = true;
+  for (Long64_t entry = 0; entry < nentries && success; ++entry)
+  {
+    tree->GetEntry(entry);
+    std::vector<TpcDistortionGrid> grids;
+    for (const auto& h : histograms)
+    {
+      grids.emplace_back(h);
+    }
+
+    if (entry == 0)
+    {
+      if (!make_layout(names, grids, headers, entry_size))
+      {
+        success = false;
+        break;
+      }
+      out.open(filename, std::ios::binary | std::ios::trunc);
+      if (!out)
+      {
+        std::cout << "TpcDistortionMapFile::convert - cannot open " << filename << std::endl;
+        success = false;
+        break;
+      }
+      write_header(out, headers, nentries, entry_size);
+    }
+
+    success = write_entry(out, headers, entry_size, grids);
+  }
+
+  // the histograms read from the branches are owned here, also when the conversion failed
+  tree->ResetBranchAddresses();
+  for (const auto& h : histograms)
+  {
+    delete h;
+  }
+
+  if (!success)
+  {
+    return false;
+  }
+
+  std::cout << "TpcDistortionMapFile::convert - " << rootfile << ": " << names.size() << " maps, " << nentries << " entries" << std::endl;
+  return nentries > 0 && out.good();
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapFile::open(const std::string& filename)
+{
+  close();
+
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "TpcDistortionMapFile::open - cannot open " << filename << std::endl;
+    return false;
+  }
+
+  struct stat status = {};
+  if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(FileHeader))
+  {
+    std::cout << "TpcDistortionMapFile::open - " << filename << " is not a distortion map file" << std::endl;
+    ::close(fd);
+    return false;
+  }
+
+  void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+  {
+    std::cout << "TpcDistortionMapFile::open - cannot map " << filename << std::endl;
+    return false;
+  }
+  m_data = static_cast<const char*>(data);
+  m_size = status.st_size;
+
+  // check header and layout
+  FileHeader header{};
+  std::memcpy(&header, m_data, sizeof(header));
+  const uint64_t headers_end = sizeof(FileHeader) + static_cast<uint64_t>(header.nmaps) * sizeof(MapHeader);
+  if (std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+      header.version != file_version ||
+      headers_end > m_size ||
+      header.data_offset < headers_end ||
+      header.data_offset > m_size ||
+      header.data_offset % sizeof(float) != 0 ||
+      header.entry_size % sizeof(float) != 0 ||
+      (header.nentries > 0 && header.entry_size > (m_size - header.data_offset) / header.nentries))
+  {
+    std::cout << "TpcDistortionMapFile::open - " << filename << " is not a valid distortion map file" << std::endl;
+    close();
+    return false;
+  }
+
+  m_entries = header.nentries;
+  m_entry_size = header.entry_size;
+  m_data_offset = header.data_offset;
+  for (uint32_t i = 0; i < header.nmaps; ++i)
+  {
+    MapHeader map{};
+    std::memcpy(&map, m_data + sizeof(FileHeader) + i * sizeof(MapHeader), sizeof(map));
+    map.name[sizeof(map.name) - 1] = 0;
+
+    // the interpolation reads neighbouring bins without bound checks, the axes must be valid
+    std::array<TpcDistortionGrid::Axis, 3> axes = {};
+    for (int j = 0; j < 3; ++j)
+    {
+      axes[j] = {map.nbins[j], map.min[j], map.max[j]};
+    }
+    if (!TpcDistortionGrid::is_valid(map.dimensions, axes))
+    {
+      std::cout << "TpcDistortionMapFile::open - " << filename << " map " << map.name << " has invalid axes" << std::endl;
+      close();
+      return false;
+    }
+
+    // number of values, without overflowing for corrupted bin counts
+    const uint64_t max_size = m_entry_size / sizeof(float);
+    uint64_t size = 1;
+    for (int j = 0; j < 3 && size <= max_size; ++j)
+    {
+      size *= map.nbins[j];
+    }
+    if (map.offset % sizeof(float) != 0 || map.offset > m_entry_size || size > (m_entry_size - map.offset) / sizeof(float))
+    {
+      std::cout << "TpcDistortionMapFile::open - " << filename << " map " << map.name << " is out of its entry" << std::endl;
+      close();
+      return false;
+    }
+
+    m_names.emplace_back(map.name);
+    m_dimensions.push_back(map.dimensions);
+    m_axes.push_back(axes);
+    m_offsets.push_back(map.offset);
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapFile::close()
+{
+  if (m_data)
+  {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_entries = 0;
+  m_entry_size = 0;
+  m_data_offset = 0;
+  m_names.clear();
+  m_dimensions.clear();
+  m_axes.clear();
+  m_offsets.clear();
+}
+
+//_____________________________________________________________________
+const char* TpcDistortionMapFile::entry_begin(unsigned int entry) const
+{
+  return m_data + m_data_offset + entry * m_entry_size;
+}
+
+//_____________________________________________________________________
+TpcDistortionGrid TpcDistortionMapFile::get(const std::string& name, unsigned int entry) const
+{
+  const auto iter = std::find(m_names.begin(), m_names.end(), name);
+  if (iter == m_names.end() || entry >= m_entries)
+  {
+    return TpcDistortionGrid();
+  }
+
+  const size_t i = std::distance(m_names.begin(), iter);
+  const auto values = reinterpret_cast<const float*>(entry_begin(entry) + m_offsets[i]);
+  return TpcDistortionGrid(m_dimensions[i], m_axes[i], values);
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapFile::prefetch(unsigned int entry) const
+{
+  if (entry >= m_entries)
+  {
+    return;
+  }
+
+  // madvise needs page aligned addresses
+  static const uintptr_t pagesize = sysconf(_SC_PAGESIZE);
+  const auto begin = reinterpret_cast<uintptr_t>(entry_begin(entry)) / pagesize * pagesize;
+  const auto end = reinterpret_cast<uintptr_t>(entry_begin(entry)) + m_entry_size;
+  madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapFile::release(unsigned int entry) const
+{
+  if (entry >= m_entries)
+  {
+    return;
+  }
+
+  // only whole pages of the entry are released, pages shared with the neighbouring entries are kept
+  static const uintptr_t pagesize = sysconf(_SC_PAGESIZE);
+  const auto begin = (reinterpret_cast<uintptr_t>(entry_begin(entry)) + pagesize - 1) / pagesize * pagesize;
+  const auto end = (reinterpret_cast<uintptr_t>(entry_begin(entry)) + m_entry_size) / pagesize * pagesize;
+  if (end > begin)
+  {
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+  }
+}
@@ -0,0 +1,107 @@
+#ifndef TRACKBASE_TPCDISTORTIONMAPFILE_H
+#define TRACKBASE_TPCDISTORTIONMAPFILE_H
+
+/**
+ * @file trackbase/TpcDistortionMapFile.h
+ * @brief Binary file of TPC distortion grids, read through a memory mapping
+ */
+
+#include "TpcDistortionGrid.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Binary file with one or several entries of TPC distortion maps.
+ * A static distortion file has one entry, a time ordered distortion file
+ * has one entry per beam crossing sequence, all with the same maps and axes.
+ *
+ * The file is a header, one descriptor per map (name, dimensions, axes,
+ * offset), then the float values of the maps of each entry, each map
+ * aligned to 64 bytes. The file is memory mapped when opened: the grids
+ * returned by get() view the mapping without copy, and the pages of an
+ * entry are only read from disk when its maps are used. prefetch() and
+ * release() let a reader of time ordered maps page in the next entry and
+ * drop the previous one.
+ *
+ * The values are in native byte order, files are not portable across
+ * architectures with different endianness.
+ *
+ * convert() makes a file from the ROOT distortion files: either the
+ * histograms of a static file, or the histograms of all entries of the
+ * "TimeDists" tree of a time ordered file.
+ */
+class TpcDistortionMapFile
+{
+ public:
+  //! constructor
+  TpcDistortionMapFile() = default;
+
+  //! constructor, opens the file
+  explicit TpcDistortionMapFile(const std::string& filename);
+
+  //! destructor, unmaps the file
+  ~TpcDistortionMapFile();
+
+  // the mapping cannot be shared
+  TpcDistortionMapFile(const TpcDistortionMapFile&) = delete;
+  TpcDistortionMapFile& operator=(const TpcDistortionMapFile&) = delete;
+
+  //! true if the file starts like a distortion map file
+  static bool is_map_file(const std::string& filename);
+
+  //! write maps to a file. entries[ientry][imap] is the map names[imap] of entry ientry
+  /*! all entries must have the same axes. Returns false on failure */
+  static bool write(const std::string& filename, const std::vector<std::string>& names, const std::vector<std::vector<TpcDistortionGrid>>& entries);
+
+  //! convert a ROOT distortion file, static or time ordered, to a distortion map file. Returns false on failure
+  static bool convert(const std::string& rootfile, const std::string& filename, const std::string& treename = "TimeDists");
+
+  //! map a file, returns false if it is not a valid distortion map file
+  bool open(const std::string& filename);
+
+  //! unmap the file. Grids obtained from it become invalid
+  void close();
+
+  //! true if a file is mapped
+  bool is_open() const { return m_data != nullptr; }
+
+  //! number of entries
+  unsigned int entries() const { return m_entries; }
+
+  //! names of the maps
+  const std::vector<std::string>& names() const { return m_names; }
+
+  //! grid viewing the map with a given name in an entry, invalid grid if there is no such map
+  TpcDistortionGrid get(const std::string& name, unsigned int entry = 0) const;
+
+  //! tell the kernel that the maps of an entry will be read soon
+  void prefetch(unsigned int entry) const;
+
+  //! tell the kernel that the maps of an entry are not needed anymore
+  void release(unsigned int entry) const;
+
+ private:
+  //! first byte of an entry in the mapping
+  const char* entry_begin(unsigned int entry) const;
+
+  //! mapping
+  const char* m_data = nullptr;
+  size_t m_size = 0;
+
+  //!@name layout
+  //@{
+  unsigned int m_entries = 0;
+  uint64_t m_entry_size = 0;
+  uint64_t m_data_offset = 0;
+  std::vector<std::string> m_names;
+  std::vector<int> m_dimensions;
+  std::vector<std::array<TpcDistortionGrid::Axis, 3>> m_axes;
+  std::vector<uint64_t> m_offsets;
+  //@}
+};
+
+#endif  // TRACKBASE_TPCDISTORTIONMAPFILE_H
@@ -0,0 +1,112 @@
+/**
+ * @file trackbase/TrkrClusterPositionCache.cc
+ * @brief Implementation of TrkrClusterPositionCache
+ */
+#include "TrkrClusterPositionCache.h"
+
+#include <phool/phool.h>
+
+#include <cstdlib>  // for exit
+#include <iostream>
+
+void TrkrClusterPositionCache::Positions::Reset()
+{
+  // clear() keeps the capacity, which saves the allocations in the next event
+  m_hitsets.clear();
+  m_keys.clear();
+  m_x.clear();
+  m_y.clear();
+  m_z.clear();
+  m_filled.clear();
+  m_corrections = 0;
+}
+
+void TrkrClusterPositionCache::Positions::addHitSet(TrkrDefs::hitsetkey hitsetkey, unsigned int nclusters)
+{
+  const auto [iter, inserted] = m_hitsets.try_emplace(hitsetkey, m_keys.size(), nclusters);
+  if (!inserted)
+  {
+    std::cout << PHWHERE << " hitset " << hitsetkey << " added twice, exiting" << std::endl;
+    exit(1);
+  }
+
+  const unsigned int newsize = m_keys.size() + nclusters;
+  m_keys.resize(newsize, 0);
+  m_x.resize(newsize, 0);
+  m_y.resize(newsize, 0);
+  m_z.resize(newsize, 0);
+  m_filled.resize(newsize, 0);
+}
+
+void TrkrClusterPositionCache::Positions::set(TrkrDefs::cluskey key, const Acts::Vector3& position)
+{
+  const auto iter = m_hitsets.find(TrkrDefs::getHitSetKeyFromClusKey(key));
+  const auto clusindex = TrkrDefs::getClusIndex(key);
+  if (iter == m_hitsets.end() || clusindex >= iter->second.second)
+  {
+    std::cout << PHWHERE << " no slot for cluster " << key << ", exiting" << std::endl;
+    exit(1);
+  }
+
+  const unsigned int index = iter->second.first + clusindex;
+  m_keys[index] = key;
+  m_x[index] = position.x();
+  m_y[index] = position.y();
+  m_z[index] = position.z();
+  m_filled[index] = 1;
+}
+
+int TrkrClusterPositionCache::Positions::index(TrkrDefs::cluskey key) const
+{
+  const auto iter = m_hitsets.find(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (iter == m_hitsets.end())
+  {
+    return -1;
+  }
+
+  const auto clusindex = TrkrDefs::getClusIndex(key);
+  if (clusindex >= iter->second.second)
+  {
+    return -1;
+  }
+
+  const unsigned int index = iter->second.first + clusindex;
+  return m_filled[index] ? static_cast<int>(index) : -1;
+}
+
+bool TrkrClusterPositionCache::Positions::find(TrkrDefs::cluskey key, Acts::Vector3& position) const
+{
+  const int index = this->index(key);
+  if (index < 0)
+  {
+    return false;
+  }
+  position = this->position(index);
+  return true;
+}
+
+void TrkrClusterPositionCache::Reset()
+{
+  for (auto& [key, positions] : m_positions)
+  {
+    positions.Reset();
+  }
+}
+
+TrkrClusterPositionCache::Positions& TrkrClusterPositionCache::addCrossing(short crossing, unsigned int corrections)
+{
+  auto& positions = m_positions[{crossing, corrections}];
+  positions.Reset();
+  positions.setCorrections(corrections);
+  return positions;
+}
+
+const TrkrClusterPositionCache::Positions* TrkrClusterPositionCache::get(short crossing, unsigned int corrections) const
+{
+  const auto iter = m_positions.find({crossing, corrections});
+  if (iter == m_positions.end() || iter->second.size() == 0)
+  {
+    return nullptr;
+  }
+  return &iter->second;
+}
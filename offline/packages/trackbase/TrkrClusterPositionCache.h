@@ -0,0 +1,126 @@
+#ifndef TRACKBASE_TRKRCLUSTERPOSITIONCACHE_H
+#define TRACKBASE_TRKRCLUSTERPOSITIONCACHE_H
+
+/**
+ * @file trackbase/TrkrClusterPositionCache.h
+ * @brief Per event cache of the corrected global cluster positions
+ */
+#include "TrkrDefs.h"
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>  // for pair
+#include <vector>
+
+/**
+ * Global positions of the clusters, including the TPC crossing and
+ * distortion corrections, computed once per event by
+ * PHClusterPositionCacheMaker. Seeding, propagation and fitting modules
+ * which opt in read them here instead of redoing the surface transforms
+ * and corrections for the same clusters.
+ *
+ * The positions of one crossing hypothesis and set of distortion
+ * corrections are stored as arrays addressed by a dense index. Each hitset
+ * owns a contiguous block of indices (one slot per cluster index of the
+ * hitset), so the index of a cluster key is one hash lookup of its hitset.
+ *
+ * It is a transient object on the node tree (PHDataNode "TRKR_CLUSTERPOSITIONS"),
+ * reads are thread safe.
+ */
+class TrkrClusterPositionCache
+{
+ public:
+  //! crossing hypothesis for positions without crossing correction of the TPC z
+  static constexpr short NoCrossing = SHRT_MAX;
+
+  //! TPC distortion corrections applied to the positions
+  enum Correction : unsigned int
+  {
+    StaticCorrection = 1U << 0U,
+    AverageCorrection = 1U << 1U,
+    FluctuationCorrection = 1U << 2U
+  };
+
+  //! Correction bits for the corrections a module applies
+  static unsigned int corrections(bool static_correction, bool average_correction, bool fluctuation_correction)
+  {
+    return (static_correction ? StaticCorrection : 0U) |
+           (average_correction ? AverageCorrection : 0U) |
+           (fluctuation_correction ? FluctuationCorrection : 0U);
+  }
+
+  //! cluster positions of one crossing hypothesis
+  class Positions
+  {
+   public:
+    //! reserve the indices for the clusters of a hitset, cluster index < nclusters
+    void addHitSet(TrkrDefs::hitsetkey hitsetkey, unsigned int nclusters);
+
+    //! store the position of a cluster, its hitset must have been added
+    void set(TrkrDefs::cluskey key, const Acts::Vector3& position);
+
+    //! dense index of the cluster, -1 if it is not cached
+    int index(TrkrDefs::cluskey key) const;
+
+    //! position of the cluster, false if it is not cached
+    bool find(TrkrDefs::cluskey key, Acts::Vector3& position) const;
+
+    //! position at a dense index
+    Acts::Vector3 position(unsigned int index) const
+    {
+      return {m_x[index], m_y[index], m_z[index]};
+    }
+
+    //! TPC distortion corrections (Correction bits) which went into the positions
+    void setCorrections(unsigned int corrections) { m_corrections = corrections; }
+    unsigned int getCorrections() const { return m_corrections; }
+
+    //! number of dense indices, including unused slots
+    unsigned int size() const { return m_keys.size(); }
+
+    //!@name arrays addressed by the dense index
+    //@{
+    const std::vector<TrkrDefs::cluskey>& keys() const { return m_keys; }
+    const std::vector<double>& x() const { return m_x; }
+    const std::vector<double>& y() const { return m_y; }
+    const std::vector<double>& z() const { return m_z; }
+    //! 0 for slots without cluster
+    const std::vector<uint8_t>& filled() const { return m_filled; }
+    //@}
+
+    void Reset();
+
+   private:
+    //! first index and number of slots of each hitset
+    std::unordered_map<TrkrDefs::hitsetkey, std::pair<unsigned int, unsigned int>> m_hitsets;
+
+    std::vector<TrkrDefs::cluskey> m_keys;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<uint8_t> m_filled;
+
+    unsigned int m_corrections = 0;
+  };
+
+  //! clear the positions of all crossing hypotheses
+  void Reset();
+
+  //! (cleared) positions of a crossing hypothesis with the given Correction bits, to be filled by the producer
+  Positions& addCrossing(short crossing, unsigned int corrections);
+
+  //! positions of a crossing hypothesis with exactly the given Correction bits,
+  //! nullptr if they were not filled in this event
+  const Positions* get(short crossing, unsigned int corrections) const;
+
+ private:
+  //! blocks are keyed by crossing and corrections, readers applying
+  //! different corrections (e.g. seeding and propagation) get their own
+  std::map<std::pair<short, unsigned int>, Positions> m_positions;
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERPOSITIONCACHE_H
@@ -5,6 +5,7 @@
  * @brief Implementation of TrkrHitSet
  */
 #include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
 
 namespace
 {
@@ -17,6 +18,18 @@ TrkrHitSet::addHitSpecificKey(const TrkrDefs::hitkey /*unused*/, TrkrHit* /*unus
   return dummy_map.cbegin();
 }
 
+void TrkrHitSet::appendHit(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  TrkrHit* hit = getHit(key);
+  if (!hit)
+  {
+    hit = new TrkrHitv2;
+    addHitSpecificKey(key, hit);
+  }
+  // setAdc saturates at the maximum adc value
+  hit->setAdc(hit->getAdc() + adc);
+}
+
 TrkrHitSet::ConstRange
 TrkrHitSet::getHits() const
 {
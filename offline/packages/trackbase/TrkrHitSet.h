@@ -11,7 +11,9 @@
 
 #include <phool/PHObject.h>
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <utility>  // for pair
 
@@ -31,7 +33,101 @@ class TrkrHitSet : public PHObject
  public:
   // iterator typedef
   using Map = std::map<TrkrDefs::hitkey, TrkrHit*>;
-  using ConstIterator = Map::const_iterator;
+
+  /**
+   * @brief Iterator over (hitkey, hit) pairs
+   *
+   * Walks either a key to hit map (TrkrHitSetv1) or a contiguous array of
+   * (hitkey, hit) pairs (TrkrHitSetv2), so getHits() is iterated the same
+   * way for all storage backends.
+   */
+  class ConstIterator
+  {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    ConstIterator() = default;
+
+    // implicit, map based storage backends return their map iterators
+    ConstIterator(Map::const_iterator iter)  // NOLINT(hicpp-explicit-conversions)
+      : m_iter(iter)
+    {
+    }
+
+    ConstIterator(Map::iterator iter)  // NOLINT(hicpp-explicit-conversions)
+      : m_iter(iter)
+    {
+    }
+
+    explicit ConstIterator(pointer ptr)
+      : m_ptr(ptr)
+      , m_contiguous(true)
+    {
+    }
+
+    reference operator*() const { return m_contiguous ? *m_ptr : *m_iter; }
+    pointer operator->() const { return &(**this); }
+
+    ConstIterator& operator++()
+    {
+      if (m_contiguous)
+      {
+        ++m_ptr;
+      }
+      else
+      {
+        ++m_iter;
+      }
+      return *this;
+    }
+
+    ConstIterator operator++(int)
+    {
+      ConstIterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    ConstIterator& operator--()
+    {
+      if (m_contiguous)
+      {
+        --m_ptr;
+      }
+      else
+      {
+        --m_iter;
+      }
+      return *this;
+    }
+
+    ConstIterator operator--(int)
+    {
+      ConstIterator tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    friend bool operator==(const ConstIterator& lhs, const ConstIterator& rhs)
+    {
+      return lhs.m_contiguous ? lhs.m_ptr == rhs.m_ptr : lhs.m_iter == rhs.m_iter;
+    }
+
+    friend bool operator!=(const ConstIterator& lhs, const ConstIterator& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+   private:
+    Map::const_iterator m_iter;
+    pointer m_ptr = nullptr;
+    bool m_contiguous = false;
+  };
+
   using ConstRange = std::pair<ConstIterator, ConstIterator>;
 
   //! TObject functions
@@ -70,6 +166,34 @@ class TrkrHitSet : public PHObject
    */
   virtual ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*);
 
+  /**
+   * @brief Bulk fill: add adc to the hit with this key, creating it if needed.
+   * @param[in] key Hit key
+   * @param[in] adc adc value to be added
+   *
+   * The default goes through getHit() and addHitSpecificKey(). Storage
+   * backends which keep their hits contiguous (TrkrHitSetv2) only append
+   * here and sort/merge all appended hits once in finalizeHits().
+   */
+  virtual void appendHit(const TrkrDefs::hitkey, const unsigned int adc);
+
+  /**
+   * @brief Reserve storage for the given number of hits (bulk fill)
+   */
+  virtual void reserveHits(const unsigned int)
+  {
+  }
+
+  /**
+   * @brief Sort and merge hits added with appendHit/addHitSpecificKey
+   *
+   * To be called once by the producer after the hitset is filled.
+   * Pointers to hits obtained before may become invalid.
+   */
+  virtual void finalizeHits()
+  {
+  }
+
   /**
    * @brief Remove a hit using its key
    * @param[in] key to be removed
@@ -181,6 +181,11 @@ void TrkrHitSetContainerv2::syncMapArray(void) const
       assert(hitset);
     }
     else
+    {
+      // hitsets read back from the DST build their transient state (the hit
+      // index of TrkrHitSetv2) here, before they are handed out to readers
+      hitset->finalizeHits();
       m_hitmap[hitset->getHitSetKey()] = hitset;
+    }
   }
 }
@@ -0,0 +1,179 @@
+/**
+ * @file trackbase/TrkrHitSetStaging.cc
+ * @brief Implementation of TrkrHitSetStaging
+ */
+#include "TrkrHitSetStaging.h"
+
+#include "TrkrHitSet.h"
+#include "TrkrHitSetContainer.h"
+
+#include <phool/PHThreadPool.h>
+
+#include <algorithm>
+#include <climits>  // for USHRT_MAX
+
+namespace
+{
+  // call func(task) for all tasks, using the thread pool if any
+  template <class T>
+  void for_each_task(PHThreadPool* pool, size_t ntasks, T&& func)
+  {
+    if (pool && pool->size() > 1 && ntasks > 1)
+    {
+      pool->parallel_for(ntasks, [&func](size_t task, unsigned int /*thread*/)
+                         { func(task); });
+    }
+    else
+    {
+      for (size_t task = 0; task < ntasks; ++task)
+      {
+        func(task);
+      }
+    }
+  }
+}  // namespace
+
+//_____________________________________________________________________
+TrkrHitSetStaging::TrkrHitSetStaging(unsigned int nbuffers)
+{
+  setNBuffers(nbuffers);
+}
+
+//_____________________________________________________________________
+void TrkrHitSetStaging::setNBuffers(unsigned int nbuffers)
+{
+  m_buffers.clear();
+  m_buffers.resize(std::max(1U, nbuffers));
+  m_segments.resize(m_buffers.size());
+}
+
+//_____________________________________________________________________
+size_t TrkrHitSetStaging::size() const
+{
+  size_t n = 0;
+  for (const auto& buffer : m_buffers)
+  {
+    n += buffer.size();
+  }
+  return n;
+}
+
+//_____________________________________________________________________
+void TrkrHitSetStaging::clear()
+{
+  for (auto& buffer : m_buffers)
+  {
+    buffer.clear();
+  }
+}
+
+//_____________________________________________________________________
+unsigned int TrkrHitSetStaging::getAdc(double edep)
+{
+  // same conversion and saturation as TrkrHitv2::addEnergy
+  const double ein = edep * TrkrDefs::EdepScaleFactor;
+  if (ein >= USHRT_MAX)
+  {
+    return USHRT_MAX;
+  }
+  return ein > 0 ? static_cast<unsigned int>(ein) : 0;
+}
+
+//_____________________________________________________________________
+void TrkrHitSetStaging::reduce(std::vector<Record>& records, unsigned int buffer, std::vector<Segment>& segments)
+{
+  segments.clear();
+  if (records.empty())
+  {
+    return;
+  }
+
+  std::sort(records.begin(), records.end(), [](const Record& lhs, const Record& rhs)
+            { return lhs.hitsetkey < rhs.hitsetkey || (lhs.hitsetkey == rhs.hitsetkey && lhs.hitkey < rhs.hitkey); });
+
+  // sum adc of records with the same keys, in place
+  auto out = records.begin();
+  out->adc = std::min<unsigned int>(out->adc, USHRT_MAX);
+  for (auto in = records.begin() + 1; in != records.end(); ++in)
+  {
+    const unsigned int adc = std::min<unsigned int>(in->adc, USHRT_MAX);
+    if (in->hitsetkey == out->hitsetkey && in->hitkey == out->hitkey)
+    {
+      out->adc = std::min<unsigned int>(out->adc + adc, USHRT_MAX);
+    }
+    else
+    {
+      *(++out) = {in->hitsetkey, in->hitkey, adc};
+    }
+  }
+  records.erase(out + 1, records.end());
+
+  // one segment per hitset
+  size_t begin = 0;
+  for (size_t i = 1; i <= records.size(); ++i)
+  {
+    if (i == records.size() || records[i].hitsetkey != records[begin].hitsetkey)
+    {
+      segments.push_back({records[begin].hitsetkey, buffer, begin, i});
+      begin = i;
+    }
+  }
+}
+
+//_____________________________________________________________________
+void TrkrHitSetStaging::merge(TrkrHitSetContainer* container, PHThreadPool* pool)
+{
+  // sort and reduce each buffer
+  for_each_task(pool, m_buffers.size(), [this](size_t i)
+                { reduce(m_buffers[i].m_records, i, m_segments[i]); });
+
+  // group segments by hitset, segments of one buffer are already sorted
+  std::vector<Segment> segments;
+  for (const auto& buffer_segments : m_segments)
+  {
+    const auto middle = segments.insert(segments.end(), buffer_segments.begin(), buffer_segments.end());
+    std::inplace_merge(segments.begin(), middle, segments.end(), [](const Segment& lhs, const Segment& rhs)
+                       { return lhs.hitsetkey < rhs.hitsetkey; });
+  }
+
+  // create the hitsets serially, the container is not thread safe
+  struct HitSetSegments
+  {
+    TrkrHitSet* hitset = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+  std::vector<HitSetSegments> hitsets;
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    if (hitsets.empty() || segments[hitsets.back().begin].hitsetkey != segments[i].hitsetkey)
+    {
+      hitsets.push_back({container->findOrAddHitSet(segments[i].hitsetkey)->second, i, i});
+    }
+    hitsets.back().end = i + 1;
+  }
+
+  // fill the hitsets, each one is filled by a single thread
+  for_each_task(pool, hitsets.size(), [this, &segments, &hitsets](size_t i)
+                {
+    const auto& entry = hitsets[i];
+    size_t nhits = 0;
+    for (size_t iseg = entry.begin; iseg < entry.end; ++iseg)
+    {
+      nhits += segments[iseg].end - segments[iseg].begin;
+    }
+    entry.hitset->reserveHits(entry.hitset->size() + nhits);
+
+    for (size_t iseg = entry.begin; iseg < entry.end; ++iseg)
+    {
+      const auto& segment = segments[iseg];
+      const auto& records = m_buffers[segment.buffer].m_records;
+      for (size_t irec = segment.begin; irec < segment.end; ++irec)
+      {
+        entry.hitset->appendHit(records[irec].hitkey, records[irec].adc);
+      }
+    }
+    entry.hitset->finalizeHits(); });
+
+  clear();
+}
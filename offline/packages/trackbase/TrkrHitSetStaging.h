@@ -0,0 +1,130 @@
+#ifndef TRACKBASE_TRKRHITSETSTAGING_H
+#define TRACKBASE_TRKRHITSETSTAGING_H
+/**
+ * @file trackbase/TrkrHitSetStaging.h
+ * @brief Per thread staging of hits before they are merged into a TrkrHitSetContainer
+ */
+
+#include "TrkrDefs.h"
+
+#include <cstddef>
+#include <vector>
+
+class PHThreadPool;
+class TrkrHitSetContainer;
+
+/**
+ * Transient staging area for hit producers (digitizers, hit reco modules).
+ *
+ * Hits are appended as (hitsetkey, hitkey, adc) records to a Buffer without
+ * touching the container. Each thread of a parallel producer owns one buffer,
+ * so no locking is needed while staging. merge() then sorts and reduces all
+ * buffers and fills the container with one findOrAddHitSet per hitset and
+ * one bulk fill (TrkrHitSet::appendHit) per hitset.
+ *
+ * Adc values of records with the same keys are summed, saturating at
+ * USHRT_MAX, and the sum is added to the adc of the hit in the container, if
+ * any. Staging energies with Buffer::addEnergy gives the same hits as calling
+ * TrkrHitv2::addEnergy for each of them.
+ */
+class TrkrHitSetStaging
+{
+ public:
+  //! staged hit
+  struct Record
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    TrkrDefs::hitkey hitkey = 0;
+    unsigned int adc = 0;
+  };
+
+  //! append only list of staged hits, used by one thread at a time
+  class Buffer
+  {
+   public:
+    //! stage adc for a given hit
+    void addHit(TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, unsigned int adc)
+    {
+      m_records.push_back({hitsetkey, hitkey, adc});
+    }
+
+    //! stage energy for a given hit, converted to adc the same way as TrkrHitv2::addEnergy
+    void addEnergy(TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, double edep)
+    {
+      addHit(hitsetkey, hitkey, TrkrHitSetStaging::getAdc(edep));
+    }
+
+    //! reserve space for records
+    void reserve(size_t n) { m_records.reserve(n); }
+
+    //! number of staged records
+    size_t size() const { return m_records.size(); }
+
+    //! true if no record is staged
+    bool empty() const { return m_records.empty(); }
+
+    //! remove all records, keeping the allocated memory
+    void clear() { m_records.clear(); }
+
+    //! staged records
+    const std::vector<Record>& getRecords() const { return m_records; }
+
+   private:
+    friend class TrkrHitSetStaging;
+    std::vector<Record> m_records;
+  };
+
+  //! constructor
+  explicit TrkrHitSetStaging(unsigned int nbuffers = 1);
+
+  //! set number of buffers, typically the number of threads of the producer. Staged records are dropped
+  void setNBuffers(unsigned int);
+
+  //! number of buffers
+  unsigned int getNBuffers() const { return m_buffers.size(); }
+
+  //! buffer for a given thread
+  Buffer& getBuffer(unsigned int i = 0) { return m_buffers[i]; }
+
+  //! total number of staged records
+  size_t size() const;
+
+  //! true if no record is staged
+  bool empty() const { return size() == 0; }
+
+  //! remove all staged records
+  void clear();
+
+  /**
+   * @brief Add all staged records to the container and clear the buffers
+   * @param container destination container
+   * @param pool optional thread pool, used to sort the buffers and fill the hitsets in parallel
+   *
+   * Hitsets are created serially, filling them is done in parallel over hitsets.
+   * Must not be called while records are being staged.
+   */
+  void merge(TrkrHitSetContainer* container, PHThreadPool* pool = nullptr);
+
+  //! convert energy to adc the same way as TrkrHitv2::addEnergy
+  static unsigned int getAdc(double edep);
+
+ private:
+  //! range of records of one hitset, in one buffer
+  struct Segment
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    unsigned int buffer = 0;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+
+  //! sort and reduce records of one buffer, and fill its hitset segments
+  static void reduce(std::vector<Record>&, unsigned int buffer, std::vector<Segment>&);
+
+  std::vector<Buffer> m_buffers;
+
+  //! per buffer hitset segments, kept between merges to reuse memory
+  std::vector<std::vector<Segment>> m_segments;
+};
+
+#endif
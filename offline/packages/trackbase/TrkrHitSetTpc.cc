@@ -11,6 +11,7 @@
 #include <cassert>
 #include <cstdlib>  // for exit
 #include <iostream>
+#include <limits>
 #include <type_traits>  // for __decay_and_strip<>::__type
 
 void TrkrHitSetTpc::identify(std::ostream& os) const
@@ -35,6 +36,13 @@ const TpcDefs::ADCDataType& TrkrHitSetTpc::getTpcADC(TrkrDefs::hitkey key) const
   return getTpcADC(local_phi_t.first, local_phi_t.second);
 }
 
+void TrkrHitSetTpc::appendHit(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  TpcDefs::ADCDataType& value = getTpcADC(key);
+  const unsigned int sum = std::max<int>(value, 0) + adc;
+  value = std::min<unsigned int>(sum, std::numeric_limits<TpcDefs::ADCDataType>::max());
+}
+
 std::pair<uint16_t, uint16_t> TrkrHitSetTpc::getLocalPhiTBin(TrkrDefs::hitkey key) const
 {
   const uint16_t pad = TpcDefs ::getPad(key);
@@ -40,6 +40,9 @@ class TrkrHitSetTpc : public TrkrHitSet
 
   const TpcDefs::ADCDataType& getTpcADC(const TrkrDefs::hitkey) const;
 
+  //! adds adc to the time frame buffer, saturating at the maximum adc value
+  void appendHit(const TrkrDefs::hitkey, const unsigned int adc) override;
+
   virtual TpcDefs::ADCDataType& getTpcADC(const uint16_t /*local_pad*/, const uint16_t /*local_tbin*/)
   {
     static TpcDefs::ADCDataType v = 0;
@@ -6,6 +6,7 @@
  */
 #include "TrkrHitSetv1.h"
 #include "TrkrHit.h"
+#include "TrkrHitv2.h"
 
 #include <cstdlib>  // for exit
 #include <iostream>
@@ -73,6 +74,17 @@ TrkrHitSetv1::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
   }
 }
 
+void TrkrHitSetv1::appendHit(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  auto it = m_hits.lower_bound(key);
+  if (it == m_hits.end() || key < it->first)
+  {
+    it = m_hits.insert(it, std::make_pair(key, new TrkrHitv2));
+  }
+  // setAdc saturates at the maximum adc value
+  it->second->setAdc(it->second->getAdc() + adc);
+}
+
 TrkrHit*
 TrkrHitSetv1::getHit(const TrkrDefs::hitkey key) const
 {
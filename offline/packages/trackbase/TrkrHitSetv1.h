@@ -43,6 +43,8 @@ class TrkrHitSetv1 : public TrkrHitSet
 
   ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
 
+  void appendHit(const TrkrDefs::hitkey, const unsigned int adc) override;
+
   void removeHit(TrkrDefs::hitkey) override;
 
   TrkrHit* getHit(const TrkrDefs::hitkey) const override;
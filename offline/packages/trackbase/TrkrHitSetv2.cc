@@ -0,0 +1,291 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <mutex>
+#include <numeric>
+
+namespace
+{
+  //! serializes building the hit index of hitsets which were not finalized
+  std::mutex hitindex_mutex;
+}  // namespace
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  // clear() keeps the capacity, which saves the allocations in the next event
+  m_hitkeys.clear();
+  m_hits.clear();
+  m_sorted = true;
+
+  for (auto&& [key, hit] : m_pendinghits)
+  {
+    delete hit;
+  }
+  m_pendinghits.clear();
+
+  m_hitindex.clear();
+  m_hitindex_valid = false;
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_hitkeys.size()
+      << " pending: " << m_pendinghits.size()
+      << std::endl;
+
+  for (unsigned int i = 0; i < m_hitkeys.size(); ++i)
+  {
+    os << " hitkey " << m_hitkeys[i] << std::endl;
+    m_hits[i].identify(os);
+  }
+  for (const auto& entry : m_pendinghits)
+  {
+    os << " hitkey " << entry.first << " (pending)" << std::endl;
+    (entry.second)->identify(os);
+  }
+}
+
+void TrkrHitSetv2::reserveHits(const unsigned int n)
+{
+  m_hitkeys.reserve(n);
+  m_hits.reserve(n);
+}
+
+void TrkrHitSetv2::appendHit(const TrkrDefs::hitkey key, const unsigned int adc)
+{
+  if (!m_pendinghits.empty())
+  {
+    const auto it = m_pendinghits.find(key);
+    if (it != m_pendinghits.end())
+    {
+      it->second->setAdc(it->second->getAdc() + adc);
+      return;
+    }
+  }
+
+  if (!m_hitkeys.empty() && !(m_hitkeys.back() < key))
+  {
+    m_sorted = false;
+  }
+  m_hitkeys.push_back(key);
+  m_hits.emplace_back();
+  m_hits.back().setAdc(adc);
+  m_hitindex_valid = false;
+}
+
+void TrkrHitSetv2::sortHits()
+{
+  m_sorted = true;
+  m_hitindex_valid = false;
+
+  // hits from a digitizer or decoder come mostly in order, sort an index
+  // permutation and merge duplicated keys on the way
+  const unsigned int nhits = m_hitkeys.size();
+  std::vector<unsigned int> order(nhits);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](const unsigned int a, const unsigned int b)
+                   { return m_hitkeys[a] < m_hitkeys[b]; });
+
+  std::vector<TrkrDefs::hitkey> keys;
+  std::vector<TrkrHitv2> hits;
+  keys.reserve(nhits);
+  hits.reserve(nhits);
+  for (const auto index : order)
+  {
+    if (!keys.empty() && keys.back() == m_hitkeys[index])
+    {
+      // setAdc saturates at the maximum adc value
+      hits.back().setAdc(hits.back().getAdc() + m_hits[index].getAdc());
+    }
+    else
+    {
+      keys.push_back(m_hitkeys[index]);
+      hits.push_back(m_hits[index]);
+    }
+  }
+  m_hitkeys.swap(keys);
+  m_hits.swap(hits);
+}
+
+void TrkrHitSetv2::finalizeHits()
+{
+  // move the individually added hits to the contiguous storage
+  Map pending;
+  pending.swap(m_pendinghits);
+  for (auto&& [key, hit] : pending)
+  {
+    appendHit(key, hit->getAdc());
+    delete hit;
+  }
+
+  if (!m_sorted)
+  {
+    sortHits();
+  }
+  // consumers only read from here on, build the index while it is safe
+  buildHitIndex();
+}
+
+void TrkrHitSetv2::requireHitIndex() const
+{
+  if (m_hitindex_valid.load(std::memory_order_acquire))
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(hitindex_mutex);
+  if (!m_hitindex_valid.load(std::memory_order_relaxed))
+  {
+    buildHitIndex();
+  }
+}
+
+void TrkrHitSetv2::buildHitIndex() const
+{
+  m_hitindex.clear();
+  m_hitindex.reserve(m_hitkeys.size() + m_pendinghits.size());
+  if (m_sorted && m_pendinghits.empty())
+  {
+    for (unsigned int i = 0; i < m_hitkeys.size(); ++i)
+    {
+      m_hitindex.emplace_back(m_hitkeys[i], &m_hits[i]);
+    }
+  }
+  else
+  {
+    // not finalized, show the hits as they were added in key order
+    std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*>> hits;
+    hits.reserve(m_hitkeys.size() + m_pendinghits.size());
+    for (unsigned int i = 0; i < m_hitkeys.size(); ++i)
+    {
+      hits.emplace_back(m_hitkeys[i], &m_hits[i]);
+    }
+    hits.insert(hits.end(), m_pendinghits.begin(), m_pendinghits.end());
+    std::stable_sort(hits.begin(), hits.end(),
+                     [](const auto& a, const auto& b)
+                     { return a.first < b.first; });
+    for (const auto& hit : hits)
+    {
+      m_hitindex.emplace_back(hit.first, hit.second);
+    }
+  }
+  m_hitindex_valid.store(true, std::memory_order_release);
+}
+
+int TrkrHitSetv2::findIndex(const TrkrDefs::hitkey key) const
+{
+  const auto it = std::lower_bound(m_hitkeys.begin(), m_hitkeys.end(), key);
+  if (it == m_hitkeys.end() || *it != key)
+  {
+    return -1;
+  }
+  return it - m_hitkeys.begin();
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const auto it = m_pendinghits.find(key);
+  if (it != m_pendinghits.end())
+  {
+    delete it->second;
+    m_pendinghits.erase(it);
+    m_hitindex_valid = false;
+    return;
+  }
+
+  if (!m_sorted)
+  {
+    sortHits();
+  }
+  const int index = findIndex(key);
+  if (index < 0)
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  m_hitkeys.erase(m_hitkeys.begin() + index);
+  m_hits.erase(m_hits.begin() + index);
+  m_hitindex_valid = false;
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  // the caller keeps using the hit pointer (e.g. to add energy) so it is
+  // kept until finalizeHits() copies it to the contiguous storage
+  if (!m_sorted)
+  {
+    sortHits();
+  }
+  if (findIndex(key) >= 0)
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  const auto ret = m_pendinghits.insert(std::make_pair(key, hit));
+  if (!ret.second)
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  m_hitindex_valid = false;
+  return ret.first;
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  if (!m_sorted)
+  {
+    // appended but not finalized, the hit index is sorted by key and
+    // has the first hit with this key first
+    requireHitIndex();
+    const auto it = std::lower_bound(m_hitindex.begin(), m_hitindex.end(), key,
+                                     [](const Map::value_type& entry, const TrkrDefs::hitkey k)
+                                     { return entry.first < k; });
+    return (it == m_hitindex.end() || it->first != key) ? nullptr : it->second;
+  }
+
+  const int index = findIndex(key);
+  if (index >= 0)
+  {
+    return &m_hits[index];
+  }
+
+  const auto it = m_pendinghits.find(key);
+  if (it != m_pendinghits.end())
+  {
+    return it->second;
+  }
+  return nullptr;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  requireHitIndex();
+  const Map::value_type* begin = m_hitindex.data();
+  return std::make_pair(ConstIterator(begin), ConstIterator(begin + m_hitindex.size()));
+}
+
+unsigned int TrkrHitSetv2::size() const
+{
+  return m_hitkeys.size() + m_pendinghits.size();
+}
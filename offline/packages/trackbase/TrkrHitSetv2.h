@@ -0,0 +1,148 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Container for storing TrkrHit's in contiguous, key sorted arrays
+ */
+#include "TrkrDefs.h"
+#include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
+
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <utility>  // for pair
+#include <vector>
+
+// forward declaration
+class TrkrHit;
+
+/**
+ * Hits are stored by value in a vector sorted by hit key, with no heap
+ * allocation per hit. Producers fill it via appendHit() and call
+ * finalizeHits() once, which sorts the hits and merges duplicated keys.
+ * Before finalizeHits() the getters see the hits as appended.
+ *
+ * Hits added one by one with addHitSpecificKey() are kept as is (the
+ * caller may still use the pointer) until finalizeHits() moves them to
+ * the contiguous storage.
+ *
+ * getHits() iterates over a contiguous array of (hitkey, hit) pairs, which
+ * is built by finalizeHits(). Hitsets read back from a DST are finalized by
+ * TrkrHitSetContainerv2 when it indexes them. Otherwise the first getHits()
+ * builds the array under a lock, so const readers in several threads (the
+ * threaded clusterizers) are safe. Modifying a hitset while other threads
+ * read it is not.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  TrkrHitSetv2() = default;
+
+  ~TrkrHitSetv2() override
+  {
+    TrkrHitSetv2::Reset();
+  }
+
+  //! the hit index points into the hit storage, copies would share it
+  TrkrHitSetv2(const TrkrHitSetv2&) = delete;
+  TrkrHitSetv2& operator=(const TrkrHitSetv2&) = delete;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! For ROOT TClonesArray end of event Operation (TrkrHitSetContainerv2)
+  void Clear(Option_t* /*option*/ = "") override { Reset(); }
+
+  //! clears all hits but keeps the allocated memory for the next event
+  void Reset() override;
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  void appendHit(const TrkrDefs::hitkey, const unsigned int adc) override;
+
+  void reserveHits(const unsigned int n) override;
+
+  void finalizeHits() override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override;
+
+  //!@name direct access to the contiguous storage, valid after finalizeHits()
+  //@{
+  unsigned int nStoredHits() const
+  {
+    return m_hitkeys.size();
+  }
+
+  TrkrDefs::hitkey getHitKey(const unsigned int index) const
+  {
+    return m_hitkeys[index];
+  }
+
+  TrkrHitv2* getHitAtIndex(const unsigned int index)
+  {
+    return &m_hits[index];
+  }
+
+  const std::vector<TrkrDefs::hitkey>& getHitKeys() const
+  {
+    return m_hitkeys;
+  }
+  //@}
+
+ private:
+  //! sort appended hits by key and merge duplicates
+  void sortHits();
+
+  //! fill the (hitkey, hit) pairs returned by getHits()
+  void buildHitIndex() const;
+
+  //! build the (hitkey, hit) pairs if needed, safe with concurrent const readers
+  void requireHitIndex() const;
+
+  //! index of key in contiguous storage, -1 if not found. Needs sorted storage
+  int findIndex(const TrkrDefs::hitkey) const;
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// hit keys, same ordering as m_hits
+  std::vector<TrkrDefs::hitkey> m_hitkeys;
+
+  /// contiguous hit storage. Mutable since the const getters of the
+  /// TrkrHitSet interface hand out non const TrkrHit pointers
+  mutable std::vector<TrkrHitv2> m_hits;
+
+  /// true if m_hitkeys is sorted and has no duplicated keys
+  bool m_sorted = true;
+
+  /// hits added via addHitSpecificKey, owned by this object, not yet moved to m_hits
+  Map m_pendinghits;
+
+  /// (hitkey, hit) pairs returned by getHits(), sorted by key
+  mutable std::vector<Map::value_type> m_hitindex;  //!
+
+  /// true if m_hitindex is in sync with the stored hits. Set with release
+  /// semantics once m_hitindex is filled, readers which see it can use m_hitindex
+  mutable std::atomic<bool> m_hitindex_valid{false};  //!
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
@@ -7,6 +7,7 @@
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterPositionCache.h>
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
@@ -44,6 +45,26 @@ void MakeSourceLinks::initialize(PHG4TpcCylinderGeomContainer* cellgeo)
 
 }
 
+//___________________________________________________________________________________
+const TrkrClusterPositionCache::Positions* MakeSourceLinks::getCachedPositions(
+    const TpcDistortionCorrectionContainer* dcc_static,
+    const TpcDistortionCorrectionContainer* dcc_average,
+    const TpcDistortionCorrectionContainer* dcc_fluctuation,
+    short int crossing) const
+{
+  if (!m_position_cache)
+  {
+    return nullptr;
+  }
+
+  const auto positions = m_position_cache->get(crossing, TrkrClusterPositionCache::corrections(dcc_static, dcc_average, dcc_fluctuation));
+  if (!positions && m_verbosity > 0)
+  {
+    std::cout << "MakeSourceLinks: no cached positions with the same distortion corrections, not used" << std::endl;
+  }
+  return positions;
+}
+
   //___________________________________________________________________________________
 SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
 						  ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
@@ -73,6 +94,9 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
   SLTrackTimer.stop();
   SLTrackTimer.restart();
 
+  // TPC positions computed upstream for this crossing, if they have the same corrections as here
+  const TrkrClusterPositionCache::Positions* positions = getCachedPositions(dcc_static, dcc_average, dcc_fluctuation, crossing);
+
   // loop over all clusters
   std::vector<TrkrDefs::cluskey> cluster_vec;
 
@@ -110,33 +134,37 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(TrackSeed* track,
       Acts::Vector3 global = tGeometry->getGlobalPosition(key, cluster);
       Acts::Vector3 global_in = global;
 
-      // make all corrections to global position of TPC cluster
-      float z = _clusterCrossingCorrection.correctZ(global[2], side, crossing);
-      global[2] = z;
-
-      // apply distortion corrections
-      if (dcc_static)
+      // the corrected position may have been computed upstream
+      if (!positions || !positions->find(key, global))
       {
-        global = _distortionCorrection.get_corrected_position(global, dcc_static);
-      }
-      if (dcc_average)
-      {
-        global = _distortionCorrection.get_corrected_position(global, dcc_average);
-      }
-      if (dcc_fluctuation)
-      {
-        global = _distortionCorrection.get_corrected_position(global, dcc_fluctuation);
+        // make all corrections to global position of TPC cluster
+        float z = _clusterCrossingCorrection.correctZ(global[2], side, crossing);
+        global[2] = z;
+
+        // apply distortion corrections
+        if (dcc_static)
+        {
+          global = _distortionCorrection.get_corrected_position(global, dcc_static);
+        }
+        if (dcc_average)
+        {
+          global = _distortionCorrection.get_corrected_position(global, dcc_average);
+        }
+        if (dcc_fluctuation)
+        {
+          global = _distortionCorrection.get_corrected_position(global, dcc_fluctuation);
+        }
+
+        if (m_verbosity > 2)
+        {
+          std::cout << " global_in " << global_in(0) << "  " << global_in(1) << "  " << global_in(2)
+                    << " corr glob " << global(0) << "  " << global(1) << "  " << global(2) << std::endl
+                    << " crossing z correction " << z - global_in(2)
+                    << " distortion correction " << global(0) - global_in(0) << "  " << global(1) - global_in(1) << "  " << global(2) - z
+                    << std::endl;
+        }
       }
 
-      if(m_verbosity > 2)
-	{
-	  std::cout << " global_in " << global_in(0) << "  " << global_in(1) << "  " << global_in(2) 
-		    << " corr glob " << global(0) << "  " << global(1) << "  " << global(2) << std::endl
-		    << " crossing z correction " << z - global_in(2) 
-		    << " distortion correction " << global(0)-global_in(0) << "  " << global(1) - global_in(1) << "  " << global(2) - z 
-		    << std::endl;
-	}
-
       // Make an afine transform that implements the correction as a translation 
       auto correction_translation = (global - global_in) * 10.0;  // need mm
       Acts::Vector3 correction_rotation(0,0,0);   // null rotation
@@ -312,6 +340,9 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
   SLTrackTimer.stop();
   SLTrackTimer.restart();
 
+  // TPC positions computed upstream for this crossing, if they have the same corrections as here
+  const TrkrClusterPositionCache::Positions* positions = getCachedPositions(dcc_static, dcc_average, dcc_fluctuation, crossing);
+
   // loop over all clusters
   std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> global_raw;
 
@@ -347,10 +378,15 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
 
     // For the TPC, cluster z has to be corrected for the crossing z offset, distortion, and TOF z offset
     // we do this locally here and do not modify the cluster, since the cluster may be associated with multiple silicon tracks
-    Acts::Vector3 global = tGeometry->getGlobalPosition(key, cluster);
+    Acts::Vector3 global;
+    const bool cached = trkrid == TrkrDefs::tpcId && positions && positions->find(key, global);
+    if (!cached)
+    {
+      global = tGeometry->getGlobalPosition(key, cluster);
+    }
     Acts::Vector3 global_in = global;
     
-    if (trkrid == TrkrDefs::tpcId)
+    if (trkrid == TrkrDefs::tpcId && !cached)
       {
 	// make all corrections to global position of TPC cluster
 	float z = _clusterCrossingCorrection.correctZ(global[2], side, crossing);
@@ -6,6 +6,7 @@
 #include <trackbase/ActsTrackFittingAlgorithm.h>
 #include <trackbase/alignmentTransformationContainer.h>
 #include <trackbase/ClusterErrorPara.h>
+#include <trackbase/TrkrClusterPositionCache.h>
 
 #include <tpc/TpcClusterMover.h>
 #include <tpc/TpcClusterZCrossingCorrection.h>
@@ -50,6 +51,9 @@ class MakeSourceLinks
 
  void set_pp_mode(bool ispp) { m_pp_mode = ispp; }
 
+  /// read the TPC positions from the per event cache when it has the crossing
+  void setPositionCache(const TrkrClusterPositionCache* cache) { m_position_cache = cache; }
+
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
   
   SourceLinkVec getSourceLinks(TrackSeed* track,
@@ -80,7 +84,14 @@ SourceLinkVec getSourceLinksClusterMover(
 							  );
 
  private:
+  const TrkrClusterPositionCache::Positions* getCachedPositions(
+      const TpcDistortionCorrectionContainer* dcc_static,
+      const TpcDistortionCorrectionContainer* dcc_average,
+      const TpcDistortionCorrectionContainer* dcc_fluctuation,
+      short int crossing) const;
+
   int m_verbosity = 0;
+  const TrkrClusterPositionCache* m_position_cache = nullptr;
   bool m_pp_mode = false;  
   std::set<int> m_ignoreLayer;
 
@@ -18,6 +18,7 @@
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterPositionCache.h>
 
 #include <trackbase_historic/ActsTransformations.h>
 #include <trackbase_historic/SvtxAlignmentStateMap_v1.h>
@@ -40,6 +41,7 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
@@ -56,6 +58,7 @@
 #include <TDatabasePDG.h>
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
@@ -85,6 +88,8 @@ PHActsTrkFitter::PHActsTrkFitter(const std::string& name)
 {
 }
 
+PHActsTrkFitter::~PHActsTrkFitter() = default;
+
 int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 {
   if (Verbosity() > 1)
@@ -167,6 +172,16 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 
   _tpccellgeo = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
 
+  // seeds are fitted concurrently on a pool of threads which lives for the whole job
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHActsTrkFitter::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   if (Verbosity() > 1)
   {
     std::cout << "Finish PHActsTrkFitter Setup" << std::endl;
@@ -295,178 +310,224 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
     std::cout << " seed map size " << m_seedMap->size() << std::endl;
   }
 
+  // the transient transforms are modified in place, the context always points to the same container
+  m_transient_geocontext = m_alignmentTransformationMapTransient;
+
+  // without the cluster mover the source links are made by modifying the shared transient
+  // alignment transforms, those fits have to stay in the calling thread
+  if (m_threadpool->size() == 1 || !m_use_clustermover || m_timeAnalysis)
+  {
+    for (auto track : *m_seedMap)
+    {
+      if (!track)
+      {
+        continue;
+      }
+      SeedFit seedfit;
+      fitSeed(track, seedfit);
+      storeSeedFit(seedfit);
+    }
+    return;
+  }
+
+  std::vector<TrackSeed*> seeds;
+  seeds.reserve(m_seedMap->size());
   for (auto track : *m_seedMap)
   {
-    if (!track)
+    if (track)
     {
-      continue;
+      seeds.push_back(track);
     }
+  }
 
-    unsigned int tpcid = track->get_tpc_seed_index();
-    unsigned int siid = track->get_silicon_seed_index();
-    short int crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate
+  // fit blocks of seeds concurrently, then store them in seed order. The block size
+  // bounds the number of trajectories held in memory before they are stored
+  const size_t blocksize = 16 * m_threadpool->size();
+  std::vector<SeedFit> seedfits;
+  for (size_t first = 0; first < seeds.size(); first += blocksize)
+  {
+    const size_t nseeds = std::min(blocksize, seeds.size() - first);
+    seedfits.clear();
+    seedfits.resize(nseeds);
+    m_threadpool->parallel_for(nseeds, [this, &seeds, &seedfits, first](size_t task, unsigned int /*thread*/)
+                               { fitSeed(seeds[first + task], seedfits[task]); });
 
-    if (Verbosity() > 3)
+    for (auto& seedfit : seedfits)
     {
-      std::cout << " tpcid " << tpcid << " siid " << siid << std::endl;
+      storeSeedFit(seedfit);
     }
+  }
+
+  return;
+}
 
-    /// A track seed is made for every tpc seed. Not every tpc seed
-    /// has a silicon match, we skip those cases completely in pp running
-    if (m_pp_mode && siid == std::numeric_limits<unsigned int>::max())
+PHActsTrkFitter::FitTrial::FitTrial()
+  : tracks(std::make_shared<Acts::VectorTrackContainer>(),
+           std::make_shared<Acts::VectorMultiTrajectory>())
+{
+}
+
+void PHActsTrkFitter::fitSeed(TrackSeed* track, SeedFit& seedfit)
+{
+  seedfit.seed = track;
+
+  unsigned int tpcid = track->get_tpc_seed_index();
+  unsigned int siid = track->get_silicon_seed_index();
+  short int crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate
+
+  if (Verbosity() > 3)
+  {
+    std::cout << " tpcid " << tpcid << " siid " << siid << std::endl;
+  }
+
+  /// A track seed is made for every tpc seed. Not every tpc seed
+  /// has a silicon match, we skip those cases completely in pp running
+  if (m_pp_mode && siid == std::numeric_limits<unsigned int>::max())
+  {
+    return;
+  }
+
+  // get the INTT crossing number
+  auto siseed = m_siliconSeeds->get(siid);
+  short crossing = SHRT_MAX;
+  if (siseed)
+  {
+    crossing = siseed->get_crossing();
+  }
+  else if (!m_pp_mode)
+  {
+    crossing = 0;
+  }
+
+  // if the crossing was not determined at all in pp running, skip this case completely
+  if (m_pp_mode && crossing == SHRT_MAX && crossing_estimate == SHRT_MAX)
+  {
+    // Skip this in the pp case.
+    if (Verbosity() > 3)
     {
-      continue;
+      std::cout << "tpcid " << tpcid << " siid " << siid << " crossing and crossing_estimate not determined, skipping track" << std::endl;
     }
+    return;
+  }
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "tpc and si id " << tpcid << ", " << siid << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
+  }
+
+  // Can't do SC case without INTT crossing
+  if (m_fitSiliconMMs && (crossing == SHRT_MAX))
+  {
+    return;
+  }
 
-    // get the INTT crossing number
-    auto siseed = m_siliconSeeds->get(siid);
-    short crossing = SHRT_MAX;
+  auto tpcseed = m_tpcSeeds->get(tpcid);
+
+  /// Need to also check that the tpc seed wasn't removed by the ghost finder
+  if (!tpcseed)
+  {
+    std::cout << "no tpc seed" << std::endl;
+    return;
+  }
+
+  if (Verbosity() > 0)
+  {
     if (siseed)
     {
-      crossing = siseed->get_crossing();
-    }
-    else if (!m_pp_mode)
-    {
-      crossing = 0;
+      std::cout << " silicon seed position is (x,y,z) = " << siseed->get_x() << "  " << siseed->get_y() << "  " << siseed->get_z() << std::endl;
     }
+    std::cout << " tpc seed position is (x,y,z) = " << tpcseed->get_x() << "  " << tpcseed->get_y() << "  " << tpcseed->get_z() << std::endl;
+  }
 
-    // if the crossing was not determined at all in pp running, skip this case completely
-    if (m_pp_mode && crossing == SHRT_MAX && crossing_estimate == SHRT_MAX)
-    {
-      // Skip this in the pp case.
-      if (Verbosity() > 3)
-      {
-        std::cout << "tpcid " << tpcid << " siid " << siid << " crossing and crossing_estimate not determined, skipping track" << std::endl;
-      }
-      continue;
-    }
+  PHTimer trackTimer("TrackTimer");
+  trackTimer.stop();
+  trackTimer.restart();
+
+  short int this_crossing = crossing;
+  short int nvary = 0;
 
+  if (Verbosity() > 1)
+  {
+    std::cout << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+  }
+
+  if (crossing == SHRT_MAX)
+  {
+    // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
+    seedfit.use_estimate = true;
+    nvary = max_bunch_search;
     if (Verbosity() > 1)
     {
-      std::cout << "tpc and si id " << tpcid << ", " << siid << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
+      std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
     }
+  }
+  else
+  {
+    // use INTT crossing
+    crossing_estimate = crossing;
+  }
 
-    // Can't do SC case without INTT crossing
-    if (m_fitSiliconMMs && (crossing == SHRT_MAX))
-    {
-      continue;
-    }
+  // Fit this track assuming either:
+  //    crossing = INTT value, if it exists (uses nvary = 0)
+  //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists
 
-    auto tpcseed = m_tpcSeeds->get(tpcid);
+  for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+  {
+    this_crossing = crossing_estimate + ivary;
 
-    /// Need to also check that the tpc seed wasn't removed by the ghost finder
-    if (!tpcseed)
+    if (Verbosity() > 1)
     {
-      std::cout << "no tpc seed" << std::endl;
-      continue;
+      std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
     }
 
-    if (Verbosity() > 0)
-    {
-      if (siseed)
-      {
-        std::cout << " silicon seed position is (x,y,z) = " << siseed->get_x() << "  " << siseed->get_y() << "  " << siseed->get_z() << std::endl;
-      }
-      std::cout << " tpc seed position is (x,y,z) = " << tpcseed->get_x() << "  " << tpcseed->get_y() << "  " << tpcseed->get_z() << std::endl;
-    }
+    seedfit.last_ok = false;
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
+    FitTrial trial;
+    auto& measurements = trial.measurements;
 
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
-    std::vector<float> chisq_ndf;
-    std::vector<SvtxTrack_v4> svtx_vec;
+    SourceLinkVec sourceLinks;
 
-    if (Verbosity() > 1)
-    {
-      std::cout << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
-    }
+    MakeSourceLinks makeSourceLinks;
+    makeSourceLinks.initialize(_tpccellgeo);
+    makeSourceLinks.setVerbosity(Verbosity());
+    makeSourceLinks.set_pp_mode(m_pp_mode);
+    makeSourceLinks.setPositionCache(m_position_cache);
 
-    if (crossing == SHRT_MAX)
+    if (m_use_clustermover)
     {
-      // If there is no INTT crossing, start with the crossing_estimate value, vary up and down, fit, and choose the best chisq/ndf
-      use_estimate = true;
-      nvary = max_bunch_search;
-      if (Verbosity() > 1)
+      if (siseed)
       {
-        std::cout << " No INTT crossing: use crossing_estimate " << crossing_estimate << " with nvary " << nvary << std::endl;
+        sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+            siseed,
+            measurements,
+            m_clusterContainer,
+            m_tGeometry,
+            _dcc_static, _dcc_average, _dcc_fluctuation,
+            this_crossing);
       }
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          tpcseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          _dcc_static, _dcc_average, _dcc_fluctuation,
+          this_crossing);
+
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
     }
     else
     {
-      // use INTT crossing
-      crossing_estimate = crossing;
-    }
-
-    // Fit this track assuming either:
-    //    crossing = INTT value, if it exists (uses nvary = 0)
-    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists
-
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
-    {
-      this_crossing = crossing_estimate + ivary;
-
-      if (Verbosity() > 1)
-      {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
-      }
-
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
-
-      SourceLinkVec sourceLinks;
-
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
-
       // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
       // does nothing if m_transient_id_set is empty
       makeSourceLinks.resetTransientTransformMap(
           m_alignmentTransformationMapTransient,
           m_transient_id_set,
           m_tGeometry);
-      if (m_use_clustermover)
-      {
-        if (siseed)
-        {
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              _dcc_static, _dcc_average, _dcc_fluctuation,
-              this_crossing);
-        }
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            tpcseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            _dcc_static, _dcc_average, _dcc_fluctuation,
-            this_crossing);
 
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
-      }
-      else
+      if (siseed)
       {
-        if (siseed)
-        {
-          sourceLinks = makeSourceLinks.getSourceLinks(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              _dcc_static, _dcc_average, _dcc_fluctuation,
-              m_alignmentTransformationMapTransient,
-              m_transient_id_set,
-              this_crossing);
-        }
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-            tpcseed,
+        sourceLinks = makeSourceLinks.getSourceLinks(
+            siseed,
             measurements,
             m_clusterContainer,
             m_tGeometry,
@@ -474,282 +535,264 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
             m_alignmentTransformationMapTransient,
             m_transient_id_set,
             this_crossing);
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+          tpcseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          _dcc_static, _dcc_average, _dcc_fluctuation,
+          m_alignmentTransformationMapTransient,
+          m_transient_id_set,
+          this_crossing);
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
-
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position(0) = siseed->get_x() * Acts::UnitConstants::cm;
-        position(1) = siseed->get_y() * Acts::UnitConstants::cm;
-        position(2) = siseed->get_z() * Acts::UnitConstants::cm;
-      }
-      if(!siseed || !is_valid(position))
+    // position comes from the silicon seed, unless there is no silicon seed
+    Acts::Vector3 position(0, 0, 0);
+    if (siseed)
+    {
+      position(0) = siseed->get_x() * Acts::UnitConstants::cm;
+      position(1) = siseed->get_y() * Acts::UnitConstants::cm;
+      position(2) = siseed->get_z() * Acts::UnitConstants::cm;
+    }
+    if (!siseed || !is_valid(position))
+    {
+      position(0) = tpcseed->get_x() * Acts::UnitConstants::cm;
+      position(1) = tpcseed->get_y() * Acts::UnitConstants::cm;
+      position(2) = tpcseed->get_z() * Acts::UnitConstants::cm;
+    }
+    if (!is_valid(position))
+    {
+      if (Verbosity() > 4)
       {
-        position(0) = tpcseed->get_x() * Acts::UnitConstants::cm;
-        position(1) = tpcseed->get_y() * Acts::UnitConstants::cm;
-        position(2) = tpcseed->get_z() * Acts::UnitConstants::cm;
+        std::cout << "Invalid position of " << position.transpose() << std::endl;
       }
-      if (!is_valid(position))
+      continue;
+    }
+
+    if (sourceLinks.empty())
+    {
+      continue;
+    }
+
+    /// If using directed navigation, collect surface list to navigate
+    SurfacePtrVec surfaces;
+    if (m_fitSiliconMMs)
+    {
+      sourceLinks = getSurfaceVector(sourceLinks, surfaces);
+
+      // skip if there is no surfaces
+      if (surfaces.empty())
       {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
         continue;
       }
 
-      if (sourceLinks.empty())
+      // make sure micromegas are in the tracks, if required
+      if (m_useMicromegas &&
+          std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                       { return m_tGeometry->maps().isMicromegasSurface(surface); }))
       {
         continue;
       }
+    }
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs)
-      {
-        sourceLinks = getSurfaceVector(sourceLinks, surfaces);
-
-        // skip if there is no surfaces
-        if (surfaces.empty())
-        {
-          continue;
-        }
-
-        // make sure micromegas are in the tracks, if required
-        if (m_useMicromegas &&
-            std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                         { return m_tGeometry->maps().isMicromegasSurface(surface); }))
-        {
-          continue;
-        }
-      }
+    float px = std::numeric_limits<float>::quiet_NaN();
+    float py = std::numeric_limits<float>::quiet_NaN();
+    float pz = std::numeric_limits<float>::quiet_NaN();
+    if (m_ConstField)
+    {
+      float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+      float phi = tpcseed->get_phi();
+      px = pt * std::cos(phi);
+      py = pt * std::sin(phi);
+      pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
+    }
+    else
+    {
+      px = tpcseed->get_px();
+      py = tpcseed->get_py();
+      pz = tpcseed->get_pz();
+    }
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-      if (m_ConstField)
-      {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = tpcseed->get_phi();
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
-      }
-      else
+    Acts::Vector3 momentum(px, py, pz);
+    if (!is_valid(momentum))
+    {
+      if (Verbosity() > 4)
       {
-        px = tpcseed->get_px();
-        py = tpcseed->get_py();
-        pz = tpcseed->get_pz();
+        std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
       }
+      continue;
+    }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
-      {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
-      }
+    auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+        position);
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          position);
+    auto actsFourPos = Acts::Vector4(position(0), position(1),
+                                     position(2),
+                                     10 * Acts::UnitConstants::ns);
+    Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      auto actsFourPos = Acts::Vector4(position(0), position(1),
-                                       position(2),
-                                       10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+    int charge = tpcseed->get_charge();
 
-      int charge = tpcseed->get_charge();
+    /// Reset the track seed with the dummy covariance
+    auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                    pSurface,
+                    m_transient_geocontext,
+                    actsFourPos,
+                    momentum,
+                    charge / momentum.norm(),
+                    cov,
+                    Acts::ParticleHypothesis::pion())
+                    .value();
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+    if (Verbosity() > 2)
+    {
+      printTrackSeed(seed);
+    }
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+    /// Set host of propagator options for Acts to do e.g. material integration
+    Acts::PropagatorPlainOptions ppPlainOptions;
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
+    auto calibptr = std::make_unique<Calibrator>();
+    CalibratorAdapter calibrator{*calibptr, measurements};
 
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+    auto magcontext = m_tGeometry->geometry().magFieldContext;
+    auto calibcontext = m_tGeometry->geometry().calibContext;
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
+    ActsTrackFittingAlgorithm::GeneralFitterOptions
+        kfOptions{
+            m_transient_geocontext,
+            magcontext,
+            calibcontext,
+            pSurface.get(),
+            ppPlainOptions};
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+    PHTimer fitTimer("FitTimer");
+    fitTimer.stop();
+    fitTimer.restart();
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+    auto result = fitTrack(sourceLinks, seed, kfOptions,
+                           surfaces, calibrator, trial.tracks);
+    fitTimer.stop();
+    auto fitTime = fitTimer.get_accumulated_time();
 
-      auto trackContainer =
-          std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer =
-          std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer
-          tracks(trackContainer, trackStateContainer);
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+    }
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions,
-                             surfaces, calibrator, tracks);
-      fitTimer.stop();
-      auto fitTime = fitTimer.get_accumulated_time();
+    /// the best crossing variation is only chosen when the last one converged
+    seedfit.last_ok = result.ok();
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
-      }
+    /// Check that the track fit result did not return an error
+    if (result.ok())
+    {
+      trial.track.set_tpc_seed(tpcseed);
+      trial.track.set_crossing(this_crossing);
+      trial.track.set_silicon_seed(siseed);
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+      if (getTrackFitResult(result, trial))
       {
-        if (use_estimate)  // trial variation case
+        if (Verbosity() > 1 && seedfit.use_estimate)
         {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
-
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-          {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
-          }
-
-          if (ivary != nvary)
-          {
-            if(Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
-          }
-
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
-          {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
-          }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
-          {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
-          }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+          std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << trial.track.get_quality() << std::endl;
         }
-        else  // case where INTT crossing is known
-        {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (m_fitSiliconMMs)
-          {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for SC calib fit
-          else
-          {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }    // end case where INTT crossing is known
+        seedfit.trials.push_back(std::move(trial));
       }
-      else if (!m_fitSiliconMMs)
+    }
+    else if (!m_fitSiliconMMs)
+    {
+      /// Track fit failed, get rid of the track from the map
+      seedfit.nBadFits++;
+      if (Verbosity() > 1)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
-        if (Verbosity() > 1)
-        {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
-        }
-      }  // end fit failed case
-    }    // end ivary loop
+        std::cout << "Track fit failed for track " << m_seedMap->find(track)
+                  << " with Acts error message "
+                  << result.error() << ", " << result.error().message()
+                  << std::endl;
+      }
+    }  // end fit failed case
+  }    // end ivary loop
+
+  trackTimer.stop();
+  auto trackTime = trackTimer.get_accumulated_time();
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+  }
+}
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+void PHActsTrkFitter::storeSeedFit(SeedFit& seedfit)
+{
+  m_nBadFits += seedfit.nBadFits;
+
+  if (seedfit.use_estimate)  // trial variation case
+  {
+    // Capture the chisq/ndf of every trial so we can choose the best one
+    std::vector<float> chisq_ndf;
+    for (auto& trial : seedfit.trials)
+    {
+      storeTrackFitResult(trial, seedfit.seed);
+      chisq_ndf.push_back(trial.track.get_quality());
+    }
+
+    if (!seedfit.last_ok || chisq_ndf.empty())
+    {
+      return;
+    }
 
     if (Verbosity() > 1)
     {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+      std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+    }
+    float best_chisq = 1000.0;
+    short int best_ivary = 0;
+    for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+    {
+      if (chisq_ndf[i] < best_chisq)
+      {
+        best_chisq = chisq_ndf[i];
+        best_ivary = i;
+      }
+      if (Verbosity() > 1)
+      {
+        std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
+      }
     }
+    unsigned int trid = m_trackMap->size();
+    seedfit.trials[best_ivary].track.set_id(trid);
+
+    m_trackMap->insertWithKey(&seedfit.trials[best_ivary].track, trid);
+    return;
   }
 
-  return;
+  // case where INTT crossing is known, there is at most one fit
+  for (auto& trial : seedfit.trials)
+  {
+    SvtxTrackMap* trackmap = m_fitSiliconMMs ? m_directedTrackMap : m_trackMap;
+    unsigned int trid = trackmap->size();
+    trial.track.set_id(trid);
+
+    storeTrackFitResult(trial, seedfit.seed);
+    trackmap->insertWithKey(&trial.track, trid);
+  }
 }
 
-bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
-                                        TrackSeed* seed, SvtxTrack* track,
-                                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                        const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput, FitTrial& trial) const
 {
   /// Make a trajectory state for storage, which conforms to Acts track fit
   /// analysis tool
-  std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
+  auto& trackTips = trial.trackTips;
   trackTips.reserve(1);
   auto& outtrack = fitOutput.value();
   if (outtrack.hasReferenceSurface())
   {
     trackTips.emplace_back(outtrack.tipIndex());
-    Trajectory::IndexedParameters indexedParams;
-    indexedParams.emplace(std::pair{outtrack.tipIndex(),
-                                    ActsExamples::TrackParameters{outtrack.referenceSurface().getSharedPtr(),
-                                                                  outtrack.parameters(), outtrack.covariance(), outtrack.particleHypothesis()}});
+    trial.indexedParams.emplace(std::pair{outtrack.tipIndex(),
+                                          ActsExamples::TrackParameters{outtrack.referenceSurface().getSharedPtr(),
+                                                                        outtrack.parameters(), outtrack.covariance(), outtrack.particleHypothesis()}});
 
     if (Verbosity() > 2)
     {
@@ -769,16 +812,7 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     PHTimer updateTrackTimer("UpdateTrackTimer");
     updateTrackTimer.stop();
     updateTrackTimer.restart();
-    updateSvtxTrack(trackTips, indexedParams, tracks, track);
-
-    if (m_commissioning)
-    {
-      if (track->get_silicon_seed() && track->get_tpc_seed())
-      {
-        m_alignStates.fillAlignmentStateMap(tracks, trackTips,
-                                            track, measurements);
-      }
-    }
+    updateSvtxTrack(trackTips, trial.indexedParams, trial.tracks, &trial.track);
 
     updateTrackTimer.stop();
     auto updateTime = updateTrackTimer.get_accumulated_time();
@@ -794,21 +828,34 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
       h_updateTime->Fill(updateTime);
     }
 
-    Trajectory trajectory(tracks.trackStateContainer(),
-                          trackTips, indexedParams);
+    return true;
+  }
 
-    m_trajectories->insert(std::make_pair(track->get_id(), trajectory));
+  return false;
+}
 
-    if (m_actsEvaluator)
+void PHActsTrkFitter::storeTrackFitResult(FitTrial& trial, TrackSeed* seed)
+{
+  SvtxTrack* track = &trial.track;
+  if (m_commissioning)
+  {
+    if (track->get_silicon_seed() && track->get_tpc_seed())
     {
-      m_evaluator->evaluateTrackFit(tracks, trackTips, indexedParams, track,
-                                    seed, measurements);
+      m_alignStates.fillAlignmentStateMap(trial.tracks, trial.trackTips,
+                                          track, trial.measurements);
     }
-
-    return true;
   }
 
-  return false;
+  Trajectory trajectory(trial.tracks.trackStateContainer(),
+                        trial.trackTips, trial.indexedParams);
+
+  m_trajectories->insert(std::make_pair(track->get_id(), trajectory));
+
+  if (m_actsEvaluator)
+  {
+    m_evaluator->evaluateTrackFit(trial.tracks, trial.trackTips, trial.indexedParams, track,
+                                  seed, trial.measurements);
+  }
 }
 
 ActsTrackFittingAlgorithm::TrackFitterResult PHActsTrkFitter::fitTrack(
@@ -817,7 +864,7 @@ ActsTrackFittingAlgorithm::TrackFitterResult PHActsTrkFitter::fitTrack(
     const ActsTrackFittingAlgorithm::GeneralFitterOptions& kfOptions,
     const SurfacePtrVec& surfSequence,
     const CalibratorAdapter& calibrator,
-    ActsTrackFittingAlgorithm::TrackContainer& tracks)
+    ActsTrackFittingAlgorithm::TrackContainer& tracks) const
 {
   if (m_fitSiliconMMs)
   {
@@ -935,7 +982,7 @@ void PHActsTrkFitter::checkSurfaceVec(SurfacePtrVec& surfaces) const
 void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                                       Trajectory::IndexedParameters& paramsMap,
                                       ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                      SvtxTrack* track)
+                                      SvtxTrack* track) const
 {
   const auto& mj = tracks.trackStateContainer();
 
@@ -1249,5 +1296,14 @@ int PHActsTrkFitter::getNodes(PHCompositeNode* topNode)
     std::cout << PHWHERE << "  found fluctuation TPC distortion correction container" << std::endl;
   }
 
+  if (m_use_position_cache)
+  {
+    m_position_cache = findNode::getClass<TrkrClusterPositionCache>(topNode, "TRKR_CLUSTERPOSITIONS");
+    if (!m_position_cache)
+    {
+      std::cout << PHWHERE << "  no TRKR_CLUSTERPOSITIONS node, computing the cluster positions here" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -19,6 +19,8 @@
 #include <trackbase/ClusterErrorPara.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
+#include <trackbase_historic/SvtxTrack_v4.h>
+
 #include <tpc/TpcClusterZCrossingCorrection.h>
 #include <tpc/TpcDistortionCorrection.h>
 
@@ -38,11 +40,13 @@
 #include <trackbase/alignmentTransformationContainer.h>
 
 class MakeActsGeometry;
+class PHThreadPool;
 class SvtxTrack;
 class SvtxTrackMap;
 class TrackSeed;
 class TrackSeedContainer;
 class TrkrClusterContainer;
+class TrkrClusterPositionCache;
 class TpcDistortionCorrectionContainer;
 class SvtxAlignmentStateMap;
 class PHG4TpcCylinderGeomContainer;
@@ -61,7 +65,7 @@ class PHActsTrkFitter : public SubsysReco
   PHActsTrkFitter(const std::string& name = "PHActsTrkFitter");
 
   /// Destructor
-  ~PHActsTrkFitter() override = default;
+  ~PHActsTrkFitter() override;
 
   /// End, write and close files
   int End(PHCompositeNode* topNode) override;
@@ -122,9 +126,38 @@ class PHActsTrkFitter : public SubsysReco
   void set_pp_mode(bool ispp) { m_pp_mode = ispp; }
 
   void set_use_clustermover(bool use) { m_use_clustermover = use; }
+  /// read the corrected TPC positions from TRKR_CLUSTERPOSITIONS (PHClusterPositionCacheMaker) for the crossings it has
+  void usePositionCache(bool opt) { m_use_position_cache = opt; }
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
 
+  /// number of threads fitting seeds concurrently (0 = all cores). The default of 1 fits in the calling thread.
+  /// Fits are merged into the track map in seed order, so the output does not depend on the thread count
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+
  private:
+  /// fit of one bunch crossing hypothesis for a seed
+  struct FitTrial
+  {
+    FitTrial();
+
+    SvtxTrack_v4 track;
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    ActsTrackFittingAlgorithm::TrackContainer tracks;
+    std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
+    Trajectory::IndexedParameters indexedParams;
+  };
+
+  /// all successful fits of a seed, waiting to be stored in the track map
+  struct SeedFit
+  {
+    TrackSeed* seed = nullptr;
+    bool use_estimate = false;
+    /// the last crossing variation returned a good fit
+    bool last_ok = false;
+    int nBadFits = 0;
+    std::vector<FitTrial> trials;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -133,11 +166,18 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// fit all crossing hypotheses of a seed. Only reads shared data, so seeds can be fitted
+  /// concurrently when the cluster mover is used
+  void fitSeed(TrackSeed* track, SeedFit& seedfit);
+
+  /// pick the fit of a seed and store it in the track map, not thread safe
+  void storeSeedFit(SeedFit& seedfit);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                       SvtxTrack* track);
+                       SvtxTrack* track) const;
 
   /// Helper function to call either the regular navigation or direct
   /// navigation, depending on m_fitSiliconMMs
@@ -148,7 +188,7 @@ class PHActsTrkFitter : public SubsysReco
           kfOptions,
       const SurfacePtrVec& surfSequence,
       const CalibratorAdapter& calibrator,
-      ActsTrackFittingAlgorithm::TrackContainer& tracks);
+      ActsTrackFittingAlgorithm::TrackContainer& tracks) const;
 
   /// Functions to get list of sorted surfaces for direct navigation, if
   /// applicable
@@ -156,10 +196,11 @@ class PHActsTrkFitter : public SubsysReco
                                  SurfacePtrVec& surfaces) const;
   void checkSurfaceVec(SurfacePtrVec& surfaces) const;
 
-  bool getTrackFitResult(FitResult& fitOutput, TrackSeed* seed,
-                         SvtxTrack* track,
-                         ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+  /// fill the track tips, parameters and SvtxTrack of a trial from the fit output
+  bool getTrackFitResult(FitResult& fitOutput, FitTrial& trial) const;
+
+  /// fill alignment states, trajectory and evaluator for a fitted track
+  void storeTrackFitResult(FitTrial& trial, TrackSeed* seed);
 
   Acts::BoundSquareMatrix setDefaultCovariance() const;
   void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const;
@@ -224,6 +265,9 @@ class PHActsTrkFitter : public SubsysReco
   TpcDistortionCorrectionContainer* _dcc_average{nullptr};
   TpcDistortionCorrectionContainer* _dcc_fluctuation{nullptr};
 
+  bool m_use_position_cache = false;
+  TrkrClusterPositionCache* m_position_cache = nullptr;
+
   ClusterErrorPara _ClusErrPara;
 
   std::set<int> m_ignoreLayer;
@@ -244,6 +288,9 @@ class PHActsTrkFitter : public SubsysReco
 
   PHG4TpcCylinderGeomContainer* _tpccellgeo = nullptr;
 
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   /// Variables for doing event time execution analysis
   bool m_timeAnalysis = false;
   TFile* m_timeFile = nullptr;
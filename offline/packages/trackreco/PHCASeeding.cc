@@ -13,6 +13,7 @@
 // sPHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -30,6 +31,7 @@
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrClusterHitAssoc.h>
 #include <trackbase/TrkrClusterIterationMapv1.h>
+#include <trackbase/TrkrClusterPositionCache.h>
 #include <trackbase/TrkrDefs.h>  // for getLayer, clu...
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeed_v2.h>
@@ -53,6 +55,7 @@
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <map>
 #include <numeric>
 #include <unordered_set>
 #include <utility>  // for pair, make_pair
@@ -175,6 +178,30 @@ namespace
     return 2 * atan2(sqrt(dx * dx + dy * dy + dz * dz), sqrt(sx * sx + sy * sy + sz * sz));
   }
 
+  /// split a phi window which crosses 0 or 2pi into the (at most two) ranges inside [0, 2pi]
+  inline int split_phi_window(double phimin, double phimax, std::array<std::array<float, 2>, 2>& ranges)
+  {
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      ranges[0] = {static_cast<float>(phimin), static_cast<float>(2 * M_PI)};
+      ranges[1] = {0.F, static_cast<float>(phimax)};
+      return 2;
+    }
+    ranges[0] = {static_cast<float>(phimin), static_cast<float>(phimax)};
+    return 1;
+  }
+
 }  // namespace
 
 // using namespace ROOT::Minuit2;
@@ -208,6 +235,8 @@ PHCASeeding::PHCASeeding(
 {
 }
 
+PHCASeeding::~PHCASeeding() = default;
+
 int PHCASeeding::InitializeGeometry(PHCompositeNode* topNode)
 {
   tGeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
@@ -234,27 +263,106 @@ Acts::Vector3 PHCASeeding::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster*
   return globalpos;
 }
 
-void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& rtree, double phimin, double etamin, double phimax, double etamax, std::vector<pointKey>& returned_values) const
+void PHCASeeding::LayerGrid::clear()
+{
+  m_nphi = 0;
+  m_nz = 0;
+  m_offsets.clear();
+  m_phi.clear();
+  m_z.clear();
+  m_keys.clear();
+}
+
+int PHCASeeding::LayerGrid::phibin(const float phi) const
+{
+  // fill and query use the same (monotonic) binning, so clamping keeps the
+  // boundaries conservative
+  const int bin = static_cast<int>(std::floor(phi / m_phibinwidth));
+  return std::clamp(bin, 0, m_nphi - 1);
+}
+
+int PHCASeeding::LayerGrid::zbin(const float z) const
 {
-  bool query_both_ends = false;
-  if (phimin < 0)
+  const int bin = static_cast<int>(std::floor((z - m_zmin) / m_zbinwidth));
+  return std::clamp(bin, 0, m_nz - 1);
+}
+
+void PHCASeeding::LayerGrid::build(const std::vector<std::array<float, 2>>& positions, const PHCASeeding::keyList& keys, const double phi_window, const double z_window)
+{
+  clear();
+  if (positions.empty())
   {
-    query_both_ends = true;
-    phimin += 2 * M_PI;
+    return;
   }
-  if (phimax > 2 * M_PI)
+
+  // bins of about the search window, a query covers 2-3 bins in each direction.
+  // Limit the number of bins to a few per cluster so sparse layers stay small
+  m_nphi = (phi_window > 0) ? std::clamp(static_cast<int>(2 * M_PI / phi_window), 1, 1024) : 1;
+  m_phibinwidth = 2 * M_PI / m_nphi;
+
+  const auto [zlow, zhigh] = std::minmax_element(positions.begin(), positions.end(),
+                                                 [](const std::array<float, 2>& lhs, const std::array<float, 2>& rhs)
+                                                 { return lhs[1] < rhs[1]; });
+  m_zmin = (*zlow)[1];
+  const double zrange = (*zhigh)[1] - m_zmin;
+  const int max_nz = std::clamp(static_cast<int>(4 * positions.size() / m_nphi), 1, 4096);
+  m_nz = (z_window > 0) ? std::clamp(static_cast<int>(zrange / z_window) + 1, 1, max_nz) : 1;
+  m_zbinwidth = (zrange > 0) ? zrange / m_nz : 1.;
+
+  // counting sort of the clusters into the bins
+  const size_t nbins = static_cast<size_t>(m_nphi) * m_nz;
+  m_offsets.assign(nbins + 1, 0);
+  std::vector<unsigned int> bins(positions.size());
+  for (size_t i = 0; i < positions.size(); ++i)
   {
-    query_both_ends = true;
-    phimax -= 2 * M_PI;
+    bins[i] = phibin(positions[i][0]) * m_nz + zbin(positions[i][1]);
+    ++m_offsets[bins[i] + 1];
   }
-  if (query_both_ends)
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+
+  m_phi.resize(positions.size());
+  m_z.resize(positions.size());
+  m_keys.resize(positions.size());
+  std::vector<unsigned int> next(m_offsets.begin(), m_offsets.end() - 1);
+  for (size_t i = 0; i < positions.size(); ++i)
   {
-    rtree.query(bgi::intersects(box(point(phimin, etamin), point(2 * M_PI, etamax))), std::back_inserter(returned_values));
-    rtree.query(bgi::intersects(box(point(0., etamin), point(phimax, etamax))), std::back_inserter(returned_values));
+    const unsigned int index = next[bins[i]]++;
+    m_phi[index] = positions[i][0];
+    m_z[index] = positions[i][1];
+    m_keys[index] = keys[i];
   }
-  else
+}
+
+void PHCASeeding::LayerGrid::query(const float phimin, const float zmin, const float phimax, const float zmax, std::vector<PHCASeeding::pointKey>& returned_values) const
+{
+  if (m_keys.empty() || phimin > phimax || zmin > zmax)
+  {
+    return;
+  }
+  const int iz0 = zbin(zmin);
+  const int iz1 = zbin(zmax);
+  for (int iphi = phibin(phimin); iphi <= phibin(phimax); ++iphi)
+  {
+    // the z bins of one phi bin are contiguous
+    const unsigned int first = m_offsets[iphi * m_nz + iz0];
+    const unsigned int last = m_offsets[iphi * m_nz + iz1 + 1];
+    for (unsigned int i = first; i < last; ++i)
+    {
+      if (m_phi[i] >= phimin && m_phi[i] <= phimax && m_z[i] >= zmin && m_z[i] <= zmax)
+      {
+        returned_values.emplace_back(point(m_phi[i], m_z[i]), m_keys[i]);
+      }
+    }
+  }
+}
+
+void PHCASeeding::QueryGrid(const PHCASeeding::LayerGrid& grid, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const
+{
+  std::array<std::array<float, 2>, 2> phiranges{};
+  const int nranges = split_phi_window(phimin, phimax, phiranges);
+  for (int i = 0; i < nranges; ++i)
   {
-    rtree.query(bgi::intersects(box(point(phimin, etamin), point(phimax, etamax))), std::back_inserter(returned_values));
+    grid.query(phiranges[i][0], static_cast<float>(zmin), phiranges[i][1], static_cast<float>(zmax), returned_values);
   }
 }
 
@@ -264,6 +372,13 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
   PositionMap cachedPositions;
   cachedPositions.reserve(_cluster_map->size());  // avoid resizing mid-execution
 
+  // positions computed upstream, if they have the same corrections as here
+  const TrkrClusterPositionCache::Positions* positions = m_position_cache ? m_position_cache->get(TrkrClusterPositionCache::NoCrossing, TrkrClusterPositionCache::corrections(m_dcc && !_pp_mode, false, false)) : nullptr;
+  if (m_position_cache && !positions && Verbosity() > 0)
+  {
+    std::cout << "PHCASeeding::FillGlobalPositions - no cached positions with the same distortion corrections, not used" << std::endl;
+  }
+
   for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
   {
     auto range = _cluster_map->getClusters(hitsetkey);
@@ -289,7 +404,11 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
       }
 
       // get global position, convert to Acts::Vector3 and store in map
-      const Acts::Vector3 globalpos_d = getGlobalPosition(ckey, cluster);
+      Acts::Vector3 globalpos_d;
+      if (!positions || !positions->find(ckey, globalpos_d))
+      {
+        globalpos_d = getGlobalPosition(ckey, cluster);
+      }
       const Acts::Vector3 globalpos = {globalpos_d.x(), globalpos_d.y(), globalpos_d.z()};
       cachedPositions.insert(std::make_pair(ckey, globalpos));
       ckeys[layer - _FIRST_LAYER_TPC].push_back(ckey);
@@ -299,14 +418,22 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
   return std::make_pair(cachedPositions, ckeys);
 }
 
-std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillGrid(PHCASeeding::LayerGrid& grid, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer) const
 {
-  // Fill _rtree with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
+  // Fill grid with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
   // Note that layer is only used for a cout statement
   int n_dupli = 0;
   std::vector<coordKey> coords;
-  _rtree.clear();
-  /* _rtree.reserve(ckeys.size()); */
+  std::vector<std::array<float, 2>> positions;
+  keyList keys;
+  coords.reserve(ckeys.size());
+  positions.reserve(ckeys.size());
+  keys.reserve(ckeys.size());
+
+  // clusters accepted so far, ordered by z. A cluster is a duplicate if an
+  // accepted cluster is within 1e-5 of its (phi, eta); the stored coordinate
+  // is z, as it has always been for the search tree
+  std::multimap<float, float> accepted;
   for (const auto& ckey : ckeys)
   {
     const auto& globalpos_d = globalPositions.at(ckey);
@@ -314,30 +441,35 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
     const double clus_eta = get_eta(globalpos_d);
     if (Verbosity() > 0)
     {
-      /* int layer = TrkrDefs::getLayer(ckey); */
       std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
     }
-    std::vector<pointKey> testduplicate;
-    QueryTree(_rtree, clus_phi - 0.00001, clus_eta - 0.00001, clus_phi + 0.00001, clus_eta + 0.00001, testduplicate);
-    if (!testduplicate.empty())
+    std::array<std::array<float, 2>, 2> phiranges{};
+    const int nranges = split_phi_window(clus_phi - 0.00001, clus_phi + 0.00001, phiranges);
+    const auto end = accepted.upper_bound(static_cast<float>(clus_eta + 0.00001));
+    bool duplicate = false;
+    for (auto iter = accepted.lower_bound(static_cast<float>(clus_eta - 0.00001)); iter != end && !duplicate; ++iter)
+    {
+      for (int i = 0; i < nranges; ++i)
+      {
+        duplicate |= (iter->second >= phiranges[i][0] && iter->second <= phiranges[i][1]);
+      }
+    }
+    if (duplicate)
     {
       ++n_dupli;
       continue;
     }
     coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_eta)}, ckey});
-    t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
+    positions.push_back({static_cast<float>(clus_phi), static_cast<float>(globalpos_d.z())});
+    keys.push_back(ckey);
+    accepted.emplace(positions.back()[1], positions.back()[0]);
   }
+  grid.build(positions, keys, _neighbor_phi_width, _neighbor_eta_width);
   if (Verbosity() > 1)
   {
     std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
   }
   if (Verbosity() > 0)
-  {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
-  }
-  if (Verbosity() > 0)
   {
     std::cout << "number of duplicates : " << n_dupli << std::endl;
   }
@@ -420,15 +552,11 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   keyLinkPerLayer bodyLinks;  //  bilinks to build chains
                               //
   double cluster_find_time = 0;
-  double rtree_query_time = 0;
+  double grid_query_time = 0;
   double transform_time = 0;
   double compute_best_angle_time = 0;
   double set_insert_time = 0;
 
-  // there are three coord_array (only the current layer is used at a time,
-  // but it is filled the same time as the _rtrees, which are used two at
-  // a time -- the prior padplane row and the next padplain row
-  std::array<std::vector<coordKey>, 3> coord_arr;
   std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
   std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
 
@@ -436,26 +564,27 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
   const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
 
-  // fill the current and prior row coord and ttrees for the first iteration
-  int _index_above = (outer_index + 1) % 3;
-  int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
+  // fill the coords and grids of all rows used below. The rows are
+  // independent, so they are filled in parallel up front
+  const int first_index = std::min(inner_index - 1, outer_index);
+  const int last_index = outer_index + 1;
+  t_fill->restart();
+  m_threadpool->parallel_for(last_index - first_index + 1, [&](size_t task, unsigned int /*thread*/)
+                             {
+    const int index = first_index + static_cast<int>(task);
+    _grid_coords[index] = FillGrid(_grids[index], ckeys[index], globalPositions, index); });
+  t_fill->stop();
+  if (Verbosity() > 0)
+  {
+    std::cout << "fill time: " << t_fill->elapsed() / 1000. << " sec" << std::endl;
+  }
 
   for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
   {
-    // these lines of code will rotates through all three _rtree's in the array,
-    // where the old lower becomes the new middle, the old middle the new upper,
-    // and the old upper drops out and that _rtree is filled with the new lower
-    int index_above = (layer_index + 1) % 3;
-    int index_current = (layer_index) % 3;
-    int index_below = (layer_index - 1) % 3;
-
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
-
-    auto& _rtree_above = _rtrees[index_above];
-    const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
+    // the grids of the prior padplane row and the next padplane row
+    const auto& grid_above = _grids[layer_index + 1];
+    const std::vector<coordKey>& coord = _grid_coords[layer_index];
+    const auto& grid_below = _grids[layer_index - 1];
 
     auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
     auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
@@ -489,14 +618,14 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       std::vector<pointKey> ClustersAbove;
       std::vector<pointKey> ClustersBelow;
 
-      QueryTree(_rtree_below,
+      QueryGrid(grid_below,
                 StartPhi - _neighbor_phi_width,
                 StartZ - _neighbor_eta_width,
                 StartPhi + _neighbor_phi_width,
                 StartZ + _neighbor_eta_width,
                 ClustersBelow);
 
-      QueryTree(_rtree_above,
+      QueryGrid(grid_above,
                 StartPhi - _neighbor_phi_width,
                 StartZ - _neighbor_eta_width,
                 StartPhi + _neighbor_phi_width,
@@ -504,7 +633,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
                 ClustersAbove);
 
       t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
+      grid_query_time += t_seed->elapsed();
       t_seed->restart();
       LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
       LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
@@ -615,7 +744,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   {
     std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
     std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
-    std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
+    std::cout << "Grid query: " << grid_query_time / 1000 << " s" << std::endl;
     std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
     std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
     std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
@@ -920,6 +1049,15 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
     std::cout << "PHCASeeding::Setup - found static TPC distortion correction container" << std::endl;
   }
 
+  if (m_use_position_cache)
+  {
+    m_position_cache = findNode::getClass<TrkrClusterPositionCache>(topNode, "TRKR_CLUSTERPOSITIONS");
+    if (!m_position_cache)
+    {
+      std::cout << "PHCASeeding::Setup - no TRKR_CLUSTERPOSITIONS node, computing the cluster positions here" << std::endl;
+    }
+  }
+
   t_fill = std::make_unique<PHTimer>("t_fill");
   t_fill->stop();
 
@@ -932,6 +1070,11 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   t_makeseeds = std::make_unique<PHTimer>("t_makeseeds");
   t_makeseeds->stop();
 
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+  }
+
   //  fcfg.set_rescale(1);
   std::unique_ptr<PHField> field_map;
   if (_use_const_field)
@@ -33,6 +33,7 @@
 #include <boost/geometry/geometries/point.hpp>  // for point
 #include <boost/geometry/index/rtree.hpp>       // for ca
 
+#include <array>
 #include <cmath>    // for M_PI
 #include <cstdint>  // for uint64_t
 #include <map>      // for map
@@ -54,11 +55,14 @@ class PHTimer;
 class SvtxTrack_v3;
 class TpcDistortionCorrectionContainer;
 class TrkrCluster;
+class TrkrClusterPositionCache;
 
 
 namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
 
+class PHThreadPool;
+
 
 class PHCASeeding : public PHTrackSeeding
 {
@@ -96,7 +100,7 @@ class PHCASeeding : public PHTrackSeeding
       float maxSinPhi = 0.999,
       float cosTheta_limit = -0.8);
 
-  ~PHCASeeding() override {}
+  ~PHCASeeding() override;
   void SetLayerRange(unsigned int layer_low, unsigned int layer_up)
   {
     _start_layer = layer_low;
@@ -137,6 +141,43 @@ class PHCASeeding : public PHTrackSeeding
   void useFixedClusterError(bool opt) { _use_fixed_clus_err = opt; }
   void setFixedClusterError(int i, double val) { _fixed_clus_err.at(i) = val; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
+  //! threads used to build the per layer cluster grids (0 = all cores)
+  void SetNumThreads(unsigned int n) { m_num_threads = n; }
+
+  /// clusters of one layer binned in (phi, z), bin contents stored contiguously
+  /**
+   * replaces the per layer rtree: the search windows are fixed boxes, so a
+   * grid with bins of about the window size only has to scan a few
+   * contiguous bins per query. Public for the comparison with the rtree in
+   * macros/PHCASeedingGridBenchmark.C
+   */
+  class LayerGrid
+  {
+   public:
+    void clear();
+    void build(const std::vector<std::array<float, 2>>& positions, const keyList& keys, double phi_window, double z_window);
+    //! append all clusters with phimin <= phi <= phimax and zmin <= z <= zmax (inclusive, like the rtree box)
+    void query(float phimin, float zmin, float phimax, float zmax, std::vector<pointKey>& returned_values) const;
+    size_t size() const { return m_keys.size(); }
+
+   private:
+    int phibin(float phi) const;
+    int zbin(float z) const;
+
+    int m_nphi = 0;
+    int m_nz = 0;
+    double m_phibinwidth = 0;
+    double m_zmin = 0;
+    double m_zbinwidth = 0;
+    // first entry of every bin (phi major, z minor), size m_nphi*m_nz+1
+    std::vector<unsigned int> m_offsets;
+    std::vector<float> m_phi;
+    std::vector<float> m_z;
+    keyList m_keys;
+  };
+
+  //! read the cluster positions from TRKR_CLUSTERPOSITIONS (PHClusterPositionCacheMaker)
+  void usePositionCache(bool opt) { m_use_position_cache = opt; }
 
  protected:
   int Setup(PHCompositeNode* topNode) override;
@@ -186,10 +227,11 @@ class PHCASeeding : public PHTrackSeeding
   std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
   PHCASeeding::keyLists FollowBiLinks( const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
-  std::vector<coordKey> FillTree(bgi::rtree<pointKey,bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
 
-  void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double etamin, double phimax, double etamax, std::vector<pointKey>& returned_values) const;
+  //! fill grid with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
+  std::vector<coordKey> FillGrid(LayerGrid&, const keyList&, const PositionMap&, int layer) const;
+  void QueryGrid(const LayerGrid& grid, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
   std::vector<TrackSeed_v2> RemoveBadClusters(const std::vector<keyList>& seeds, const PositionMap& globalPositions) const;
   double getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PositionMap& globalPositions) const;
 
@@ -233,14 +275,21 @@ class PHCASeeding : public PHTrackSeeding
   /// distortion correction container
   TpcDistortionCorrectionContainer* m_dcc = nullptr;
 
+  /// cluster positions computed once per event
+  bool m_use_position_cache = false;
+  TrkrClusterPositionCache* m_position_cache = nullptr;
+
   std::unique_ptr<ALICEKF> fitter;
 
   std::unique_ptr<PHTimer> t_seed;
   std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
-  /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey,bgi::quadratic<16>>, 3> _rtrees; // need three layers at a time
+  std::array<LayerGrid, _NLAYERS_TPC> _grids;
+  std::array<std::vector<coordKey>, _NLAYERS_TPC> _grid_coords;
+
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
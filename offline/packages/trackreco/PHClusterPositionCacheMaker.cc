@@ -0,0 +1,183 @@
+#include "PHClusterPositionCacheMaker.h"
+
+#include <trackbase/ActsGeometry.h>
+#include <trackbase/TpcDefs.h>
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterPositionCache.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <tpc/TpcDistortionCorrectionContainer.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <iostream>
+
+//____________________________________________________________________________..
+PHClusterPositionCacheMaker::PHClusterPositionCacheMaker(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+int PHClusterPositionCacheMaker::InitRun(PHCompositeNode *topNode)
+{
+  PHNodeIterator iter(topNode);
+  auto dstNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << PHWHERE << " DST node is missing, quitting" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  PHNodeIterator dstiter(dstNode);
+  auto trkrNode = dynamic_cast<PHCompositeNode *>(dstiter.findFirst("PHCompositeNode", "TRKR"));
+  if (!trkrNode)
+  {
+    trkrNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(trkrNode);
+  }
+
+  // transient, the positions are not written out
+  m_cache = findNode::getClass<TrkrClusterPositionCache>(topNode, "TRKR_CLUSTERPOSITIONS");
+  if (!m_cache)
+  {
+    m_cache = new TrkrClusterPositionCache;
+    auto node = new PHDataNode<TrkrClusterPositionCache>(m_cache, "TRKR_CLUSTERPOSITIONS");
+    trkrNode->addNode(node);
+  }
+
+  return get_nodes(topNode);
+}
+
+//____________________________________________________________________________..
+int PHClusterPositionCacheMaker::get_nodes(PHCompositeNode *topNode)
+{
+  m_tGeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
+  if (!m_tGeometry)
+  {
+    std::cout << PHWHERE << " No Acts tracking geometry, exiting." << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  const std::string clusternode = m_use_truth_clusters ? "TRKR_CLUSTER_TRUTH" : "TRKR_CLUSTER";
+  m_cluster_map = findNode::getClass<TrkrClusterContainer>(topNode, clusternode);
+  if (!m_cluster_map)
+  {
+    std::cout << PHWHERE << " ERROR: Can't find node " << clusternode << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  // tpc distortion corrections
+  m_dcc_static = findNode::getClass<TpcDistortionCorrectionContainer>(topNode, "TpcDistortionCorrectionContainerStatic");
+  m_dcc_average = findNode::getClass<TpcDistortionCorrectionContainer>(topNode, "TpcDistortionCorrectionContainerAverage");
+  m_dcc_fluctuation = findNode::getClass<TpcDistortionCorrectionContainer>(topNode, "TpcDistortionCorrectionContainerFluctuation");
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHClusterPositionCacheMaker::InitRun - distortion corrections"
+              << " static: " << (m_dcc_static != nullptr)
+              << " average: " << (m_dcc_average != nullptr)
+              << " fluctuation: " << (m_dcc_fluctuation != nullptr)
+              << " crossings: " << m_crossings.size() << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int PHClusterPositionCacheMaker::process_event(PHCompositeNode * /*topNode*/)
+{
+  m_cache->Reset();
+
+  // the seeders do not correct TPC positions in pp mode, the fitters with a crossing always do
+  const unsigned int all_corrections = TrkrClusterPositionCache::corrections(m_dcc_static, m_dcc_average, m_dcc_fluctuation);
+  const unsigned int nocrossing_corrections = m_pp_mode ? 0U : all_corrections;
+  fill(TrkrClusterPositionCache::NoCrossing, nocrossing_corrections, false);
+
+  // PHCASeeding only applies the static correction, give it its own TPC block
+  const unsigned int seeding_corrections = m_pp_mode ? 0U : TrkrClusterPositionCache::corrections(m_dcc_static, false, false);
+  if (seeding_corrections != nocrossing_corrections)
+  {
+    fill(TrkrClusterPositionCache::NoCrossing, seeding_corrections, true);
+  }
+
+  for (const auto crossing : m_crossings)
+  {
+    fill(crossing, all_corrections, true);
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+void PHClusterPositionCacheMaker::fill(short crossing, unsigned int corrections, bool tpc_only)
+{
+  auto &positions = m_cache->addCrossing(crossing, corrections);
+  const auto *dcc_static = (corrections & TrkrClusterPositionCache::StaticCorrection) ? m_dcc_static : nullptr;
+  const auto *dcc_average = (corrections & TrkrClusterPositionCache::AverageCorrection) ? m_dcc_average : nullptr;
+  const auto *dcc_fluctuation = (corrections & TrkrClusterPositionCache::FluctuationCorrection) ? m_dcc_fluctuation : nullptr;
+
+  const auto hitsetkeys = tpc_only ? m_cluster_map->getHitSetKeys(TrkrDefs::tpcId) : m_cluster_map->getHitSetKeys();
+  for (const auto &hitsetkey : hitsetkeys)
+  {
+    // one slot per cluster index of the hitset
+    auto range = m_cluster_map->getClusters(hitsetkey);
+    unsigned int nslots = 0;
+    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+    {
+      nslots = std::max(nslots, TrkrDefs::getClusIndex(clusIter->first) + 1);
+    }
+    positions.addHitSet(hitsetkey, nslots);
+
+    const bool is_tpc = TrkrDefs::getTrkrId(hitsetkey) == TrkrDefs::tpcId;
+    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+    {
+      const auto key = clusIter->first;
+      auto cluster = clusIter->second;
+      if (!cluster)
+      {
+        continue;
+      }
+
+      auto global = m_tGeometry->getGlobalPosition(key, cluster);
+      if (is_tpc)
+      {
+        if (crossing != TrkrClusterPositionCache::NoCrossing)
+        {
+          global[2] = m_clusterCrossingCorrection.correctZ(global[2], TpcDefs::getSide(key), crossing);
+        }
+        if (dcc_static)
+        {
+          global = m_distortionCorrection.get_corrected_position(global, dcc_static);
+        }
+        if (dcc_average)
+        {
+          global = m_distortionCorrection.get_corrected_position(global, dcc_average);
+        }
+        if (dcc_fluctuation)
+        {
+          global = m_distortionCorrection.get_corrected_position(global, dcc_fluctuation);
+        }
+      }
+      positions.set(key, global);
+      ++m_nclusters;
+    }
+  }
+}
+
+//____________________________________________________________________________..
+int PHClusterPositionCacheMaker::End(PHCompositeNode * /*topNode*/)
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHClusterPositionCacheMaker::End - cached " << m_nclusters << " cluster positions" << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,88 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+
+/*!
+ *  \file PHClusterPositionCacheMaker.h
+ *  \brief Compute the corrected global positions of all clusters once per event
+ */
+
+#ifndef TRACKRECO_PHCLUSTERPOSITIONCACHEMAKER_H
+#define TRACKRECO_PHCLUSTERPOSITIONCACHEMAKER_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <tpc/TpcClusterZCrossingCorrection.h>
+#include <tpc/TpcDistortionCorrection.h>
+
+#include <set>
+#include <string>
+
+class ActsGeometry;
+class PHCompositeNode;
+class TpcDistortionCorrectionContainer;
+class TrkrClusterContainer;
+class TrkrClusterPositionCache;
+
+/**
+ * Fills the TRKR_CLUSTERPOSITIONS node (TrkrClusterPositionCache) with the
+ * global position of every cluster. TPC positions get the static, average
+ * and fluctuation distortion corrections which are present on the node tree
+ * (none in pp mode), the same as in the seeding and fitting modules.
+ *
+ * The positions without crossing correction are always filled. If the
+ * static correction alone differs from all corrections, the TPC positions
+ * are filled a second time with only the static correction, as PHCASeeding
+ * applies it. For each crossing given with add_crossing() the TPC positions
+ * are also filled with the z corrected for that crossing before the
+ * distortion corrections.
+ *
+ * The cache is only valid until the clusters are modified, register the
+ * module after the last module which moves clusters (e.g. the delta z
+ * correction) and before the modules reading it. It can be registered
+ * several times under different names to refresh the cache.
+ */
+class PHClusterPositionCacheMaker : public SubsysReco
+{
+ public:
+  PHClusterPositionCacheMaker(const std::string &name = "PHClusterPositionCacheMaker");
+
+  ~PHClusterPositionCacheMaker() override = default;
+
+  int InitRun(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+  int End(PHCompositeNode *topNode) override;
+
+  void set_pp_mode(bool mode) { m_pp_mode = mode; }
+
+  void useTruthClusters(bool truth) { m_use_truth_clusters = truth; }
+
+  //! also fill the TPC positions corrected for this bunch crossing
+  void add_crossing(short crossing) { m_crossings.insert(crossing); }
+
+ private:
+  int get_nodes(PHCompositeNode *topNode);
+
+  //! fill the positions of all clusters for one crossing hypothesis with the
+  //! given Correction bits, TPC only if tpc_only is set
+  void fill(short crossing, unsigned int corrections, bool tpc_only);
+
+  ActsGeometry *m_tGeometry = nullptr;
+  TrkrClusterContainer *m_cluster_map = nullptr;
+  TrkrClusterPositionCache *m_cache = nullptr;
+
+  const TpcDistortionCorrectionContainer *m_dcc_static = nullptr;
+  const TpcDistortionCorrectionContainer *m_dcc_average = nullptr;
+  const TpcDistortionCorrectionContainer *m_dcc_fluctuation = nullptr;
+
+  TpcDistortionCorrection m_distortionCorrection;
+  TpcClusterZCrossingCorrection m_clusterCrossingCorrection;
+
+  std::set<short> m_crossings;
+
+  bool m_pp_mode = false;
+  bool m_use_truth_clusters = false;
+
+  unsigned long m_nclusters = 0;
+};
+
+#endif  // TRACKRECO_PHCLUSTERPOSITIONCACHEMAKER_H
@@ -29,6 +29,7 @@
 #include <trackbase/TrkrCluster.h>
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrClusterIterationMapv1.h>
+#include <trackbase/TrkrClusterPositionCache.h>
 #include <trackbase/TrkrDefs.h>
 
 #include <trackbase_historic/ActsTransformations.h>
@@ -37,6 +38,7 @@
 
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -51,6 +53,7 @@
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>  // for operator<<, basic_ostream
 #include <vector>
@@ -73,8 +76,26 @@ PHSimpleKFProp::PHSimpleKFProp(const std::string& name)
 {
 }
 
+PHSimpleKFProp::~PHSimpleKFProp() = default;
+
+double PHSimpleKFProp::get_propagation_time() const
+{
+  return t_propagate ? t_propagate->get_accumulated_time() : 0;
+}
+
 int PHSimpleKFProp::End(PHCompositeNode* /*unused*/)
 {
+  if (Verbosity() > 0 && t_propagate)
+  {
+    const double time = get_propagation_time();
+    std::cout << "PHSimpleKFProp::End - threads: " << m_threadpool->size() << std::endl;
+    std::cout << "  propagation: " << time << " ms for " << m_nseeds << " seeds in " << t_propagate->get_ncycle() << " events";
+    if (time > 0)
+    {
+      std::cout << ", " << m_nseeds / time * 1000. << " seeds/s";
+    }
+    std::cout << std::endl;
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -124,6 +145,18 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   fitter->setFixedClusterError(0, _fixed_clus_err.at(0));
   fitter->setFixedClusterError(1, _fixed_clus_err.at(1));
   fitter->setFixedClusterError(2, _fixed_clus_err.at(2));
+
+  // seeds are propagated on a pool of threads which lives for the whole job
+  if (!m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_num_threads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHSimpleKFProp::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+  t_propagate = std::make_unique<PHTimer>("t_propagate");
+  t_propagate->stop();
   //  _field_map = PHFieldUtility::GetFieldMapNode(nullptr,topNode);
   // m_Cache = magField->makeCache(m_tGeometry->magFieldContext);
 
@@ -186,6 +219,15 @@ int PHSimpleKFProp::get_nodes(PHCompositeNode* topNode)
     std::cout << PHWHERE << "  found fluctuation TPC distortion correction container" << std::endl;
   }
 
+  if (m_use_position_cache)
+  {
+    m_position_cache = findNode::getClass<TrkrClusterPositionCache>(topNode, "TRKR_CLUSTERPOSITIONS");
+    if (!m_position_cache)
+    {
+      std::cout << PHWHERE << "  no TRKR_CLUSTERPOSITIONS node, computing the cluster positions here" << std::endl;
+    }
+  }
+
   if (_use_truth_clusters)
   {
     _cluster_map = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER_TRUTH");
@@ -250,149 +292,34 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
     std::cout << "prepared KD trees" << std::endl;
   }
 
+  // refit and propagate the seeds, concurrently if there is more than one thread.
+  // The results are kept per seed and merged in seed order below
+  t_propagate->restart();
+  const unsigned int nseeds = _track_map->size();
+  m_results.clear();
+  m_results.resize(nseeds);
+  m_threadpool->parallel_for(nseeds, [this, &globalPositions](size_t task, unsigned int /*thread*/)
+                             { PropagateSeed(_track_map->get(task), globalPositions, m_results[task]); });
+  t_propagate->stop();
+  m_nseeds += nseeds;
+
   std::vector<std::vector<TrkrDefs::cluskey>> new_chains;
   std::vector<TrackSeed_v2> unused_tracks;
-  for (unsigned int track_it = 0; track_it != _track_map->size(); ++track_it)
+  for (unsigned int track_it = 0; track_it != nseeds; ++track_it)
   {
-    if (Verbosity())
+    auto& result = m_results[track_it];
+    if (result.has_chain)
     {
-      std::cout << "TPC seed " << track_it << std::endl;
+      new_chains.push_back(std::move(result.chain));
     }
-    // if not a TPC track, ignore
-    TrackSeed* track = _track_map->get(track_it);
-    const bool is_tpc = std::any_of(
-        track->begin_cluster_keys(),
-        track->end_cluster_keys(),
-        [](const TrkrDefs::cluskey& key)
-        { return TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId; });
-
-    if (is_tpc)
-    {
-      std::vector<std::vector<TrkrDefs::cluskey>> keylist_A;
-      std::vector<TrkrDefs::cluskey> dumvec;
-      std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
-      for (TrackSeed::ConstClusterKeyIter iter = track->begin_cluster_keys();
-           iter != track->end_cluster_keys();
-           ++iter)
-      {
-        dumvec.push_back(*iter);
-        auto pos = globalPositions.at(*iter);
-        trackClusPositions.insert(std::make_pair(*iter, pos));
-      }
-
-      /// Can't circle fit a seed with less than 3 clusters, skip it
-      if (dumvec.size() < 3)
-      {
-        continue;
-      }
-
-      keylist_A.push_back(dumvec);
-
-      /// This will by definition return a single pair with each vector
-      /// in the pair length 1 corresponding to the seed info
-      std::vector<float> trackChi2;
-      timer.stop();
-      timer.restart();
-
-      auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
-                                                trackClusPositions, trackChi2);
-
-      timer.stop();
-      if (Verbosity() > 3)
-      {
-        std::cout << "single track ALICEKF time " << timer.elapsed()
-                  << std::endl;
-      }
-      timer.restart();
-      /// circle fit back to update track parameters
-      track->circleFitByTaubin(trackClusPositions, 7, 55);
-      track->lineFit(trackClusPositions, 7, 55);
-      float trackphi = track->get_phi(trackClusPositions);
-      track->set_phi(trackphi);  // make phi persistent
-      timer.stop();
-      if (Verbosity() > 3)
-      {
-        std::cout << "single track circle fit time " << timer.elapsed() << std::endl;
-      }
-      if (seedpair.first.size() == 0 || seedpair.second.size() == 0)
-      {
-        continue;
-      }
-      if (Verbosity())
-      {
-        std::cout << "is tpc track" << std::endl;
-      }
-
-      timer.stop();
-      timer.restart();
-
-      if (Verbosity())
-      {
-        std::cout << "propagate first round" << std::endl;
-      }
-
-      auto preseed = PropagateTrack(track, seedpair.second.at(0), globalPositions);
-
-      if (Verbosity())
-      {
-        std::cout << "preseed size " << preseed.size() << std::endl;
-      }
-
-      if (preseed.size() > 40)
-      {
-        new_chains.push_back(preseed);
-        continue;
-      }
-
-      std::vector<std::vector<TrkrDefs::cluskey>> kl;
-      kl.push_back(preseed);
-
-      if (Verbosity())
-      {
-        std::cout << "kl size " << kl.size() << std::endl;
-      }
-      std::vector<float> pretrackChi2;
-      auto prepair = fitter->ALICEKalmanFilter(kl, false, globalPositions, pretrackChi2);
-      if (prepair.first.size() == 0 || prepair.second.size() == 0)
-      {
-        continue;
-      }
-
-      auto pretrack = prepair.first.at(0);
-      std::vector<TrkrDefs::cluskey> dumvec2;
-      std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
-      for (TrackSeed::ConstClusterKeyIter iter = pretrack.begin_cluster_keys();
-           iter != pretrack.end_cluster_keys();
-           ++iter)
-      {
-        dumvec2.push_back(*iter);
-        auto pos = globalPositions.at(*iter);
-        pretrackClusPositions.insert(std::make_pair(*iter, pos));
-      }
-
-      pretrack.circleFitByTaubin(pretrackClusPositions, 7, 55);
-      pretrack.lineFit(pretrackClusPositions, 7, 55);
-      float pretrackphi = pretrack.get_phi(pretrackClusPositions);
-      pretrack.set_phi(pretrackphi);  // make phi persistent
-
-      new_chains.push_back(PropagateTrack(&pretrack, prepair.second.at(0),
-                                          globalPositions));
-      timer.stop();
-
-      if (Verbosity() > 3)
-      {
-        const auto propagatetime = timer.elapsed();
-        std::cout << "propagate track time " << propagatetime << std::endl;
-      }
-    }
-    else
+    else if (!result.is_tpc)
     {
       // this is bad: it copies the track to its base class, which is essentially empty
       if (Verbosity())
       {
-        std::cout << "is NOT tpc track" << std::endl;
+        std::cout << "TPC seed " << track_it << " is NOT tpc track" << std::endl;
       }
-      unused_tracks.emplace_back(*track);
+      unused_tracks.emplace_back(*_track_map->get(track_it));
     }
   }
 
@@ -478,6 +405,13 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
     return globalPositions;
   }
 
+  // positions computed upstream, if they have the same corrections as here
+  const TrkrClusterPositionCache::Positions* positions = m_position_cache ? m_position_cache->get(TrkrClusterPositionCache::NoCrossing, TrkrClusterPositionCache::corrections(m_dcc_static && !_pp_mode, m_dcc_average && !_pp_mode, m_dcc_fluctuation && !_pp_mode)) : nullptr;
+  if (m_position_cache && !positions && Verbosity() > 0)
+  {
+    std::cout << "PHSimpleKFProp::PrepareKDTrees - no cached positions with the same distortion corrections, not used" << std::endl;
+  }
+
   for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
   {
     auto range = _cluster_map->getClusters(hitsetkey);
@@ -496,7 +430,11 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
         continue;
       }
 
-      const Acts::Vector3 globalpos_d = getGlobalPosition(cluskey, cluster);
+      Acts::Vector3 globalpos_d;
+      if (!positions || !positions->find(cluskey, globalpos_d))
+      {
+        globalpos_d = getGlobalPosition(cluskey, cluster);
+      }
       const Acts::Vector3 globalpos = {(float) globalpos_d.x(), (float) globalpos_d.y(), (float) globalpos_d.z()};
       globalPositions.insert(std::make_pair(cluskey, globalpos));
 
@@ -541,6 +479,139 @@ PositionMap PHSimpleKFProp::PrepareKDTrees()
   return globalPositions;
 }
 
+void PHSimpleKFProp::PropagateSeed(TrackSeed* track, const PositionMap& globalPositions, PropagationResult& result) const
+{
+  // if not a TPC track, ignore
+  result.is_tpc = std::any_of(
+      track->begin_cluster_keys(),
+      track->end_cluster_keys(),
+      [](const TrkrDefs::cluskey& key)
+      { return TrkrDefs::getTrkrId(key) == TrkrDefs::tpcId; });
+  if (!result.is_tpc)
+  {
+    return;
+  }
+
+  PHTimer timer("KFPropSeedTimer");
+  timer.stop();
+
+  std::vector<std::vector<TrkrDefs::cluskey>> keylist_A;
+  std::vector<TrkrDefs::cluskey> dumvec;
+  std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
+  for (TrackSeed::ConstClusterKeyIter iter = track->begin_cluster_keys();
+       iter != track->end_cluster_keys();
+       ++iter)
+  {
+    dumvec.push_back(*iter);
+    auto pos = globalPositions.at(*iter);
+    trackClusPositions.insert(std::make_pair(*iter, pos));
+  }
+
+  /// Can't circle fit a seed with less than 3 clusters, skip it
+  if (dumvec.size() < 3)
+  {
+    return;
+  }
+
+  keylist_A.push_back(dumvec);
+
+  /// This will by definition return a single pair with each vector
+  /// in the pair length 1 corresponding to the seed info
+  std::vector<float> trackChi2;
+  timer.restart();
+
+  auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
+                                            trackClusPositions, trackChi2);
+
+  timer.stop();
+  if (Verbosity() > 3)
+  {
+    std::cout << "single track ALICEKF time " << timer.elapsed()
+              << std::endl;
+  }
+  timer.restart();
+  /// circle fit back to update track parameters
+  track->circleFitByTaubin(trackClusPositions, 7, 55);
+  track->lineFit(trackClusPositions, 7, 55);
+  float trackphi = track->get_phi(trackClusPositions);
+  track->set_phi(trackphi);  // make phi persistent
+  timer.stop();
+  if (Verbosity() > 3)
+  {
+    std::cout << "single track circle fit time " << timer.elapsed() << std::endl;
+  }
+  if (seedpair.first.size() == 0 || seedpair.second.size() == 0)
+  {
+    return;
+  }
+  if (Verbosity())
+  {
+    std::cout << "is tpc track" << std::endl;
+  }
+
+  timer.restart();
+
+  if (Verbosity())
+  {
+    std::cout << "propagate first round" << std::endl;
+  }
+
+  auto preseed = PropagateTrack(track, seedpair.second.at(0), globalPositions);
+
+  if (Verbosity())
+  {
+    std::cout << "preseed size " << preseed.size() << std::endl;
+  }
+
+  if (preseed.size() > 40)
+  {
+    result.chain = std::move(preseed);
+    result.has_chain = true;
+    return;
+  }
+
+  std::vector<std::vector<TrkrDefs::cluskey>> kl;
+  kl.push_back(preseed);
+
+  if (Verbosity())
+  {
+    std::cout << "kl size " << kl.size() << std::endl;
+  }
+  std::vector<float> pretrackChi2;
+  auto prepair = fitter->ALICEKalmanFilter(kl, false, globalPositions, pretrackChi2);
+  if (prepair.first.size() == 0 || prepair.second.size() == 0)
+  {
+    return;
+  }
+
+  auto pretrack = prepair.first.at(0);
+  std::vector<TrkrDefs::cluskey> dumvec2;
+  std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
+  for (TrackSeed::ConstClusterKeyIter iter = pretrack.begin_cluster_keys();
+       iter != pretrack.end_cluster_keys();
+       ++iter)
+  {
+    dumvec2.push_back(*iter);
+    auto pos = globalPositions.at(*iter);
+    pretrackClusPositions.insert(std::make_pair(*iter, pos));
+  }
+
+  pretrack.circleFitByTaubin(pretrackClusPositions, 7, 55);
+  pretrack.lineFit(pretrackClusPositions, 7, 55);
+  float pretrackphi = pretrack.get_phi(pretrackClusPositions);
+  pretrack.set_phi(pretrackphi);  // make phi persistent
+
+  result.chain = PropagateTrack(&pretrack, prepair.second.at(0), globalPositions);
+  result.has_chain = true;
+  timer.stop();
+
+  if (Verbosity() > 3)
+  {
+    const auto propagatetime = timer.elapsed();
+    std::cout << "propagate track time " << propagatetime << std::endl;
+  }
+}
+
 std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, Eigen::Matrix<double, 6, 6>& xyzCov, const PositionMap& globalPositions) const
 {
   // extract cluster list
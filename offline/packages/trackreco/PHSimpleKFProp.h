@@ -29,9 +29,12 @@
 class ActsGeometry;
 class PHCompositeNode;
 class PHField;
+class PHThreadPool;
+class PHTimer;
 class TpcDistortionCorrectionContainer;
 class TrkrClusterContainer;
 class TrkrClusterIterationMapv1;
+class TrkrClusterPositionCache;
 class SvtxTrackMap;
 class TrackSeedContainer;
 class TrackSeed;
@@ -42,7 +45,7 @@ class PHSimpleKFProp : public SubsysReco
 {
  public:
   PHSimpleKFProp(const std::string& name = "PHSimpleKFProp");
-  ~PHSimpleKFProp() override = default;
+  ~PHSimpleKFProp() override;
 
   int InitRun(PHCompositeNode* topNode) override;
   int process_event(PHCompositeNode* topNode) override;
@@ -68,6 +71,14 @@ class PHSimpleKFProp : public SubsysReco
   }
   void SetIteration(int iter) { _n_iteration = iter; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
+  //! read the cluster positions from TRKR_CLUSTERPOSITIONS (PHClusterPositionCacheMaker)
+  void usePositionCache(bool opt) { m_use_position_cache = opt; }
+  //! number of threads propagating seeds (0 = all cores), the default of 1 propagates in the calling thread.
+  //! Results are merged in seed order and do not depend on the number of threads
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+  //! accumulated wall time [ms] of the seed propagation and number of propagated seeds, for benchmarking
+  double get_propagation_time() const;
+  unsigned long get_propagated_seeds() const { return m_nseeds; }
 
  private:
   bool _use_truth_clusters = false;
@@ -105,6 +116,10 @@ class PHSimpleKFProp : public SubsysReco
   TpcDistortionCorrectionContainer* m_dcc_average{nullptr};
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
 
+  /// cluster positions computed once per event
+  bool m_use_position_cache{false};
+  TrkrClusterPositionCache* m_position_cache{nullptr};
+
   /// get global position for a given cluster
   /**
    * uses ActsTransformation to convert cluster local position into global coordinates
@@ -114,6 +129,17 @@ class PHSimpleKFProp : public SubsysReco
 
   PositionMap PrepareKDTrees();
 
+  /// outcome of the propagation of one seed
+  struct PropagationResult
+  {
+    bool is_tpc = false;
+    bool has_chain = false;
+    std::vector<TrkrDefs::cluskey> chain;
+  };
+
+  /// refit a seed and propagate it through the TPC. Only the seed itself is modified, so seeds can be propagated concurrently
+  void PropagateSeed(TrackSeed* track, const PositionMap& globalPositions, PropagationResult& result) const;
+
   std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, Eigen::Matrix<double, 6, 6>& xyzCov, const PositionMap& globalPositions) const;
   std::vector<std::vector<TrkrDefs::cluskey>> RemoveBadClusters(const std::vector<std::vector<TrkrDefs::cluskey>>& seeds, const PositionMap& globalPositions) const;
   template <typename T>
@@ -162,6 +188,13 @@ class PHSimpleKFProp : public SubsysReco
   std::array<double, 3> _fixed_clus_err = {.1, .1, .1};
   TrkrClusterIterationMapv1* _iteration_map = nullptr;
   int _n_iteration = 0;
+
+  unsigned int m_num_threads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  std::vector<PropagationResult> m_results;
+
+  std::unique_ptr<PHTimer> t_propagate;
+  unsigned long m_nseeds = 0;
 };
 
 #endif
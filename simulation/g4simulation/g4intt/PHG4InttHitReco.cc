@@ -532,9 +532,6 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
       // The hitset key includes the layer, the ladder_z_index (sensors numbered 0-3) and  ladder_phi_index (azimuthal location of ladder) for this hit
       TrkrDefs::hitsetkey hitsetkey = InttDefs::genHitSetKey(sphxlayer, ladder_z_index, ladder_phi_index, crossing);
 
-      // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
-
       // generate the key for this hit
       TrkrDefs::hitkey hitkey = InttDefs::genHitKey(vzbin[i1], vybin[i1]);
       // See if this hit already exists and is not a raw hit
@@ -550,35 +547,32 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
 
       if (m_HotChannelSet.find(raw) != m_HotChannelSet.end())
       { //We still want the truth hit
+        // the hitset is created even if the hit is masked
+        hitsetcontainer->findOrAddHitSet(hitsetkey);
         continue;
       }
 
-      TrkrHit *hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // Otherwise, create a new one
-        hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-
-      // Either way, add the energy to it
+      // stage the energy, hits are created or updated on the node tree once all g4hits are processed
       if (Verbosity() > 2)
       {
         std::cout << "add energy " << venergy[i1].first << " to intthit " << std::endl;
       }
 
-      hit->addEnergy(hit_energy);
+      m_staging.getBuffer().addEnergy(hitsetkey, hitkey, hit_energy);
 
       // Add this hit to the association map
       hittruthassoc->addAssoc(hitsetkey, hitkey, hiter->first);
 
       if (Verbosity() > 2)
       {
-        std::cout << "PHG4InttHitReco: added hit wirh hitsetkey " << hitsetkey << " hitkey " << hitkey << " g4hitkey " << hiter->first << " energy " << hit->getEnergy() << std::endl;
+        std::cout << "PHG4InttHitReco: added hit wirh hitsetkey " << hitsetkey << " hitkey " << hitkey << " g4hitkey " << hiter->first << " energy " << hit_energy << std::endl;
       }
     }
   }  // end loop over g4hits
 
+  // create or update the hits on the node tree
+  m_staging.merge(hitsetcontainer);
+
   // print the list of entries in the association table
   if (Verbosity() > 0)
   {
@@ -7,6 +7,7 @@
 #include <gsl/gsl_vector.h>  // for gsl_vector
 #include <phparameter/PHParameterInterface.h>
 #include <trackbase/TrkrDefs.h>
+#include <trackbase/TrkrHitSetStaging.h>
 
 #include <map>
 #include <set>
@@ -73,6 +74,9 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
   typedef std::set<InttNameSpace::RawData_s, InttNameSpace::RawDataComparator> Set_t;
   Set_t m_HotChannelSet;
 
+  // hits are staged during the g4hit loop and merged to the node tree once per event
+  TrkrHitSetStaging m_staging;
+
   PHG4Hit* prior_g4hit{nullptr};  // used to check for jumps in g4hits for loopers;
   void truthcheck_g4hit(PHG4Hit*, PHCompositeNode* topNode);
   void addtruthhitset(TrkrDefs::hitsetkey, TrkrDefs::hitkey, float neffelectrons);
@@ -5,6 +5,7 @@
 
 #include "Fun4AllDstPileupInputManager.h"
 #include "Fun4AllDstPileupMerger.h"
+#include "Fun4AllDstPileupPool.h"
 
 #include <fun4all/Fun4AllInputManager.h>  // for Fun4AllInputManager
 #include <fun4all/Fun4AllReturnCodes.h>
@@ -22,11 +23,14 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 
+#include <TROOT.h>
+
 #include <gsl/gsl_randist.h>
 
 #include <cassert>
 #include <iostream>  // for operator<<, basic_ostream, endl
-#include <utility>   // for pair
+#include <memory>
+#include <utility>  // for pair
 
 //_____________________________________________________________________________
 Fun4AllDstPileupInputManager::Fun4AllDstPileupInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
@@ -38,6 +42,13 @@ Fun4AllDstPileupInputManager::Fun4AllDstPileupInputManager(const std::string &na
   gsl_rng_set(m_rng.get(), seed);
 }
 
+//_____________________________________________________________________________
+Fun4AllDstPileupInputManager::~Fun4AllDstPileupInputManager()
+{
+  // stop the pool thread before deleting the input manager and node it reads from
+  m_pool.reset();
+}
+
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 {
@@ -126,6 +137,11 @@ int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
     m_ievent_thisfile = 0;
     setBranches();                // set branch selections
     AddToFileOpened(FileName());  // add file to the list of files which were opened
+    if (m_pool)
+    {
+      // the pool thread reads from the new file
+      m_pool->resume();
+    }
     return 0;
   }
   else
@@ -139,7 +155,16 @@ int Fun4AllDstPileupInputManager::fileopen(const std::string &filenam)
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::run(const int nevents)
 {
-  if (nevents == 0)
+  if (m_pool_memory > 0)
+  {
+    // background events are sampled from the pool, there is no event to skip
+    const auto result = startPool();
+    if (result != 0)
+    {
+      return result;
+    }
+  }
+  else if (nevents == 0)
   {
     return runOne(nevents);
   }
@@ -184,6 +209,32 @@ int Fun4AllDstPileupInputManager::run(const int nevents)
     const int ncollisions = gsl_ran_poisson(m_rng.get(), mu);
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
+      if (m_pool)
+      {
+        // sample one event
+        bool last_use = false;
+        const auto event = samplePool(last_use);
+        if (!event)
+        {
+          return -1;
+        }
+
+        // merge. The objects of an event used for the last time are moved rather than copied
+        if (Verbosity() > 0)
+        {
+          std::cout << "Fun4AllDstPileupInputManager::run - merged pooled background event time: " << crossing_time << std::endl;
+        }
+        if (last_use)
+        {
+          merger.move_background_event(*event, crossing_time);
+        }
+        else
+        {
+          merger.copy_background_event(*event, crossing_time);
+        }
+        continue;
+      }
+
       // read one event
       const auto result = runOne(1);
       if (result != 0)
@@ -211,6 +262,11 @@ int Fun4AllDstPileupInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  if (m_pool)
+  {
+    // the pool thread may be reading from the input manager
+    m_pool->suspend();
+  }
   m_IManager.reset();
   IsOpen(0);
   UpdateFileList();
@@ -315,6 +371,14 @@ void Fun4AllDstPileupInputManager::Print(const std::string &what) const
     std::cout << "PHNodeIOManager print in Fun4AllDstPileupInputManager " << Name() << ":" << std::endl;
     m_IManager->print();
   }
+  if ((what == "ALL" || what == "POOL") && m_pool)
+  {
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Background pool in Fun4AllDstPileupInputManager " << Name() << ": "
+              << m_pool->size() << " events, " << m_pool->memory() / (1024 * 1024) << " MB out of " << m_pool_memory / (1024 * 1024) << " MB"
+              << ", " << m_pool_reuse << " uses per event" << std::endl;
+  }
   Fun4AllInputManager::Print(what);
   return;
 }
@@ -322,6 +386,11 @@ void Fun4AllDstPileupInputManager::Print(const std::string &what) const
 //_____________________________________________________________________________
 int Fun4AllDstPileupInputManager::PushBackEvents(const int i)
 {
+  if (m_pool)
+  {
+    std::cout << PHWHERE << Name() << ": could not push back events, background events are sampled from the pool" << std::endl;
+    return -1;
+  }
   if (m_IManager)
   {
     unsigned EventOnDst = m_IManager->getEventNumber();
@@ -410,3 +479,96 @@ void Fun4AllDstPileupInputManager::setDetectorActiveCrossings(const std::string
   m_DetectorTiming.insert(std::make_pair(nodename, std::make_pair(m_time_between_crossings * (min + 1), m_time_between_crossings * (max - 1))));
   return;
 }
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupInputManager::setBackgroundPoolMemory(double megabytes)
+{
+  if (m_pool)
+  {
+    std::cout << PHWHERE << " " << Name() << ": the background pool is already running, its memory cannot be changed" << std::endl;
+    return;
+  }
+  m_pool_memory = megabytes > 0 ? static_cast<size_t>(megabytes * 1024 * 1024) : 0;
+  if (m_pool_memory > 0)
+  {
+    // the pool thread reads background events while other files are read and written
+    ROOT::EnableThreadSafety();
+  }
+}
+
+//_____________________________________________________________________________
+int Fun4AllDstPileupInputManager::startPool()
+{
+  if (m_pool)
+  {
+    return 0;
+  }
+
+  if (!IsOpen())
+  {
+    if (FileListEmpty())
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << Name() << ": No Input file open" << std::endl;
+      }
+      return -1;
+    }
+    if (OpenNextFile())
+    {
+      std::cout << Name() << ": No Input file from filelist opened" << std::endl;
+      return -1;
+    }
+  }
+
+  // runs on the pool thread. Until it returns nullptr at the end of the file, or the pool is suspended in fileclose, only this thread uses m_IManager and m_dstNodeInternal
+  auto loader = [this]() -> std::unique_ptr<Fun4AllDstPileupMerger::Event>
+  {
+    if (!m_IManager->read(m_dstNodeInternal.get()))
+    {
+      return nullptr;
+    }
+    return std::make_unique<Fun4AllDstPileupMerger::Event>(m_dstNodeInternal.get());
+  };
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllDstPileupInputManager::startPool - memory: " << m_pool_memory / (1024 * 1024) << " MB, uses per event: " << m_pool_reuse << std::endl;
+  }
+  m_pool = std::make_unique<Fun4AllDstPileupPool>(loader, m_pool_memory, m_pool_reuse);
+  m_pool_preload = true;
+  m_pool_input_done = false;
+  return 0;
+}
+
+//_____________________________________________________________________________
+Fun4AllDstPileupMerger::Event *Fun4AllDstPileupInputManager::samplePool(bool &last_use)
+{
+  while (true)
+  {
+    // the pool is filled completely before the first sampling, afterwards one event is enough
+    m_pool->wait(m_pool_preload);
+    if (m_pool_input_done || !m_pool->end_of_input())
+    {
+      break;
+    }
+
+    // the loader reached the end of the file, or the file was closed. The next one is opened on this thread, since it updates the run node
+    // opening it resumes the loader
+    if (IsOpen())
+    {
+      fileclose();
+    }
+    if (OpenNextFile())
+    {
+      m_pool_input_done = true;
+    }
+  }
+  m_pool_preload = false;
+
+  if (m_pool->empty())
+  {
+    return nullptr;
+  }
+  return m_pool->sample(m_rng.get(), last_use);
+}
@@ -8,6 +8,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "Fun4AllDstPileupMerger.h"
+
 #include <fun4all/Fun4AllInputManager.h>
 #include <fun4all/Fun4AllReturnCodes.h>  // for SYNC_NOOBJECT, SYNC_OK
 
@@ -16,11 +18,13 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>  // for pair
 
+class Fun4AllDstPileupPool;
 class SyncObject;
 
 /*!
@@ -31,6 +35,7 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 {
  public:
   Fun4AllDstPileupInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
+  ~Fun4AllDstPileupInputManager() override;
   int fileopen(const std::string &filenam) override;
   int fileclose() override;
   int run(const int nevents = 0) override;
@@ -67,10 +72,30 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
 
   void setDetectorActiveCrossings(const std::string &name, const int min, const int max);
 
+  //! keep decoded background events in memory, up to the given budget (MB)
+  /*!
+   * events are read and decoded on a background thread, and sampled randomly from the pool.
+   * 0 (default) reads the background events one by one from the file when merging.
+   * Subsystems registered to this input manager are not run on pooled events
+   */
+  void setBackgroundPoolMemory(double megabytes);
+
+  //! number of times a pooled background event is merged before it is replaced by a new one
+  void setBackgroundPoolReuse(unsigned int n)
+  {
+    m_pool_reuse = n;
+  }
+
  private:
   //! loads one event on internal DST node
   int runOne(const int nevents = 0);
 
+  //! create the background pool, if not already done
+  int startPool();
+
+  //! sample an event from the background pool, nullptr at the end of the input
+  Fun4AllDstPileupMerger::Event *samplePool(bool &last_use);
+
   //!@name event counters
   //@{
   bool m_ReadRunTTree = true;
@@ -123,6 +148,24 @@ class Fun4AllDstPileupInputManager : public Fun4AllInputManager
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
   std::map<std::string, std::pair<double, double>> m_DetectorTiming;
+
+  //!@name background event pool
+  //@{
+  //! memory budget (bytes). 0 to disable
+  size_t m_pool_memory = 0;
+
+  //! number of uses per background event
+  unsigned int m_pool_reuse = 1;
+
+  //! true until the pool has been filled once
+  bool m_pool_preload = true;
+
+  //! true once all files have been loaded into the pool
+  bool m_pool_input_done = false;
+
+  //! the pool, its thread reads from m_IManager into m_dstNodeInternal
+  std::unique_ptr<Fun4AllDstPileupPool> m_pool;
+  //@}
 };
 
 #endif /* __Fun4AllDstPileupInputManager_H__ */
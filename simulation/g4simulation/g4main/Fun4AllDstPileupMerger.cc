@@ -30,12 +30,17 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <HepMC/GenEvent.h>
+#include <HepMC/GenParticle.h>
+#include <HepMC/GenVertex.h>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // convenient aliases for deep copying nodes
 namespace
@@ -81,6 +86,96 @@ namespace
     ContainerMap m_containers;
   };
 
+  //! converts the keys of a truth container map to 1...N for positive keys and -1...-M for negative keys, preserving their order
+  class IdConversion
+  {
+   public:
+    //! no keys
+    IdConversion() = default;
+
+    //! constructor from map
+    template <class Map>
+    explicit IdConversion(const Map &map)
+    {
+      const auto first_positive = map.upper_bound(0);
+      m_negative = std::distance(map.begin(), first_positive);
+      m_positive = std::distance(first_positive, map.end());
+
+      // keys are normally already contiguous, in which case the conversion is the identity
+      m_contiguous =
+          (m_negative == 0 || map.begin()->first == -m_negative) &&
+          (m_positive == 0 || map.rbegin()->first == m_positive);
+      if (!m_contiguous)
+      {
+        m_keys.reserve(map.size());
+        for (const auto &pair : map)
+        {
+          m_keys.push_back(pair.first);
+        }
+      }
+    }
+
+    //! converted key, 0 if the key is not found
+    int convert(int key) const
+    {
+      if (key == 0)
+      {
+        return 0;
+      }
+
+      if (m_contiguous)
+      {
+        return (key >= -m_negative && key <= m_positive) ? key : 0;
+      }
+
+      const auto iter = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+      if (iter == m_keys.end() || *iter != key)
+      {
+        return 0;
+      }
+      const int index = std::distance(m_keys.begin(), iter);
+      return key < 0 ? index - m_negative : index - m_negative + 1;
+    }
+
+   private:
+    //! number of negative and positive keys
+    int m_negative = 0;
+    int m_positive = 0;
+
+    //! true if keys are -M...-1 and 1...N
+    bool m_contiguous = true;
+
+    //! sorted keys, when not contiguous
+    std::vector<int> m_keys;
+  };
+
+  //! convert an id, keep the original one if not found and add flag to unconverted
+  int convert_id(const IdConversion &conversion, int id, const std::string &type, unsigned char &unconverted, unsigned char flag)
+  {
+    const int converted = conversion.convert(id);
+    if (converted == 0)
+    {
+      std::cout << "Fun4AllDstPileupMerger::Event - " << type << " id " << id << " not found in map" << std::endl;
+      unconverted |= flag;
+      return id;
+    }
+    return converted;
+  }
+
+  //! object of a decoded event for the destination container, copied if the event is const, released from it otherwise
+  template <class Copy, class Pointer>
+  typename Pointer::element_type *take(Pointer &pointer)
+  {
+    if constexpr (std::is_const_v<Pointer>)
+    {
+      return new Copy(pointer.get());
+    }
+    else
+    {
+      return pointer.release();
+    }
+  }
+
 }  // namespace
 
 //_____________________________________________________________________________
@@ -111,124 +206,91 @@ void Fun4AllDstPileupMerger::load_nodes(PHCompositeNode *dstNode)
 }
 
 //_____________________________________________________________________________
-void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, double delta_t) const
+Fun4AllDstPileupMerger::Event::Event(PHCompositeNode *dstNode)
 {
-  // copy PHHepMCGenEventMap
+  // hep mc
   const auto map = findNode::getClass<PHHepMCGenEventMap>(dstNode, "PHHepMCGenEventMap");
-
-  // keep track of new embed id, after insertion as background event
-  int new_embed_id = -1;
-
-  if (map && m_geneventmap)
+  if (map)
   {
     if (map->size() != 1)
     {
-      std::cout << "Fun4AllDstPileupMerger::copy_background_event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
+      std::cout << "Fun4AllDstPileupMerger::Event - cannot merge events that contain more than one PHHepMCGenEventMap" << std::endl;
+      m_valid = false;
       return;
     }
 
-    // get event and insert in new map
     auto genevent = map->get_map().begin()->second;
-    auto newevent = m_geneventmap->insert_background_event(genevent);
+    m_genevent.reset(static_cast<PHHepMCGenEvent *>(genevent->CloneMe()));
 
     /*
      * this hack prevents a crash when writting out
      * it boils down to root trying to write deleted items from the HepMC::GenEvent copy if the source has been deleted
      * it does not happen if the source gets written while the copy is deleted
+     * the decoded event keeps the source content, which is the one eventually written, and the node gets the copy
      */
-    newevent->getEvent()->swap(*genevent->getEvent());
-
-    // shift vertex time and store new embed id
-    newevent->moveVertex(0, 0, 0, delta_t);
-    new_embed_id = newevent->get_embedding_id();
+    if (genevent->getEvent() && m_genevent->getEvent())
+    {
+      m_genevent->getEvent()->swap(*genevent->getEvent());
+      m_memory += m_genevent->getEvent()->particles_size() * sizeof(HepMC::GenParticle);
+      m_memory += m_genevent->getEvent()->vertices_size() * sizeof(HepMC::GenVertex);
+    }
   }
 
-  // copy truth container
-  // keep track of the correspondance between source index and destination index for vertices, tracks and showers
-  using ConversionMap = std::map<int, int>;
-  ConversionMap vtxid_map;
-  ConversionMap trkid_map;
-
+  // truth container
   const auto container_truth = findNode::getClass<PHG4TruthInfoContainer>(dstNode, "G4TruthInfo");
-  if (container_truth && m_g4truthinfo)
+  m_has_truth = container_truth != nullptr;
+
+  // renumbered track and vertex ids
+  const auto vtxids = m_has_truth ? IdConversion(container_truth->GetVtxMap()) : IdConversion();
+  const auto trkids = m_has_truth ? IdConversion(container_truth->GetMap()) : IdConversion();
+
+  if (m_has_truth)
   {
     {
       // primary vertices
-      auto key = m_g4truthinfo->maxvtxindex();
       const auto range = container_truth->GetPrimaryVtxRange();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
-        // clone vertex, insert in map, and add index conversion
-        const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(++key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        m_primary_vertices.emplace_back(new PHG4VtxPoint_t(iter->second));
       }
     }
 
     {
       // secondary vertices
-      auto key = m_g4truthinfo->minvtxindex();
-      const auto range = container_truth->GetSecondaryVtxRange();
-
       // loop from last to first to preserve order with respect to the original event
+      const auto range = container_truth->GetSecondaryVtxRange();
       for (
           auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.second);
           iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstVtxIterator>(range.first);
           ++iter)
       {
-        // clone vertex, shift time, insert in map, and add index conversion
-        const auto &sourceVertex = iter->second;
-        auto newVertex = new PHG4VtxPoint_t(sourceVertex);
-        newVertex->set_t(sourceVertex->get_t() + delta_t);
-        m_g4truthinfo->AddVertex(--key, newVertex);
-        vtxid_map.insert(std::make_pair(sourceVertex->get_id(), key));
+        m_secondary_vertices.emplace_back(new PHG4VtxPoint_t(iter->second));
       }
     }
 
     {
       // primary particles
-      auto key = m_g4truthinfo->maxtrkindex();
       const auto range = container_truth->GetPrimaryParticleRange();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
         const auto &source = iter->second;
         auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(++key, dest);
-        dest->set_track_id(key);
-
-        // set parent to zero
-        dest->set_parent_id(0);
-
-        // set primary to itself
-        dest->set_primary_id(dest->get_track_id());
+        m_primary_particles.emplace_back(dest);
 
         // update vertex
-        const auto keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
+        unsigned char unconverted = 0;
+        dest->set_vtx_id(convert_id(vtxids, source->get_vtx_id(), "vertex", unconverted, UnconvertedVertex));
+        if (unconverted)
         {
-          dest->set_vtx_id(keyiter->second);
+          m_unconverted[m_primary_particles.back().get()] = unconverted;
         }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
-
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
       }
     }
 
     {
       // secondary particles
-      auto key = m_g4truthinfo->mintrkindex();
+      // loop from last to first to preserve order with respect to the original event
       const auto range = container_truth->GetSecondaryParticleRange();
-
-      /*
-       * loop from last to first to preserve order with respect to the original event
-       * also this ensures that for a given particle its parent has already been converted and thus found in the map
-       */
       for (
           auto iter = std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.second);
           iter != std::reverse_iterator<PHG4TruthInfoContainer::ConstIterator>(range.first);
@@ -236,65 +298,191 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       {
         const auto &source = iter->second;
         auto dest = new PHG4Particle_t(source);
-        m_g4truthinfo->AddParticle(--key, dest);
-        dest->set_track_id(key);
-
-        // update parent id
-        auto keyiter = trkid_map.find(source->get_parent_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_parent_id(keyiter->second);
-        }
-        else
+        m_secondary_particles.emplace_back(dest);
+
+        // update parent, primary and vertex ids
+        unsigned char unconverted = 0;
+        dest->set_parent_id(convert_id(trkids, source->get_parent_id(), "track", unconverted, UnconvertedParent));
+        dest->set_primary_id(convert_id(trkids, source->get_primary_id(), "track", unconverted, UnconvertedPrimary));
+        dest->set_vtx_id(convert_id(vtxids, source->get_vtx_id(), "vertex", unconverted, UnconvertedVertex));
+        if (unconverted)
         {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_parent_id() << " not found in map" << std::endl;
+          m_unconverted[m_secondary_particles.back().get()] = unconverted;
         }
+      }
+    }
 
-        // update primary id
-        keyiter = trkid_map.find(source->get_primary_id());
-        if (keyiter != trkid_map.end())
-        {
-          dest->set_primary_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << source->get_primary_id() << " not found in map" << std::endl;
-        }
+    m_memory += (m_primary_vertices.size() + m_secondary_vertices.size()) * sizeof(PHG4VtxPoint_t);
+    m_memory += (m_primary_particles.size() + m_secondary_particles.size()) * sizeof(PHG4Particle_t);
+  }
 
-        // update vertex
-        keyiter = vtxid_map.find(source->get_vtx_id());
-        if (keyiter != vtxid_map.end())
-        {
-          dest->set_vtx_id(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - vertex id " << source->get_vtx_id() << " not found in map" << std::endl;
-        }
+  // g4hits
+  FindG4HitContainer nodeFinder;
+  PHNodeIterator(dstNode).forEach(nodeFinder);
+  for (const auto &pair : nodeFinder.containers())
+  {
+    auto &container = m_hitcontainers[pair.first];
 
-        // insert in map
-        trkid_map.insert(std::make_pair(source->get_track_id(), dest->get_track_id()));
+    // hits
+    const auto range = pair.second->getHits();
+    container.m_hits.reserve(pair.second->size());
+    for (auto iter = range.first; iter != range.second; ++iter)
+    {
+      const auto &sourceHit = iter->second;
+      auto newHit = new PHG4Hit_t(sourceHit);
+      container.m_hits.emplace_back(newHit);
+
+      // update track id
+      unsigned char unconverted = 0;
+      newHit->set_trkid(convert_id(trkids, sourceHit->get_trkid(), "track", unconverted, UnconvertedTrack));
+      if (unconverted)
+      {
+        m_unconverted[container.m_hits.back().get()] = unconverted;
       }
+
+      /*
+       * reset shower ids
+       * it was decided that showers from the background events will not be copied to the merged event
+       * as such we just reset the hits shower id
+       */
+      newHit->set_shower_id(std::numeric_limits<int>::min());
     }
+    m_memory += container.m_hits.size() * sizeof(PHG4Hit_t);
+
+    // layers
+    const auto layers = pair.second->getLayers();
+    container.m_layers.assign(layers.first, layers.second);
+  }
+}
+
+//_____________________________________________________________________________
+Fun4AllDstPileupMerger::Event::~Event() = default;
 
-    // vertex embed flags
-    /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
-    for (const auto &pair : vtxid_map)
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, double delta_t) const
+{
+  // decode, then move the decoded objects so that they are copied only once
+  Event event(dstNode);
+  move_background_event(event, delta_t);
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::copy_background_event(const Event &event, double delta_t) const
+{
+  merge_background_event(event, delta_t);
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupMerger::move_background_event(Event &event, double delta_t) const
+{
+  merge_background_event(event, delta_t);
+}
+
+//_____________________________________________________________________________
+template <class EventT>
+void Fun4AllDstPileupMerger::merge_background_event(EventT &event, double delta_t) const
+{
+  if (!event.m_valid)
+  {
+    return;
+  }
+
+  // keep track of new embed id, after insertion as background event
+  int new_embed_id = -1;
+
+  if (event.m_genevent && m_geneventmap)
+  {
+    PHHepMCGenEvent *newevent = nullptr;
+    if constexpr (std::is_const_v<EventT>)
     {
-      if (pair.first > 0)
-      {
-        m_g4truthinfo->AddEmbededVtxId(pair.second, new_embed_id);
-      }
+      // the copy is written while the source is still in the event, see Event::Event
+      newevent = m_geneventmap->insert_background_event(event.m_genevent.get());
+    }
+    else
+    {
+      // hand the HepMC content over to the inserted event rather than copying it
+      HepMC::GenEvent *content = nullptr;
+      event.m_genevent->swapEvent(content);
+      newevent = m_geneventmap->insert_background_event(event.m_genevent.get());
+      newevent->swapEvent(content);
     }
 
-    // track embed flags
-    /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
-    for (const auto &pair : trkid_map)
+    // shift vertex time and store new embed id
+    newevent->moveVertex(0, 0, 0, delta_t);
+    new_embed_id = newevent->get_embedding_id();
+  }
+
+  /*
+   * background ids are contiguous, 1...N and -1...-M, see Event
+   * they are shifted past the largest and smallest ids of the destination container
+   * ids which were not found when decoding are left unchanged
+   */
+  const bool merge_truth = event.m_has_truth && m_g4truthinfo;
+  const int vtx_offset = merge_truth ? m_g4truthinfo->maxvtxindex() : 0;
+  const int secondary_vtx_offset = merge_truth ? m_g4truthinfo->minvtxindex() : 0;
+  const int trk_offset = merge_truth ? m_g4truthinfo->maxtrkindex() : 0;
+  const int secondary_trk_offset = merge_truth ? m_g4truthinfo->mintrkindex() : 0;
+  const auto vtxid = [&](int id, bool unconverted)
+  { return unconverted ? id : (id > 0 ? id + vtx_offset : (id < 0 ? id + secondary_vtx_offset : id)); };
+  const auto trkid = [&](int id, bool unconverted)
+  { return unconverted ? id : (id > 0 ? id + trk_offset : (id < 0 ? id + secondary_trk_offset : id)); };
+
+  if (merge_truth)
+  {
+    // primary vertices
+    int key = vtx_offset;
+    for (auto &vertex : event.m_primary_vertices)
     {
-      if (pair.first > 0)
-      {
-        m_g4truthinfo->AddEmbededTrkId(pair.second, new_embed_id);
-      }
+      auto newVertex = take<PHG4VtxPoint_t>(vertex);
+      newVertex->set_t(newVertex->get_t() + delta_t);
+      m_g4truthinfo->AddVertex(++key, newVertex);
+
+      /* embed flag is stored only for primary vertices, consistently with PHG4TruthEventAction */
+      m_g4truthinfo->AddEmbededVtxId(key, new_embed_id);
+    }
+
+    // secondary vertices
+    key = secondary_vtx_offset;
+    for (auto &vertex : event.m_secondary_vertices)
+    {
+      auto newVertex = take<PHG4VtxPoint_t>(vertex);
+      newVertex->set_t(newVertex->get_t() + delta_t);
+      m_g4truthinfo->AddVertex(--key, newVertex);
+    }
+
+    // primary particles
+    key = trk_offset;
+    for (auto &particle : event.m_primary_particles)
+    {
+      const auto unconverted = event.unconverted(particle.get());
+      auto dest = take<PHG4Particle_t>(particle);
+      m_g4truthinfo->AddParticle(++key, dest);
+      dest->set_track_id(key);
+
+      // set parent to zero
+      dest->set_parent_id(0);
+
+      // set primary to itself
+      dest->set_primary_id(key);
+
+      // update vertex
+      dest->set_vtx_id(vtxid(dest->get_vtx_id(), unconverted & Event::UnconvertedVertex));
+
+      /* embed flag is stored only for primary tracks, consistently with PHG4TruthEventAction */
+      m_g4truthinfo->AddEmbededTrkId(key, new_embed_id);
+    }
+
+    // secondary particles
+    key = secondary_trk_offset;
+    for (auto &particle : event.m_secondary_particles)
+    {
+      const auto unconverted = event.unconverted(particle.get());
+      auto dest = take<PHG4Particle_t>(particle);
+      m_g4truthinfo->AddParticle(--key, dest);
+      dest->set_track_id(key);
+      dest->set_parent_id(trkid(dest->get_parent_id(), unconverted & Event::UnconvertedParent));
+      dest->set_primary_id(trkid(dest->get_primary_id(), unconverted & Event::UnconvertedPrimary));
+      dest->set_vtx_id(vtxid(dest->get_vtx_id(), unconverted & Event::UnconvertedVertex));
     }
   }
 
@@ -309,9 +497,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
       continue;
     }
 
-    // find source node
-    auto container_hit = findNode::getClass<PHG4HitContainer>(dstNode, pair.first);
-    if (!container_hit)
+    // find source container
+    auto source = event.m_hitcontainers.find(pair.first);
+    if (source == event.m_hitcontainers.end())
     {
       std::cout << "Fun4AllDstPileupMerger::copy_background_event - invalid source container " << pair.first << std::endl;
       continue;
@@ -325,52 +513,31 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
         continue;
       }
     }
+
+    // hits
+    for (auto &hit : source->second.m_hits)
     {
-      // hits
-      const auto range = container_hit->getHits();
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        // clone hit
-        const auto &sourceHit = iter->second;
-        auto newHit = new PHG4Hit_t(sourceHit);
+      const auto unconverted = event.unconverted(hit.get());
+      auto newHit = take<PHG4Hit_t>(hit);
 
-        // shift time
-        newHit->set_t(0, sourceHit->get_t(0) + delta_t);
-        newHit->set_t(1, sourceHit->get_t(1) + delta_t);
+      // shift time
+      newHit->set_t(0, newHit->get_t(0) + delta_t);
+      newHit->set_t(1, newHit->get_t(1) + delta_t);
 
-        // update track id
-        const auto keyiter = trkid_map.find(sourceHit->get_trkid());
-        if (keyiter != trkid_map.end())
-        {
-          newHit->set_trkid(keyiter->second);
-        }
-        else
-        {
-          std::cout << "Fun4AllDstPileupMerger::copy_background_event - track id " << sourceHit->get_trkid() << " not found in map" << std::endl;
-        }
+      // update track id
+      newHit->set_trkid(trkid(newHit->get_trkid(), unconverted & Event::UnconvertedTrack));
 
-        /*
-         * reset shower ids
-         * it was decided that showers from the background events will not be copied to the merged event
-         * as such we just reset the hits shower id
-         */
-        newHit->set_shower_id(std::numeric_limits<int>::min());
-
-        /*
-         * this will generate a new key for the hit and assign it to the hit
-         * this ensures that there is no conflict with the hits from the 'main' event
-         */
-        pair.second->AddHit(newHit->get_detid(), newHit);
-      }
+      /*
+       * this will generate a new key for the hit and assign it to the hit
+       * this ensures that there is no conflict with the hits from the 'main' event
+       */
+      pair.second->AddHit(newHit->get_detid(), newHit);
     }
 
+    // layers
+    for (const auto &layer : source->second.m_layers)
     {
-      // layers
-      const auto range = container_hit->getLayers();
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        pair.second->AddLayer(*iter);
-      }
+      pair.second->AddLayer(layer);
     }
   }
 }
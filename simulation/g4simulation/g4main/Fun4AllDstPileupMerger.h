@@ -8,13 +8,20 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
+class PHG4Hit;
 class PHG4HitContainer;
+class PHG4Particle;
 class PHG4TruthInfoContainer;
+class PHG4VtxPoint;
+class PHHepMCGenEvent;
 class PHHepMCGenEventMap;
 
 /*!
@@ -25,6 +32,86 @@ class PHHepMCGenEventMap;
 class Fun4AllDstPileupMerger final
 {
  public:
+  /*!
+   * background event decoded from the nodes of a DST event, independent of the nodes
+   * track and vertex ids are renumbered to 1...N for primaries and -1...-M for secondaries,
+   * preserving their order, so that merging them only requires adding an offset to the ids
+   */
+  class Event
+  {
+   public:
+    //! decode the background event stored under composite
+    explicit Event(PHCompositeNode *);
+
+    //! destructor
+    ~Event();
+
+    // objects are owned by the event
+    Event(const Event &) = delete;
+    Event &operator=(const Event &) = delete;
+
+    //! approximate memory used by the event (bytes)
+    size_t memory() const { return m_memory; }
+
+   private:
+    friend class Fun4AllDstPileupMerger;
+
+    //! hit containers content
+    class HitContainer
+    {
+     public:
+      std::vector<std::unique_ptr<PHG4Hit>> m_hits;
+      std::vector<unsigned int> m_layers;
+    };
+
+    //! false if the event cannot be merged
+    bool m_valid = true;
+
+    //! hepmc event, nullptr if none
+    std::unique_ptr<PHHepMCGenEvent> m_genevent;
+
+    //! true if the source event has truth information
+    bool m_has_truth = false;
+
+    //!@name vertices and particles, ordered by renumbered id: 1, 2, ... and -1, -2, ...
+    //@{
+    std::vector<std::unique_ptr<PHG4VtxPoint>> m_primary_vertices;
+    std::vector<std::unique_ptr<PHG4VtxPoint>> m_secondary_vertices;
+    std::vector<std::unique_ptr<PHG4Particle>> m_primary_particles;
+    std::vector<std::unique_ptr<PHG4Particle>> m_secondary_particles;
+    //@}
+
+    //! hit containers, mapped to node names
+    std::map<std::string, HitContainer> m_hitcontainers;
+
+    //! ids which were not found when decoding
+    enum UnconvertedId : unsigned char
+    {
+      UnconvertedParent = 1 << 0,
+      UnconvertedPrimary = 1 << 1,
+      UnconvertedVertex = 1 << 2,
+      UnconvertedTrack = 1 << 3
+    };
+
+    //! unconverted ids of the decoded particles and hits, usually empty
+    /*! these ids keep their original value and are not shifted when merging */
+    std::map<const void *, unsigned char> m_unconverted;
+
+    //! unconverted ids of a decoded object
+    unsigned char unconverted(const void *object) const
+    {
+      if (m_unconverted.empty())
+      {
+        return 0;
+      }
+      const auto iter = m_unconverted.find(object);
+      return iter == m_unconverted.end() ? 0 : iter->second;
+    }
+
+    //! approximate memory (bytes)
+    size_t m_memory = 0;
+  };
+
   //! constructor
   Fun4AllDstPileupMerger() = default;
 
@@ -37,9 +124,19 @@ class Fun4AllDstPileupMerger final
   //! time-shift and copy content of source nodes to destination
   void copy_background_event(PHCompositeNode *, double delta_t) const;
 
+  //! time-shift and copy content of a decoded background event to destination. The event is unchanged
+  void copy_background_event(const Event &, double delta_t) const;
+
+  //! time-shift and move content of a decoded background event to destination, without copying its objects. The event is left empty
+  void move_background_event(Event &, double delta_t) const;
+
   void copyDetectorActiveCrossings(const std::map<std::string, std::pair<double, double>> &dmap) { m_DetectorTiming = dmap; }
 
  private:
+  //! copy content of a const decoded background event, move content of a non const one
+  template <class EventT>
+  void merge_background_event(EventT &, double delta_t) const;
+
   //! hepmc
   PHHepMCGenEventMap *m_geneventmap = nullptr;
 
@@ -0,0 +1,148 @@
+/*!
+ * \file Fun4AllDstPileupPool.cc
+ */
+
+#include "Fun4AllDstPileupPool.h"
+
+#include <algorithm>  // for max
+#include <utility>    // for move
+
+//_____________________________________________________________________________
+Fun4AllDstPileupPool::Fun4AllDstPileupPool(Loader loader, size_t max_memory, unsigned int max_reuse)
+  : m_loader(std::move(loader))
+  , m_max_memory(max_memory)
+  , m_max_reuse(std::max(1U, max_reuse))
+{
+  m_thread = std::thread([this]()
+                         { load(); });
+}
+
+//_____________________________________________________________________________
+Fun4AllDstPileupPool::~Fun4AllDstPileupPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupPool::wait(bool full)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_condition.wait(lock, [this, full]()
+                   { return m_end_of_input || (!m_entries.empty() && (!full || m_memory >= m_max_memory)); });
+}
+
+//_____________________________________________________________________________
+bool Fun4AllDstPileupPool::end_of_input() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_end_of_input;
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupPool::suspend()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_end_of_input = true;
+  m_condition.wait(lock, [this]()
+                   { return !m_loading; });
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupPool::resume()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_end_of_input = false;
+  }
+  m_condition.notify_all();
+}
+
+//_____________________________________________________________________________
+bool Fun4AllDstPileupPool::empty() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.empty();
+}
+
+//_____________________________________________________________________________
+size_t Fun4AllDstPileupPool::memory() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memory;
+}
+
+//_____________________________________________________________________________
+size_t Fun4AllDstPileupPool::size() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+//_____________________________________________________________________________
+Fun4AllDstPileupPool::Event *Fun4AllDstPileupPool::sample(gsl_rng *rng, bool &last_use)
+{
+  // the previous retired event is not used anymore
+  m_retired.reset();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto &entry = m_entries[gsl_rng_uniform_int(rng, m_entries.size())];
+  last_use = (++entry.m_uses >= m_max_reuse);
+  if (!last_use)
+  {
+    // only this thread removes events, the pointer stays valid after unlocking
+    return entry.m_event.get();
+  }
+
+  // remove from the pool and let the loader replace it
+  m_retired = std::move(entry.m_event);
+  m_memory -= m_retired->memory();
+  entry = std::move(m_entries.back());
+  m_entries.pop_back();
+  lock.unlock();
+  m_condition.notify_all();
+  return m_retired.get();
+}
+
+//_____________________________________________________________________________
+void Fun4AllDstPileupPool::load()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]()
+                       { return m_stop || (!m_end_of_input && m_memory < m_max_memory); });
+      if (m_stop)
+      {
+        return;
+      }
+      m_loading = true;
+    }
+
+    // load outside of the lock, the owner does not touch the input until the end of input is reached or the loader is suspended
+    auto event = m_loader();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_loading = false;
+      if (event)
+      {
+        m_memory += event->memory();
+        m_entries.push_back({std::move(event), 0});
+      }
+      else
+      {
+        m_end_of_input = true;
+      }
+    }
+    m_condition.notify_all();
+  }
+}
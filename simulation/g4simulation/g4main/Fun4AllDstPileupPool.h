@@ -0,0 +1,123 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_FUN4ALLDSTPILEUPPOOL_H
+#define G4MAIN_FUN4ALLDSTPILEUPPOOL_H
+
+/*!
+ * \file Fun4AllDstPileupPool.h
+ */
+
+#include "Fun4AllDstPileupMerger.h"
+
+#include <gsl/gsl_rng.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ * in-memory pool of decoded background events, used by Fun4AllDstPileupInputManager
+ * events are loaded and decoded on a background thread until the pool reaches its memory budget
+ * each event is sampled up to a maximum number of times, then it is removed from the pool
+ * and the thread loads a new one in its place
+ *
+ * the loader stops when it reaches the end of its input, e.g. the end of a file, or when suspended.
+ * the owner then provides new input, on its own thread, and calls resume()
+ */
+class Fun4AllDstPileupPool
+{
+ public:
+  using Event = Fun4AllDstPileupMerger::Event;
+
+  //! loads and decodes the next event, returns nullptr at the end of the input
+  /*! it is called on the pool thread */
+  using Loader = std::function<std::unique_ptr<Event>()>;
+
+  //! constructor, starts the loading thread
+  /*!
+   * \param loader loads the next event
+   * \param max_memory memory budget (bytes)
+   * \param max_reuse number of times an event is sampled before being removed from the pool
+   */
+  Fun4AllDstPileupPool(Loader loader, size_t max_memory, unsigned int max_reuse);
+
+  //! destructor, stops the loading thread
+  ~Fun4AllDstPileupPool();
+
+  // the thread holds a pointer to the pool
+  Fun4AllDstPileupPool(const Fun4AllDstPileupPool &) = delete;
+  Fun4AllDstPileupPool &operator=(const Fun4AllDstPileupPool &) = delete;
+
+  //! wait until the pool is full, or has at least one event if full is false, or the loader reached the end of its input
+  void wait(bool full);
+
+  //! true if the loader reached the end of its input
+  bool end_of_input() const;
+
+  //! wait for the loader to finish the event it is loading, then stop it as at the end of its input
+  /*! it must be called before the owner changes the input, resume() lets the loader continue */
+  void suspend();
+
+  //! let the loader continue, once new input is available
+  void resume();
+
+  //! true if the pool has no event
+  bool empty() const;
+
+  //! pick a random event from the pool
+  /*!
+   * the event is valid until the next call to sample()
+   * last_use is set to true when the event reached its maximum number of uses. It is then removed from the pool
+   * and its content can be moved to the merged event
+   * the pool must not be empty
+   */
+  Event *sample(gsl_rng *, bool &last_use);
+
+  //! approximate memory used by the pooled events (bytes)
+  size_t memory() const;
+
+  //! number of pooled events
+  size_t size() const;
+
+ private:
+  //! pooled event
+  class Entry
+  {
+   public:
+    std::unique_ptr<Event> m_event;
+    unsigned int m_uses = 0;
+  };
+
+  //! loading thread
+  void load();
+
+  Loader m_loader;
+
+  //! memory budget (bytes)
+  size_t m_max_memory = 0;
+
+  //! maximum number of uses per event
+  unsigned int m_max_reuse = 1;
+
+  //!@name shared with the loading thread, guarded by m_mutex
+  //@{
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::vector<Entry> m_entries;
+  size_t m_memory = 0;
+  bool m_end_of_input = false;
+  bool m_loading = false;
+  bool m_stop = false;
+  //@}
+
+  //! last sampled event, when removed from the pool
+  std::unique_ptr<Event> m_retired;
+
+  std::thread m_thread;
+};
+
+#endif
@@ -8,6 +8,7 @@
 #include <TSystem.h>
 
 #include <cstdlib>
+#include <iterator>  // for prev
 
 using namespace std;
 
@@ -27,11 +28,11 @@ PHG4HitContainer::PHG4HitContainer(const std::string &nodename)
 
 void PHG4HitContainer::Reset()
 {
-  while (hitmap.begin() != hitmap.end())
+  for (auto &iter : hitmap)
   {
-    delete hitmap.begin()->second;
-    hitmap.erase(hitmap.begin());
+    delete iter.second;
   }
+  hitmap.clear();
   return;
 }
 
@@ -78,6 +79,13 @@ PHG4HitContainer::getmaxkey(const unsigned int detid)
 
 PHG4HitDefs::keytype
 PHG4HitContainer::genkey(const unsigned int detid)
+{
+  Iterator next;
+  return genkey(detid, next);
+}
+
+PHG4HitDefs::keytype
+PHG4HitContainer::genkey(const unsigned int detid, Iterator &next)
 {
   PHG4HitDefs::keytype detidlong = detid;
   if ((detidlong >> PHG4HitDefs::keybits) > 0)
@@ -86,14 +94,29 @@ PHG4HitContainer::genkey(const unsigned int detid)
     gSystem->Exit(1);
   }
   PHG4HitDefs::keytype shiftval = detidlong << PHG4HitDefs::hit_idbits;
-  //  cout << "max index: " << (detminmax->second)->first << endl;
+  PHG4HitDefs::keytype keyup = ((detidlong + 1) << PHG4HitDefs::hit_idbits) - 1;
+
+  // first hit after this layer. Hits are mostly added to the last layer
+  // in the map, in which case no search is needed
+  next = (hitmap.empty() || hitmap.rbegin()->first <= keyup) ? hitmap.end() : hitmap.upper_bound(keyup);
+
   // after removing hits with no energy deposition, we have holes
   // in our hit ranges. This construct will get us the last hit in
   // a layer and return it's hit id. Adding 1 will put us at the end of this layer
-  PHG4HitDefs::keytype hitid = getmaxkey(detid);
+  PHG4HitDefs::keytype hitid = 0;
+  if (next != hitmap.begin())
+  {
+    ConstIterator lastlayerentry = std::prev(next);
+    if (lastlayerentry->first >= shiftval)
+    {
+      hitid = lastlayerentry->first - shiftval;  // subtract layer mask
+    }
+  }
   hitid++;
   PHG4HitDefs::keytype newkey = hitid | shiftval;
-  if (hitmap.find(newkey) != hitmap.end())
+  // the new key is the largest of its layer, it can only exist already
+  // if the hit ids overflow into the next layer
+  if (next != hitmap.end() && next->first == newkey)
   {
     cout << PHWHERE << " duplicate key: 0x"
          << hex << newkey << dec
@@ -109,24 +132,28 @@ PHG4HitContainer::ConstIterator
 PHG4HitContainer::AddHit(PHG4Hit *newhit)
 {
   PHG4HitDefs::keytype key = newhit->get_hit_id();
-  if (hitmap.find(key) != hitmap.end())
+  Iterator it = hitmap.lower_bound(key);
+  if (it != hitmap.end() && it->first == key)
   {
     cout << "hit with id  0x" << hex << key << dec << " exists already" << endl;
-    return hitmap.find(key);
+    return it;
   }
   PHG4HitDefs::keytype detidlong = key >> PHG4HitDefs::hit_idbits;
   unsigned int detid = detidlong;
   layers.insert(detid);
-  return hitmap.insert(std::make_pair(key, newhit)).first;
+  return hitmap.emplace_hint(it, key, newhit);
 }
 
 PHG4HitContainer::ConstIterator
 PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
 {
-  PHG4HitDefs::keytype key = genkey(detid);
+  // the new key goes right before the first hit of the next layer,
+  // use it as hint so that the map is not searched a second time
+  Iterator next;
+  PHG4HitDefs::keytype key = genkey(detid, next);
   layers.insert(detid);
   newhit->set_hit_id(key);
-  return hitmap.insert(std::make_pair(key, newhit)).first;
+  return hitmap.emplace_hint(next, key, newhit);
 }
 
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid) const
@@ -152,11 +179,10 @@ PHG4HitContainer::ConstRange PHG4HitContainer::getHits() const
 
 PHG4HitContainer::Iterator PHG4HitContainer::findOrAddHit(PHG4HitDefs::keytype key)
 {
-  PHG4HitContainer::Iterator it = hitmap.find(key);
-  if (it == hitmap.end())
+  PHG4HitContainer::Iterator it = hitmap.lower_bound(key);
+  if (it == hitmap.end() || it->first != key)
   {
-    hitmap[key] = new PHG4Hitv1();
-    it = hitmap.find(key);
+    it = hitmap.emplace_hint(it, key, new PHG4Hitv1());
     PHG4Hit *mhit = it->second;
     mhit->set_hit_id(key);
     mhit->set_edep(0.);
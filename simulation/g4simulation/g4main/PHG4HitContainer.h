@@ -75,6 +75,9 @@ class PHG4HitContainer : public PHObject
   Map hitmap;
   std::set<unsigned int> layers;  // layers is not reset since layers must not change event by event
 
+  //! generate the next key of a layer, next is set to the first hit after the layer
+  PHG4HitDefs::keytype genkey(const unsigned int detid, Iterator &next);
+
   ClassDefOverride(PHG4HitContainer, 1)
 };
 
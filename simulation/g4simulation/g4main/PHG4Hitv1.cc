@@ -6,9 +6,214 @@
 #include <cmath>
 #include <cstdlib>
 #include <limits>
+#include <mutex>
+#include <new>
 #include <string>
 #include <utility>
 
+namespace
+{
+  struct Block
+  {
+    Block* next;
+  };
+
+  // Free list of PHG4Hitv1 sized blocks, carved out of large slabs.
+  // Stepping actions create one hit per step in an active volume and all of
+  // them are deleted at the end of the event, so after the first events new
+  // hits reuse the blocks of the previous event instead of going to the heap,
+  // and hits of one event are packed into a few slabs. Slabs are never
+  // released, the pool keeps the peak number of live hits. The pool is shared
+  // by all threads, threads take and return blocks in batches (see HitCache).
+  // Blocks are freed hit by hit rather than per event, since hits can outlive
+  // the event they were made in (e.g. background events kept and reused by
+  // the pileup pool)
+  class HitPool
+  {
+   public:
+    //! prepend n blocks to list
+    void take(Block*& list, const std::size_t n)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        Block* block = m_free;
+        if (block)
+        {
+          m_free = block->next;
+        }
+        else
+        {
+          if (m_next == m_end)
+          {
+            m_next = static_cast<char*>(::operator new(block_size * blocks_per_slab));
+            m_end = m_next + block_size * blocks_per_slab;
+          }
+          block = reinterpret_cast<Block*>(m_next);
+          m_next += block_size;
+        }
+        block->next = list;
+        list = block;
+      }
+    }
+
+    //! return the blocks from first to last (linked through next)
+    void give(Block* first, Block* last)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      last->next = m_free;
+      m_free = first;
+    }
+
+    // keep every block aligned like memory from operator new
+    static constexpr std::size_t alignment = alignof(std::max_align_t);
+    static constexpr std::size_t block_size = (sizeof(PHG4Hitv1) + alignment - 1) / alignment * alignment;
+    static constexpr std::size_t blocks_per_slab = 4096;
+
+   private:
+    std::mutex m_mutex;
+    Block* m_free = nullptr;
+    char* m_next = nullptr;
+    char* m_end = nullptr;
+  };
+
+  // never destroyed, hits can be deleted during static destruction
+  HitPool& hit_pool()
+  {
+    static HitPool* pool = new HitPool;
+    return *pool;
+  }
+
+  // Per thread cache of free blocks in front of the shared pool, the mutex is
+  // only taken once per batch. A block freed by another thread than the one
+  // which allocated it (e.g. hits read by the pileup pool loader and deleted by
+  // the main thread) goes into the cache of the deleting thread, which returns
+  // a batch to the shared pool once it holds more than two batches, so the
+  // memory stays bounded by the peak number of live hits plus two batches per
+  // thread. At thread exit the cache is returned to the shared pool and later
+  // calls of this thread (thread_local destructors) go to the shared pool directly
+  class HitCache
+  {
+   public:
+    void* allocate()
+    {
+      if (!m_free)
+      {
+        if (m_closed)
+        {
+          Block* block = nullptr;
+          hit_pool().take(block, 1);
+          return block;
+        }
+        register_close();
+        hit_pool().take(m_free, batch_size);
+        m_size = batch_size;
+      }
+      Block* block = m_free;
+      m_free = block->next;
+      --m_size;
+      return block;
+    }
+
+    void deallocate(void* ptr)
+    {
+      Block* block = static_cast<Block*>(ptr);
+      if (m_closed)
+      {
+        hit_pool().give(block, block);
+        return;
+      }
+      // a thread which only deletes hits returns its cache at exit as well
+      register_close();
+      block->next = m_free;
+      m_free = block;
+      if (++m_size > 2 * batch_size)
+      {
+        release(batch_size);
+      }
+    }
+
+    void close()
+    {
+      release(m_size);
+      m_closed = true;
+    }
+
+   private:
+    //! return the first n blocks to the shared pool
+    void release(const std::size_t n)
+    {
+      if (!n)
+      {
+        return;
+      }
+      Block* first = m_free;
+      Block* last = first;
+      for (std::size_t i = 1; i < n; ++i)
+      {
+        last = last->next;
+      }
+      m_free = last->next;
+      m_size -= n;
+      hit_pool().give(first, last);
+    }
+
+    //! the cache itself is trivially destructible, a separate thread_local closes it at thread exit
+    void register_close()
+    {
+      if (!m_registered)
+      {
+        register_closer();
+        m_registered = true;
+      }
+    }
+    static void register_closer();
+
+    static constexpr std::size_t batch_size = 256;
+
+    Block* m_free = nullptr;
+    std::size_t m_size = 0;
+    bool m_closed = false;
+    bool m_registered = false;
+  };
+
+  thread_local HitCache hit_cache;
+
+  void HitCache::register_closer()
+  {
+    struct Closer
+    {
+      ~Closer() { hit_cache.close(); }
+    };
+    static thread_local Closer closer;
+    (void) closer;
+  }
+}  // namespace
+
+void* PHG4Hitv1::operator new(std::size_t size)
+{
+  // derived classes (PHG4HitEval) are larger and keep the TObject allocation
+  if (size != sizeof(PHG4Hitv1))
+  {
+    return TObject::operator new(size);
+  }
+  return hit_cache.allocate();
+}
+
+void PHG4Hitv1::operator delete(void* ptr, std::size_t size)
+{
+  if (!ptr)
+  {
+    return;
+  }
+  if (size != sizeof(PHG4Hitv1))
+  {
+    TObject::operator delete(ptr);
+    return;
+  }
+  hit_cache.deallocate(ptr);
+}
+
 PHG4Hitv1::PHG4Hitv1(const PHG4Hit* g4hit)
 {
   CopyFrom(g4hit);
@@ -7,6 +7,7 @@
 #include "PHG4HitDefs.h"
 
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <limits>
@@ -18,6 +19,21 @@ class PHG4Hitv1 : public PHG4Hit
   PHG4Hitv1() = default;
   explicit PHG4Hitv1(const PHG4Hit* g4hit);
   ~PHG4Hitv1() override = default;
+
+  //! hits are allocated from a pool of blocks which are reused from event to event, see PHG4Hitv1.cc
+  /*!
+   * the pool bypasses TStorage::ObjectAlloc, so IsOnHeap() is false for
+   * PHG4Hitv1 objects and TObject::Delete or TCollection::Delete would not
+   * delete them. Hits are owned by PHG4HitContainer and deleted with
+   * operator delete, they are never put into ROOT collections
+   */
+  static void* operator new(std::size_t size);
+  static void operator delete(void* ptr, std::size_t size);
+
+  //! placement new, hidden by the above otherwise (used e.g. by the ROOT dictionary)
+  static void* operator new(std::size_t /*size*/, void* ptr) { return ptr; }
+  static void operator delete(void* /*ptr*/, void* /*place*/) {}
+
   void identify(std::ostream& os = std::cout) const override;
   void Reset() override;
 
@@ -34,7 +34,6 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
 #include <trackbase/TrkrHitTruthAssocv1.h>
-#include <trackbase/TrkrHitv2.h>
 
 #include <TVector2.h>
 #include <TVector3.h>
@@ -298,9 +297,8 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
         continue;
       }
 
-      // create hitset
+      // hitset key
       const TrkrDefs::hitsetkey hitsetkey = MicromegasDefs::genHitSetKey(layer, layergeom->get_segmentation_type(), tileid);
-      const auto hitset_it = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
 
       // keep track of all charges
       using charge_map_t = std::map<int, double>;
@@ -374,6 +372,13 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
         }
       }
 
+      // the hitset is created even if no strip is fired
+      if (total_charges.empty())
+      {
+        trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
+        continue;
+      }
+
       // generate the key for this hit
       // loop over strips in list
       for (const auto pair : total_charges)
@@ -381,18 +386,9 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
         // get strip and bound check
         const int strip = pair.first;
 
-        // get hit from hitset
+        // stage energy from g4hit, hits are created or updated once all g4hits are processed
         TrkrDefs::hitkey hitkey = MicromegasDefs::genHitKey(strip);
-        auto hit = hitset_it->second->getHit(hitkey);
-        if (!hit)
-        {
-          // create hit and insert in hitset
-          hit = new TrkrHitv2;
-          hitset_it->second->addHitSpecificKey(hitkey, hit);
-        }
-
-        // add energy from g4hit
-        hit->addEnergy(pair.second);
+        m_staging.getBuffer().addEnergy(hitsetkey, hitkey, pair.second);
 
         // associate this hitset and hit to the geant4 hit key
         hittruthassoc->addAssoc(hitsetkey, hitkey, g4hit_it->first);
@@ -400,6 +396,9 @@ int PHG4MicromegasHitReco::process_event(PHCompositeNode* topNode)
     }
   }
 
+  // create or update the hits on the node tree
+  m_staging.merge(trkrhitsetcontainer);
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
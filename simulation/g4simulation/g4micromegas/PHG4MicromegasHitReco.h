@@ -13,6 +13,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrHitSetStaging.h>
+
 #include <gsl/gsl_rng.h>
 #include <memory>
 #include <string>
@@ -100,6 +102,9 @@ class PHG4MicromegasHitReco : public SubsysReco, public PHParameterInterface
   //! random generator that conform with sPHENIX standard
   /*! using a unique_ptr with custom Deleter ensures that the structure is properly freed when parent object is destroyed */
   std::unique_ptr<gsl_rng, Deleter> m_rng;
+
+  //! hits staged during the g4hit loop, merged to the node tree once per event
+  TrkrHitSetStaging m_staging;
 };
 
 #endif
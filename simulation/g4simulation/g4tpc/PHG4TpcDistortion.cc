@@ -10,13 +10,18 @@
 
 #include "PHG4TpcDistortion.h"
 
+#include <trackbase/TpcDistortionMapFile.h>
+
 #include <TFile.h>
 #include <TH3.h>
 #include <TTree.h>
 
+#include <array>
 #include <cmath>    // for sqrt, fabs, NAN
 #include <cstdlib>  // for exit
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace
 {
@@ -26,6 +31,10 @@ namespace
     return x * x;
   }
 
+  // histogram names, in the order of PHG4TpcDistortion::MapIndex
+  const std::array<std::string, 4> map_names = {{"hIntDistortionR", "hIntDistortionP", "hIntDistortionZ", "hReachesReadout"}};
+  const std::array<std::string, 2> map_extensions = {{"_negz", "_posz"}};
+
   // check boundaries in axis
   /* for the interpolation to work, the value must be within the range of the provided axis, and not into the first and last bin */
   inline bool check_boundaries(const TAxis* axis, double value)
@@ -36,9 +45,33 @@ namespace
 
   // check boundaries in histogram, before interpolation
   /* for the interpolation to work, the value must be within the range of the provided axis, and not into the first and last bin */
-  inline bool check_boundaries(const TH3* h, double r, double phi, double z)
+  inline bool check_boundaries(const TH3* h, double phi, double r, double z)
   {
-    return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi) && check_boundaries(h->GetZaxis(), z);
+    return check_boundaries(h->GetXaxis(), phi) && check_boundaries(h->GetYaxis(), r) && check_boundaries(h->GetZaxis(), z);
+  }
+
+  // interpolated distortion, from the grid when it is valid, from the histogram otherwise, 0 outside of the histogram boundaries
+  inline double get_value(const TpcDistortionGrid& grid, TH3* h, double phi, double r, double z)
+  {
+    if (grid.valid())
+    {
+      return grid.interpolate(phi, r, z);
+    }
+    return check_boundaries(h, phi, r, z) ? h->Interpolate(phi, r, z) : 0;
+  }
+
+  // copy histogram to grid when it has regular bins, keep the histogram for interpolation otherwise
+  void make_grid(TH3* h, TpcDistortionGrid& grid, TH3*& histogram)
+  {
+    if (h && !TpcDistortionGrid::is_supported(h))
+    {
+      std::cout << "PHG4TpcDistortion - distortion map " << h->GetName() << " cannot be copied to a grid, interpolating the histogram." << std::endl;
+      grid = TpcDistortionGrid();
+      histogram = h;
+      return;
+    }
+    grid = h ? TpcDistortionGrid(h) : TpcDistortionGrid();
+    histogram = nullptr;
   }
 
   // print histogram
@@ -67,30 +100,64 @@ void PHG4TpcDistortion::Init()
   if (m_do_static_distortions)
   {
     std::cout << "PHG4TpcDistortion::Init - m_static_distortion_filename: " << m_static_distortion_filename << std::endl;
-    m_static_tfile.reset(new TFile(m_static_distortion_filename.c_str()));
-    if (!m_static_tfile->IsOpen())
+    if (TpcDistortionMapFile::is_map_file(m_static_distortion_filename))
     {
-      std::cout << "PHG4TpcDistortion::Init - Static distortion file could not be opened!" << std::endl;
-      exit(1);
+      // binary distortion maps, used in place from the memory mapped file
+      m_static_mapfile.reset(new TpcDistortionMapFile);
+      if (!m_static_mapfile->open(m_static_distortion_filename) || m_static_mapfile->entries() == 0)
+      {
+        std::cout << "PHG4TpcDistortion::Init - Static distortion file could not be opened!" << std::endl;
+        exit(1);
+      }
+      load_grids(*m_static_mapfile, 0, m_static_grids);
     }
-
-    // Open Static Space Charge Maps
-    hDRint[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionR_negz"));
-    hDRint[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionR_posz"));
-    hDPint[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionP_negz"));
-    hDPint[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionP_posz"));
-    hDZint[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionZ_negz"));
-    hDZint[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hIntDistortionZ_posz"));
-    if (m_do_ReachesReadout)
+    else
     {
-      hReach[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_negz"));
-      hReach[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_posz"));
+      m_static_tfile.reset(new TFile(m_static_distortion_filename.c_str()));
+      if (!m_static_tfile->IsOpen())
+      {
+        std::cout << "PHG4TpcDistortion::Init - Static distortion file could not be opened!" << std::endl;
+        exit(1);
+      }
+
+      // Open Static Space Charge Maps, copied to grids so that the file can be closed
+      bool keep_file = false;
+      for (int imap = 0; imap < NMaps; ++imap)
+      {
+        if (imap == MapReach && !m_do_ReachesReadout)
+        {
+          continue;
+        }
+        for (int side = 0; side < 2; ++side)
+        {
+          make_grid(dynamic_cast<TH3*>(m_static_tfile->Get((map_names[imap] + map_extensions[side]).c_str())), m_static_grids[imap][side], m_static_histograms[imap][side]);
+          keep_file |= (m_static_histograms[imap][side] != nullptr);
+        }
+      }
+
+      // histograms which could not be copied to grids are owned by the file
+      if (!keep_file)
+      {
+        m_static_tfile.reset();
+      }
     }
   }
 
   if (m_do_time_ordered_distortions)
   {
     std::cout << "PHG4TpcDistortion::Init - m_time_ordered_distortion_filename: " << m_time_ordered_distortion_filename << std::endl;
+    if (TpcDistortionMapFile::is_map_file(m_time_ordered_distortion_filename))
+    {
+      // binary distortion maps, the maps of an event are paged in from the memory mapped file when loaded
+      m_time_ordered_mapfile.reset(new TpcDistortionMapFile);
+      if (!m_time_ordered_mapfile->open(m_time_ordered_distortion_filename) || m_time_ordered_mapfile->entries() == 0)
+      {
+        std::cout << "PHG4TpcDistortion::Init - TimeOrdered distortion file could not be opened!" << std::endl;
+        exit(1);
+      }
+      return;
+    }
+
     m_time_ordered_tfile.reset(new TFile(m_time_ordered_distortion_filename.c_str()));
     if (!m_time_ordered_tfile->IsOpen())
     {
@@ -130,10 +197,53 @@ void PHG4TpcDistortion::Init()
   }
 }
 
+//__________________________________________________________________________________________________________
+PHG4TpcDistortion::PHG4TpcDistortion() = default;
+
+//__________________________________________________________________________________________________________
+PHG4TpcDistortion::~PHG4TpcDistortion() = default;
+
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::load_grids(const TpcDistortionMapFile& mapfile, unsigned int entry, GridArray& grids) const
+{
+  for (int imap = 0; imap < NMaps; ++imap)
+  {
+    if (imap == MapReach && !m_do_ReachesReadout)
+    {
+      continue;
+    }
+    for (int side = 0; side < 2; ++side)
+    {
+      grids[imap][side] = mapfile.get(map_names[imap] + map_extensions[side], entry);
+    }
+  }
+}
+
 //__________________________________________________________________________________________________________
 void PHG4TpcDistortion::load_event(int event_num)
 {
-  if (TimeTree)
+  if (m_time_ordered_mapfile)
+  {
+    const int nentries = m_time_ordered_mapfile->entries();
+    if (event_num % nentries == 0 && event_num != 0)
+    {
+      std::cout << "Distortion map sequence repeating as of event number " << event_num << std::endl;
+    }
+
+    // only the maps of the current entry are paged in
+    const int entry = event_num % nentries;
+    if (entry != m_time_ordered_entry)
+    {
+      if (m_time_ordered_entry >= 0)
+      {
+        m_time_ordered_mapfile->release(m_time_ordered_entry);
+      }
+      m_time_ordered_entry = entry;
+      load_grids(*m_time_ordered_mapfile, entry, m_time_ordered_grids);
+      m_time_ordered_mapfile->prefetch((entry + 1) % nentries);
+    }
+  }
+  else if (TimeTree)
   {
     int nentries = TimeTree->GetEntries();
     if (event_num > nentries)
@@ -145,6 +255,20 @@ void PHG4TpcDistortion::load_event(int event_num)
       std::cout << "Distortion map sequence repeating as of event number " << event_num << std::endl;
     }
     TimeTree->GetEntry(event_num);
+
+    // copy to grids
+    const std::array<TH3**, NMaps> histograms = {{TimehDR, TimehDP, TimehDZ, TimehRR}};
+    for (int imap = 0; imap < NMaps; ++imap)
+    {
+      if (imap == MapReach && !m_do_ReachesReadout)
+      {
+        continue;
+      }
+      for (int side = 0; side < 2; ++side)
+      {
+        make_grid(histograms[imap][side], m_time_ordered_grids[imap][side], m_time_ordered_histograms[imap][side]);
+      }
+    }
   }
 
   return;
@@ -231,6 +355,97 @@ double PHG4TpcDistortion::get_reaches_readout(double r, double phi, double z) co
   }
 }
 
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::get_distortions(const std::vector<double>& r, const std::vector<double>& phi, const std::vector<double>& z,
+                                        std::vector<double>& dr, std::vector<double>& drphi, std::vector<double>& dz, std::vector<double>& reaches) const
+{
+  const size_t n = r.size();
+  dr.assign(n, 0);
+  drphi.assign(n, 0);
+  dz.assign(n, 0);
+  reaches.assign(n, m_do_ReachesReadout ? 0 : 1);
+
+  // the maps are in phi from 0 to 2pi
+  std::vector<double> phi_map(phi);
+  for (auto& value : phi_map)
+  {
+    if (value < 0)
+    {
+      value += 2 * M_PI;
+    }
+  }
+
+  std::vector<double> values(n);
+  const auto add_distortion = [&](const std::array<TpcDistortionGrid, 2>& grids, const std::array<TH3*, 2>& histograms, const std::string& type, std::vector<double>& result)
+  {
+    // interpolate the points of each side of the TPC together, they usually come in a single run
+    for (size_t begin = 0; begin < n;)
+    {
+      const int zpart = (z[begin] > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
+      size_t end = begin + 1;
+      while (end < n && (z[end] > 0 ? 1 : 0) == zpart)
+      {
+        ++end;
+      }
+
+      if (grids[zpart].valid())
+      {
+        grids[zpart].interpolate(end - begin, &phi_map[begin], &r[begin], &z[begin], &values[begin]);
+      }
+      else if (histograms[zpart])
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          values[i] = get_value(grids[zpart], histograms[zpart], phi_map[i], r[i], z[i]);
+        }
+      }
+      else
+      {
+        std::cout << type << " Distortion Requested, but distortion map does not exist.  Exiting.\n"
+                  << std::endl;
+        exit(1);
+      }
+      begin = end;
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      result[i] += values[i];
+    }
+  };
+
+  if (m_do_static_distortions)
+  {
+    add_distortion(m_static_grids[MapR], m_static_histograms[MapR], "Static", dr);
+    add_distortion(m_static_grids[MapP], m_static_histograms[MapP], "Static", drphi);
+    add_distortion(m_static_grids[MapZ], m_static_histograms[MapZ], "Static", dz);
+    if (m_do_ReachesReadout)
+    {
+      add_distortion(m_static_grids[MapReach], m_static_histograms[MapReach], "Static", reaches);
+    }
+  }
+
+  if (m_do_time_ordered_distortions)
+  {
+    add_distortion(m_time_ordered_grids[MapR], m_time_ordered_histograms[MapR], "Time Series", dr);
+    add_distortion(m_time_ordered_grids[MapP], m_time_ordered_histograms[MapP], "Time Series", drphi);
+    add_distortion(m_time_ordered_grids[MapZ], m_time_ordered_histograms[MapZ], "Time Series", dz);
+    if (m_do_ReachesReadout)
+    {
+      add_distortion(m_time_ordered_grids[MapReach], m_time_ordered_histograms[MapReach], "Time Series", reaches);
+    }
+  }
+
+  if (m_phi_hist_in_radians)
+  {  // if the hist is in radians, multiply by r to get the rphi distortion
+    for (size_t i = 0; i < n; ++i)
+    {
+      drphi[i] *= r[i];
+    }
+  }
+}
+
+//__________________________________________________________________________________________________________
 double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double z) const
 {
   if (phi < 0)
@@ -239,8 +454,6 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
   }
   const int zpart = (z > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
 
-  TH3* hdistortion = nullptr;
-
   if (axis != 'r' && axis != 'p' && axis != 'z' && axis != 'R')
   {
     std::cout << "Distortion Requested along axis " << axis << " which is invalid.  Exiting.\n"
@@ -248,33 +461,29 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
     exit(1);
   }
 
+  // select the appropriate map:
+  int imap = MapReach;
+  if (axis == 'r')
+  {
+    imap = MapR;
+  }
+  else if (axis == 'p')
+  {
+    imap = MapP;
+  }
+  else if (axis == 'z')
+  {
+    imap = MapZ;
+  }
+
   double _distortion = 0.;
 
-  // select the appropriate histogram:
   if (m_do_static_distortions)
   {
-    if (axis == 'r')
-    {
-      hdistortion = hDRint[zpart];
-    }
-    else if (axis == 'p')
-    {
-      hdistortion = hDPint[zpart];
-    }
-    else if (axis == 'z')
-    {
-      hdistortion = hDZint[zpart];
-    }
-    else if (axis == 'R')
+    const auto& grid = m_static_grids[imap][zpart];
+    if (grid.valid() || m_static_histograms[imap][zpart])
     {
-      hdistortion = hReach[zpart];
-    }
-    if (hdistortion)
-    {
-      if (check_boundaries(hdistortion, phi, r, z))
-      {
-        _distortion += hdistortion->Interpolate(phi, r, z);
-      }
+      _distortion += get_value(grid, m_static_histograms[imap][zpart], phi, r, z);
     }
     else
     {
@@ -286,28 +495,10 @@ double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double
 
   if (m_do_time_ordered_distortions)
   {
-    if (axis == 'r')
-    {
-      hdistortion = TimehDR[zpart];
-    }
-    else if (axis == 'p')
+    const auto& grid = m_time_ordered_grids[imap][zpart];
+    if (grid.valid() || m_time_ordered_histograms[imap][zpart])
     {
-      hdistortion = TimehDP[zpart];
-    }
-    else if (axis == 'z')
-    {
-      hdistortion = TimehDZ[zpart];
-    }
-    else if (axis == 'R')
-    {
-      hdistortion = TimehRR[zpart];
-    }
-    if (hdistortion)
-    {
-      if (check_boundaries(hdistortion, phi, r, z))
-      {
-        _distortion += hdistortion->Interpolate(phi, r, z);
-      }
+      _distortion += get_value(grid, m_time_ordered_histograms[imap][zpart], phi, r, z);
     }
     else
     {
@@ -11,19 +11,33 @@
 #ifndef G4TPC_PHG4TPCDISTORTION_H
 #define G4TPC_PHG4TPCDISTORTION_H
 
+#include <trackbase/TpcDistortionGrid.h>
+
+#include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TFile;
 class TH3;
+class TpcDistortionMapFile;
 class TTree;
 
 //! handle distortions (static and time-ordered)
+/*!
+ * The distortion files are either ROOT files with the distortion histograms,
+ * or TpcDistortionMapFile binary files made from them, which are memory mapped.
+ * In both cases the distortions are interpolated on TpcDistortionGrid copies of the maps,
+ * histograms with variable bins are interpolated directly.
+ */
 class PHG4TpcDistortion
 {
  public:
   //! constructor
-  explicit PHG4TpcDistortion() = default;
+  explicit PHG4TpcDistortion();
+
+  //! destructor
+  ~PHG4TpcDistortion();
 
   //!@name accessors
   //@{
@@ -49,6 +63,11 @@ class PHG4TpcDistortion
   // The ReachesReadout serves as a fourth axis in the distortion histogram
   double get_reaches_readout(double r, double phi, double z) const;
 
+  //! radial, R*phi and z distortions, and reaches readout, for a set of cylindrical truth locations
+  /*! gives the same values as the single location accessors, for all locations in one pass */
+  void get_distortions(const std::vector<double> &r, const std::vector<double> &phi, const std::vector<double> &z,
+                       std::vector<double> &dr, std::vector<double> &drphi, std::vector<double> &dz, std::vector<double> &reaches) const;
+
   //! Gets the verbosity of this module.
   int Verbosity() const
   {
@@ -113,6 +132,25 @@ class PHG4TpcDistortion
   //! get distortion for a set of histogram and an input momentum distribution
   double get_distortion(char axis, double r, double phi, double z) const;
 
+  //! distortion maps: radial, phi and z distortions, and reaches readout
+  enum MapIndex
+  {
+    MapR = 0,
+    MapP,
+    MapZ,
+    MapReach,
+    NMaps
+  };
+
+  //! grids of each map, for negative and positive z
+  using GridArray = std::array<std::array<TpcDistortionGrid, 2>, NMaps>;
+
+  //! histograms of each map, for negative and positive z, used when they cannot be copied to grids (variable bins)
+  using HistogramArray = std::array<std::array<TH3 *, 2>, NMaps>;
+
+  //! load the grids from a distortion map file entry
+  void load_grids(const TpcDistortionMapFile&, unsigned int entry, GridArray&) const;
+
   //! The verbosity level. 0 means not verbose at all.
   int verbosity = 0;
 
@@ -126,10 +164,9 @@ class PHG4TpcDistortion
   bool m_do_static_distortions = false;
   std::string m_static_distortion_filename;
   std::unique_ptr<TFile> m_static_tfile;
-  TH3 *hDRint[2] = {nullptr, nullptr};
-  TH3 *hDPint[2] = {nullptr, nullptr};
-  TH3 *hDZint[2] = {nullptr, nullptr};
-  TH3 *hReach[2] = {nullptr, nullptr};
+  std::unique_ptr<TpcDistortionMapFile> m_static_mapfile;
+  GridArray m_static_grids;
+  HistogramArray m_static_histograms = {};
   //@}
 
   //!@name time ordered histograms
@@ -137,6 +174,10 @@ class PHG4TpcDistortion
   bool m_do_time_ordered_distortions = false;
   std::string m_time_ordered_distortion_filename;
   std::unique_ptr<TFile> m_time_ordered_tfile;
+  std::unique_ptr<TpcDistortionMapFile> m_time_ordered_mapfile;
+  int m_time_ordered_entry = -1;
+  GridArray m_time_ordered_grids;
+  HistogramArray m_time_ordered_histograms = {};
   TTree *TimeTree = nullptr;
   TH3 *TimehDR[2] = {nullptr, nullptr};
   TH3 *TimehDP[2] = {nullptr, nullptr};
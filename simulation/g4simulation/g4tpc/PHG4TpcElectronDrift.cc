@@ -17,7 +17,6 @@
 #include <trackbase/TrkrHitSetContainerv1.h>
 #include <trackbase/TrkrHitTruthAssoc.h>  // for TrkrHitTruthA...
 #include <trackbase/TrkrHitTruthAssocv1.h>
-#include <trackbase/TrkrHitv2.h>
 
 #include <g4tracking/TrkrTruthTrackContainerv1.h>
 #include <g4tracking/TrkrTruthTrackv1.h>
@@ -510,156 +509,61 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
     int notReachingReadout = 0;
     int notInAcceptance = 0;
-    for (unsigned int i = 0; i < n_electrons; i++)
+    if (m_batch_electrons)
     {
-      // We choose the electron starting position at random from a flat
-      // distribution along the path length the parameter t is the fraction of
-      // the distance along the path betwen entry and exit points, it has
-      // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
-
-      const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
-
-      unsigned int side = 0;
-      if (z_start > 0)
-      {
-        side = 1;
-      }
-
-      const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
-      const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
-
-      const double t_path = (tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
-      const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / drift_velocity;
-      double t_final = t_start + t_path + rantime;
-
-      if (t_final < min_time || t_final > max_time)
-      {
-        continue;
-      }
-
-      double z_final;
-      if (z_start < 0)
-      {
-        z_final = -tpc_length / 2. + t_final * drift_velocity;
-      }
-      else
-      {
-        z_final = tpc_length / 2. - t_final * drift_velocity;
-      }
-
-      const double radstart = std::sqrt(square(x_start) + square(y_start));
-      const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
-
-      double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
-      double y_final = y_start + rantrans * std::sin(ranphi);
-
-      double rad_final = sqrt(square(x_final) + square(y_final));
-      double phi_final = atan2(y_final, x_final);
-
-      if (do_ElectronDriftQAHistos)
-      {
-        z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
-        deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
-        deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
-      }
-
-      if (m_distortionMap)
+      drift_electrons(hiter, n_electrons, ihit, notReachingReadout, notInAcceptance);
+    }
+    else
+    {
+      for (unsigned int i = 0; i < n_electrons; i++)
       {
-        // zhangcanyu
-        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
-        if (reaches < thresholdforreachesreadout)
+        // We choose the electron starting position at random from a flat
+        // distribution along the path length the parameter t is the fraction of
+        // the distance along the path betwen entry and exit points, it has
+        // values between 0 and 1
+        Electron electron;
+        electron.f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+        const double f = electron.f;
+
+        electron.x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
+        electron.y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
+        electron.z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
+        electron.t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+        const double z_start = electron.z_start;
+
+        const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
+        electron.rantrans =
+            gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
+
+        const double t_path = (tpc_length / 2. - std::abs(z_start)) / drift_velocity;
+        electron.t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / drift_velocity;
+        electron.rantime =
+            gsl_ran_gaussian(RandomGenerator.get(), electron.t_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / drift_velocity;
+        electron.t_final = electron.t_start + t_path + electron.rantime;
+
+        if (electron.t_final < min_time || electron.t_final > max_time)
         {
-          notReachingReadout++;
           continue;
         }
 
-        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
-        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
-        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
-
-        rad_final += r_distortion;
-        phi_final += phi_distortion;
-        z_final += z_distortion;
-        if (z_start < 0)
-        {
-          t_final = (z_final + tpc_length / 2.0) / drift_velocity;
-        }
-        else
-        {
-          t_final = (tpc_length / 2.0 - z_final) / drift_velocity;
-        }
-
-        x_final = rad_final * std::cos(phi_final);
-        y_final = rad_final * std::sin(phi_final);
+        electron.radstart = std::sqrt(square(electron.x_start) + square(electron.y_start));
+        electron.phistart = std::atan2(electron.y_start, electron.x_start);
+        electron.ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
 
-        //	if(i < 1)
-        //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
-
-        if (do_ElectronDriftQAHistos)
+        double x_final;
+        double y_final;
+        double t_final;
+        if (!transport_electron(electron, nullptr, hiter, i, ihit, notReachingReadout, notInAcceptance, x_final, y_final, t_final))
         {
-          const double phi_final_nodiff = phistart + phi_distortion;
-          const double rad_final_nodiff = radstart + r_distortion;
-          deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
-          deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
-          deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
-          deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
-
-          // Fill Diagnostic plots, written into ElectronDriftQA.root
-          hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
-          hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
-          hitmapstart_z->Fill(z_start, radstart);
-          hitmapend_z->Fill(z_final, rad_final);
-          deltar->Fill(radstart, rad_final - radstart);    // total delta r
-          deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
-          deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+          continue;
         }
-      }
-
-      // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
-      if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
-      {
-        notInAcceptance++;
-        continue;
-      }
-
-      if (Verbosity() > 1000)
-      //      if(i < 1)
-      {
-        std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
-        std::cout << "radstart " << radstart << " x_start: " << x_start
-                  << ", y_start: " << y_start
-                  << ",z_start: " << z_start
-                  << " t_start " << t_start
-                  << " t_path " << t_path
-                  << " t_sigma " << t_sigma
-                  << " rantime " << rantime
-                  << std::endl;
-
-        std::cout << "       rad_final " << rad_final << " x_final " << x_final
-                  << " y_final " << y_final
-                  << " z_final " << z_final << " t_final " << t_final
-                  << " zdiff " << z_final - z_start << std::endl;
-      }
-
-      if (Verbosity() > 0)
-      {
-        assert(nt);
-        nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
-      }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
-    }  // end loop over electrons for this g4hit
+        padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
+                                electron.side(), hiter, ntpad, nthit);
+      }  // end loop over electrons for this g4hit
+    }
 
     if (do_ElectronDriftQAHistos)
     {
@@ -723,9 +627,6 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
                     << " with sector " << sector << " side " << side << std::endl;
         }
 
-        // find or add this hitset on the node tree
-        TrkrHitSetContainer::Iterator node_hitsetit = hitsetcontainer->findOrAddHitSet(node_hitsetkey);
-
         // get all of the hits from the temporary hitset
         TrkrHitSet::ConstRange temp_hit_range = temp_hitset_iter->second->getHits();
         for (TrkrHitSet::ConstIterator temp_hit_iter = temp_hit_range.first;
@@ -745,17 +646,8 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
             ncollectedhits++;
           }
 
-          // find or add this hit to the node tree
-          TrkrHit *node_hit = node_hitsetit->second->getHit(temp_hitkey);
-          if (!node_hit)
-          {
-            // Otherwise, create a new one
-            node_hit = new TrkrHitv2();
-            node_hitsetit->second->addHitSpecificKey(temp_hitkey, node_hit);
-          }
-
-          // Either way, add the energy to it
-          node_hit->addEnergy(temp_tpchit->getEnergy());
+          // stage the hit, it is added to the node tree, or its adc added to the existing hit, below
+          m_staging.getBuffer().addHit(node_hitsetkey, temp_hitkey, temp_tpchit->getAdc());
 
         }  // end loop over temp hits
 
@@ -766,6 +658,9 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
       }  // end loop over temp hitsets
 
+      // one sorted bulk fill per hitset on the node tree
+      m_staging.merge(hitsetcontainer);
+
       // erase all entries in the temp hitsetcontainer
       temp_hitsetcontainer->Reset();
 
@@ -846,6 +741,262 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHG4TpcElectronDrift::ElectronBatch::resize(size_t n)
+{
+  for (auto *v : {&f, &x_start, &y_start, &z_start, &t_start, &t_sigma, &t_final, &rantrans, &rantime, &ranphi, &radstart, &phistart})
+  {
+    v->resize(n);
+  }
+}
+
+void PHG4TpcElectronDrift::drift_electrons(PHG4HitContainer::ConstIterator hiter, const unsigned int n_electrons, const double ihit, int &notReachingReadout, int &notInAcceptance)
+{
+  auto &electrons = m_electrons;
+  electrons.resize(n_electrons);
+  gsl_rng *rng = RandomGenerator.get();
+
+  // draw the random numbers for all electrons up front, one quantity at a time
+  // fraction of the distance along the path between entry and exit points
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    electrons.f[i] = gsl_rng_uniform(rng);
+  }
+
+  // unit gaussians, scaled below by the combined diffusion and smearing width
+  // the sum of two gaussians is a gaussian with the widths added in quadrature, so one draw per direction is enough
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    electrons.rantrans[i] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+  }
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    electrons.rantime[i] = gsl_ran_gaussian_ziggurat(rng, 1.0);
+  }
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    electrons.ranphi[i] = gsl_ran_flat(rng, -M_PI, M_PI);
+  }
+
+  // starting position and drift, without branches so that the compiler can vectorize it
+  const PHG4Hit *g4hit = hiter->second;
+  const double x0 = g4hit->get_x(0);
+  const double y0 = g4hit->get_y(0);
+  const double z0 = g4hit->get_z(0);
+  const double t0 = g4hit->get_t(0);
+  const double dx = g4hit->get_x(1) - x0;
+  const double dy = g4hit->get_y(1) - y0;
+  const double dz = g4hit->get_z(1) - z0;
+  const double dt = g4hit->get_t(1) - t0;
+  const double smear_trans2 = square(added_smear_sigma_trans);
+  const double smear_long2 = square(added_smear_sigma_long / drift_velocity);
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    const double f = electrons.f[i];
+    electrons.x_start[i] = x0 + f * dx;
+    electrons.y_start[i] = y0 + f * dy;
+    electrons.z_start[i] = z0 + f * dz;
+    electrons.t_start[i] = t0 + f * dt;
+
+    const double drift_length = tpc_length / 2. - std::abs(electrons.z_start[i]);
+    const double r_sigma = diffusion_trans * std::sqrt(drift_length);
+    const double t_path = drift_length / drift_velocity;
+    const double t_sigma = diffusion_long * std::sqrt(drift_length) / drift_velocity;
+    electrons.rantrans[i] *= std::sqrt(square(r_sigma) + smear_trans2);
+    electrons.rantime[i] *= std::sqrt(square(t_sigma) + smear_long2);
+    electrons.t_sigma[i] = t_sigma;
+    electrons.t_final[i] = electrons.t_start[i] + t_path + electrons.rantime[i];
+  }
+
+  // keep only the electrons that arrive within the readout time window
+  size_t nkept = 0;
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    if (electrons.t_final[i] < min_time || electrons.t_final[i] > max_time)
+    {
+      continue;
+    }
+    for (auto *v : {&electrons.f, &electrons.x_start, &electrons.y_start, &electrons.z_start, &electrons.t_start, &electrons.t_sigma, &electrons.t_final, &electrons.rantrans, &electrons.rantime, &electrons.ranphi})
+    {
+      (*v)[nkept] = (*v)[i];
+    }
+    ++nkept;
+  }
+  electrons.resize(nkept);
+
+  for (size_t i = 0; i < nkept; ++i)
+  {
+    electrons.radstart[i] = std::sqrt(square(electrons.x_start[i]) + square(electrons.y_start[i]));
+    electrons.phistart[i] = std::atan2(electrons.y_start[i], electrons.x_start[i]);
+  }
+
+  if (m_distortionMap)
+  {
+    m_distortionMap->get_distortions(electrons.radstart, electrons.phistart, electrons.z_start,
+                                     electrons.r_distortion, electrons.rphi_distortion, electrons.z_distortion, electrons.reaches);
+  }
+
+  electrons.x_gem.clear();
+  electrons.y_gem.clear();
+  electrons.t_gem.clear();
+  electrons.side.clear();
+  for (size_t i = 0; i < nkept; ++i)
+  {
+    Electron electron;
+    electron.f = electrons.f[i];
+    electron.x_start = electrons.x_start[i];
+    electron.y_start = electrons.y_start[i];
+    electron.z_start = electrons.z_start[i];
+    electron.t_start = electrons.t_start[i];
+    electron.t_sigma = electrons.t_sigma[i];
+    electron.t_final = electrons.t_final[i];
+    electron.rantrans = electrons.rantrans[i];
+    electron.rantime = electrons.rantime[i];
+    electron.ranphi = electrons.ranphi[i];
+    electron.radstart = electrons.radstart[i];
+    electron.phistart = electrons.phistart[i];
+
+    ElectronDistortion distortion;
+    if (m_distortionMap)
+    {
+      distortion.r = electrons.r_distortion[i];
+      distortion.rphi = electrons.rphi_distortion[i];
+      distortion.z = electrons.z_distortion[i];
+      distortion.reaches = electrons.reaches[i];
+    }
+
+    double x_final;
+    double y_final;
+    double t_final;
+    if (!transport_electron(electron, &distortion, hiter, i, ihit, notReachingReadout, notInAcceptance, x_final, y_final, t_final))
+    {
+      continue;
+    }
+    electrons.x_gem.push_back(x_final);
+    electrons.y_gem.push_back(y_final);
+    electrons.t_gem.push_back(t_final);
+    electrons.side.push_back(electron.side());
+  }
+
+  padplane->MapElectronsToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                   temp_hitsetcontainer.get(), hittruthassoc, electrons.x_gem, electrons.y_gem, electrons.t_gem,
+                                   electrons.side, hiter, ntpad, nthit);
+}
+
+bool PHG4TpcElectronDrift::transport_electron(const Electron &electron, const ElectronDistortion *distortion, PHG4HitContainer::ConstIterator hiter, const unsigned int i, const double ihit, int &notReachingReadout, int &notInAcceptance, double &x_final, double &y_final, double &t_final)
+{
+  const double x_start = electron.x_start;
+  const double y_start = electron.y_start;
+  const double z_start = electron.z_start;
+  const double radstart = electron.radstart;
+  const double phistart = electron.phistart;
+  const double rantrans = electron.rantrans;
+  t_final = electron.t_final;
+
+  double z_final;
+  if (z_start < 0)
+  {
+    z_final = -tpc_length / 2. + t_final * drift_velocity;
+  }
+  else
+  {
+    z_final = tpc_length / 2. - t_final * drift_velocity;
+  }
+
+  x_final = x_start + rantrans * std::cos(electron.ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
+  y_final = y_start + rantrans * std::sin(electron.ranphi);
+
+  double rad_final = sqrt(square(x_final) + square(y_final));
+  double phi_final = atan2(y_final, x_final);
+
+  if (do_ElectronDriftQAHistos)
+  {
+    z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
+    deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
+    deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
+  }
+
+  if (m_distortionMap)
+  {
+    // zhangcanyu
+    const double reaches = distortion ? distortion->reaches : m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
+    if (reaches < thresholdforreachesreadout)
+    {
+      notReachingReadout++;
+      return false;
+    }
+
+    const double r_distortion = distortion ? distortion->r : m_distortionMap->get_r_distortion(radstart, phistart, z_start);
+    const double phi_distortion = (distortion ? distortion->rphi : m_distortionMap->get_rphi_distortion(radstart, phistart, z_start)) / radstart;
+    const double z_distortion = distortion ? distortion->z : m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+
+    rad_final += r_distortion;
+    phi_final += phi_distortion;
+    z_final += z_distortion;
+    if (z_start < 0)
+    {
+      t_final = (z_final + tpc_length / 2.0) / drift_velocity;
+    }
+    else
+    {
+      t_final = (tpc_length / 2.0 - z_final) / drift_velocity;
+    }
+
+    x_final = rad_final * std::cos(phi_final);
+    y_final = rad_final * std::sin(phi_final);
+
+    if (do_ElectronDriftQAHistos)
+    {
+      const double phi_final_nodiff = phistart + phi_distortion;
+      const double rad_final_nodiff = radstart + r_distortion;
+      deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
+      deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
+      deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
+      deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+
+      // Fill Diagnostic plots, written into ElectronDriftQA.root
+      hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
+      hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
+      hitmapstart_z->Fill(z_start, radstart);
+      hitmapend_z->Fill(z_final, rad_final);
+      deltar->Fill(radstart, rad_final - radstart);    // total delta r
+      deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
+      deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+    }
+  }
+
+  // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
+  if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
+  {
+    notInAcceptance++;
+    return false;
+  }
+
+  if (Verbosity() > 1000)
+  {
+    std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << electron.f << std::endl;
+    std::cout << "radstart " << radstart << " x_start: " << x_start
+              << ", y_start: " << y_start
+              << ",z_start: " << z_start
+              << " t_start " << electron.t_start
+              << " t_path " << (tpc_length / 2. - std::abs(z_start)) / drift_velocity
+              << " t_sigma " << electron.t_sigma
+              << " rantime " << electron.rantime
+              << std::endl;
+
+    std::cout << "       rad_final " << rad_final << " x_final " << x_final
+              << " y_final " << y_final
+              << " z_final " << z_final << " t_final " << t_final
+              << " zdiff " << z_final - z_start << std::endl;
+  }
+
+  if (Verbosity() > 0)
+  {
+    assert(nt);
+    nt->Fill(ihit, electron.t_start, t_final, electron.t_sigma, rad_final, z_start, z_final);
+  }
+  return true;
+}
+
 int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
 {
   if (Verbosity() > 0)
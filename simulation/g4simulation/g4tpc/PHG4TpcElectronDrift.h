@@ -6,6 +6,7 @@
 #include "TpcClusterBuilder.h"
 
 #include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrHitSetStaging.h>
 
 #include <g4main/PHG4HitContainer.h>
 
@@ -21,6 +22,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
@@ -82,9 +84,49 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   void set_zero_bfield_flag(bool flag) { zero_bfield = flag; };
   void set_zero_bfield_diffusion_factor(double f) { zero_bfield_diffusion_factor = f; };
+
+  //! drift all electrons of a g4hit together rather than one at a time
+  /*! gives statistically equivalent results, with a different random number sequence */
+  void set_batch_electrons(bool flag) { m_batch_electrons = flag; };
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
+  //! drift the electrons of a g4hit in one go and map them to the pad plane
+  void drift_electrons(PHG4HitContainer::ConstIterator hiter, unsigned int n_electrons, double ihit, int &notReachingReadout, int &notInAcceptance);
+
+  //! one electron after diffusion, at its start position
+  struct Electron
+  {
+    unsigned int side() const { return z_start > 0 ? 1 : 0; }
+
+    double f = 0;
+    double x_start = 0;
+    double y_start = 0;
+    double z_start = 0;
+    double t_start = 0;
+    double t_sigma = 0;
+    double t_final = 0;
+    double rantrans = 0;
+    double rantime = 0;
+    double ranphi = 0;
+    double radstart = 0;
+    double phistart = 0;
+  };
+
+  //! distortions at the start position of an electron
+  struct ElectronDistortion
+  {
+    double r = 0;
+    double rphi = 0;
+    double z = 0;
+    double reaches = 1;
+  };
+
+  //! distortions, QA histograms and acceptance for one electron, shared by the
+  //! serial and the batched drift. The distortions are taken from the map if
+  //! distortion is null. Returns false if the electron does not reach the pad plane
+  bool transport_electron(const Electron &electron, const ElectronDistortion *distortion, PHG4HitContainer::ConstIterator hiter, unsigned int i, double ihit, int &notReachingReadout, int &notInAcceptance, double &x_final, double &y_final, double &t_final);
+
   TrkrHitSetContainer *hitsetcontainer{nullptr};
   TrkrHitTruthAssoc *hittruthassoc{nullptr};
   TrkrTruthTrackContainer *truthtracks{nullptr};
@@ -141,8 +183,41 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_ElectronDriftQAHistos{false};
   bool do_getReachReadout{false};
   bool zero_bfield{false};
+  bool m_batch_electrons{false};
+
+  //! per electron quantities of a g4hit, for the batched electron drift
+  struct ElectronBatch
+  {
+    void resize(size_t n);
+
+    std::vector<double> f;
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> t_start;
+    std::vector<double> t_sigma;
+    std::vector<double> t_final;
+    std::vector<double> rantrans;
+    std::vector<double> rantime;
+    std::vector<double> ranphi;
+    std::vector<double> radstart;
+    std::vector<double> phistart;
+    std::vector<double> r_distortion;
+    std::vector<double> rphi_distortion;
+    std::vector<double> z_distortion;
+    std::vector<double> reaches;
+
+    //! electron positions at the readout plane
+    std::vector<double> x_gem;
+    std::vector<double> y_gem;
+    std::vector<double> t_gem;
+    std::vector<unsigned int> side;
+  };
+  ElectronBatch m_electrons;
 
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
+  //! temp_hitsetcontainer hits, staged for merging to the node tree
+  TrkrHitSetStaging m_staging;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
   std::unique_ptr<PHG4TpcPadPlane> padplane;
   std::unique_ptr<PHG4TpcDistortion> m_distortionMap;
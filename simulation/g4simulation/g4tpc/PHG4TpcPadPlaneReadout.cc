@@ -33,10 +33,12 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <tuple>
 #include <utility>  // for pair
 
 class PHCompositeNode;
@@ -103,6 +105,25 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
   GeomContainer = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, seggeonodename);
   assert(GeomContainer);
 
+  // radial extent of the layers, ordered in radius, to find the layer of an electron with a binary search
+  m_layer_rad_low.clear();
+  m_layer_rad_high.clear();
+  m_layer_geom.clear();
+  PHG4TpcCylinderGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
+  for (PHG4TpcCylinderGeomContainer::ConstIterator layeriter = layerrange.first;
+       layeriter != layerrange.second;
+       ++layeriter)
+  {
+    m_layer_rad_low.push_back(layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0);
+    m_layer_rad_high.push_back(layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0);
+    m_layer_geom.push_back(layeriter->second);
+  }
+  if (!std::is_sorted(m_layer_rad_high.begin(), m_layer_rad_high.end()))
+  {
+    std::cout << PHWHERE << " TPC layers are not ordered in radius" << std::endl;
+    gSystem->Exit(1);
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -134,7 +155,49 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   // One electron per call of this method
   // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
   // The t_gem value already reflects the drift time of the primary electron from the production point, and is randomized within the longitudinal diffusion witdth
+  m_deposits.clear();
+  const unsigned int layernum = amplify_electron(x_gem, y_gem, t_gem, side, hiter);
+  if (layernum == 0)
+  {
+    return;
+  }
+
+  hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
+  fill_hits(tpc_truth_clusterer, single_hitsetcontainer, hitsetcontainer);
+}
 
+void PHG4TpcPadPlaneReadout::MapElectronsToPadPlane(
+    TpcClusterBuilder &tpc_truth_clusterer,
+    TrkrHitSetContainer *single_hitsetcontainer,
+    TrkrHitSetContainer *hitsetcontainer,
+    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    const std::vector<double> &x_gem, const std::vector<double> &y_gem, const std::vector<double> &t_gem,
+    const std::vector<unsigned int> &side,
+    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+{
+  // the charge of all electrons is collected first, then added to the hits once per hit
+  m_deposits.clear();
+  unsigned int layernum = 0;
+  for (size_t i = 0; i < x_gem.size(); ++i)
+  {
+    const unsigned int layer = amplify_electron(x_gem[i], y_gem[i], t_gem[i], side[i], hiter);
+    if (layer > 0)
+    {
+      layernum = layer;
+    }
+  }
+  if (layernum == 0)
+  {
+    return;
+  }
+
+  // same as the last electron that reached a layer when mapping one electron at a time
+  hiter->second->set_layer(layernum);
+  fill_hits(tpc_truth_clusterer, single_hitsetcontainer, hitsetcontainer);
+}
+
+unsigned int PHG4TpcPadPlaneReadout::amplify_electron(const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter)
+{
   double phi = atan2(y_gem, x_gem);
   if (phi > +M_PI)
   {
@@ -173,44 +236,36 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   }
 
   phi = check_phi(side, phi, rad_gem);
-  unsigned int layernum = 0;
-  /* TpcClusterBuilder pass_data {}; */
 
   // Find which readout layer this electron ends up in
-
-  PHG4TpcCylinderGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
-  for (PHG4TpcCylinderGeomContainer::ConstIterator layeriter = layerrange.first;
-       layeriter != layerrange.second;
-       ++layeriter)
+  // the layers are ordered in radius, take the first one whose outer edge is above the electron
+  const auto layeriter = std::upper_bound(m_layer_rad_high.begin(), m_layer_rad_high.end(), rad_gem);
+  if (layeriter == m_layer_rad_high.end())
   {
-    double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
-    double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
-
-    if (rad_gem > rad_low && rad_gem < rad_high)
-    {
-      // capture the layer where this electron hits the gem stack
-      LayerGeom = layeriter->second;
+    return 0;
+  }
+  const size_t ilayer = std::distance(m_layer_rad_high.begin(), layeriter);
+  if (!(rad_gem > m_layer_rad_low[ilayer] && rad_gem < m_layer_rad_high[ilayer]))
+  {
+    return 0;
+  }
 
-      layernum = LayerGeom->get_layer();
-      /* pass_data.layerGeom = LayerGeom; */
-      /* pass_data.layer = layernum; */
-      if (Verbosity() > 1000)
-      {
-        std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem << " rad_low " << rad_low << " rad_high " << rad_high
-                  << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
-      }
-      hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
-    }
+  // capture the layer where this electron hits the gem stack
+  LayerGeom = m_layer_geom[ilayer];
+  const unsigned int layernum = LayerGeom->get_layer();
+  if (Verbosity() > 1000)
+  {
+    std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem << " rad_low " << m_layer_rad_low[ilayer] << " rad_high " << m_layer_rad_high[ilayer]
+              << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
   }
 
   if (layernum == 0)
   {
-    return;
+    return 0;
   }
 
   // store phi bins and tbins upfront to avoid repetitive checks on the phi methods
   const auto phibins = LayerGeom->get_phibins();
-  /* pass_data.nphibins = phibins; */
 
   const auto tbins = LayerGeom->get_zbins();
 
@@ -238,7 +293,6 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   }
   nelec = nelec * gain_weight;
   // std::cout<<"PHG4TpcPadPlaneReadout::MapToPadPlane gain_weight = "<<gain_weight<<std::endl;
-  /* pass_data.neff_electrons = nelec; */
 
   // Distribute the charge between the pads in phi
   //====================================
@@ -253,15 +307,12 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
               << std::endl;
   }
 
-  std::vector<int> pad_phibin;
-  std::vector<double> pad_phibin_share;
+  auto &pad_phibin = m_pad_phibin;
+  auto &pad_phibin_share = m_pad_phibin_share;
+  pad_phibin.clear();
+  pad_phibin_share.clear();
 
   populate_zigzag_phibins(side, layernum, phi, sigmaT, pad_phibin, pad_phibin_share);
-  /* if (pad_phibin.size() == 0) { */
-  /* pass_data.neff_electrons = 0; */
-  /* } else { */
-  /* pass_data.fillPhiBins(pad_phibin); */
-  /* } */
 
   // Normalize the shares so they add up to 1
   double norm1 = 0.0;
@@ -283,14 +334,11 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
               << " with t_gem " << t_gem << " sigmaL[0] " << sigmaL[0] << " sigmaL[1] " << sigmaL[1] << std::endl;
   }
 
-  std::vector<int> adc_tbin;
-  std::vector<double> adc_tbin_share;
+  auto &adc_tbin = m_adc_tbin;
+  auto &adc_tbin_share = m_adc_tbin_share;
+  adc_tbin.clear();
+  adc_tbin_share.clear();
   populate_tbins(t_gem, sigmaL, adc_tbin, adc_tbin_share);
-  /* if (adc_tbin.size() == 0)  { */
-  /* pass_data.neff_electrons = 0; */
-  /* } else { */
-  /* pass_data.fillTimeBins(adc_tbin); */
-  /* } */
 
   // Normalize the shares so that they add up to 1
   double tnorm = 0.0;
@@ -304,13 +352,16 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
     adc_tbin_share[it] /= tnorm;
   }
 
-  // Fill HitSetContainer
+  // Collect the charge per hit
   //===============
   // These are used to do a quick clustering for checking
   double phi_integral = 0.0;
   double t_integral = 0.0;
   double weight = 0.0;
 
+  // get the Tpc readout sector - there are 12 sectors with how many pads each?
+  const unsigned int pads_per_sector = phibins / 12;
+
   for (unsigned int ipad = 0; ipad < pad_phibin.size(); ++ipad)
   {
     int pad_num = pad_phibin[ipad];
@@ -351,72 +402,17 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
                   << " neffelectrons " << neffelectrons << " neffelectrons_threshold " << neffelectrons_threshold << std::endl;
       }
 
-      // new containers
-      //============
-      // We add the Tpc TrkrHitsets directly to the node using hitsetcontainer
-      // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a Tpc readout module
       // The hitset key includes the layer, sector, side
-
       // The side is an input parameter
-
-      // get the Tpc readout sector - there are 12 sectors with how many pads each?
-      unsigned int pads_per_sector = phibins / 12;
       unsigned int sector = pad_num / pads_per_sector;
       TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
-      // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
-      TrkrHitSetContainer::Iterator single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
 
       // generate the key for this hit, requires tbin and phibin
       TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
-      // See if this hit already exists
-      TrkrHit *hit = nullptr;
-      hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // create a new one
-        hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      hit->addEnergy(neffelectrons);
-
-      tpc_truth_clusterer.addhitset(hitsetkey, hitkey, neffelectrons);
-
-      // repeat for the single_hitsetcontainer
-      // See if this hit already exists
-      TrkrHit *single_hit = nullptr;
-      single_hit = single_hitsetit->second->getHit(hitkey);
-      if (!single_hit)
-      {
-        // create a new one
-        single_hit = new TrkrHitv2();
-        single_hitsetit->second->addHitSpecificKey(hitkey, single_hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      single_hit->addEnergy(neffelectrons);
-
-      /*
-      if (Verbosity() > 0)
-      {
-        assert(nthit);
-        nthit->Fill(layernum, pad_num, tbin_num, neffelectrons);
-      }
-      */
+      m_deposits.push_back({hitsetkey, hitkey, neffelectrons});
 
     }  // end of loop over adc T bins
   }    // end of loop over zigzag pads
-  /* pass_data.phi_integral = phi_integral; */
-  /* pass_data.time_integral = t_integral; */
-
-  /*
-  // Capture the input values at the gem stack and the quick clustering results, elecron-by-electron
-  if (Verbosity() > 0)
-  {
-    assert(ntpad);
-    ntpad->Fill(layernum, phi, phi_integral / weight, t_gem, t_integral / weight);
-  }
-  */
 
   if (Verbosity() > 100)
   {
@@ -428,17 +424,67 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       // For a single track event, this captures the distribution of single electron centroids on the pad plane for layer print_layer.
       // The centroid of that should match the cluster centroid found by PHG4TpcClusterizer for layer print_layer, if everything is working
       //   - matches to < .01 cm for a few cases that I checked
-
-      /*
-      assert(nthit);
-      nthit->Fill(hit, layernum, phi, phi_integral / weight, t_gem, t_integral / weight, weight);
-      */
     }
   }
 
   m_NHits++;
-  /* return pass_data; */
+  return layernum;
 }
+
+void PHG4TpcPadPlaneReadout::fill_hits(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer)
+{
+  // Fill HitSetContainer
+  //===============
+  // deposits to the same hit become adjacent, the stable sort keeps them in electron order
+  // so that the energy is summed in the same order as when adding electron by electron
+  std::stable_sort(m_deposits.begin(), m_deposits.end(), [](const HitDeposit &lhs, const HitDeposit &rhs)
+                   { return std::tie(lhs.hitsetkey, lhs.hitkey) < std::tie(rhs.hitsetkey, rhs.hitkey); });
+
+  TrkrHitSetContainer::Iterator hitsetit;
+  TrkrHitSetContainer::Iterator single_hitsetit;
+  TrkrHit *hit = nullptr;
+  TrkrHit *single_hit = nullptr;
+  for (size_t i = 0; i < m_deposits.size(); ++i)
+  {
+    const auto &deposit = m_deposits[i];
+    const bool new_hitset = (i == 0 || deposit.hitsetkey != m_deposits[i - 1].hitsetkey);
+    if (new_hitset)
+    {
+      // We add the Tpc TrkrHitsets directly to the node using hitsetcontainer
+      // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a Tpc readout module
+      hitsetit = hitsetcontainer->findOrAddHitSet(deposit.hitsetkey);
+      single_hitsetit = single_hitsetcontainer->findOrAddHitSet(deposit.hitsetkey);
+    }
+
+    if (new_hitset || deposit.hitkey != m_deposits[i - 1].hitkey)
+    {
+      // See if this hit already exists
+      hit = hitsetit->second->getHit(deposit.hitkey);
+      if (!hit)
+      {
+        // create a new one
+        hit = new TrkrHitv2();
+        hitsetit->second->addHitSpecificKey(deposit.hitkey, hit);
+      }
+
+      // repeat for the single_hitsetcontainer
+      single_hit = single_hitsetit->second->getHit(deposit.hitkey);
+      if (!single_hit)
+      {
+        single_hit = new TrkrHitv2();
+        single_hitsetit->second->addHitSpecificKey(deposit.hitkey, single_hit);
+      }
+    }
+
+    // Either way, add the energy to it  -- adc values will be added at digitization
+    hit->addEnergy(deposit.neffelectrons);
+    single_hit->addEnergy(deposit.neffelectrons);
+
+    tpc_truth_clusterer.addhitset(deposit.hitsetkey, deposit.hitkey, deposit.neffelectrons);
+  }
+  m_deposits.clear();
+}
+
 double PHG4TpcPadPlaneReadout::check_phi(const unsigned int side, const double phi, const double radius)
 {
   double new_phi = phi;
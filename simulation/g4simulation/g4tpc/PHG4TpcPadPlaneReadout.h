@@ -6,6 +6,8 @@
 
 #include <g4main/PHG4HitContainer.h>
 
+#include <trackbase/TrkrDefs.h>
+
 #include <gsl/gsl_rng.h>
 
 #include <array>
@@ -41,6 +43,8 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   void MapToPadPlane(TpcClusterBuilder &tpc_clustbuilder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
 
+  void MapElectronsToPadPlane(TpcClusterBuilder &tpc_clustbuilder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const std::vector<double> &x_gem, const std::vector<double> &y_gem, const std::vector<double> &t_gem, const std::vector<unsigned int> &side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
+
   void SetDefaultParameters() override;
   void UpdateInternalParameters() override;
 
@@ -51,6 +55,33 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   double check_phi(const unsigned int side, const double phi, const double radius);
 
+  //! amplify one electron and distribute its charge on the pads, the deposits are appended to m_deposits
+  /*! returns the layer the electron ends up in, 0 if it misses the readout */
+  unsigned int amplify_electron(const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter);
+
+  //! add the charge in m_deposits to the hits, creating the hitsets and hits as needed
+  void fill_hits(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer);
+
+  //! charge collected by one pad and time bin
+  struct HitDeposit
+  {
+    TrkrDefs::hitsetkey hitsetkey;
+    TrkrDefs::hitkey hitkey;
+    float neffelectrons;
+  };
+  std::vector<HitDeposit> m_deposits;
+
+  //! radial extent of the layers, ordered in radius
+  std::vector<double> m_layer_rad_low;
+  std::vector<double> m_layer_rad_high;
+  std::vector<PHG4TpcCylinderGeom *> m_layer_geom;
+
+  //! scratch space for the pad and time bin shares of one electron
+  std::vector<int> m_pad_phibin;
+  std::vector<double> m_pad_phibin_share;
+  std::vector<int> m_adc_tbin;
+  std::vector<double> m_adc_tbin_share;
+
   PHG4TpcCylinderGeomContainer *GeomContainer = nullptr;
   PHG4TpcCylinderGeom *LayerGeom = nullptr;
 
@@ -35,7 +35,10 @@
 #include <TProfile.h>
 #include <TSystem.h>
 #include <TTree.h>
+
+#include <algorithm>  // for fill, min, sort
 #include <cassert>
+#include <cmath>  // for floor
 #include <sstream>
 #include <string>
 
@@ -74,6 +77,15 @@ int CaloWaveformSim::Init(PHCompositeNode *topNode)
   assert(ft);
   assert(ft->IsOpen());
   h_template = (TProfile *) ft->Get("hpwaveform");
+  m_template.set_template(h_template);
+
+  // position of the template maximum, used to put the pulse peak at m_peakpos
+  TF1 f_template(
+      "f_template", [this](double *x, double *par)
+      { return this->template_function(x, par); },
+      0, m_nsamples, 3);
+  f_template.SetParameters(1.0, 0., 0.);
+  m_template_maxx = f_template.GetMaximumX();
   
   // get the decalibration from the CDB
   PHNodeIterator nodeIter(topNode);
@@ -198,11 +210,7 @@ int CaloWaveformSim::Init(PHCompositeNode *topNode)
       exit(1);
     }
   }
-  m_waveforms.resize(m_nchannels);
-  for (auto &waveform : m_waveforms)
-  {
-    waveform.resize(m_nsamples);
-  }
+  m_waveforms.assign(m_nchannels * m_nsamples, 0.);
 
   CreateNodeTree(topNode);
   return Fun4AllReturnCodes::EVENT_OK;
@@ -243,23 +251,11 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   }
 
   // initialize the waveform
-  for (auto &waveform : m_waveforms)
-  {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
-  }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
+  std::fill(m_waveforms.begin(), m_waveforms.end(), 0.);
+
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
-  float _shiftval = m_peakpos + shift_of_shift - f_fit->GetMaximumX();
-  f_fit->SetParameters(1, _shiftval, 0);
+  float _shiftval = m_peakpos + shift_of_shift - m_template_maxx;
 
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
@@ -271,7 +267,10 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     exit(1);
   }
 
-  // loop over hits
+  const CDBTTree::Column<float> &calibconsts = cdbttree->GetFloatColumn(m_fieldname);
+
+  // loop over hits, collect their amplitudes and times per tower
+  m_pulses.clear();
   for (PHG4HitContainer::ConstIterator hititer = hits->getHits().first; hititer != hits->getHits().second; hititer++)
   {
     PHG4Hit *hit = hititer->second;
@@ -288,7 +287,7 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     float correction = 1.;
     maphitetaphi(hit, etabin, phibin, correction);
     unsigned int key = encode_tower(etabin, phibin);
-    float calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    float calibconst = calibconsts.Get(key);
     float e_vis = hit->get_light_yield();
     e_vis *= correction;
     float e_dep = e_vis / m_sampling_fraction;
@@ -298,11 +297,24 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     float t0 = hit->get_t(0) / m_sampletime;
     unsigned int tower_index = decode_tower(key);
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
-    for (int i = 0; i < m_nsamples; i++)
+    // hits of a tower within the same time bin are merged into one pulse,
+    // without time bins each hit gets its own pulse
+    const long tbin = (m_time_granularity > 0) ? static_cast<long>(std::floor(t0 / m_time_granularity)) : static_cast<long>(m_pulses.size());
+    m_pulses.push_back({tower_index, tbin, ADC, std::abs(ADC), std::abs(ADC) * t0, t0});
+  }
+
+  // merge pulses and add them to the waveforms
+  if (m_time_granularity > 0)
+  {
+    merge_pulses();
+  }
+  for (const auto &pulse : m_pulses)
+  {
+    if (pulse.amplitude == 0)
     {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
+      continue;
     }
+    m_template.add_pulse(&m_waveforms[pulse.tower * m_nsamples], m_nsamples, pulse.amplitude, _shiftval + pulse.time);
   }
 
   // do noise here and add to waveform
@@ -320,30 +332,70 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
       }
     }
 
+    // pedestal and noise, the waveforms are one contiguous channel x sample buffer
+    if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+    {
+      for (auto &sample : m_waveforms)
+      {
+        sample += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+      }
+    }
+    else if (m_noiseType == NoiseType::NOISE_NONE)
+    {
+      for (auto &sample : m_waveforms)
+      {
+        sample += m_fixpedestal;
+      }
+    }
+
     for (int i = 0; i < m_nchannels; i++)
     {
-      for (int j = 0; j < m_nsamples; j++)
+      float *waveform = &m_waveforms[i * m_nsamples];
+      if (m_noiseType == NoiseType::NOISE_TREE)
       {
-        if (m_noiseType == NoiseType::NOISE_TREE)
-        {
-          TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
-          m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
-        }
-        if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
-        {
-          m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
-        }
-        if (m_noiseType == NoiseType::NOISE_NONE)
+        TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += m_fixpedestal;
+          waveform[j] += pedestal_tower->get_waveform_value(std::min(j, m_pedestalsamples - 1));
         }
-        m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+      }
+      TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(i);
+      for (int j = 0; j < m_nsamples; j++)
+      {
+        tower->set_waveform_value(j, waveform[j]);
       }
     }
-    delete f_fit;
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
+  void CaloWaveformSim::merge_pulses()
+  {
+    std::sort(m_pulses.begin(), m_pulses.end(), [](const Pulse &lhs, const Pulse &rhs)
+              { return lhs.tower < rhs.tower || (lhs.tower == rhs.tower && lhs.tbin < rhs.tbin); });
+
+    // sum pulses with the same tower and time bin, in place
+    if (m_pulses.empty())
+    {
+      return;
+    }
+    auto out = m_pulses.begin();
+    for (auto in = m_pulses.begin() + 1; in != m_pulses.end(); ++in)
+    {
+      if (in->tower == out->tower && in->tbin == out->tbin)
+      {
+        out->amplitude += in->amplitude;
+        out->weight += in->weight;
+        out->weighted_time += in->weighted_time;
+        out->time = (out->weight > 0) ? out->weighted_time / out->weight : out->time;
+      }
+      else
+      {
+        *(++out) = *in;
+      }
+    }
+    m_pulses.erase(out + 1, m_pulses.end());
+  }
+
   void CaloWaveformSim::maphitetaphi(PHG4Hit * g4hit, unsigned short &etabin, unsigned short &phibin, float &correction)
   {
     if (m_dettype == CaloTowerDefs::CEMC)
@@ -3,6 +3,8 @@
 #ifndef CALOWAVEFORMSIM_H
 #define CALOWAVEFORMSIM_H
 
+#include "CaloWaveformTemplate.h"
+
 #include <calobase/TowerInfoDefs.h>
 #include <caloreco/CaloTowerDefs.h>
 #include <fun4all/SubsysReco.h>
@@ -130,6 +132,14 @@ class CaloWaveformSim : public SubsysReco
     m_highgain = _highgain;
     return;
   }
+  // hits of a tower within the same time bin (in units of samples) are merged into one pulse
+  // at their amplitude weighted time. Pays off when there are many hits per tower and bin.
+  // 0 (default) injects one pulse per hit, same waveforms as the TF1 based injection
+  void set_time_granularity(float _time_granularity)
+  {
+    m_time_granularity = _time_granularity;
+    return;
+  }
   // for CEMC light yield correction
   LightCollectionModel &get_light_collection_model() { return light_collection_model; }
 
@@ -146,7 +156,25 @@ class CaloWaveformSim : public SubsysReco
   TowerInfoContainer *m_CaloWaveformContainer{nullptr};
   TowerInfoContainer *m_PedestalContainer{nullptr};
 
-  std::vector<std::vector<float>> m_waveforms = {{}};
+  CaloWaveformTemplate m_template;
+  double m_template_maxx{0};
+
+  // pulse of one or more hits in a tower
+  struct Pulse
+  {
+    unsigned int tower{0};
+    long tbin{0};
+    double amplitude{0};
+    double weight{0};
+    double weighted_time{0};
+    // hit time, amplitude weighted time once hits are merged
+    float time{0};
+  };
+  std::vector<Pulse> m_pulses;
+  float m_time_granularity{0.};
+
+  // waveforms of all channels, m_nsamples per channel
+  std::vector<float> m_waveforms;
   int m_runNumber{0};
   int m_nsamples{31};
   int m_nchannels{24576};
@@ -168,6 +196,7 @@ class CaloWaveformSim : public SubsysReco
   unsigned int (*encode_tower)(const unsigned int etabin, const unsigned int phibin){TowerInfoDefs::encode_emcal};
   unsigned int (*decode_tower)(const unsigned int tower_key){TowerInfoDefs::decode_emcal};
   double template_function(double *x, double *par);
+  void merge_pulses();
   void CreateNodeTree(PHCompositeNode *topNode);
 
   LightCollectionModel light_collection_model;
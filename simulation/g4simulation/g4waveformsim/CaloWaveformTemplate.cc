@@ -0,0 +1,88 @@
+#include "CaloWaveformTemplate.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>  // for min
+#include <iostream>
+
+CaloWaveformTemplate::CaloWaveformTemplate(const TH1 *h)
+{
+  set_template(h);
+}
+
+void CaloWaveformTemplate::set_template(const TH1 *h)
+{
+  m_values.clear();
+  if (!h || h->GetNbinsX() < 1)
+  {
+    std::cout << "CaloWaveformTemplate::set_template - invalid template histogram" << std::endl;
+    return;
+  }
+
+  const int nbins = h->GetNbinsX();
+  if (!h->GetXaxis()->IsVariableBinSize())
+  {
+    // linear interpolation between bin centers, the table is the bin contents
+    m_values.reserve(nbins);
+    for (int i = 1; i <= nbins; ++i)
+    {
+      m_values.push_back(h->GetBinContent(i));
+    }
+    m_first = h->GetBinCenter(1);
+    m_inv_step = 1. / h->GetBinWidth(1);
+  }
+  else
+  {
+    // variable bins, sample TH1::Interpolate on a grid ten times finer than the smallest bin
+    double step = h->GetBinWidth(1);
+    for (int i = 2; i <= nbins; ++i)
+    {
+      step = std::min(step, h->GetBinWidth(i));
+    }
+    step /= 10;
+    m_first = h->GetBinCenter(1);
+    const double last = h->GetBinCenter(nbins);
+    const auto npoints = static_cast<unsigned int>((last - m_first) / step) + 2;
+    m_values.reserve(npoints);
+    for (unsigned int i = 0; i < npoints; ++i)
+    {
+      m_values.push_back(h->Interpolate(m_first + i * step));
+    }
+    m_inv_step = 1. / step;
+  }
+  m_last_index = m_values.size() - 1;
+}
+
+void CaloWaveformTemplate::add_pulse(float *waveform, int nsamples, double amplitude, double shift) const
+{
+  if (empty())
+  {
+    return;
+  }
+
+  // samples before the first and after the last tabulated point get the edge values,
+  // the samples in between are interpolated without further range checks
+  int i = 0;
+  const double front = amplitude * m_values.front();
+  for (; i < nsamples && !((i - shift - m_first) * m_inv_step > 0); ++i)
+  {
+    waveform[i] += front;
+  }
+  for (; i < nsamples; ++i)
+  {
+    const double u = (i - shift - m_first) * m_inv_step;
+    if (u >= m_last_index)
+    {
+      break;
+    }
+    const auto bin = static_cast<unsigned int>(u);
+    const double frac = u - bin;
+    waveform[i] += amplitude * (m_values[bin] + frac * (m_values[bin + 1] - m_values[bin]));
+  }
+  const double back = amplitude * m_values.back();
+  for (; i < nsamples; ++i)
+  {
+    waveform[i] += back;
+  }
+}
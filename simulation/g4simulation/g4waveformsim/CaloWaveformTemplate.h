@@ -0,0 +1,54 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef CALOWAVEFORMTEMPLATE_H
+#define CALOWAVEFORMTEMPLATE_H
+
+#include <vector>
+
+class TH1;
+
+// Pulse template tabulated from a histogram (e.g. the TProfile of the
+// waveform template file). eval() gives the same values as TH1::Interpolate,
+// which is linear between bin centers and constant outside the first and last
+// bin centers, without the TH1/TF1 call overhead. add_pulse() adds a scaled
+// and shifted pulse to a waveform in one pass over the samples.
+class CaloWaveformTemplate
+{
+ public:
+  CaloWaveformTemplate() = default;
+  explicit CaloWaveformTemplate(const TH1 *h);
+
+  // tabulate the bin contents of h, h is not used afterwards
+  void set_template(const TH1 *h);
+
+  bool empty() const { return m_values.empty(); }
+
+  // template value at x, same as TH1::Interpolate(x)
+  double eval(double x) const
+  {
+    const double u = (x - m_first) * m_inv_step;
+    if (!(u > 0))
+    {
+      return m_values.front();
+    }
+    if (u >= m_last_index)
+    {
+      return m_values.back();
+    }
+    const auto i = static_cast<unsigned int>(u);
+    const double frac = u - i;
+    return m_values[i] + frac * (m_values[i + 1] - m_values[i]);
+  }
+
+  // waveform[i] += amplitude * eval(i - shift), for i in [0, nsamples)
+  void add_pulse(float *waveform, int nsamples, double amplitude, double shift) const;
+
+ private:
+  // bin contents, at bin centers m_first + i / m_inv_step
+  std::vector<double> m_values;
+  double m_first{0};
+  double m_inv_step{1};
+  double m_last_index{0};
+};
+
+#endif  // CALOWAVEFORMTEMPLATE_H